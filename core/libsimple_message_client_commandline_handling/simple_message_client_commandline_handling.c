@@ -48,47 +48,48 @@
 
 /**
  *
- * \brief Parse the command line
- *
- * This function parses the command line and extracts the arguments
+ * \brief Parse the command line into \a options
  *
  * \param argc [IN] - number of command line arguments.
  * \param argv [IN] - array of command line arguments.
  * \param usagefunc [IN] - pointer to a function called for diplaying usage information.
- * \param server [OUT] - string containing the IP address or the FQDN of the server
- * \param port [OUT] - string containing the port number or the service name
- * \param user [OUT] - string containing the name of the user
- * \param message [OUT] - string containing the message
- * \param img_url [OUT] - string containing the image URL
- * \param verbose [OUT] - int containing info whether output shall be verbose or not
- *
- * \return Upon successful execution, the function returns and the output parameters
- *         \a port, \a server, \a message, and  \a img_url are filled properly (Note that
- *         img_url might be NULL, since it's optional on the commandline.). - Upon
- *         failure the function prints usage information and terminates the program by
- *         calling \a usagefunc.
+ * \param extended [IN] - TRUE if the extended options are accepted
+ * \param options [OUT] - the extracted arguments
  *
  */
-void smc_parsecommandline(
+static void parsecommandline(
     int argc,
     const char * const argv[],
-    smc_usagefunc_t usagefunc, 
-    const char **server,
-    const char **port,
-    const char **user,
-    const char **message,
-    const char **img_url,
-    int *verbose
+    smc_usagefunc_t usagefunc,
+    int extended,
+    smc_options_t *options
     )
 {
     int c;
 
-    *server = NULL;
-    *port = NULL;
-    *user = NULL;
-    *message = NULL;
-    *img_url = NULL;
-    *verbose = FALSE;
+    options->server = NULL;
+    options->port = NULL;
+    options->user = NULL;
+    options->message = NULL;
+    options->img_url = NULL;
+    options->verbose = FALSE;
+    options->compressed = FALSE;
+    options->keep_alive = FALSE;
+    options->messages = NULL;
+    options->message_count = 0;
+    options->batch = NULL;
+    options->follow = FALSE;
+    options->search = NULL;
+    options->posts_by = NULL;
+    options->board = NULL;
+
+    /*
+     * there are never more messages than arguments
+     */
+    if (extended && ((options->messages = malloc(argc * sizeof(*options->messages))) == NULL))
+    {
+        usagefunc(stderr, argv[0], EXIT_FAILURE);
+    }
 
     struct option long_options[] =
     {
@@ -99,14 +100,31 @@ void smc_parsecommandline(
         {"message", 1, NULL, 'm'},
         {"verbose", 0, NULL, 'v'},
         {"help", 0, NULL, 'h'},
+        {"compressed", 0, NULL, 'c'},
+        {"keep-alive", 0, NULL, 'k'},
+        {"batch", 1, NULL, 'b'},
+        {"follow", 0, NULL, 'f'},
+        {"search", 1, NULL, 'q'},
+        {"posts-by", 1, NULL, 'a'},
+        {"board", 1, NULL, 'B'},
         {0, 0, 0, 0}
     };
 
+    /*
+     * the extended options are listed last, hide them from the
+     * original interface.
+     */
+    if (!extended)
+    {
+        long_options[7].name = NULL;
+        long_options[7].val = 0;
+    }
+
     while (
         (c = getopt_long(
              argc,
              (char ** const) argv,
-             "s:p:u:i:m:hv",
+             extended ? "s:p:u:i:m:hvckb:fq:a:B:" : "s:p:u:i:m:hv",
              long_options,
              NULL
              )
@@ -116,27 +134,59 @@ void smc_parsecommandline(
         switch (c)
         {
             case 's':
-                *server = optarg;
+                options->server = optarg;
                 break;
 
             case 'p':
-                *port = optarg;
+                options->port = optarg;
                 break;
 
             case 'u':
-                *user = optarg;
+                options->user = optarg;
                 break;
 
             case 'i':
-                *img_url = optarg;
+                options->img_url = optarg;
                 break;
 
             case 'm':
-                *message = optarg;
+                options->message = optarg;
+                if (extended)
+                {
+                    options->messages[options->message_count++] = optarg;
+                }
                 break;
 
             case 'v':
-                *verbose = TRUE;
+                options->verbose = TRUE;
+                break;
+
+            case 'c':
+                options->compressed = TRUE;
+                break;
+
+            case 'k':
+                options->keep_alive = TRUE;
+                break;
+
+            case 'b':
+                options->batch = optarg;
+                break;
+
+            case 'f':
+                options->follow = TRUE;
+                break;
+
+            case 'q':
+                options->search = optarg;
+                break;
+
+            case 'a':
+                options->posts_by = optarg;
+                break;
+
+            case 'B':
+                options->board = optarg;
                 break;
 
             case 'h':
@@ -150,18 +200,111 @@ void smc_parsecommandline(
         }
     }
 
+    /*
+     * a batch file carries users and messages itself, following,
+     * searching or listing the bulletin board requires no message at all
+     */
     if (
         (optind != argc) ||
-        (*port == NULL) ||
-        (*server == NULL) ||
-        (*user == NULL) ||
-        (*message == NULL)
+        (options->port == NULL) ||
+        (options->server == NULL) ||
+        (
+            (
+                (options->batch == NULL && !options->follow && options->search == NULL && options->posts_by == NULL) ||
+                (options->message != NULL)
+                ) &&
+            (options->user == NULL)
+            ) ||
+        (
+            (options->batch == NULL) && !options->follow && (options->search == NULL) &&
+            (options->posts_by == NULL) &&
+            (options->message == NULL)
+            )
         )
     {
         usagefunc(stderr, argv[0], EXIT_FAILURE);
     }
 }
 
+/**
+ *
+ * \brief Parse the command line
+ *
+ * This function parses the command line and extracts the arguments
+ *
+ * \param argc [IN] - number of command line arguments.
+ * \param argv [IN] - array of command line arguments.
+ * \param usagefunc [IN] - pointer to a function called for diplaying usage information.
+ * \param server [OUT] - string containing the IP address or the FQDN of the server
+ * \param port [OUT] - string containing the port number or the service name
+ * \param user [OUT] - string containing the name of the user
+ * \param message [OUT] - string containing the message
+ * \param img_url [OUT] - string containing the image URL
+ * \param verbose [OUT] - int containing info whether output shall be verbose or not
+ *
+ * \return Upon successful execution, the function returns and the output parameters
+ *         \a port, \a server, \a message, and  \a img_url are filled properly (Note that
+ *         img_url might be NULL, since it's optional on the commandline.). - Upon
+ *         failure the function prints usage information and terminates the program by
+ *         calling \a usagefunc.
+ *
+ */
+void smc_parsecommandline(
+    int argc,
+    const char * const argv[],
+    smc_usagefunc_t usagefunc, 
+    const char **server,
+    const char **port,
+    const char **user,
+    const char **message,
+    const char **img_url,
+    int *verbose
+    )
+{
+    smc_options_t options;
+
+    parsecommandline(argc, argv, usagefunc, FALSE, &options);
+
+    *server = options.server;
+    *port = options.port;
+    *user = options.user;
+    *message = options.message;
+    *img_url = options.img_url;
+    *verbose = options.verbose;
+}
+
+/**
+ *
+ * \brief Parse the extended command line
+ *
+ * This function parses the command line like \a smc_parsecommandline()
+ * and additionally accepts the options -c, --compressed, -k, --keep-alive,
+ * -b, --batch, -f, --follow, -q, --search and -a, --posts-by. The option
+ * -m may be given several times, \a message is the last of the \a
+ * messages then. If a batch file is given, the bulletin board is
+ * followed, searched or the posts of a user are requested, the options
+ * -u and -m are optional.
+ *
+ * \param argc [IN] - number of command line arguments.
+ * \param argv [IN] - array of command line arguments.
+ * \param usagefunc [IN] - pointer to a function called for diplaying usage information.
+ * \param options [OUT] - the extracted arguments
+ *
+ * \return Upon successful execution, the function returns and \a options is
+ *         filled properly. - Upon failure the function prints usage information
+ *         and terminates the program by calling \a usagefunc.
+ *
+ */
+void smc_parsecommandline_ext(
+    int argc,
+    const char * const argv[],
+    smc_usagefunc_t usagefunc,
+    smc_options_t *options
+    )
+{
+    parsecommandline(argc, argv, usagefunc, TRUE, options);
+}
+
 /*
  * =================================================================== eof ==
  */
@@ -36,6 +36,29 @@
 
 typedef void (* smc_usagefunc_t) (FILE *, const char *, int);
 
+/**
+ * The arguments extracted by \a smc_parsecommandline_ext(). Strings
+ * which are not given on the commandline are NULL.
+ */
+typedef struct
+{
+    const char *server;
+    const char *port;
+    const char *user;
+    const char *message;
+    const char *img_url;
+    int verbose;
+    int compressed;     /* request compressed responses (-c) */
+    int keep_alive;     /* send all messages over one connection (-k) */
+    const char **messages;  /* all messages given with -m, in order */
+    int message_count;
+    const char *batch;  /* file of records to be posted (-b), "-" is stdin */
+    int follow;         /* print new posts as they are pushed by the server (-f) */
+    const char *search; /* words of the posts to be printed (-q) */
+    const char *posts_by;   /* user whose posts are to be printed (-a) */
+    const char *board;  /* board the requests are addressed to (-B), NULL for the default board */
+} smc_options_t;
+
 /*
  * --------------------------------------------------------------- globals --
  */
@@ -79,6 +102,36 @@ extern void smc_parsecommandline(
     int *verbose
     );
 
+/**
+ *
+ * \brief Parse the extended command line
+ *
+ * This function parses the command line like \a smc_parsecommandline()
+ * and additionally accepts the options -c, --compressed, -k, --keep-alive,
+ * -b, --batch, -f, --follow, -q, --search, -a, --posts-by and -B,
+ * --board. The option
+ * -m may be given several times, \a message is the last of the \a
+ * messages then. If a batch file is given, the bulletin board is
+ * followed, searched or the posts of a user are requested, the options
+ * -u and -m are optional.
+ *
+ * \param argc [IN] - number of command line arguments.
+ * \param argv [IN] - array of command line arguments.
+ * \param usagefunc [IN] - pointer to a function called for diplaying usage information.
+ * \param options [OUT] - the extracted arguments
+ *
+ * \return Upon successful execution, the function returns and \a options is
+ *         filled properly. - Upon failure the function prints usage information
+ *         and terminates the program by calling \a usagefunc.
+ *
+ */
+extern void smc_parsecommandline_ext(
+    int argc,
+    const char * const argv[],
+    smc_usagefunc_t usagefunc,
+    smc_options_t *options
+    );
+
 /*
  * =================================================================== eof ==
  */
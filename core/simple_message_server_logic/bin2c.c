@@ -8,18 +8,25 @@
 // worth it, you can buy me a beer in return.  Sandro Sigala
 //
 // syntax:  bin2c [-c] [-z] <input_file> <output_file>
+//          bin2c -t <input_file> <output_file>
 //
 //          -c    add the "const" keyword to definition
 //          -z    terminate the array with a zero (useful for embedded C strings)
+//          -t    compile a template into a template_t (see template.h): every
+//                "%s" becomes a placeholder, every "%h" a placeholder escaped
+//                for HTML, "%%" a literal '%'. The literal segments are
+//                additionally stored as raw deflate streams.
 //
 // examples:
 //     bin2c -c myimage.png myimage_png.cpp
 //     bin2c -z sometext.txt sometext_txt.cpp
+//     bin2c -t page.thtml page.thtml.h
  
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <zlib.h>
  
 #ifndef PATH_MAX
 #define PATH_MAX 1024
@@ -27,6 +34,7 @@
  
 int useconst = 0;
 int zeroterminated = 0;
+int template = 0;
  
 int myfgetc(FILE *f)
 {
@@ -39,22 +47,9 @@ int myfgetc(FILE *f)
         return c;
 }
  
-void process(const char *ifname, const char *ofname)
+void identifier(const char *ifname, char *buf)
 {
-        FILE *ifile, *ofile;
-        ifile = fopen(ifname, "rb");
-        if (ifile == NULL)
-        {
-                fprintf(stderr, "cannot open %s for reading\n", ifname);
-                exit(1);
-        }
-        ofile = fopen(ofname, "wb");
-        if (ofile == NULL)
-        {
-                fprintf(stderr, "cannot open %s for writing\n", ofname);
-                exit(1);
-        }
-        char buf[PATH_MAX], *p;
+        char *p;
         const char *cp;
         if ((cp = strrchr(ifname, '/')) != NULL)
         {
@@ -71,6 +66,30 @@ void process(const char *ifname, const char *ofname)
           if (!isalnum((int) *p))
                         *p = '_';
         }
+}
+ 
+void open_files(const char *ifname, const char *ofname, FILE **ifile, FILE **ofile)
+{
+        *ifile = fopen(ifname, "rb");
+        if (*ifile == NULL)
+        {
+                fprintf(stderr, "cannot open %s for reading\n", ifname);
+                exit(1);
+        }
+        *ofile = fopen(ofname, "wb");
+        if (*ofile == NULL)
+        {
+                fprintf(stderr, "cannot open %s for writing\n", ofname);
+                exit(1);
+        }
+}
+ 
+void process(const char *ifname, const char *ofname)
+{
+        FILE *ifile, *ofile;
+        char buf[PATH_MAX];
+        open_files(ifname, ofname, &ifile, &ofile);
+        identifier(ifname, buf);
         fprintf(ofile, "static %sunsigned char %s[] = {\n", useconst ? "const " : "", buf);
         int c, col = 1;
         while ((c = myfgetc(ifile)) != EOF)
@@ -89,9 +108,147 @@ void process(const char *ifname, const char *ofname)
         fclose(ofile);
 }
  
+// write the character c as part of a C string literal
+void literal_char(FILE *ofile, int c)
+{
+        if (c == '"' || c == '\\')
+                fprintf(ofile, "\\%c", c);
+        else if (c == '\n')
+                fprintf(ofile, "\\n\"\n                \"");
+        else if (c == '\t')
+                fprintf(ofile, "\\t");
+        else if (c < 0x20 || c >= 0x7f || c == '?')
+                fprintf(ofile, "\\%.3o", c);  // '?' avoids trigraphs
+        else
+                fputc(c, ofile);
+}
+ 
+// a segment of a template: literal text or a placeholder
+struct segment
+{
+        int placeholder;        // 0, 's' or 'h'
+        unsigned char *text;
+        size_t len;
+        unsigned char *deflated;
+        size_t deflated_len;
+};
+ 
+struct segment *add_segment(struct segment **segs, int *count)
+{
+        *segs = realloc(*segs, (*count + 1) * sizeof(**segs));
+        if (*segs == NULL)
+        {
+                fprintf(stderr, "out of memory\n");
+                exit(1);
+        }
+        memset(&(*segs)[*count], 0, sizeof(**segs));
+        return &(*segs)[(*count)++];
+}
+ 
+// compress a literal into a raw deflate stream which ends on a byte
+// boundary without a final block, thus it can be concatenated with
+// other such streams
+void deflate_literal(struct segment *seg)
+{
+        z_stream z;
+        memset(&z, 0, sizeof(z));
+        if (deflateInit2(&z, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+                fprintf(stderr, "deflateInit2() failed\n");
+                exit(1);
+        }
+        seg->deflated = malloc(deflateBound(&z, seg->len) + 16);
+        z.next_in = seg->text;
+        z.avail_in = seg->len;
+        z.next_out = seg->deflated;
+        z.avail_out = deflateBound(&z, seg->len) + 16;
+        if (seg->deflated == NULL || deflate(&z, Z_SYNC_FLUSH) != Z_OK || z.avail_in != 0)
+        {
+                fprintf(stderr, "deflate() failed\n");
+                exit(1);
+        }
+        seg->deflated_len = z.total_out;
+        deflateEnd(&z);
+}
+ 
+void process_template(const char *ifname, const char *ofname)
+{
+        FILE *ifile, *ofile;
+        char buf[PATH_MAX];
+        struct segment *segs = NULL, *seg;
+        int c, count = 0, placeholders = 0;
+        size_t i, literal_len = 0, deflated_len = 0;
+        open_files(ifname, ofname, &ifile, &ofile);
+        identifier(ifname, buf);
+        for (;;)
+        {
+                c = fgetc(ifile);
+                if (c == '%')
+                {
+                        c = fgetc(ifile);
+                        if (c == 's' || c == 'h')
+                        {
+                                add_segment(&segs, &count)->placeholder = c;
+                                ++placeholders;
+                                continue;
+                        }
+                        if (c != '%')
+                        {
+                                fprintf(stderr, "%s: unsupported placeholder %%%c\n", ifname, c == EOF ? ' ' : c);
+                                exit(1);
+                        }
+                }
+                if (c == EOF)
+                        break;
+                if (count == 0 || segs[count - 1].placeholder)
+                        add_segment(&segs, &count);
+                seg = &segs[count - 1];
+                seg->text = realloc(seg->text, seg->len + 1);
+                if (seg->text == NULL)
+                {
+                        fprintf(stderr, "out of memory\n");
+                        exit(1);
+                }
+                seg->text[seg->len++] = c;
+        }
+        fprintf(ofile, "#include \"template.h\"\n\n");
+        for (seg = segs; seg < segs + count; ++seg)
+        {
+                if (seg->placeholder)
+                        continue;
+                deflate_literal(seg);
+                fprintf(ofile, "static const unsigned char %s_deflated_%d[] = {", buf, (int) (seg - segs));
+                for (i = 0; i < seg->deflated_len; ++i)
+                        fprintf(ofile, "%s0x%.2x,", i % 12 == 0 ? "\n        " : " ", seg->deflated[i]);
+                fprintf(ofile, "\n};\n\n");
+                literal_len += seg->len;
+                deflated_len += seg->deflated_len;
+        }
+        fprintf(ofile, "static const template_segment_t %s_segments[] = {\n", buf);
+        for (seg = segs; seg < segs + count; ++seg)
+        {
+                if (seg->placeholder)
+                {
+                        fprintf(ofile, "        { %s, NULL, 0, NULL, 0 },\n", seg->placeholder == 's' ? "TEMPLATE_STRING" : "TEMPLATE_HTML");
+                        continue;
+                }
+                fprintf(ofile, "        { TEMPLATE_LITERAL, \"");
+                for (i = 0; i < seg->len; ++i)
+                        literal_char(ofile, seg->text[i]);
+                fprintf(ofile, "\", %lu, %s_deflated_%d, %lu },\n", (unsigned long) seg->len, buf, (int) (seg - segs), (unsigned long) seg->deflated_len);
+        }
+        fprintf(ofile, "};\n\n");
+        fprintf(ofile, "static const template_t %s = {\n", buf);
+        fprintf(ofile, "        %s_segments, %d, %lu, %d, %lu\n};\n", buf, count, (unsigned long) literal_len, placeholders, (unsigned long) deflated_len);
+ 
+        fclose(ifile);
+        fclose(ofile);
+}
+ 
 void usage(void)
 {
-        fprintf(stderr, "usage: bin2c [-cz] <input_file> <output_file>\n");
+        fprintf(stderr, "usage: bin2c [-cz] <input_file> <output_file>\n"
+                        "       bin2c -t <input_file> <output_file>\n");
         exit(1);
 }
  
@@ -109,6 +266,11 @@ int main(int argc, char **argv)
                         zeroterminated = 1;
                         --argc;
                         ++argv;
+                } else if (!strcmp(argv[1], "-t"))
+                {
+                        template = 1;
+                        --argc;
+                        ++argv;
                 } else {
                         usage();
                 }
@@ -117,6 +279,9 @@ int main(int argc, char **argv)
         {
                 usage();
         }
-        process(argv[1], argv[2]);
+        if (template)
+                process_template(argv[1], argv[2]);
+        else
+                process(argv[1], argv[2]);
         return 0;
 }
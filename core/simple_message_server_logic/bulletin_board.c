@@ -0,0 +1,808 @@
+/* ================================================================ */
+/**
+ * @file bulletin_board.c
+ * Post store of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the binary post store which is shared by
+ * the business logic and the tools operating on the bulletin board,
+ * i.e. the file and the null backend and the dispatch to the backend
+ * of an opened store.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+
+#include "bulletin_board.h"
+#include "template.h"
+
+/*
+ * include compiled HTML templates.
+ */
+#include "content_entry_with_img.thtml.h"
+#include "content_entry_without_img.thtml.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MAXPATHLEN _POSIX_PATH_MAX
+
+/*
+ * layout of the record header (native byte order):
+ *
+ *  0: uint32_t length of the record incl. header
+ *  4: uint32_t length of the message
+ *  8: uint64_t timestamp
+ * 16: uint16_t length of the user name
+ * 18: uint16_t length of the image URL (0 if there is no image)
+ * 20: user name, image URL and message (not zero-terminated)
+ */
+#define RECORD_HEADER_LEN 20
+#define INDEX_ENTRY_LEN sizeof(uint64_t)
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+/*
+ * backend of the stores opened, see bb_use_backend()
+ */
+static const bb_backend_t *selected_backend = &bb_file_backend;
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Open a file of the post store
+ *
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param name zero-terminated string containing the name of the file [IN]
+ * \param mode BB_READ or BB_WRITE [IN]
+ *
+ * \return file descriptor of the opened file
+ * \retval -1 failed, errno is set
+ */
+static int open_store_file(
+    const char *dir,
+    const char *name,
+    int mode
+    )
+{
+    char file[MAXPATHLEN];
+    int cnt;
+
+    cnt = snprintf(file, sizeof(file), "%s/%s", dir, name);
+
+    if ((cnt < 0) || ((size_t) cnt >= sizeof(file)))
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    if (mode == BB_WRITE)
+    {
+        return open(file, O_RDWR | O_APPEND | O_CREAT, 0644);
+    }
+
+    return open(file, O_RDONLY);
+}
+
+/**
+ * \brief Open the data and the index file of the post store, see bb_open()
+ *
+ * \param store the store to be initialised [OUT]
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param mode BB_READ or BB_WRITE [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int file_open(
+    bb_store_t *store,
+    const char *dir,
+    int mode
+    )
+{
+    int saved_errno;
+
+    if ((store->data_fd = open_store_file(dir, BB_POSTS_FILE, mode)) == -1)
+    {
+        return -1;
+    }
+
+    if ((store->index_fd = open_store_file(dir, BB_INDEX_FILE, mode)) == -1)
+    {
+        saved_errno = errno;
+        (void) close(store->data_fd);
+        errno = saved_errno;
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Close the data and the index file of the post store
+ *
+ * \param store the store to be closed [IN]
+ */
+static void file_close(
+    bb_store_t *store
+    )
+{
+    (void) close(store->index_fd);
+    (void) close(store->data_fd);
+}
+
+/**
+ * \brief Write a buffer completely
+ *
+ * \param fd file descriptor to write to [IN]
+ * \param buf pointer to the buffer to write [IN]
+ * \param len length of the buffer pointed to by \a buf [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int write_all(
+    int fd,
+    const void *buf,
+    size_t len
+    )
+{
+    ssize_t cnt;
+
+    if ((cnt = write(fd, buf, len)) == -1)
+    {
+        return -1;
+    }
+
+    if ((size_t) cnt != len)
+    {
+        errno = EIO;  /* short write on a regular file - disk full */
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Serialize a post into a record
+ *
+ * \param post the post to be serialized [IN]
+ * \param buf buffer of at least RECORD_HEADER_LEN + BB_MAXPOSTLEN bytes [OUT]
+ *
+ * \return the length of the record
+ * \retval 0 the post is too long
+ */
+static size_t encode_record(
+    const bb_post_t *post,
+    char *buf
+    )
+{
+    const size_t img_size = (post->img != NULL) ? post->img_len : 0;
+    const uint16_t user_len = (uint16_t) post->user_len;
+    const uint16_t img_len = (uint16_t) img_size;
+    const uint32_t msg_len = (uint32_t) post->msg_len;
+    uint32_t len;
+
+    if (post->user_len + img_size + post->msg_len > BB_MAXPOSTLEN)
+    {
+        return 0;
+    }
+
+    len = RECORD_HEADER_LEN + user_len + img_len + msg_len;
+
+    memcpy(buf, &len, sizeof(len));
+    memcpy(buf + 4, &msg_len, sizeof(msg_len));
+    memcpy(buf + 8, &post->timestamp, sizeof(post->timestamp));
+    memcpy(buf + 16, &user_len, sizeof(user_len));
+    memcpy(buf + 18, &img_len, sizeof(img_len));
+
+    buf += RECORD_HEADER_LEN;
+    memcpy(buf, post->user, user_len);
+    memcpy(buf + user_len, post->img, img_len);
+    memcpy(buf + user_len + img_len, post->msg, msg_len);
+
+    return len;
+}
+
+/**
+ * \brief Append posts to the data and the index file, see bb_append()
+ *
+ * The records and their index entries are written with a single write
+ * each while the index is locked exclusively.
+ *
+ * \param store the store opened with BB_WRITE [IN]
+ * \param posts the posts to be appended [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param first set to the number of the first appended post, may be NULL [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int file_append(
+    bb_store_t *store,
+    const bb_post_t *posts,
+    size_t count,
+    uint64_t *first
+    )
+{
+    struct stat data_stat, index_stat;
+    char *records;
+    uint64_t *offsets;
+    uint64_t entries;
+    size_t i, len = 0, rec_len;
+    int saved_errno;
+    int rc = -1;
+
+    records = malloc(count * (RECORD_HEADER_LEN + BB_MAXPOSTLEN));
+    offsets = malloc(count * INDEX_ENTRY_LEN);
+
+    if ((records == NULL) || (offsets == NULL))
+    {
+        free(records);
+        free(offsets);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (flock(store->index_fd, LOCK_EX) == -1)
+    {
+        goto out;
+    }
+
+    if (
+        (fstat(store->data_fd, &data_stat) == -1) ||
+        (fstat(store->index_fd, &index_stat) == -1)
+        )
+    {
+        goto out;
+    }
+
+    /*
+     * drop a torn index entry of a writer which died in the middle
+     * of the write.
+     */
+    entries = (uint64_t) index_stat.st_size / INDEX_ENTRY_LEN;
+
+    if (
+        ((index_stat.st_size % INDEX_ENTRY_LEN) != 0) &&
+        (ftruncate(store->index_fd, entries * INDEX_ENTRY_LEN) == -1)
+        )
+    {
+        goto out;
+    }
+
+    /*
+     * all writers hold the index lock, thus the records are appended
+     * right at the current end of the data file.
+     */
+    for (i = 0; i < count; i++)
+    {
+        if ((rec_len = encode_record(&posts[i], records + len)) == 0)
+        {
+            errno = EMSGSIZE;
+            goto out;
+        }
+
+        offsets[i] = (uint64_t) data_stat.st_size + len;
+        len += rec_len;
+    }
+
+    /*
+     * the records are written before the index entries - readers
+     * never see an index entry of a missing record.
+     */
+    if (
+        (write_all(store->data_fd, records, len) == -1) ||
+        (write_all(store->index_fd, offsets, count * INDEX_ENTRY_LEN) == -1)
+        )
+    {
+        goto out;
+    }
+
+    if (first != NULL)
+    {
+        *first = entries;
+    }
+
+    rc = 0;
+
+out:
+    saved_errno = errno;
+    (void) flock(store->index_fd, LOCK_UN);
+    free(records);
+    free(offsets);
+    errno = saved_errno;
+
+    return rc;
+}
+
+/**
+ * \brief Get the number of posts from the size of the index file
+ *
+ * \param store the opened store [IN]
+ *
+ * \return the number of posts
+ * \retval -1 failed, errno is set
+ */
+static int64_t file_count(
+    bb_store_t *store
+    )
+{
+    struct stat statbuf;
+
+    if (fstat(store->index_fd, &statbuf) == -1)
+    {
+        return -1;
+    }
+
+    return (int64_t) (statbuf.st_size / INDEX_ENTRY_LEN);
+}
+
+/**
+ * \brief Get the identity of the store from the inode of the index file
+ *
+ * \param store the opened store [IN]
+ *
+ * \return identity of the store
+ * \retval 0 unknown, errno is set
+ */
+static uint64_t file_id(
+    const bb_store_t *store
+    )
+{
+    struct stat statbuf;
+
+    if (fstat(store->index_fd, &statbuf) == -1)
+    {
+        return 0;
+    }
+
+    return ((uint64_t) statbuf.st_dev << 32) ^ (uint64_t) statbuf.st_ino;
+}
+
+/**
+ * \brief Read exactly \a len bytes at offset \a offset
+ *
+ * \param fd file descriptor to read from [IN]
+ * \param buf buffer to be filled [OUT]
+ * \param len number of bytes to read [IN]
+ * \param offset position in the file to read from [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int read_at(
+    int fd,
+    void *buf,
+    size_t len,
+    uint64_t offset
+    )
+{
+    ssize_t cnt;
+
+    if ((cnt = pread(fd, buf, len, (off_t) offset)) == -1)
+    {
+        return -1;
+    }
+
+    if ((size_t) cnt != len)
+    {
+        errno = EIO;  /* store is truncated */
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Read a post via its index entry, see bb_read()
+ *
+ * \param store the opened store [IN]
+ * \param number the number of the post [IN]
+ * \param record the record to be filled [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int file_read(
+    bb_store_t *store,
+    uint64_t number,
+    bb_record_t *record
+    )
+{
+    char header[RECORD_HEADER_LEN];
+    char body[BB_MAXPOSTLEN];
+    uint64_t offset;
+    uint32_t len, msg_len;
+    uint16_t user_len, img_len;
+    bb_post_t *post = &record->post;
+    char *p = record->buf;
+
+    if (
+        (read_at(
+            store->index_fd,
+            &offset,
+            sizeof(offset),
+            number * INDEX_ENTRY_LEN
+            ) == -1) ||
+        (read_at(store->data_fd, header, sizeof(header), offset) == -1)
+        )
+    {
+        return -1;
+    }
+
+    memcpy(&len, header, sizeof(len));
+    memcpy(&msg_len, header + 4, sizeof(msg_len));
+    memcpy(&post->timestamp, header + 8, sizeof(post->timestamp));
+    memcpy(&user_len, header + 16, sizeof(user_len));
+    memcpy(&img_len, header + 18, sizeof(img_len));
+
+    if (
+        ((size_t) user_len + img_len + msg_len > BB_MAXPOSTLEN) ||
+        (len != RECORD_HEADER_LEN + user_len + img_len + msg_len)
+        )
+    {
+        errno = EINVAL;  /* corrupted record */
+        return -1;
+    }
+
+    if (read_at(
+            store->data_fd,
+            body,
+            len - RECORD_HEADER_LEN,
+            offset + RECORD_HEADER_LEN
+            ) == -1)
+    {
+        return -1;
+    }
+
+    /*
+     * copy the strings into the record buffer and terminate them.
+     */
+    post->user = p;
+    post->user_len = user_len;
+    memcpy(p, body, user_len);
+    p += user_len;
+    *p++ = '\0';
+
+    post->img = NULL;
+    post->img_len = img_len;
+    if (img_len > 0)
+    {
+        post->img = p;
+        memcpy(p, body + user_len, img_len);
+        p += img_len;
+        *p++ = '\0';
+    }
+
+    post->msg = p;
+    post->msg_len = msg_len;
+    memcpy(p, body + user_len + img_len, msg_len);
+    p[msg_len] = '\0';
+
+    return 0;
+}
+
+/**
+ * \brief Flush the data and the index file to stable storage
+ *
+ * \param store the store opened with BB_WRITE [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int file_flush(
+    bb_store_t *store
+    )
+{
+    if ((fdatasync(store->data_fd) == -1) || (fdatasync(store->index_fd) == -1))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+const bb_backend_t bb_file_backend =
+{
+    "file",
+    0,
+    file_open,
+    file_close,
+    file_append,
+    file_flush,
+    file_count,
+    file_id,
+    file_read
+};
+
+/**
+ * \brief Open the null store
+ *
+ * \param store the store to be initialised [OUT]
+ * \param dir ignored [IN]
+ * \param mode ignored [IN]
+ *
+ * \retval 0 always
+ */
+static int null_open(
+    bb_store_t *store,
+    const char *dir,
+    int mode
+    )
+{
+    (void) dir;
+    (void) mode;
+
+    store->data_fd = -1;
+    store->index_fd = -1;
+
+    return 0;
+}
+
+/**
+ * \brief Close the null store
+ *
+ * \param store ignored [IN]
+ */
+static void null_close(
+    bb_store_t *store
+    )
+{
+    (void) store;
+}
+
+/**
+ * \brief Discard posts
+ *
+ * The posts are checked like the ones appended to the other backends,
+ * thus a post rejected by them is rejected by the null sink as well.
+ *
+ * \param store ignored [IN]
+ * \param posts the posts to be discarded [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param first set to 0, the null store numbers no posts (see
+ *        null_count()), may be NULL [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 a post is too long, errno is set
+ */
+static int null_append(
+    bb_store_t *store,
+    const bb_post_t *posts,
+    size_t count,
+    uint64_t *first
+    )
+{
+    size_t i, img_len;
+
+    (void) store;
+
+    for (i = 0; i < count; i++)
+    {
+        img_len = (posts[i].img != NULL) ? posts[i].img_len : 0;
+
+        if (posts[i].user_len + img_len + posts[i].msg_len > BB_MAXPOSTLEN)
+        {
+            errno = EMSGSIZE;
+            return -1;
+        }
+    }
+
+    if (first != NULL)
+    {
+        *first = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Flush the null store
+ *
+ * \param store ignored [IN]
+ *
+ * \retval 0 always
+ */
+static int null_flush(
+    bb_store_t *store
+    )
+{
+    (void) store;
+
+    return 0;
+}
+
+/**
+ * \brief Get the number of posts in the null store
+ *
+ * \param store ignored [IN]
+ *
+ * \retval 0 always
+ */
+static int64_t null_count(
+    bb_store_t *store
+    )
+{
+    (void) store;
+
+    return 0;
+}
+
+/**
+ * \brief Get the identity of the null store
+ *
+ * \param store ignored [IN]
+ *
+ * \retval 0 always, there are no posts to be told apart
+ */
+static uint64_t null_id(
+    const bb_store_t *store
+    )
+{
+    (void) store;
+
+    errno = ENOENT;
+    return 0;
+}
+
+/**
+ * \brief Read a post from the null store
+ *
+ * \param store ignored [IN]
+ * \param number ignored [IN]
+ * \param record ignored [OUT]
+ *
+ * \retval -1 always, errno is set to ENOENT
+ */
+static int null_read(
+    bb_store_t *store,
+    uint64_t number,
+    bb_record_t *record
+    )
+{
+    (void) store;
+    (void) number;
+    (void) record;
+
+    errno = ENOENT;
+    return -1;
+}
+
+const bb_backend_t bb_null_backend =
+{
+    "null",
+    0,
+    null_open,
+    null_close,
+    null_append,
+    null_flush,
+    null_count,
+    null_id,
+    null_read
+};
+
+void bb_use_backend(
+    const bb_backend_t *backend
+    )
+{
+    selected_backend = backend;
+}
+
+int bb_open(
+    bb_store_t *store,
+    const char *dir,
+    int mode
+    )
+{
+    store->backend = selected_backend;
+    store->memory = NULL;
+
+    return store->backend->open(store, dir, mode);
+}
+
+void bb_close(
+    bb_store_t *store
+    )
+{
+    store->backend->close(store);
+}
+
+int bb_append(
+    bb_store_t *store,
+    const bb_post_t *posts,
+    size_t count,
+    uint64_t *first
+    )
+{
+    return store->backend->append(store, posts, count, first);
+}
+
+int bb_flush(
+    bb_store_t *store
+    )
+{
+    return store->backend->flush(store);
+}
+
+int64_t bb_count(
+    bb_store_t *store
+    )
+{
+    return store->backend->count(store);
+}
+
+uint64_t bb_id(
+    const bb_store_t *store
+    )
+{
+    return store->backend->id(store);
+}
+
+int bb_read(
+    bb_store_t *store,
+    uint64_t number,
+    bb_record_t *record
+    )
+{
+    return store->backend->read(store, number, record);
+}
+
+int bb_render(
+    const bb_post_t *post,
+    char *buf,
+    size_t len
+    )
+{
+    /*
+     * the content entry templates have placeholders for image, user
+     * (twice) and message resp. user and message.
+     */
+    const template_arg_t args_with_img[] =
+    {
+        { post->img, post->img_len },
+        { post->user, post->user_len },
+        { post->user, post->user_len },
+        { post->msg, post->msg_len }
+    };
+    const template_arg_t args_without_img[] =
+    {
+        { post->user, post->user_len },
+        { post->msg, post->msg_len }
+    };
+
+    if (post->img != NULL)
+    {
+        return (int) template_render(&content_entry_with_img_thtml, args_with_img, buf, len);
+    }
+
+    return (int) template_render(&content_entry_without_img_thtml, args_without_img, buf, len);
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,244 @@
+/* ================================================================ */
+/**
+ * @file bulletin_board.h
+ * Post store of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the binary post store which is shared by the
+ * business logic and the tools operating on the bulletin board.
+ *
+ * Each post is stored as a length-prefixed binary record in the data
+ * file. The index file holds the 64 bit offset of every record, thus
+ * post number \a n (counting from 0) is located via the index entry at
+ * offset \a n * 8 without reading any other post.
+ *
+ * The posts are kept by a storage backend. The flat files described
+ * above are the default, a memory-only ring (see memory_store.h) and a
+ * null sink discarding all posts may be selected with bb_use_backend()
+ * to measure the transport without the disk I/O of the store.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef BULLETIN_BOARD_H
+#define BULLETIN_BOARD_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "html_escape.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define BB_POSTS_FILE "bulletin_board_posts.dat"
+#define BB_INDEX_FILE "bulletin_board_posts.idx"
+
+#define BB_MAXPOSTLEN 1024 /* maximum size of user, image and message */
+/*
+ * the user appears twice, user and image URL may grow by escaping
+ */
+#define BB_MAXENTRYLEN (2 * HTML_ESCAPE_MAXEXPANSION * BB_MAXPOSTLEN + 512)
+
+#define BB_READ  0  /* open store for reading */
+#define BB_WRITE 1  /* open store for reading and appending */
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A single post. All strings are zero-terminated, \a img is NULL in case
+ * the post has no image.
+ */
+typedef struct
+{
+    uint64_t timestamp;  /* seconds since the epoch */
+    const char *user;
+    size_t user_len;
+    const char *img;
+    size_t img_len;
+    const char *msg;
+    size_t msg_len;
+} bb_post_t;
+
+/**
+ * A post read from the store, the strings point into \a buf.
+ */
+typedef struct
+{
+    bb_post_t post;
+    char buf[BB_MAXPOSTLEN + 3];
+} bb_record_t;
+
+struct bb_backend;
+
+/**
+ * An opened post store.
+ */
+typedef struct
+{
+    const struct bb_backend *backend;
+    int data_fd;
+    int index_fd;
+    void *memory;  /* mapped store of the memory backend */
+} bb_store_t;
+
+/**
+ * A storage backend. The operations have the semantics of the
+ * functions of the same name below, which dispatch to the backend
+ * of the store.
+ */
+typedef struct bb_backend
+{
+    const char *name;
+    uint64_t kept;  /* number of the newest posts kept, 0 if all of them are */
+    int (*open)(bb_store_t *store, const char *dir, int mode);
+    void (*close)(bb_store_t *store);
+    int (*append)(bb_store_t *store, const bb_post_t *posts, size_t count, uint64_t *first);
+    int (*flush)(bb_store_t *store);
+    int64_t (*count)(bb_store_t *store);
+    uint64_t (*id)(const bb_store_t *store);
+    int (*read)(bb_store_t *store, uint64_t number, bb_record_t *record);
+} bb_backend_t;
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+extern const bb_backend_t bb_file_backend;  /* data and index file, the default */
+extern const bb_backend_t bb_null_backend;  /* discards the posts */
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Select the storage backend
+ *
+ * Select the backend of the stores opened from now on.
+ *
+ * \param backend the backend, e.g. bb_file_backend [IN]
+ */
+extern void bb_use_backend(const bb_backend_t *backend);
+
+/**
+ * \brief Open the post store
+ *
+ * Open the post store located in the directory \a dir with the selected
+ * backend. In case \a mode is BB_WRITE the store is created if it does
+ * not exist.
+ *
+ * \param store the store to be initialised [OUT]
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param mode BB_READ or BB_WRITE [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+extern int bb_open(bb_store_t *store, const char *dir, int mode);
+
+/**
+ * \brief Close the post store
+ *
+ * \param store the store to be closed [IN]
+ */
+extern void bb_close(bb_store_t *store);
+
+/**
+ * \brief Append posts to the store
+ *
+ * Append the \a count posts given by \a posts to the store. The records
+ * and their index entries are written with a single write each while
+ * the index is locked exclusively.
+ *
+ * \param store the store opened with BB_WRITE [IN]
+ * \param posts the posts to be appended [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param first set to the number of the first appended post, may be NULL [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+extern int bb_append(
+    bb_store_t *store, const bb_post_t *posts, size_t count, uint64_t *first
+    );
+
+/**
+ * \brief Flush the appended posts to stable storage
+ *
+ * \param store the store opened with BB_WRITE [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+extern int bb_flush(bb_store_t *store);
+
+/**
+ * \brief Get the number of posts in the store
+ *
+ * \param store the opened store [IN]
+ *
+ * \return the number of posts
+ * \retval -1 failed, errno is set
+ */
+extern int64_t bb_count(bb_store_t *store);
+
+/**
+ * \brief Get the identity of the store
+ *
+ * The identity tells the posts of a recreated store from those of its
+ * predecessor, e.g. in data derived from the store.
+ *
+ * \param store the opened store [IN]
+ *
+ * \return identity of the store
+ * \retval 0 unknown, errno is set
+ */
+extern uint64_t bb_id(const bb_store_t *store);
+
+/**
+ * \brief Read a post from the store
+ *
+ * Read post number \a number (counting from 0) from the store.
+ *
+ * \param store the opened store [IN]
+ * \param number the number of the post [IN]
+ * \param record the record to be filled [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+extern int bb_read(bb_store_t *store, uint64_t number, bb_record_t *record);
+
+/**
+ * \brief Render a post as bulletin board content entry
+ *
+ * Render the post \a post as HTML content entry into \a buf. User name
+ * and image URL are escaped for HTML, the message is inserted as is
+ * (its tags have been checked against the whitelist on posting).
+ *
+ * \param post the post to be rendered [IN]
+ * \param buf buffer for the HTML content entry [OUT]
+ * \param len size of the buffer pointed to by \a buf [IN]
+ *
+ * \return number of bytes rendered (excl. terminating zero)
+ * \retval -1 the entry does not fit into \a buf
+ */
+extern int bb_render(const bb_post_t *post, char *buf, size_t len);
+
+#endif /* BULLETIN_BOARD_H */
+
+/*
+ * =================================================================== eof ==
+ */
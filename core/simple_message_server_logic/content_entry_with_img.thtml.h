@@ -0,0 +1,52 @@
+#include "template.h"
+
+static const unsigned char content_entry_with_img_thtml_deflated_0[] = {
+        0xb2, 0x49, 0x29, 0xb1, 0xe3, 0x52, 0x00, 0x02, 0x9b, 0xcc, 0xdc, 0x74,
+        0x85, 0xe2, 0xa2, 0x64, 0x5b, 0x25, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char content_entry_with_img_thtml_deflated_2[] = {
+        0x52, 0x52, 0x28, 0xcf, 0x4c, 0x29, 0xc9, 0xb0, 0x55, 0x32, 0x31, 0x50,
+        0x52, 0xc8, 0x48, 0xcd, 0x4c, 0xcf, 0x28, 0x81, 0xb0, 0x13, 0x73, 0x80,
+        0x0c, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char content_entry_with_img_thtml_deflated_4[] = {
+        0x52, 0x2f, 0x56, 0xf0, 0xcc, 0x4d, 0x4c, 0x4f, 0x55, 0xb2, 0xe3, 0x52,
+        0x00, 0x02, 0x9b, 0xe2, 0x92, 0xa2, 0xfc, 0xbc, 0x74, 0x3b, 0x00, 0x00,
+        0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char content_entry_with_img_thtml_deflated_6[] = {
+        0x52, 0x28, 0x4e, 0x4c, 0x2f, 0xb1, 0xb2, 0xd1, 0x2f, 0x2e, 0x29, 0xca,
+        0xcf, 0x4b, 0xb7, 0xe3, 0xb2, 0xd1, 0x4f, 0x29, 0x01, 0x92, 0x29, 0x29,
+        0x76, 0x5c, 0x0a, 0x40, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char content_entry_with_img_thtml_deflated_8[] = {
+        0xe2, 0xb2, 0xd1, 0x4f, 0x49, 0xb1, 0xe3, 0x02, 0x00, 0x00, 0x00, 0xff,
+        0xff,
+};
+
+static const template_segment_t content_entry_with_img_thtml_segments[] = {
+        { TEMPLATE_LITERAL, "<dt>\n"
+                "    <img src=\"", 19, content_entry_with_img_thtml_deflated_0, 24 },
+        { TEMPLATE_HTML, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "\" width=\"40\" height=\"40\" alt=\"", 30, content_entry_with_img_thtml_deflated_2, 31 },
+        { TEMPLATE_HTML, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "'s Image\">\n"
+                "    <strong>", 23, content_entry_with_img_thtml_deflated_4, 28 },
+        { TEMPLATE_HTML, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, " sagt:</strong>\n"
+                "</dt>\n"
+                "<dd>\n"
+                "    ", 31, content_entry_with_img_thtml_deflated_6, 34 },
+        { TEMPLATE_STRING, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "\n"
+                "</dd>\n"
+                "", 7, content_entry_with_img_thtml_deflated_8, 13 },
+};
+
+static const template_t content_entry_with_img_thtml = {
+        content_entry_with_img_thtml_segments, 9, 110, 4, 130
+};
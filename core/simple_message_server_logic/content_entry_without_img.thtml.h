@@ -0,0 +1,35 @@
+#include "template.h"
+
+static const unsigned char content_entry_without_img_thtml_deflated_0[] = {
+        0xb2, 0x49, 0x29, 0xb1, 0xe3, 0x52, 0x00, 0x02, 0x9b, 0xe2, 0x92, 0xa2,
+        0xfc, 0xbc, 0x74, 0x3b, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char content_entry_without_img_thtml_deflated_2[] = {
+        0x52, 0x28, 0x4e, 0x4c, 0x2f, 0xb1, 0xb2, 0xd1, 0x2f, 0x2e, 0x29, 0xca,
+        0xcf, 0x4b, 0xb7, 0xe3, 0xb2, 0xd1, 0x4f, 0x29, 0x01, 0x92, 0x29, 0x29,
+        0x76, 0x5c, 0x0a, 0x40, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char content_entry_without_img_thtml_deflated_4[] = {
+        0xe2, 0xb2, 0xd1, 0x4f, 0x49, 0xb1, 0xe3, 0x02, 0x00, 0x00, 0x00, 0xff,
+        0xff,
+};
+
+static const template_segment_t content_entry_without_img_thtml_segments[] = {
+        { TEMPLATE_LITERAL, "<dt>\n"
+                "    <strong>", 17, content_entry_without_img_thtml_deflated_0, 22 },
+        { TEMPLATE_HTML, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, " sagt:</strong>\n"
+                "</dt>\n"
+                "<dd>\n"
+                "    ", 31, content_entry_without_img_thtml_deflated_2, 34 },
+        { TEMPLATE_STRING, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "\n"
+                "</dd>\n"
+                "", 7, content_entry_without_img_thtml_deflated_4, 13 },
+};
+
+static const template_t content_entry_without_img_thtml = {
+        content_entry_without_img_thtml_segments, 5, 55, 2, 69
+};
@@ -0,0 +1,294 @@
+/* ================================================================ */
+/**
+ * @file dup_filter.c
+ * Shared duplicate filter of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the counting Bloom filter of the recent
+ * posts kept in a shared memory segment. The counters are updated with
+ * atomic operations only, concurrent posts may thus be counted in a
+ * filter which is cleared right afterwards - the filter then misses a
+ * copy, which is acceptable for detecting floods.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <errno.h>
+
+#include "dup_filter.h"
+#include "shared_segment.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MAXSEGMENTNAMELEN 48
+#define MINCELLS 64U
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+df_filter_t *df_map(
+    size_t memory,
+    unsigned long window
+    )
+{
+    char name[MAXSEGMENTNAMELEN];
+    df_filter_t *filter;
+    uint64_t cells = MINCELLS;
+    uint64_t slot_len;
+    int cnt;
+
+    /*
+     * the window is covered by all slots but the one of the oldest
+     * filter, which is cleared next.
+     */
+    slot_len = (window + DF_SLOTS - 2) / (DF_SLOTS - 1);
+
+    while (sizeof(df_filter_t) + 2 * cells * DF_SLOTS <= memory)
+    {
+        cells *= 2;
+    }
+
+    cnt = snprintf(
+        name,
+        sizeof(name),
+        "%s.%llu.%llu",
+        DF_SEGMENT,
+        (unsigned long long) cells,
+        (unsigned long long) slot_len
+        );
+
+    if ((cnt < 0) || ((size_t) cnt >= sizeof(name)))
+    {
+        errno = ENAMETOOLONG;
+        return NULL;
+    }
+
+    if ((filter = shared_segment_map(name, sizeof(df_filter_t) + cells * DF_SLOTS)) == NULL)
+    {
+        return NULL;
+    }
+
+    /*
+     * every instance mapping the segment stores the same values
+     */
+    __atomic_store_n(&filter->cells, cells, __ATOMIC_RELAXED);
+    __atomic_store_n(&filter->slot_len, slot_len, __ATOMIC_RELAXED);
+
+    return filter;
+}
+
+uint64_t df_hash(
+    const char *user,
+    size_t user_len,
+    const char *msg,
+    size_t msg_len
+    )
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t i;
+
+    for (i = 0; i < user_len; i++)
+    {
+        hash ^= (unsigned char) user[i];
+        hash *= FNV_PRIME;
+    }
+
+    /*
+     * user and message are separated by a null character, which
+     * neither of them contains.
+     */
+    hash *= FNV_PRIME;
+
+    for (i = 0; i < msg_len; i++)
+    {
+        hash ^= (unsigned char) msg[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Get a counter of a post
+ *
+ * The counters of a post are chosen by double hashing, the second
+ * hash is derived from the first by a finalizer of MurmurHash3.
+ *
+ * \param filter the mapped filter [IN]
+ * \param slot number of the filter [IN]
+ * \param hash the hash of the post [IN]
+ * \param i number of the counter of the post [IN]
+ *
+ * \return pointer to the counter
+ */
+static uint8_t *get_counter(
+    df_filter_t *filter,
+    unsigned int slot,
+    uint64_t hash,
+    unsigned int i
+    )
+{
+    uint64_t step = hash;
+
+    step ^= step >> 33;
+    step *= 0xff51afd7ed558ccdULL;
+    step ^= step >> 33;
+    step |= 1U;  /* odd, thus all counters are distinct */
+
+    return &filter->counters[slot * filter->cells + ((hash + i * step) & (filter->cells - 1))];
+}
+
+/**
+ * \brief Clear a filter for reuse
+ *
+ * \param filter the mapped filter [IN]
+ * \param slot number of the filter [IN]
+ */
+static void clear_filter(
+    df_filter_t *filter,
+    unsigned int slot
+    )
+{
+    uint64_t i;
+
+    for (i = 0; i < filter->cells; i++)
+    {
+        __atomic_store_n(&filter->counters[slot * filter->cells + i], 0, __ATOMIC_RELAXED);
+    }
+}
+
+int df_admit(
+    df_filter_t *filter,
+    uint64_t hash,
+    uint64_t now,
+    unsigned long limit
+    )
+{
+    const uint64_t epoch = now / filter->slot_len + 1;  /* 0 marks an unused filter */
+    const unsigned int current = (unsigned int) (epoch % DF_SLOTS);
+    uint64_t held, copies = 0;
+    unsigned int slot, i;
+    uint8_t count, min;
+    uint8_t *counter;
+
+    /*
+     * the first instance entering a new slot of time takes over the
+     * oldest filter.
+     */
+    held = __atomic_load_n(&filter->epochs[current], __ATOMIC_ACQUIRE);
+
+    if (
+        (held < epoch) &&
+        __atomic_compare_exchange_n(
+            &filter->epochs[current], &held, epoch, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+            )
+        )
+    {
+        clear_filter(filter, current);
+    }
+
+    for (slot = 0; slot < DF_SLOTS; slot++)
+    {
+        held = __atomic_load_n(&filter->epochs[slot], __ATOMIC_ACQUIRE);
+
+        if ((held == 0) || (held > epoch) || (epoch - held >= DF_SLOTS))
+        {
+            continue;  /* unused or outside the window */
+        }
+
+        min = DF_MAXCOUNT;
+
+        for (i = 0; i < DF_HASHES; i++)
+        {
+            count = __atomic_load_n(get_counter(filter, slot, hash, i), __ATOMIC_RELAXED);
+
+            if (count < min)
+            {
+                min = count;
+            }
+        }
+
+        copies += min;
+    }
+
+    if (copies >= limit)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < DF_HASHES; i++)
+    {
+        counter = get_counter(filter, current, hash, i);
+        count = __atomic_load_n(counter, __ATOMIC_RELAXED);
+
+        while (
+            (count < DF_MAXCOUNT) &&
+            !__atomic_compare_exchange_n(
+                counter, &count, count + 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+                )
+            )
+        {
+            ;  /* count has been reloaded by the failed exchange */
+        }
+    }
+
+    return 1;
+}
+
+void df_withdraw(
+    df_filter_t *filter,
+    uint64_t hash,
+    uint64_t now
+    )
+{
+    const uint64_t epoch = now / filter->slot_len + 1;
+    const unsigned int slot = (unsigned int) (epoch % DF_SLOTS);
+    unsigned int i;
+    uint8_t count;
+    uint8_t *counter;
+
+    if (__atomic_load_n(&filter->epochs[slot], __ATOMIC_ACQUIRE) != epoch)
+    {
+        return;  /* cleared for a later slot of time */
+    }
+
+    for (i = 0; i < DF_HASHES; i++)
+    {
+        counter = get_counter(filter, slot, hash, i);
+        count = __atomic_load_n(counter, __ATOMIC_RELAXED);
+
+        /*
+         * a saturated counter may count more posts than it shows
+         */
+        while (
+            (count > 0) &&
+            (count < DF_MAXCOUNT) &&
+            !__atomic_compare_exchange_n(
+                counter, &count, count - 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+                )
+            )
+        {
+            ;  /* count has been reloaded by the failed exchange */
+        }
+    }
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,146 @@
+/* ================================================================ */
+/**
+ * @file dup_filter.h
+ * Shared duplicate filter of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the counting Bloom filter of the posts of the
+ * last seconds which is kept in a shared memory segment (see
+ * shared_segment_map()), thus every instance of the business logic
+ * recognizes a message which has been posted by the same user before
+ * without looking at the post store.
+ *
+ * The time is divided into slots of a (DF_SLOTS - 1)th of the window,
+ * each of the last DF_SLOTS slots has a filter of its own. A post is
+ * counted in the filter of the current slot, the copies of a post are
+ * estimated as the sum of the smallest of its DF_HASHES counters of
+ * every filter. The filter of the oldest slot is cleared and reused for
+ * the next one, thus the memory taken does not depend on the number of
+ * posts. The estimate never falls short of the actual number of copies
+ * (unless a counter is saturated), it may exceed it for a post which
+ * shares all counters with others.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef DUP_FILTER_H
+#define DUP_FILTER_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define DF_SEGMENT "dup_filter"  /* prefix of the name of the shared memory segment */
+#define DF_SLOTS 8U              /* filters, the window spans all but one */
+#define DF_HASHES 4U             /* counters of a post in every filter */
+#define DF_MAXCOUNT 255U         /* counters saturate */
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * The filter as mapped from the shared memory segment.
+ */
+typedef struct
+{
+    uint64_t epochs[DF_SLOTS];   /* slot of time held by each filter, 0 if none */
+    uint64_t cells;              /* counters of each filter, a power of 2 */
+    uint64_t slot_len;           /* length of a slot of time in seconds */
+    uint8_t counters[];          /* DF_SLOTS filters of \a cells counters */
+} df_filter_t;
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Map the filter
+ *
+ * Map the filter shared by all instances of the business logic using
+ * at most \a memory bytes, it is created empty if it does not exist
+ * yet. Instances given another amount of memory or another window
+ * share a filter of their own.
+ *
+ * \param memory maximum size of the filter in bytes, at least 1 KiB [IN]
+ * \param window the time in seconds the copies of a post are counted
+ *        at least, greater than 0 [IN]
+ *
+ * \return address of the mapped filter
+ * \retval NULL failed, errno is set
+ */
+extern df_filter_t *df_map(size_t memory, unsigned long window);
+
+/**
+ * \brief Hash a post
+ *
+ * \param user the name of the posting user [IN]
+ * \param user_len length of \a user [IN]
+ * \param msg the message [IN]
+ * \param msg_len length of \a msg [IN]
+ *
+ * \return the hash of user and message
+ */
+extern uint64_t df_hash(
+    const char *user, size_t user_len, const char *msg, size_t msg_len
+    );
+
+/**
+ * \brief Admit a post
+ *
+ * Estimate the copies of the post with the hash \a hash which have been
+ * admitted within the window of the filter. The post is counted and
+ * admitted if there are less than \a limit of them.
+ *
+ * \param filter the mapped filter [IN]
+ * \param hash the hash of the post, see df_hash() [IN]
+ * \param now the current time in seconds [IN]
+ * \param limit number of copies admitted within the window, at most
+ *        DF_MAXCOUNT - 1 [IN]
+ *
+ * \retval 1 the post has been admitted
+ * \retval 0 the post is a duplicate
+ */
+extern int df_admit(
+    df_filter_t *filter,
+    uint64_t hash,
+    uint64_t now,
+    unsigned long limit
+    );
+
+/**
+ * \brief Withdraw an admitted post
+ *
+ * Uncount the post with the hash \a hash admitted by df_admit() at the
+ * time \a now, e.g. because it could not be stored, thus it is not
+ * taken for a duplicate if it is posted again. Nothing is uncounted if
+ * the filter of that slot of time has been reused meanwhile, saturated
+ * counters are left as they are.
+ *
+ * \param filter the mapped filter [IN]
+ * \param hash the hash of the post, see df_hash() [IN]
+ * \param now the time in seconds passed to df_admit() [IN]
+ */
+extern void df_withdraw(
+    df_filter_t *filter,
+    uint64_t hash,
+    uint64_t now
+    );
+
+#endif /* DUP_FILTER_H */
+
+/*
+ * =================================================================== eof ==
+ */
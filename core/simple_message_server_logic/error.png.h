@@ -0,0 +1,118 @@
+static const unsigned char error_png[] = {
+0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 
+0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x40, 
+0x08, 0x06, 0x00, 0x00, 0x00, 0xaa, 0x69, 0x71, 0xde, 0x00, 0x00, 0x00, 
+0x04, 0x73, 0x42, 0x49, 0x54, 0x08, 0x08, 0x08, 0x08, 0x7c, 0x08, 0x64, 
+0x88, 0x00, 0x00, 0x00, 0x09, 0x70, 0x48, 0x59, 0x73, 0x00, 0x00, 0x06, 
+0xec, 0x00, 0x00, 0x06, 0xec, 0x01, 0x1e, 0x75, 0x38, 0x35, 0x00, 0x00, 
+0x00, 0x19, 0x74, 0x45, 0x58, 0x74, 0x53, 0x6f, 0x66, 0x74, 0x77, 0x61, 
+0x72, 0x65, 0x00, 0x77, 0x77, 0x77, 0x2e, 0x69, 0x6e, 0x6b, 0x73, 0x63, 
+0x61, 0x70, 0x65, 0x2e, 0x6f, 0x72, 0x67, 0x9b, 0xee, 0x3c, 0x1a, 0x00, 
+0x00, 0x04, 0xeb, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0x9b, 0xeb, 
+0x8b, 0x14, 0x47, 0x10, 0xc0, 0xab, 0xee, 0x21, 0x3e, 0xf2, 0x97, 0x04, 
+0x41, 0x90, 0xf8, 0xc0, 0x4b, 0x24, 0xea, 0x85, 0x20, 0x81, 0xa0, 0xa8, 
+0xa0, 0xa0, 0xc4, 0x9c, 0x77, 0xbb, 0x7b, 0x17, 0xf0, 0x83, 0x82, 0xf8, 
+0x4d, 0xf2, 0x55, 0x30, 0x60, 0x1e, 0xba, 0xf7, 0x52, 0x41, 0x41, 0xf1, 
+0x81, 0xe1, 0xc4, 0x84, 0x90, 0x93, 0x84, 0xcb, 0x1e, 0x48, 0x08, 0x81, 
+0x03, 0xf1, 0x2f, 0x91, 0x28, 0x7a, 0x5a, 0xd6, 0x42, 0x41, 0x8d, 0xed, 
+0xd5, 0xce, 0x76, 0xd7, 0xee, 0xce, 0x1e, 0xd9, 0x86, 0xa6, 0x77, 0x66, 
+0x6f, 0xf7, 0xe6, 0xf7, 0x9b, 0x9a, 0xa9, 0x9e, 0xee, 0x5e, 0x24, 0x22, 
+0xf8, 0x3f, 0x97, 0x9e, 0x80, 0x9e, 0x80, 0x9e, 0x80, 0x9e, 0x80, 0x9e, 
+0x80, 0x98, 0xf2, 0x2d, 0xe2, 0x07, 0x6b, 0x01, 0x7e, 0x26, 0x80, 0xbb, 
+0x67, 0x89, 0xaa, 0xdd, 0x00, 0x71, 0x1e, 0xb1, 0xc2, 0xcd, 0xc1, 0xe7, 
+0x00, 0xfb, 0xce, 0x11, 0x3d, 0x73, 0x08, 0xc8, 0x87, 0xdf, 0x00, 0xf0, 
+0x2b, 0x01, 0x7c, 0xcc, 0x9b, 0xc4, 0xed, 0xc4, 0x99, 0x82, 0x25, 0x5c, 
+0x60, 0x78, 0x02, 0xb8, 0x54, 0x67, 0xe1, 0x5a, 0x5b, 0x0f, 0xb0, 0x77, 
+0xc2, 0x90, 0xe0, 0x12, 0x70, 0x89, 0xe1, 0xff, 0x63, 0x78, 0xa8, 0xc3, 
+0x6b, 0x21, 0x64, 0x09, 0xa7, 0x59, 0x42, 0x51, 0xf0, 0x00, 0x02, 0xaf, 
+0xa5, 0xb6, 0x4e, 0x25, 0x78, 0x05, 0x28, 0xfc, 0x0b, 0x85, 0x0f, 0x0b, 
+0x71, 0x1d, 0x3f, 0x45, 0x34, 0xd9, 0x49, 0xf8, 0xef, 0x10, 0xcb, 0x4c, 
+0x7d, 0x59, 0xe1, 0xb5, 0x20, 0x4b, 0x58, 0x23, 0x12, 0x1c, 0x02, 0x14, 
+0xfe, 0xa5, 0x86, 0xbd, 0x55, 0x88, 0x3a, 0x28, 0xe1, 0x22, 0xc3, 0x93, 
+0xc2, 0x1b, 0x45, 0x25, 0x24, 0x08, 0x50, 0xf8, 0x57, 0x7a, 0xe6, 0xed, 
+0xa2, 0x97, 0x43, 0xe5, 0x24, 0xd1, 0x54, 0x3b, 0xe1, 0xbf, 0x47, 0x2c, 
+0x11, 0x40, 0x35, 0x0b, 0x8f, 0x0d, 0x24, 0x0c, 0xa8, 0x04, 0x53, 0x80, 
+0x09, 0xbf, 0x6c, 0xc2, 0xdb, 0x12, 0x40, 0x24, 0xb4, 0x0b, 0x1e, 0x15, 
+0xbe, 0xd9, 0x52, 0xeb, 0x17, 0x09, 0x51, 0x02, 0x7e, 0x40, 0x9c, 0xe7, 
+0x66, 0x8f, 0x61, 0x39, 0x37, 0x12, 0xbe, 0x69, 0xb1, 0x84, 0x9f, 0x18, 
+0x9e, 0x2c, 0xf8, 0xfc, 0x63, 0x7c, 0xc4, 0xc7, 0x33, 0x1c, 0x25, 0xe0, 
+0x47, 0xc4, 0x0a, 0x86, 0x77, 0xd8, 0x38, 0x09, 0x65, 0xb6, 0x3e, 0xed, 
+0xa2, 0xd6, 0x68, 0x1c, 0xe3, 0x66, 0xd2, 0x71, 0x2c, 0x13, 0xe3, 0x44, 
+0xd5, 0xe8, 0x7b, 0xc0, 0xe5, 0x4c, 0x8e, 0x35, 0x4d, 0xdb, 0x85, 0x48, 
+0x24, 0x78, 0xe1, 0x31, 0x12, 0x1e, 0x03, 0xf8, 0x32, 0xc3, 0x27, 0x67, 
+0x81, 0x49, 0x43, 0x02, 0x34, 0x2f, 0xa1, 0xc4, 0xf6, 0x67, 0x52, 0xe0, 
+0xa7, 0x10, 0x47, 0x89, 0x9b, 0xd4, 0xff, 0x0d, 0x02, 0xef, 0xee, 0x07, 
+0x54, 0x8d, 0x9c, 0x8b, 0xcd, 0x1f, 0x48, 0xa9, 0xc4, 0x12, 0x62, 0xe1, 
+0xc1, 0x07, 0x3f, 0x5e, 0xd2, 0xb4, 0xec, 0xef, 0x09, 0x4e, 0x89, 0x84, 
+0xe4, 0x48, 0x88, 0x90, 0x30, 0xeb, 0x3c, 0xf3, 0xc8, 0xf0, 0x27, 0x0c, 
+0x78, 0xd7, 0xb3, 0xc0, 0x0c, 0x62, 0x89, 0x9b, 0x6a, 0x6a, 0x24, 0x20, 
+0xc0, 0xd8, 0x08, 0xd1, 0x2c, 0x34, 0x28, 0x57, 0x10, 0x4f, 0x10, 0xc0, 
+0xb4, 0x43, 0x74, 0x65, 0xd4, 0xce, 0x40, 0xfe, 0xa7, 0xc1, 0xab, 0x92, 
+0x8e, 0x92, 0x43, 0x53, 0x24, 0x58, 0xf0, 0x90, 0x81, 0xc7, 0xf8, 0xef, 
+0xae, 0x7c, 0x2d, 0xf0, 0x4e, 0x01, 0xf9, 0x12, 0xc0, 0x90, 0x80, 0xcd, 
+0x1d, 0xe8, 0xe8, 0x71, 0xa2, 0x2b, 0xd9, 0x9d, 0xd7, 0x10, 0x47, 0xb8, 
+0x99, 0x71, 0x84, 0x7d, 0xe5, 0x2b, 0x81, 0x6f, 0xa7, 0x00, 0x3d, 0x60, 
+0x49, 0x4f, 0xe9, 0xa1, 0x2a, 0x12, 0x04, 0x1e, 0x1b, 0xc0, 0x63, 0x3e, 
+0x7c, 0xf9, 0x18, 0xd1, 0x74, 0xc7, 0x47, 0x84, 0xae, 0xb3, 0x04, 0x62, 
+0x09, 0xe8, 0x90, 0x20, 0x80, 0xc9, 0x67, 0x1e, 0x04, 0xbe, 0xb0, 0x21, 
+0xb1, 0x1b, 0xce, 0x74, 0x15, 0x73, 0x1f, 0xc5, 0x15, 0x32, 0xcb, 0x51, 
+0xc9, 0x2c, 0x5e, 0x01, 0x6e, 0x09, 0x28, 0x12, 0x10, 0x3a, 0x52, 0x08, 
+0x19, 0xfe, 0x88, 0xc2, 0x17, 0x3f, 0x28, 0x7a, 0xd3, 0x11, 0x09, 0xd1, 
+0x51, 0x23, 0xf0, 0x5d, 0x37, 0x2a, 0x7c, 0x2b, 0x93, 0xc6, 0xb0, 0x4d, 
+0xf0, 0x04, 0x30, 0x76, 0x98, 0xd3, 0x68, 0xd7, 0x0e, 0x8b, 0xdf, 0x71, 
+0x75, 0x64, 0xf2, 0x3b, 0x52, 0x87, 0x18, 0xbe, 0xeb, 0xe7, 0x05, 0x6e, 
+0x67, 0xd2, 0x1a, 0xb6, 0x0e, 0x7e, 0xf4, 0x00, 0xa7, 0xcd, 0x55, 0x33, 
+0x31, 0x72, 0x2f, 0xe8, 0xd8, 0x78, 0xe0, 0xc1, 0x01, 0xef, 0x14, 0xe0, 
+0x97, 0x90, 0xcd, 0xf1, 0x98, 0x08, 0xbf, 0x5f, 0xe0, 0x57, 0x9d, 0x80, 
+0xfb, 0x81, 0x80, 0x84, 0x42, 0xb4, 0x5a, 0x05, 0xcc, 0x31, 0x3c, 0x19, 
+0xf0, 0x98, 0x10, 0x05, 0x5f, 0xae, 0xa6, 0x4b, 0x60, 0xce, 0x71, 0xe6, 
+0xcd, 0x48, 0x10, 0x09, 0x5d, 0x2f, 0xe0, 0x01, 0xa7, 0x41, 0xb4, 0xd2, 
+0xa0, 0x3f, 0x12, 0xc6, 0xbe, 0xe8, 0xe6, 0x34, 0xf8, 0x30, 0x1f, 0xde, 
+0x1f, 0x09, 0x22, 0xa1, 0xeb, 0x04, 0xfc, 0x22, 0xcf, 0x03, 0x29, 0xf0, 
+0x98, 0xf0, 0x1c, 0xf0, 0x79, 0x37, 0x75, 0x85, 0x7f, 0xf3, 0x3e, 0x07, 
+0xa4, 0xa4, 0x47, 0x91, 0x50, 0xb8, 0x80, 0xdf, 0x9d, 0x03, 0x98, 0x61, 
+0x10, 0x60, 0xa4, 0x84, 0xcf, 0x8a, 0x7c, 0x1c, 0x9e, 0x77, 0x0e, 0x88, 
+0x80, 0x0c, 0x88, 0x80, 0x73, 0x40, 0x64, 0xb8, 0x88, 0x01, 0x91, 0xf9, 
+0x16, 0x0c, 0x89, 0x0d, 0x4b, 0x5a, 0x9b, 0x97, 0xb4, 0xe9, 0x88, 0x84, 
+0xf2, 0xee, 0x4e, 0x0e, 0x89, 0xfd, 0x61, 0x8c, 0x0c, 0x63, 0xc4, 0x99, 
+0xdf, 0xc5, 0xf0, 0xc1, 0x77, 0x8e, 0x38, 0x23, 0xa1, 0xb2, 0xcb, 0x31, 
+0x28, 0x1a, 0x05, 0x8f, 0xce, 0x61, 0xf1, 0x4f, 0x8d, 0x34, 0xf6, 0x67, 
+0x30, 0x2c, 0x9e, 0x32, 0x2b, 0xbd, 0xb3, 0x9d, 0xc3, 0xe2, 0x0b, 0x4d, 
+0xce, 0x09, 0x60, 0x03, 0xf8, 0x9d, 0x39, 0x39, 0x7c, 0x41, 0x24, 0x38, 
+0x04, 0x1b, 0x12, 0x9c, 0x02, 0x16, 0x9c, 0x53, 0x63, 0x5c, 0x4b, 0x9f, 
+0x34, 0x79, 0xc7, 0xfe, 0xcb, 0x48, 0xab, 0x18, 0x31, 0x35, 0x36, 0xd4, 
+0xca, 0xa9, 0xb1, 0x45, 0x86, 0xa7, 0x44, 0x78, 0x14, 0xf8, 0xa1, 0xc8, 
+0x74, 0xb5, 0xe8, 0x1d, 0x6d, 0x16, 0x09, 0x6e, 0x01, 0x8b, 0xce, 0x85, 
+0x12, 0x14, 0xc0, 0xc7, 0x4a, 0x40, 0x5f, 0x24, 0x4c, 0x6c, 0xf7, 0x4c, 
+0x8f, 0x3f, 0xf6, 0xaf, 0x0d, 0x28, 0xef, 0x70, 0x2e, 0x90, 0x78, 0xec, 
+0x5c, 0x1d, 0x02, 0x22, 0x21, 0x5a, 0xc0, 0xdf, 0x2d, 0x80, 0xdf, 0xee, 
+0x83, 0x57, 0x09, 0x46, 0x9f, 0x03, 0x23, 0x24, 0x6c, 0x65, 0x09, 0x71, 
+0x02, 0x64, 0x91, 0x54, 0x22, 0x7c, 0x65, 0x5b, 0x8b, 0x17, 0x49, 0xfd, 
+0xe3, 0x9b, 0x95, 0x7e, 0xb4, 0x25, 0x76, 0x91, 0xd4, 0xd3, 0x60, 0x69, 
+0x6c, 0x4c, 0x1a, 0xfa, 0xc8, 0x80, 0x77, 0x4b, 0x88, 0x9e, 0x95, 0xd6, 
+0xa5, 0xb3, 0x1f, 0xc6, 0x2d, 0x93, 0x53, 0x09, 0xcf, 0x23, 0x17, 0x4a, 
+0x6e, 0x6e, 0xf3, 0x42, 0xc9, 0x7f, 0x0d, 0x09, 0x16, 0xfc, 0x5a, 0x81, 
+0x4f, 0xce, 0x02, 0x4f, 0x23, 0x96, 0xca, 0x6e, 0x0e, 0xd2, 0x4e, 0x1b, 
+0x25, 0xd8, 0xeb, 0x84, 0x83, 0xa5, 0xb2, 0x0a, 0x9f, 0x26, 0x40, 0x25, 
+0x48, 0x24, 0x58, 0x1d, 0x8f, 0x4d, 0x1d, 0x5e, 0x2c, 0xbd, 0xc4, 0x12, 
+0xc0, 0xee, 0x9b, 0xd4, 0x06, 0x03, 0x78, 0x87, 0x00, 0x95, 0xb0, 0x1c, 
+0x4a, 0x90, 0xdf, 0x0c, 0x6c, 0x2a, 0x68, 0xb9, 0xfc, 0xd2, 0xca, 0x7d, 
+0x94, 0xda, 0x40, 0x08, 0xef, 0x17, 0xa0, 0x12, 0xde, 0xe8, 0xe5, 0x40, 
+0xc8, 0xf0, 0x1b, 0x05, 0xbe, 0xa8, 0xf2, 0xe4, 0xdd, 0xdf, 0x0c, 0xd4, 
+0xfa, 0x2c, 0x78, 0xbf, 0x00, 0x95, 0x40, 0xf2, 0x93, 0x99, 0x00, 0xbe, 
+0x50, 0x09, 0x4c, 0x7f, 0x90, 0xeb, 0xbe, 0x3a, 0x7c, 0xef, 0x47, 0x53, 
+0x45, 0x0b, 0x40, 0x2e, 0x99, 0xeb, 0x52, 0x5e, 0xeb, 0xb6, 0x91, 0xbe, 
+0x29, 0x7c, 0x2d, 0x2d, 0x65, 0xb7, 0xeb, 0xa5, 0xbd, 0x02, 0x14, 0xa2, 
+0x8f, 0x9b, 0x7e, 0xae, 0xda, 0x6a, 0xd5, 0x6d, 0xbb, 0x62, 0xa6, 0xc5, 
+0x1c, 0x11, 0x36, 0xb8, 0xd6, 0x37, 0xda, 0x36, 0xac, 0xaf, 0x8d, 0xed, 
+0xd7, 0xcc, 0xca, 0xed, 0xfb, 0x02, 0x14, 0xf6, 0xdd, 0x1a, 0xee, 0x1b, 
+0x30, 0xf6, 0x9b, 0x9f, 0x0b, 0x5f, 0x87, 0x55, 0x45, 0x08, 0xb8, 0x09, 
+0xc4, 0xd5, 0x7e, 0xad, 0xf5, 0xfd, 0xf7, 0x97, 0x57, 0xde, 0xaf, 0xef, 
+0xd5, 0x05, 0x64, 0xc3, 0xb6, 0x2f, 0x00, 0x1e, 0x34, 0xe1, 0xec, 0x7d, 
+0x46, 0xe4, 0x68, 0x0d, 0xa3, 0x21, 0x3c, 0xeb, 0xb6, 0x08, 0x6d, 0x0d, 
+0x30, 0x6b, 0xdf, 0x2b, 0xa9, 0xb2, 0xad, 0xd1, 0x90, 0x7b, 0x0f, 0xa8, 
+0x7b, 0x31, 0xc2, 0x38, 0x08, 0x73, 0x0b, 0x54, 0x2f, 0x1b, 0xe3, 0x73, 
+0x18, 0x86, 0xb7, 0x25, 0xc1, 0xfe, 0x3b, 0x6d, 0xc3, 0x4a, 0x39, 0x80, 
+0x6f, 0x01, 0x52, 0xb0, 0x7d, 0xb2, 0x34, 0x24, 0x42, 0x91, 0x00, 0x00, 
+0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82, 
+};
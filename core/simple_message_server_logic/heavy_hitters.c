@@ -0,0 +1,377 @@
+/* ================================================================ */
+/**
+ * @file heavy_hitters.c
+ * Shared statistics of the heaviest users of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the count-min sketches and their top lists
+ * kept in a shared memory segment. The counters are updated with atomic
+ * additions only. The top list of a sketch is guarded by a spin lock
+ * holding the process id of its owner, thus the lock of an instance
+ * which died while holding it is taken over by the next one.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "heavy_hitters.h"
+#include "shared_segment.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define LOCK_ATTEMPTS_COUNT 64    /* attempts to lock a top list when counting */
+#define LOCK_ATTEMPTS_TOP 4096    /* attempts to lock a top list when reading it */
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+hh_table_t *hh_map(
+    void
+    )
+{
+    return shared_segment_map(HH_SEGMENT, sizeof(hh_table_t));
+}
+
+/**
+ * \brief Hash a key
+ *
+ * \param key the key [IN]
+ * \param key_len length of \a key [IN]
+ *
+ * \return the FNV-1a hash of the key
+ */
+static uint64_t hash_key(
+    const char *key,
+    size_t key_len
+    )
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t i;
+
+    for (i = 0; i < key_len; i++)
+    {
+        hash ^= (unsigned char) key[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Swap two keys of a top list
+ *
+ * \param sketch the mapped sketch [IN]
+ * \param i index of the first key [IN]
+ * \param j index of the second key [IN]
+ */
+static void swap_entries(
+    hh_sketch_t *sketch,
+    uint32_t i,
+    uint32_t j
+    )
+{
+    hh_entry_t entry = sketch->top[i];
+
+    sketch->top[i] = sketch->top[j];
+    sketch->top[j] = entry;
+}
+
+/**
+ * \brief Move a key of a top list towards the leaves of the heap
+ *
+ * \param sketch the mapped sketch [IN]
+ * \param i index of the key whose count has been raised [IN]
+ */
+static void sift_down(
+    hh_sketch_t *sketch,
+    uint32_t i
+    )
+{
+    uint32_t child;
+
+    while ((child = 2 * i + 1) < sketch->top_len)
+    {
+        if (
+            (child + 1 < sketch->top_len) &&
+            (sketch->top[child + 1].count < sketch->top[child].count)
+            )
+        {
+            child++;
+        }
+
+        if (sketch->top[i].count <= sketch->top[child].count)
+        {
+            break;
+        }
+
+        swap_entries(sketch, i, child);
+        i = child;
+    }
+}
+
+/**
+ * \brief Move a key of a top list towards the root of the heap
+ *
+ * \param sketch the mapped sketch [IN]
+ * \param i index of the key which has been added [IN]
+ */
+static void sift_up(
+    hh_sketch_t *sketch,
+    uint32_t i
+    )
+{
+    while ((i > 0) && (sketch->top[i].count < sketch->top[(i - 1) / 2].count))
+    {
+        swap_entries(sketch, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+/**
+ * \brief Lock the top list of a sketch
+ *
+ * Spin on the lock, yielding the processor between the attempts. A
+ * lock held by a process which no longer exists is taken over, the
+ * heap it may have left half updated is restored.
+ *
+ * \param sketch the mapped sketch [IN]
+ * \param attempts maximum number of attempts [IN]
+ *
+ * \retval 0 success
+ * \retval -1 the lock is held by another process
+ */
+static int lock_top(
+    hh_sketch_t *sketch,
+    unsigned int attempts
+    )
+{
+    const pid_t self = getpid();
+    pid_t holder;
+    uint32_t i;
+
+    while (attempts-- > 0)
+    {
+        holder = 0;
+
+        if (
+            __atomic_compare_exchange_n(
+                &sketch->lock, &holder, self, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED
+                )
+            )
+        {
+            return 0;
+        }
+
+        if (
+            (kill(holder, 0) == -1) &&
+            (errno == ESRCH) &&
+            __atomic_compare_exchange_n(
+                &sketch->lock, &holder, self, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED
+                )
+            )
+        {
+            if (sketch->top_len > HH_TOPK)
+            {
+                sketch->top_len = HH_TOPK;
+            }
+
+            for (i = sketch->top_len / 2; i-- > 0; )
+            {
+                sift_down(sketch, i);
+            }
+
+            return 0;
+        }
+
+        (void) sched_yield();
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Unlock the top list of a sketch
+ *
+ * \param sketch the mapped sketch [IN]
+ */
+static void unlock_top(
+    hh_sketch_t *sketch
+    )
+{
+    __atomic_store_n(&sketch->lock, 0, __ATOMIC_RELEASE);
+}
+
+void hh_count(
+    hh_sketch_t *sketch,
+    const char *key,
+    size_t key_len
+    )
+{
+    const uint64_t hash = hash_key(key, key_len);
+    uint64_t step = hash;
+    uint64_t estimate = UINT64_MAX;
+    uint32_t count, i;
+
+    /*
+     * the counters of the rows are chosen by double hashing like the
+     * ones of the duplicate filter.
+     */
+    step ^= step >> 33;
+    step *= 0xff51afd7ed558ccdULL;
+    step ^= step >> 33;
+
+    for (i = 0; i < HH_DEPTH; i++)
+    {
+        count = __atomic_add_fetch(
+            &sketch->counters[i][(hash + i * step) & (HH_WIDTH - 1)], 1, __ATOMIC_RELAXED
+            );
+
+        if (count < estimate)
+        {
+            estimate = count;
+        }
+    }
+
+    __atomic_add_fetch(&sketch->total, 1, __ATOMIC_RELAXED);
+
+    /*
+     * a key on a full list has been counted at least as often as the
+     * root of the heap, thus a key not exceeding the root neither is on
+     * the list nor gets on it. the root is read without the lock, a
+     * stale value only costs a needless locking.
+     */
+    if (
+        (__atomic_load_n(&sketch->top_len, __ATOMIC_RELAXED) == HH_TOPK) &&
+        (estimate <= __atomic_load_n(&sketch->top[0].count, __ATOMIC_RELAXED))
+        )
+    {
+        return;
+    }
+
+    if (lock_top(sketch, LOCK_ATTEMPTS_COUNT) == -1)
+    {
+        return;
+    }
+
+    for (i = 0; i < sketch->top_len; i++)
+    {
+        if (sketch->top[i].hash == hash)
+        {
+            if (estimate > sketch->top[i].count)
+            {
+                sketch->top[i].count = estimate;
+                sift_down(sketch, i);
+            }
+
+            unlock_top(sketch);
+            return;
+        }
+    }
+
+    if (sketch->top_len < HH_TOPK)
+    {
+        i = sketch->top_len++;
+    }
+    else if (estimate > sketch->top[0].count)
+    {
+        i = 0;
+    }
+    else
+    {
+        unlock_top(sketch);
+        return;
+    }
+
+    sketch->top[i].hash = hash;
+    sketch->top[i].count = estimate;
+    sketch->top[i].label_len = (uint32_t) ((key_len < HH_MAXLABELLEN) ? key_len : HH_MAXLABELLEN);
+    memcpy(sketch->top[i].label, key, sketch->top[i].label_len);
+
+    if (i == 0)
+    {
+        sift_down(sketch, i);
+    }
+    else
+    {
+        sift_up(sketch, i);
+    }
+
+    unlock_top(sketch);
+}
+
+/**
+ * \brief Compare two keys of a top list by their counts, descending
+ *
+ * \param a first key [IN]
+ * \param b second key [IN]
+ *
+ * \return <0, 0, >0 like strcmp()
+ */
+static int compare_entries(
+    const void *a,
+    const void *b
+    )
+{
+    const hh_entry_t *ea = a;
+    const hh_entry_t *eb = b;
+
+    return (ea->count < eb->count) - (ea->count > eb->count);
+}
+
+size_t hh_top(
+    hh_sketch_t *sketch,
+    hh_entry_t top[HH_TOPK]
+    )
+{
+    size_t len;
+
+    /*
+     * a list which cannot be locked is copied anyway, a single key may
+     * then be garbled.
+     */
+    if (lock_top(sketch, LOCK_ATTEMPTS_TOP) == 0)
+    {
+        len = sketch->top_len;
+        memcpy(top, sketch->top, sizeof(hh_entry_t) * HH_TOPK);
+        unlock_top(sketch);
+    }
+    else
+    {
+        len = __atomic_load_n(&sketch->top_len, __ATOMIC_RELAXED);
+        memcpy(top, sketch->top, sizeof(hh_entry_t) * HH_TOPK);
+    }
+
+    if (len > HH_TOPK)
+    {
+        len = HH_TOPK;
+    }
+
+    qsort(top, len, sizeof(hh_entry_t), compare_entries);
+
+    return len;
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,133 @@
+/* ================================================================ */
+/**
+ * @file heavy_hitters.h
+ * Shared statistics of the heaviest users of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the sketches of the requests per posting user,
+ * per client address and per message which are kept in a shared memory
+ * segment (see shared_segment_map()), thus the sources of the load are
+ * known without parsing any logs.
+ *
+ * Each sketch is a count-min sketch of HH_DEPTH rows of HH_WIDTH
+ * counters: a key is counted in one counter of every row, its count is
+ * estimated as the smallest of them. The estimate never falls short of
+ * the actual count, it exceeds it by at most a HH_WIDTH-th of the total
+ * count of the sketch in most cases. The HH_TOPK keys of the highest
+ * estimates are kept in a min-heap next to the counters. The memory
+ * taken does not depend on the number of keys or requests.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define HH_SEGMENT "heavy_hitters"  /* name of the shared memory segment */
+#define HH_DEPTH 4U                 /* rows of counters of every sketch */
+#define HH_WIDTH 4096U              /* counters of every row, a power of 2 */
+#define HH_TOPK 16U                 /* keys of the highest counts kept */
+#define HH_MAXLABELLEN 64U          /* bytes of a key kept for display */
+
+#define HH_USERS 0U                 /* sketch of the posting users */
+#define HH_ADDRESSES 1U             /* sketch of the client addresses */
+#define HH_MESSAGES 2U              /* sketch of the posted messages */
+#define HH_SKETCHES 3U
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A key of the top list of a sketch.
+ */
+typedef struct
+{
+    uint64_t hash;                  /* hash of the complete key */
+    uint64_t count;                 /* estimated count of the key */
+    uint32_t label_len;             /* length of label */
+    char label[HH_MAXLABELLEN];     /* the key, possibly truncated (not zero-terminated) */
+} hh_entry_t;
+
+/**
+ * A sketch as mapped from the shared memory segment.
+ */
+typedef struct
+{
+    uint32_t counters[HH_DEPTH][HH_WIDTH];
+    uint64_t total;                 /* keys counted */
+    pid_t lock;                     /* process updating the top list, 0 if none */
+    uint32_t top_len;               /* keys in top */
+    hh_entry_t top[HH_TOPK];        /* min-heap of the keys of the highest counts */
+} hh_sketch_t;
+
+/**
+ * The sketches as mapped from the shared memory segment.
+ */
+typedef struct
+{
+    hh_sketch_t sketches[HH_SKETCHES];  /* indexed by HH_USERS, ... */
+} hh_table_t;
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Map the sketches
+ *
+ * Map the sketches shared by all instances of the business logic, they
+ * are created empty if they do not exist yet.
+ *
+ * \return address of the mapped sketches
+ * \retval NULL failed, errno is set
+ */
+extern hh_table_t *hh_map(void);
+
+/**
+ * \brief Count a key
+ *
+ * Count the key \a key in the sketch \a sketch and put it on the top
+ * list if its estimate is high enough. The top list is only locked if
+ * the key makes it onto the list, a key which cannot get the lock in
+ * time is counted but the list is not updated.
+ *
+ * \param sketch the mapped sketch [IN]
+ * \param key the key [IN]
+ * \param key_len length of \a key [IN]
+ */
+extern void hh_count(hh_sketch_t *sketch, const char *key, size_t key_len);
+
+/**
+ * \brief Get the top list of a sketch
+ *
+ * \param sketch the mapped sketch [IN]
+ * \param top filled with the keys of the highest counts, highest count
+ *        first [OUT]
+ *
+ * \return number of keys in \a top, at most HH_TOPK
+ */
+extern size_t hh_top(hh_sketch_t *sketch, hh_entry_t top[HH_TOPK]);
+
+#endif /* HEAVY_HITTERS_H */
+
+/*
+ * =================================================================== eof ==
+ */
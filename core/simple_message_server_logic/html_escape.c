@@ -0,0 +1,186 @@
+/* ================================================================ */
+/**
+ * @file html_escape.c
+ * HTML escaping of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the escaping of text inserted into HTML.
+ * The replacement of every character is looked up in a table. Runs of
+ * characters which need no escaping are located 16 bytes at a time
+ * with SSE2 (if available) and copied with a single memcpy(), thus
+ * text without any special character costs little more than a copy.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "html_escape.h"
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+typedef struct
+{
+    const char *text;  /* NULL if the character is copied unchanged */
+    size_t len;
+} replacement_t;
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+/*
+ * replacement of every character
+ */
+static const replacement_t replacements[256] =
+{
+    ['&'] = { "&amp;", 5 },
+    ['<'] = { "&lt;", 4 },
+    ['>'] = { "&gt;", 4 },
+    ['"'] = { "&quot;", 6 },
+    ['\''] = { "&#39;", 5 }
+};
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Get the length of the leading run of plain characters
+ *
+ * \param s the text to be scanned [IN]
+ * \param len length of \a s [IN]
+ *
+ * \return number of leading characters of \a s which need no escaping
+ */
+static size_t plain_run(
+    const char *s,
+    size_t len
+    )
+{
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i gt = _mm_set1_epi8('>');
+    const __m128i quot = _mm_set1_epi8('"');
+    const __m128i apos = _mm_set1_epi8('\'');
+    __m128i v, m;
+    int mask;
+
+    for (; i + 16 <= len; i += 16)
+    {
+        v = _mm_loadu_si128((const __m128i *) (s + i));
+        m = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, amp), _mm_cmpeq_epi8(v, lt)),
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, gt), _mm_cmpeq_epi8(v, quot)),
+                _mm_cmpeq_epi8(v, apos)
+                )
+            );
+
+        if ((mask = _mm_movemask_epi8(m)) != 0)
+        {
+            return i + (size_t) __builtin_ctz((unsigned int) mask);
+        }
+    }
+#endif
+
+    /*
+     * scalar fallback and the tail of less than 16 bytes
+     */
+    while ((i < len) && (replacements[(unsigned char) s[i]].text == NULL))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+size_t html_escaped_length(
+    const char *s,
+    size_t len
+    )
+{
+    size_t total = 0;
+    size_t run;
+
+    for (;;)
+    {
+        run = plain_run(s, len);
+        total += run;
+
+        if (run == len)
+        {
+            return total;
+        }
+
+        total += replacements[(unsigned char) s[run]].len;
+        s += run + 1;
+        len -= run + 1;
+    }
+}
+
+ssize_t html_escape(
+    char *buf,
+    size_t size,
+    const char *s,
+    size_t len
+    )
+{
+    const replacement_t *r;
+    char *p = buf;
+    size_t run;
+
+    for (;;)
+    {
+        run = plain_run(s, len);
+
+        if (run > size)
+        {
+            return -1;
+        }
+
+        memcpy(p, s, run);
+        p += run;
+        size -= run;
+
+        if (run == len)
+        {
+            return p - buf;
+        }
+
+        r = &replacements[(unsigned char) s[run]];
+
+        if (r->len > size)
+        {
+            return -1;
+        }
+
+        memcpy(p, r->text, r->len);
+        p += r->len;
+        size -= r->len;
+        s += run + 1;
+        len -= run + 1;
+    }
+}
+
+/*
+ * =================================================================== eof ==
+ */
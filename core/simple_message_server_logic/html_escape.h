@@ -0,0 +1,69 @@
+/* ================================================================ */
+/**
+ * @file html_escape.h
+ * HTML escaping of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the escaping of text which is inserted into
+ * HTML content or attribute values (e.g. user name and image URL).
+ * The characters '&', '<', '>', '"' and '\'' are replaced by character
+ * references, all other characters are copied unchanged.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef HTML_ESCAPE_H
+#define HTML_ESCAPE_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define HTML_ESCAPE_MAXEXPANSION 6  /* length of the longest reference */
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Get the length of escaped text
+ *
+ * \param s the text to be escaped [IN]
+ * \param len length of \a s [IN]
+ *
+ * \return length of \a s after escaping
+ */
+extern size_t html_escaped_length(const char *s, size_t len);
+
+/**
+ * \brief Escape text
+ *
+ * Write the escaped text \a s into \a buf (without terminating zero).
+ *
+ * \param buf buffer for the escaped text [OUT]
+ * \param size size of the buffer pointed to by \a buf [IN]
+ * \param s the text to be escaped [IN]
+ * \param len length of \a s [IN]
+ *
+ * \return number of bytes written
+ * \retval -1 the escaped text does not fit into \a buf
+ */
+extern ssize_t html_escape(char *buf, size_t size, const char *s, size_t len);
+
+#endif /* HTML_ESCAPE_H */
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,311 @@
+/* ================================================================ */
+/**
+ * @file html_escape_test.c
+ * Tests and benchmark of the HTML escaping.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file checks the SSE2 fast path of html_escape.c against
+ * its scalar path, which is html_escape.c compiled once more without
+ * __SSE2__ and with the functions renamed to html_escape_scalar() and
+ * html_escaped_length_scalar(). Every byte value is placed at every
+ * position of a text at every alignment, thus it is found both by the
+ * vector loop and in the tail. It is run by "make test", the exit
+ * status is EXIT_FAILURE if any check failed.
+ *
+ * Invoked with -b the throughput of both paths is measured instead.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "html_escape.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define TEXTLEN 48           /* three vectors, the last one partially */
+#define ALIGNMENTS 16        /* alignments of the text to a vector */
+#define BENCHLEN (1024 * 1024)
+#define BENCHROUNDS 200
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/*
+ * the scalar path, see the Makefile
+ */
+extern size_t html_escaped_length_scalar(const char *s, size_t len);
+extern ssize_t html_escape_scalar(char *buf, size_t size, const char *s, size_t len);
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+static unsigned int failures = 0;
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Compare both paths on a text
+ *
+ * \param s the text to be escaped [IN]
+ * \param len length of \a s [IN]
+ * \param c the byte placed into the text [IN]
+ * \param pos position of \a c in the text [IN]
+ */
+static void compare(
+    const char *s,
+    size_t len,
+    int c,
+    size_t pos
+    )
+{
+    char vector[TEXTLEN * HTML_ESCAPE_MAXEXPANSION];
+    char scalar[TEXTLEN * HTML_ESCAPE_MAXEXPANSION];
+    ssize_t vector_len, scalar_len;
+    size_t escaped_len;
+
+    escaped_len = html_escaped_length_scalar(s, len);
+    vector_len = html_escape(vector, sizeof(vector), s, len);
+    scalar_len = html_escape_scalar(scalar, sizeof(scalar), s, len);
+
+    if (
+        (html_escaped_length(s, len) != escaped_len) ||
+        (vector_len != scalar_len) ||
+        (scalar_len != (ssize_t) escaped_len) ||
+        (memcmp(vector, scalar, escaped_len) != 0)
+        )
+    {
+        (void) fprintf(
+            stderr,
+            "%s: byte 0x%02x at position %zu of %zu bytes escaped differently\n",
+            __FILE__,
+            (unsigned int) c,
+            pos,
+            len
+            );
+        failures++;
+        return;
+    }
+
+    /*
+     * both paths have to give up at the same size of the buffer
+     */
+    if (
+        (escaped_len > 0) &&
+        (
+            (html_escape(vector, escaped_len - 1, s, len) != -1) ||
+            (html_escape_scalar(scalar, escaped_len - 1, s, len) != -1)
+            )
+        )
+    {
+        (void) fprintf(
+            stderr,
+            "%s: byte 0x%02x at position %zu of %zu bytes exceeds the buffer\n",
+            __FILE__,
+            (unsigned int) c,
+            pos,
+            len
+            );
+        failures++;
+    }
+}
+
+/**
+ * \brief Check the SSE2 path against the scalar path
+ */
+static void test_equivalence(
+    void
+    )
+{
+    char buf[ALIGNMENTS + TEXTLEN];
+    char *s;
+    size_t align, pos, len;
+    int c;
+
+    for (align = 0; align < ALIGNMENTS; align++)
+    {
+        s = buf + align;
+
+        for (c = 0; c < 256; c++)
+        {
+            for (pos = 0; pos < TEXTLEN; pos++)
+            {
+                memset(s, 'x', TEXTLEN);
+                s[pos] = (char) c;
+
+                /*
+                 * the full text as well as the text ending right
+                 * behind the byte, i.e. every length of a tail
+                 */
+                compare(s, TEXTLEN, c, pos);
+                compare(s, pos + 1, c, pos);
+            }
+        }
+
+        /*
+         * nothing but characters to be escaped
+         */
+        for (len = 0; len < TEXTLEN; len++)
+        {
+            s[len] = "&<>\"'"[len % 5];
+        }
+
+        compare(s, TEXTLEN, '&', 0);
+    }
+}
+
+/**
+ * \brief Measure the throughput of an escaper
+ *
+ * \param name zero-terminated string containing the name of the escaper [IN]
+ * \param escape the escaper [IN]
+ * \param text zero-terminated string containing the kind of the text [IN]
+ * \param s the text to be escaped [IN]
+ * \param buf buffer for the escaped text of BENCHLEN * HTML_ESCAPE_MAXEXPANSION bytes [OUT]
+ */
+static void bench(
+    const char *name,
+    ssize_t (*escape)(char *, size_t, const char *, size_t),
+    const char *text,
+    const char *s,
+    char *buf
+    )
+{
+    struct timespec start, stop;
+    double seconds;
+    int i;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; i < BENCHROUNDS; i++)
+    {
+        if (escape(buf, (size_t) BENCHLEN * HTML_ESCAPE_MAXEXPANSION, s, BENCHLEN) == -1)
+        {
+            failures++;
+        }
+    }
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    seconds = (double) (stop.tv_sec - start.tv_sec) +
+        (double) (stop.tv_nsec - start.tv_nsec) / 1e9;
+
+    (void) printf(
+        "%-8s %-14s %8.1f MB/s\n",
+        name,
+        text,
+        (double) BENCHLEN * BENCHROUNDS / seconds / 1e6
+        );
+}
+
+/**
+ * \brief Compare the throughput of the SSE2 and the scalar path
+ *
+ * \retval 0 success
+ * \retval -1 out of memory
+ */
+static int run_benchmark(
+    void
+    )
+{
+    char *s, *buf;
+    size_t i;
+
+    if (
+        ((s = malloc(BENCHLEN)) == NULL) ||
+        ((buf = malloc((size_t) BENCHLEN * HTML_ESCAPE_MAXEXPANSION)) == NULL)
+        )
+    {
+        free(s);
+        return -1;
+    }
+
+    /*
+     * a user name or image URL without special characters
+     */
+    for (i = 0; i < BENCHLEN; i++)
+    {
+        s[i] = (char) ('a' + i % 26);
+    }
+
+    bench("sse2", html_escape, "plain", s, buf);
+    bench("scalar", html_escape_scalar, "plain", s, buf);
+
+    /*
+     * a special character every 64 bytes, e.g. the '&' of a query
+     */
+    for (i = 63; i < BENCHLEN; i += 64)
+    {
+        s[i] = '&';
+    }
+
+    bench("sse2", html_escape, "every 64 bytes", s, buf);
+    bench("scalar", html_escape_scalar, "every 64 bytes", s, buf);
+
+    free(buf);
+    free(s);
+
+    return 0;
+}
+
+/**
+ * \brief Run the tests or the benchmark (-b)
+ *
+ * \param argc the number of arguments [IN]
+ * \param argv the arguments [IN]
+ *
+ * \return EXIT_SUCCESS if all checks passed, EXIT_FAILURE otherwise
+ */
+int main(
+    int argc,
+    char **argv
+    )
+{
+    if ((argc == 2) && (strcmp(argv[1], "-b") == 0))
+    {
+        if (run_benchmark() == -1)
+        {
+            (void) fprintf(stderr, "%s: out of memory\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    else if (argc == 1)
+    {
+        test_equivalence();
+    }
+    else
+    {
+        (void) fprintf(stderr, "usage: %s [-b]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (failures > 0)
+    {
+        (void) fprintf(stderr, "%s: %u checks failed\n", __FILE__, failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * =================================================================== eof ==
+ */
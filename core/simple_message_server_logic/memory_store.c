@@ -0,0 +1,473 @@
+/* ================================================================ */
+/**
+ * @file memory_store.c
+ * Memory-only post store of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the memory backend of the post store. The
+ * slots are written while the writer lock is held, the count of the
+ * store is raised afterwards, thus the readers never look at a slot
+ * of a post which has not been appended completely.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "memory_store.h"
+#include "shared_segment.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MAXSEGMENTNAMELEN 32
+
+/*
+ * number of attempts of a reader to copy a slot which is being written
+ */
+#define MS_READ_ATTEMPTS 8
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+/*
+ * the store mapped last and the hash of its directory, a process
+ * opens the store of the same directory over and over.
+ */
+static ms_store_t *mapped_store = NULL;
+static uint32_t mapped_hash = 0;
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Hash the directory of a store
+ *
+ * \param dir zero-terminated string containing the directory [IN]
+ *
+ * \return the FNV-1a hash of the directory
+ */
+static uint32_t hash_dir(
+    const char *dir
+    )
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    while (*dir != '\0')
+    {
+        hash ^= (unsigned char) *dir++;
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Open the store of a directory
+ *
+ * The shared memory segment of the store is created empty if it does
+ * not exist yet, whatever the mode is.
+ *
+ * \param store the store to be initialised [OUT]
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param mode ignored [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int ms_open(
+    bb_store_t *store,
+    const char *dir,
+    int mode
+    )
+{
+    char name[MAXSEGMENTNAMELEN];
+    const uint32_t hash = hash_dir(dir);
+
+    (void) mode;
+
+    if ((mapped_store == NULL) || (mapped_hash != hash))
+    {
+        (void) snprintf(name, sizeof(name), "%s.%08lx", MS_SEGMENT, (unsigned long) hash);
+
+        if ((mapped_store = shared_segment_map(name, sizeof(ms_store_t))) == NULL)
+        {
+            return -1;
+        }
+
+        mapped_hash = hash;
+    }
+
+    store->data_fd = -1;
+    store->index_fd = -1;
+    store->memory = mapped_store;
+
+    return 0;
+}
+
+/**
+ * \brief Close the store
+ *
+ * The segment stays mapped for the next store opened.
+ *
+ * \param store the store to be closed [IN]
+ */
+static void ms_close(
+    bb_store_t *store
+    )
+{
+    store->memory = NULL;
+}
+
+/**
+ * \brief Lock the store for appending
+ *
+ * Spin on the lock, yielding the processor between the attempts. A
+ * lock held by a process which no longer exists is taken over.
+ *
+ * \param ms the mapped store [IN]
+ */
+static void lock_writer(
+    ms_store_t *ms
+    )
+{
+    const pid_t self = getpid();
+    pid_t holder;
+
+    for (;;)
+    {
+        holder = 0;
+
+        if (
+            __atomic_compare_exchange_n(
+                &ms->writer, &holder, self, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED
+                )
+            )
+        {
+            return;
+        }
+
+        if (
+            (kill(holder, 0) == -1) &&
+            (errno == ESRCH) &&
+            __atomic_compare_exchange_n(
+                &ms->writer, &holder, self, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED
+                )
+            )
+        {
+            return;
+        }
+
+        (void) sched_yield();
+    }
+}
+
+/**
+ * \brief Unlock the store
+ *
+ * \param ms the mapped store [IN]
+ */
+static void unlock_writer(
+    ms_store_t *ms
+    )
+{
+    __atomic_store_n(&ms->writer, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * \brief Write a post into its slot
+ *
+ * \param slot the slot of the post [IN]
+ * \param number number of the post (counting from 0) [IN]
+ * \param post the post, must not exceed BB_MAXPOSTLEN [IN]
+ */
+static void write_slot(
+    ms_slot_t *slot,
+    uint64_t number,
+    const bb_post_t *post
+    )
+{
+    /*
+     * a slot left odd by a writer which died is taken over as it is.
+     */
+    const uint32_t lock = __atomic_load_n(&slot->lock, __ATOMIC_RELAXED) | 1U;
+    char *p;
+
+    __atomic_store_n(&slot->lock, lock, __ATOMIC_RELAXED);
+
+    /*
+     * the odd lock has to be visible before any of the data
+     */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->number = number + 1;
+    slot->timestamp = post->timestamp;
+    slot->user_len = (uint32_t) post->user_len;
+    slot->img_len = (post->img != NULL) ? (uint32_t) post->img_len : 0;
+    slot->msg_len = (uint32_t) post->msg_len;
+
+    p = slot->data;
+    memcpy(p, post->user, post->user_len);
+    p += post->user_len;
+    *p++ = '\0';
+
+    if (slot->img_len > 0)
+    {
+        memcpy(p, post->img, post->img_len);
+        p += post->img_len;
+        *p++ = '\0';
+    }
+
+    memcpy(p, post->msg, post->msg_len);
+    p[post->msg_len] = '\0';
+
+    __atomic_store_n(&slot->lock, lock + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * \brief Append posts to the store, see bb_append()
+ *
+ * \param store the opened store [IN]
+ * \param posts the posts to be appended [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param first set to the number of the first appended post, may be NULL [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 a post is too long, errno is set
+ */
+static int ms_append(
+    bb_store_t *store,
+    const bb_post_t *posts,
+    size_t count,
+    uint64_t *first
+    )
+{
+    ms_store_t *ms = store->memory;
+    uint64_t entries;
+    size_t i, img_len;
+
+    for (i = 0; i < count; i++)
+    {
+        img_len = (posts[i].img != NULL) ? posts[i].img_len : 0;
+
+        if (posts[i].user_len + img_len + posts[i].msg_len > BB_MAXPOSTLEN)
+        {
+            errno = EMSGSIZE;
+            return -1;
+        }
+    }
+
+    lock_writer(ms);
+
+    /*
+     * the identity tells the posts of this store from those of a
+     * store recreated after a reboot, e.g. in the post ring.
+     */
+    if (ms->id == 0)
+    {
+        __atomic_store_n(
+            &ms->id,
+            (((uint64_t) time(NULL) << 32) ^ (uint64_t) getpid()) | 1U,
+            __ATOMIC_RELAXED
+            );
+    }
+
+    entries = ms->count;
+
+    for (i = 0; i < count; i++)
+    {
+        write_slot(&ms->slots[(entries + i) % MS_SLOTS], entries + i, &posts[i]);
+    }
+
+    __atomic_store_n(&ms->count, entries + count, __ATOMIC_RELEASE);
+
+    unlock_writer(ms);
+
+    if (first != NULL)
+    {
+        *first = entries;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Flush the store
+ *
+ * The segment lives in memory only, there is nothing to be flushed.
+ *
+ * \param store ignored [IN]
+ *
+ * \retval 0 always
+ */
+static int ms_flush(
+    bb_store_t *store
+    )
+{
+    (void) store;
+
+    return 0;
+}
+
+/**
+ * \brief Get the number of posts appended to the store
+ *
+ * \param store the opened store [IN]
+ *
+ * \return the number of posts, including the ones overwritten
+ */
+static int64_t ms_count(
+    bb_store_t *store
+    )
+{
+    const ms_store_t *ms = store->memory;
+
+    return (int64_t) __atomic_load_n(&ms->count, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * \brief Get the identity of the store
+ *
+ * \param store the opened store [IN]
+ *
+ * \return identity of the store
+ * \retval 0 nothing has been posted yet, errno is set
+ */
+static uint64_t ms_id(
+    const bb_store_t *store
+    )
+{
+    const ms_store_t *ms = store->memory;
+    uint64_t id;
+
+    if ((id = __atomic_load_n(&ms->id, __ATOMIC_RELAXED)) == 0)
+    {
+        errno = ENOENT;
+    }
+
+    return id;
+}
+
+/**
+ * \brief Read a post from the store, see bb_read()
+ *
+ * \param store the opened store [IN]
+ * \param number the number of the post [IN]
+ * \param record the record to be filled [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set to ENOENT if the post has not been
+ *         appended yet or has been overwritten, to EAGAIN if the slot
+ *         has been written during all attempts to copy it
+ */
+static int ms_read(
+    bb_store_t *store,
+    uint64_t number,
+    bb_record_t *record
+    )
+{
+    ms_store_t *ms = store->memory;
+    const ms_slot_t *slot = &ms->slots[number % MS_SLOTS];
+    uint32_t lock, user_len, img_len, msg_len;
+    uint64_t slot_number, timestamp;
+    size_t data_len;
+    int attempt;
+
+    if (number >= __atomic_load_n(&ms->count, __ATOMIC_ACQUIRE))
+    {
+        errno = ENOENT;
+        return -1;
+    }
+
+    for (attempt = 0; attempt < MS_READ_ATTEMPTS; attempt++)
+    {
+        if (((lock = __atomic_load_n(&slot->lock, __ATOMIC_ACQUIRE)) & 1U) != 0)
+        {
+            (void) sched_yield();
+            continue;  /* being written */
+        }
+
+        slot_number = slot->number;
+        timestamp = slot->timestamp;
+        user_len = slot->user_len;
+        img_len = slot->img_len;
+        msg_len = slot->msg_len;
+
+        /*
+         * the values may be torn, thus keep the copy within bounds
+         * before the lock tells whether they are valid.
+         */
+        data_len = (size_t) user_len + img_len + msg_len + 3;
+
+        if (data_len > sizeof(slot->data))
+        {
+            data_len = 0;
+        }
+
+        memcpy(record->buf, slot->data, data_len);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slot->lock, __ATOMIC_RELAXED) != lock)
+        {
+            continue;  /* modified while copying */
+        }
+
+        if ((slot_number != number + 1) || (data_len == 0))
+        {
+            errno = ENOENT;  /* overwritten by a newer post */
+            return -1;
+        }
+
+        record->post.timestamp = timestamp;
+        record->post.user = record->buf;
+        record->post.user_len = user_len;
+        record->post.img = (img_len > 0) ? record->buf + user_len + 1 : NULL;
+        record->post.img_len = img_len;
+        record->post.msg = record->buf + user_len + 1 + ((img_len > 0) ? img_len + 1 : 0);
+        record->post.msg_len = msg_len;
+
+        return 0;
+    }
+
+    errno = EAGAIN;
+    return -1;
+}
+
+const bb_backend_t ms_backend =
+{
+    "memory",
+    MS_SLOTS,
+    ms_open,
+    ms_close,
+    ms_append,
+    ms_flush,
+    ms_count,
+    ms_id,
+    ms_read
+};
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,88 @@
+/* ================================================================ */
+/**
+ * @file memory_store.h
+ * Memory-only post store of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the memory backend of the post store (see
+ * bb_use_backend()). It keeps the last MS_SLOTS posts in a shared memory
+ * segment (see shared_segment_map()) per store directory, thus the
+ * posts are shared by all instances of the business logic but never
+ * reach the disk. Older posts are overwritten and cannot be read any
+ * more, the posts are lost when the system is restarted.
+ *
+ * Post \a n (counting from 0) is kept in slot \a n % MS_SLOTS. The
+ * writers are serialized by a spin lock holding the process id of the
+ * writer, the lock of a writer which died while holding it is taken
+ * over by the next one. Every slot is guarded by a sequence lock like
+ * the ones of the post ring (see post_ring.h), thus the readers neither
+ * take a lock nor issue a system call.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef MEMORY_STORE_H
+#define MEMORY_STORE_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "bulletin_board.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MS_SEGMENT "memory_store"  /* prefix of the names of the shared memory segments */
+#define MS_SLOTS 4096U             /* number of posts kept in the store */
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A slot of the store. The strings of the post are stored one after
+ * the other in \a data, each of them zero-terminated.
+ */
+typedef struct
+{
+    uint32_t lock;       /* sequence lock, odd while the slot is written */
+    uint32_t user_len;
+    uint64_t number;     /* number of the post + 1, 0 if empty */
+    uint64_t timestamp;
+    uint32_t img_len;    /* 0 if the post has no image */
+    uint32_t msg_len;
+    char data[BB_MAXPOSTLEN + 3];
+} ms_slot_t;
+
+/**
+ * The store as mapped from the shared memory segment.
+ */
+typedef struct
+{
+    pid_t writer;        /* process appending posts, 0 if none */
+    uint64_t id;         /* identity of the store, 0 until the first post */
+    uint64_t count;      /* number of posts appended */
+    ms_slot_t slots[MS_SLOTS];
+} ms_store_t;
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+extern const bb_backend_t ms_backend;  /* last MS_SLOTS posts in shared memory */
+
+#endif /* MEMORY_STORE_H */
+
+/*
+ * =================================================================== eof ==
+ */
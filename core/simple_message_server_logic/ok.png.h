@@ -0,0 +1,248 @@
+static const unsigned char ok_png[] = {
+0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 
+0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x40, 
+0x08, 0x06, 0x00, 0x00, 0x00, 0xaa, 0x69, 0x71, 0xde, 0x00, 0x00, 0x00, 
+0x04, 0x73, 0x42, 0x49, 0x54, 0x08, 0x08, 0x08, 0x08, 0x7c, 0x08, 0x64, 
+0x88, 0x00, 0x00, 0x00, 0x09, 0x70, 0x48, 0x59, 0x73, 0x00, 0x00, 0x06, 
+0xec, 0x00, 0x00, 0x06, 0xec, 0x01, 0x1e, 0x75, 0x38, 0x35, 0x00, 0x00, 
+0x00, 0x19, 0x74, 0x45, 0x58, 0x74, 0x53, 0x6f, 0x66, 0x74, 0x77, 0x61, 
+0x72, 0x65, 0x00, 0x77, 0x77, 0x77, 0x2e, 0x69, 0x6e, 0x6b, 0x73, 0x63, 
+0x61, 0x70, 0x65, 0x2e, 0x6f, 0x72, 0x67, 0x9b, 0xee, 0x3c, 0x1a, 0x00, 
+0x00, 0x0b, 0x02, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0x9a, 0x09, 
+0x70, 0x14, 0x55, 0x1a, 0xc7, 0xff, 0xaf, 0xbb, 0xe7, 0xce, 0x39, 0x39, 
+0x26, 0x93, 0xc9, 0xe9, 0x4c, 0x48, 0x0c, 0x31, 0xdc, 0x20, 0x42, 0x48, 
+0xb8, 0x05, 0x5c, 0x91, 0xa2, 0x16, 0x17, 0xf1, 0x5c, 0x4a, 0xb1, 0x50, 
+0x77, 0x17, 0x17, 0x94, 0x5d, 0x71, 0xb5, 0xdc, 0xd5, 0x62, 0xad, 0x5d, 
+0xd4, 0xf2, 0x42, 0x5d, 0xf1, 0x80, 0x80, 0x28, 0x2a, 0xb2, 0xa0, 0x72, 
+0x06, 0x10, 0x02, 0xc8, 0x1d, 0xc5, 0x70, 0x43, 0x08, 0x39, 0x26, 0x99, 
+0x4c, 0xe6, 0x48, 0xe6, 0xea, 0x6b, 0xdf, 0xcc, 0xc0, 0x90, 0x2a, 0x8f, 
+0xcd, 0x6e, 0xa2, 0x92, 0x38, 0x5f, 0xd5, 0x57, 0xaf, 0x7b, 0xa6, 0x7a, 
+0xa6, 0xff, 0xbf, 0xef, 0xfb, 0xfa, 0xbd, 0x7e, 0xef, 0x11, 0x59, 0x96, 
+0xf1, 0x4b, 0xb6, 0x28, 0x80, 0x28, 0x80, 0x28, 0x80, 0x28, 0x80, 0x28, 
+0x80, 0x28, 0x80, 0x28, 0x80, 0x28, 0x80, 0x28, 0x80, 0x28, 0x80, 0x28, 
+0x80, 0x9e, 0x67, 0x84, 0x8c, 0xe6, 0x86, 0xcf, 0x18, 0xbb, 0xff, 0x96, 
+0x49, 0x25, 0xc5, 0x6d, 0x6d, 0x2e, 0xe7, 0x8e, 0x9d, 0x87, 0xee, 0xde, 
+0xf1, 0xfe, 0x13, 0xeb, 0x7a, 0x3b, 0x80, 0x88, 0x78, 0xf3, 0xc4, 0x91, 
+0xe7, 0x2c, 0x79, 0xf9, 0x19, 0xb3, 0x26, 0x5f, 0x87, 0xcc, 0xd4, 0x78, 
+0x2c, 0x58, 0xb2, 0x4e, 0xac, 0x3d, 0x5d, 0x3d, 0xa1, 0x71, 0xdf, 0xab, 
+0xdb, 0x7a, 0x35, 0x00, 0x42, 0xcd, 0x3c, 0xe1, 0xb1, 0xb3, 0xba, 0x44, 
+0x53, 0x4e, 0x46, 0x7a, 0x1c, 0xfe, 0x32, 0xa7, 0x0c, 0xf5, 0x56, 0x3b, 
+0x16, 0x3e, 0xbf, 0x1d, 0xbc, 0xaf, 0x4d, 0x68, 0x6f, 0xbe, 0x50, 0x66, 
+0xdd, 0xff, 0xea, 0xee, 0x5e, 0x0b, 0x20, 0xef, 0xc6, 0x45, 0xa7, 0x62, 
+0x93, 0x32, 0x2d, 0x3a, 0x0d, 0x87, 0x27, 0x1f, 0x1c, 0x0d, 0x49, 0x1b, 
+0x07, 0x1d, 0x23, 0xe3, 0xdd, 0x0f, 0x77, 0x61, 0xeb, 0xde, 0x8b, 0x08, 
+0xf8, 0xdc, 0x02, 0xef, 0xbe, 0x30, 0xbc, 0x7e, 0xd7, 0xd2, 0x03, 0xbd, 
+0x0e, 0x40, 0xfe, 0x94, 0x45, 0xd5, 0xb1, 0xfa, 0xac, 0x02, 0x95, 0x8a, 
+0xc5, 0xa2, 0x39, 0x25, 0x80, 0x26, 0x0e, 0xd2, 0x25, 0x0d, 0xb1, 0x0a, 
+0x19, 0x6f, 0x7f, 0x50, 0x89, 0x9d, 0x07, 0xeb, 0x11, 0xf0, 0xba, 0x02, 
+0x7e, 0xc7, 0xb9, 0xa1, 0xd6, 0x7d, 0x6f, 0x1e, 0xed, 0x35, 0x00, 0xae, 
+0xbd, 0x71, 0xd1, 0x57, 0x71, 0x86, 0x9c, 0x22, 0x4e, 0xc5, 0xe0, 0x91, 
+0xbb, 0xaf, 0x07, 0xd1, 0xc4, 0x40, 0x94, 0x64, 0x74, 0xb4, 0x58, 0x15, 
+0xc1, 0xb2, 0xd5, 0x7b, 0xb0, 0xf7, 0x68, 0x63, 0x30, 0x13, 0xfc, 0x92, 
+0xbb, 0x65, 0x40, 0xfd, 0x9e, 0xe7, 0xaa, 0x7b, 0x3c, 0x80, 0x82, 0xc9, 
+0x8f, 0x1d, 0xd6, 0x1b, 0x72, 0xfb, 0xb3, 0x2c, 0xc1, 0xef, 0xee, 0x18, 
+0x02, 0xa8, 0x75, 0x90, 0xa4, 0xef, 0xbe, 0xf7, 0x78, 0x35, 0x83, 0x65, 
+0x1f, 0xec, 0xc1, 0x97, 0x5f, 0x35, 0x41, 0xf4, 0xba, 0x7c, 0x4a, 0x34, 
+0xf7, 0x3b, 0xb3, 0xe5, 0xa5, 0x93, 0x3d, 0x16, 0x40, 0xc1, 0x94, 0x85, 
+0xfb, 0x92, 0xd3, 0xcc, 0x43, 0x19, 0xc2, 0xe2, 0xfe, 0x5b, 0xfb, 0x83, 
+0xa8, 0xb5, 0x10, 0x24, 0x09, 0x3f, 0x64, 0x89, 0x5a, 0x16, 0xe5, 0x6b, 
+0x0f, 0x41, 0xad, 0x50, 0xa1, 0xa6, 0xe6, 0xbc, 0x75, 0xdb, 0x5b, 0x0f, 
+0xa7, 0xf5, 0x48, 0x00, 0x7d, 0x27, 0x3d, 0xba, 0x2b, 0xc9, 0x64, 0x1e, 
+0xc1, 0xb2, 0x32, 0xee, 0x98, 0x3a, 0x00, 0x9c, 0x46, 0x03, 0x41, 0x94, 
+0xd0, 0x19, 0x8b, 0x51, 0x12, 0x6c, 0xdc, 0x71, 0x0a, 0x3e, 0xaf, 0x57, 
+0x2e, 0x7f, 0xe6, 0x76, 0xa6, 0x5b, 0x01, 0x98, 0x4a, 0x1f, 0xc8, 0xac, 
+0xdb, 0xf1, 0x72, 0xed, 0x8f, 0x2c, 0x7e, 0x5b, 0x6a, 0x86, 0x79, 0x34, 
+0xc3, 0xc8, 0x98, 0x31, 0xb9, 0x2f, 0x58, 0xb5, 0xb6, 0xd3, 0xe2, 0x19, 
+0x48, 0xa8, 0xdc, 0x7b, 0x16, 0xd6, 0x16, 0x0f, 0x5c, 0xf6, 0x86, 0xda, 
+0xdd, 0xab, 0x1e, 0xcb, 0xea, 0x0e, 0x00, 0xf4, 0x41, 0x34, 0xff, 0x8f, 
+0x63, 0x47, 0x0e, 0x5e, 0x9c, 0x6f, 0x36, 0x71, 0x7b, 0x0e, 0x7c, 0x63, 
+0xad, 0xdc, 0x71, 0x68, 0xc0, 0xf9, 0x03, 0xaf, 0x35, 0xa0, 0x9b, 0xad, 
+0x70, 0xd2, 0x82, 0x8d, 0xe9, 0x99, 0xe6, 0x09, 0xa0, 0x76, 0xcb, 0x84, 
+0x02, 0x70, 0x6a, 0x35, 0x02, 0x42, 0xe7, 0xc4, 0xab, 0x39, 0x06, 0xab, 
+0xd7, 0x1f, 0xc6, 0x99, 0xf3, 0x2d, 0x08, 0xf8, 0x5c, 0x7e, 0x21, 0x60, 
+0x2f, 0x6a, 0xaa, 0xfc, 0xd7, 0xe9, 0x2e, 0x03, 0xb8, 0xa6, 0x6c, 0xee, 
+0x43, 0x29, 0xa6, 0xbc, 0x17, 0x7e, 0x55, 0x5a, 0x44, 0x8a, 0xf3, 0x8d, 
+0xa8, 0x3a, 0x59, 0x87, 0x75, 0x9b, 0xbe, 0x74, 0xd5, 0xd9, 0x9c, 0xe6, 
+0xba, 0x8a, 0x7f, 0xd8, 0xd0, 0x4d, 0x56, 0x34, 0x7e, 0xde, 0x7a, 0x43, 
+0x76, 0xee, 0x14, 0xc2, 0x28, 0x30, 0x79, 0xb4, 0x05, 0x0a, 0xb5, 0x06, 
+0x01, 0x5e, 0x40, 0x67, 0x4c, 0xab, 0x56, 0xe0, 0x93, 0x8d, 0x55, 0x38, 
+0x71, 0x96, 0x8a, 0xf7, 0xb7, 0xf9, 0xa5, 0xb6, 0xc6, 0x41, 0x0d, 0x5f, 
+0xbe, 0x7d, 0xac, 0xcb, 0xbd, 0x40, 0xf6, 0x88, 0xfb, 0xef, 0xa3, 0xe9, 
+0xb8, 0x54, 0xa9, 0x52, 0x92, 0x9b, 0xc7, 0x15, 0xc0, 0x94, 0x96, 0x88, 
+0xca, 0x03, 0xa7, 0xf0, 0x35, 0x85, 0xe0, 0x71, 0x38, 0x5c, 0x56, 0xdf, 
+0xe9, 0xdc, 0xda, 0xcf, 0xdf, 0xb7, 0x77, 0x39, 0xed, 0xc7, 0x3f, 0xb0, 
+0x36, 0x25, 0x3d, 0x7b, 0x2a, 0xcb, 0xb2, 0x18, 0x57, 0x5a, 0x08, 0x15, 
+0x8d, 0xbc, 0xbf, 0x93, 0xe2, 0xe3, 0x63, 0x34, 0xd8, 0xb8, 0xf3, 0x18, 
+0xbe, 0x3e, 0xd1, 0x0c, 0xde, 0xd3, 0xc6, 0xfb, 0x9d, 0x75, 0x43, 0xac, 
+0x87, 0x96, 0x77, 0x7d, 0x1c, 0x90, 0x5d, 0x72, 0xef, 0x9d, 0xc9, 0x86, 
+0xdc, 0xb7, 0x39, 0x85, 0x8a, 0x0c, 0xe9, 0x9f, 0x0e, 0x4b, 0xae, 0x01, 
+0xae, 0x36, 0x1f, 0x12, 0xe2, 0xd4, 0xd8, 0xbc, 0xfd, 0x08, 0xec, 0x2d, 
+0x2e, 0x78, 0xdb, 0x5d, 0x8e, 0x5a, 0xbb, 0x33, 0xab, 0x79, 0xd7, 0x9b, 
+0xee, 0xff, 0xbb, 0x9f, 0x1f, 0x33, 0x67, 0x4d, 0x72, 0x5a, 0xda, 0x74, 
+0x86, 0xe3, 0x30, 0x66, 0xd4, 0x75, 0x54, 0xbc, 0x0e, 0x81, 0x00, 0x8f, 
+0xce, 0x58, 0xb2, 0x3e, 0x16, 0x15, 0xbb, 0x8f, 0xe3, 0xc8, 0xb1, 0x46, 
+0x1a, 0xf9, 0x76, 0xa1, 0xdd, 0x53, 0x3f, 0xd2, 0xb6, 0xe7, 0xdd, 0x7d, 
+0x5d, 0x1e, 0x09, 0x66, 0x0d, 0xbb, 0x7f, 0x66, 0xa2, 0xd1, 0x54, 0xae, 
+0x50, 0x2a, 0xc8, 0xa0, 0x7e, 0x26, 0x98, 0x73, 0xa8, 0x78, 0xb7, 0x17, 
+0x97, 0x4d, 0x9f, 0xa0, 0xc1, 0xd6, 0x8a, 0xfd, 0xb0, 0xdb, 0x1d, 0xf0, 
+0x7a, 0xbc, 0xad, 0x8d, 0x17, 0x4f, 0x65, 0x36, 0x1e, 0xdd, 0xd8, 0xfe, 
+0x3f, 0x8f, 0xf0, 0xc6, 0xfc, 0xf6, 0xbd, 0xa4, 0x64, 0xfd, 0xad, 0x0c, 
+0xc3, 0xa1, 0xac, 0x74, 0x30, 0xd4, 0x1a, 0x2d, 0x7c, 0xbe, 0xce, 0x89, 
+0x37, 0xa6, 0xc6, 0x63, 0xf7, 0xc1, 0x33, 0x38, 0x78, 0xe4, 0x22, 0xfc, 
+0x3e, 0x8f, 0xc0, 0xbb, 0xea, 0xca, 0xea, 0xf6, 0xaf, 0xe8, 0xfa, 0xbb, 
+0x40, 0xe6, 0xb0, 0xbb, 0xa6, 0xc5, 0x1b, 0x72, 0xd6, 0x28, 0x15, 0x0a, 
+0xa6, 0x5f, 0xb1, 0x09, 0x79, 0xd9, 0xa9, 0x70, 0xba, 0x3c, 0xe8, 0x68, 
+0x84, 0x7a, 0x62, 0x82, 0x16, 0x5b, 0x77, 0xec, 0x85, 0x83, 0x42, 0xf0, 
+0x79, 0x03, 0x2d, 0x6e, 0x7f, 0x20, 0xe3, 0x5c, 0xc5, 0x5b, 0xbe, 0x4e, 
+0x8b, 0x2f, 0xbb, 0x6b, 0x79, 0xbc, 0x3e, 0xe6, 0x76, 0x86, 0x51, 0x60, 
+0x54, 0xc9, 0x10, 0x68, 0x34, 0xba, 0x4e, 0x8b, 0xcf, 0x36, 0xa5, 0xd0, 
+0x01, 0x4f, 0x0d, 0xf6, 0x1d, 0x38, 0x4f, 0x23, 0xef, 0x11, 0xdb, 0x5b, 
+0x2e, 0x4c, 0x6c, 0x3c, 0xb4, 0x6a, 0x6b, 0x97, 0xdf, 0x06, 0x8d, 0x83, 
+0xef, 0x98, 0x92, 0x64, 0xcc, 0x59, 0xc7, 0xb0, 0x2c, 0x53, 0x4c, 0xc5, 
+0x5b, 0x32, 0x83, 0xe2, 0x23, 0x81, 0xfd, 0x36, 0x84, 0x44, 0x2d, 0xb6, 
+0x57, 0xec, 0x46, 0xab, 0xa3, 0x85, 0x46, 0x41, 0xb4, 0x7d, 0xb3, 0xe5, 
+0x5d, 0x23, 0xfd, 0xed, 0xff, 0x5a, 0xbc, 0x79, 0x65, 0xb7, 0x2d, 0x8b, 
+0x8d, 0x55, 0xdf, 0x43, 0x18, 0x16, 0xa3, 0x4a, 0x47, 0x40, 0xa3, 0x8e, 
+0x81, 0xd7, 0x1b, 0x40, 0x67, 0xcc, 0x92, 0x9d, 0x86, 0xa3, 0xf4, 0x19, 
+0xb4, 0x6b, 0xcf, 0x19, 0x5a, 0x2a, 0x5e, 0xa9, 0xdd, 0x55, 0x77, 0x53, 
+0xc3, 0x9e, 0x15, 0x9f, 0x75, 0xcb, 0x7c, 0x40, 0xf1, 0x94, 0x47, 0x1a, 
+0xd3, 0xd2, 0x0c, 0x86, 0xf4, 0x8c, 0x78, 0x18, 0x0d, 0xf1, 0x70, 0x39, 
+0x3d, 0xdf, 0xf7, 0x6a, 0x1a, 0x72, 0x86, 0x7a, 0x42, 0x92, 0x0e, 0xdb, 
+0xb7, 0x6e, 0xa1, 0x99, 0x60, 0xa7, 0x37, 0xc4, 0x34, 0x1d, 0xaf, 0x58, 
+0x99, 0x26, 0x53, 0xfb, 0x5e, 0x01, 0x25, 0xbf, 0x79, 0x4d, 0xab, 0xc5, 
+0x7d, 0x0c, 0xc3, 0x60, 0xd4, 0x98, 0x31, 0xd0, 0x69, 0x13, 0xe0, 0xf1, 
+0xf8, 0x21, 0x4b, 0x32, 0x24, 0x59, 0xc2, 0x0f, 0x65, 0xe7, 0xb5, 0x66, 
+0x13, 0x4e, 0xd4, 0x34, 0xa1, 0x62, 0xe7, 0x09, 0x04, 0x78, 0xbf, 0xe4, 
+0xb4, 0x5e, 0x98, 0x6e, 0x3d, 0xbc, 0x72, 0x6d, 0xb7, 0xcd, 0x08, 0x0d, 
+0x9f, 0xf1, 0x84, 0x64, 0x34, 0x26, 0x91, 0x5c, 0x73, 0x2a, 0xdc, 0xad, 
+0xee, 0xef, 0xbe, 0x98, 0x61, 0xc0, 0x50, 0x27, 0x24, 0xd8, 0x52, 0x08, 
+0xb4, 0x4d, 0xd0, 0x6b, 0xb0, 0x79, 0xd3, 0xa7, 0x70, 0xb6, 0xd8, 0x20, 
+0x49, 0xca, 0xc6, 0x13, 0x3b, 0xd6, 0xa4, 0x7f, 0x17, 0x04, 0xcb, 0xc8, 
+0x19, 0x2f, 0x2a, 0x95, 0x81, 0x07, 0x09, 0x01, 0x4a, 0xc7, 0xdf, 0x88, 
+0x38, 0x5d, 0x0a, 0x3c, 0x5e, 0x1f, 0xbd, 0x26, 0x24, 0x9c, 0xba, 0x14, 
+0x3e, 0x96, 0xbe, 0x0d, 0xa2, 0xb8, 0x20, 0x0b, 0x67, 0xeb, 0x5b, 0xf0, 
+0xf9, 0x96, 0x2a, 0x48, 0x01, 0x41, 0x76, 0xdb, 0x9b, 0x67, 0xd6, 0x1d, 
+0x7c, 0x67, 0x75, 0xb7, 0x4e, 0x89, 0xf5, 0x29, 0x9b, 0x53, 0x9d, 0x9c, 
+0x6a, 0x28, 0xd0, 0xeb, 0x75, 0x48, 0xcf, 0x4a, 0x42, 0xa0, 0xdd, 0xdf, 
+0x31, 0xec, 0x21, 0xe1, 0x2c, 0xc3, 0x76, 0x80, 0x40, 0x42, 0xc7, 0x2c, 
+0x85, 0x10, 0x97, 0xa8, 0xc2, 0xe6, 0x4f, 0x3f, 0x46, 0xab, 0xbd, 0x05, 
+0x80, 0xa6, 0xfe, 0xd4, 0x17, 0x6b, 0x4d, 0xe8, 0x60, 0xe6, 0xa1, 0xd3, 
+0x9f, 0x63, 0x54, 0xee, 0x3f, 0x04, 0xc5, 0x8f, 0x9e, 0x78, 0x33, 0xe2, 
+0x63, 0x8d, 0x34, 0xed, 0xbd, 0x1d, 0x23, 0x1f, 0x11, 0x2f, 0x85, 0x5c, 
+0x0c, 0xb5, 0x41, 0x1b, 0x58, 0x64, 0x46, 0xbd, 0xad, 0x15, 0x9f, 0x6c, 
+0xd8, 0x07, 0x51, 0x94, 0x64, 0xb7, 0xcd, 0x7e, 0x4f, 0xc3, 0xe1, 0x15, 
+0xef, 0x74, 0xfb, 0x9c, 0x20, 0xe9, 0x77, 0xa7, 0x2e, 0x2b, 0x96, 0xa9, 
+0x55, 0xaa, 0xb5, 0x89, 0xa9, 0xb4, 0x04, 0xf2, 0xf3, 0xb3, 0xe1, 0x73, 
+0xfb, 0xc2, 0xd1, 0x66, 0xc3, 0xe2, 0x19, 0x26, 0x78, 0xcc, 0x86, 0x4b, 
+0x20, 0x74, 0x4e, 0xc2, 0xdf, 0xd3, 0xf3, 0xb8, 0x04, 0x15, 0x36, 0xac, 
+0x2b, 0x87, 0xb3, 0xd5, 0x46, 0x3f, 0x8f, 0xbf, 0x78, 0xb6, 0x72, 0x43, 
+0x26, 0xa8, 0xe5, 0x0c, 0x9b, 0xfa, 0x2c, 0x81, 0x7d, 0x01, 0x08, 0x30, 
+0x76, 0xf2, 0x74, 0x24, 0xc6, 0x67, 0x50, 0xf1, 0xfe, 0xa0, 0xe8, 0x88, 
+0x70, 0xea, 0xe1, 0x0c, 0x10, 0xa9, 0xcb, 0x22, 0x6d, 0xc3, 0x10, 0x06, 
+0x17, 0x5b, 0x60, 0x73, 0xba, 0xf0, 0xfe, 0x47, 0x15, 0xf4, 0x33, 0x59, 
+0x76, 0x39, 0x1c, 0x73, 0xad, 0x87, 0x56, 0x2f, 0xfd, 0xd1, 0x26, 0x45, 
+0xb3, 0x8b, 0x4b, 0x12, 0x11, 0x9b, 0x5b, 0xa3, 0x54, 0xb2, 0xb1, 0x69, 
+0xa6, 0x14, 0x98, 0xf3, 0x72, 0x41, 0x47, 0x96, 0x60, 0x59, 0x36, 0x24, 
+0x38, 0xdc, 0x86, 0x81, 0x30, 0xe4, 0x72, 0x36, 0x5c, 0xce, 0x04, 0x02, 
+0x4d, 0x1c, 0x8b, 0x0d, 0x1f, 0x2d, 0x83, 0xd3, 0x6e, 0x03, 0xc7, 0xa6, 
+0xd4, 0x48, 0xb2, 0x62, 0xb9, 0x2c, 0x5b, 0x17, 0x51, 0x99, 0x18, 0x77, 
+0xf3, 0xaf, 0x91, 0x9c, 0x90, 0x07, 0x5f, 0x44, 0x7c, 0x87, 0xa8, 0xcb, 
+0x91, 0xc8, 0x47, 0xc4, 0x0f, 0xed, 0x6f, 0x81, 0xa3, 0xcd, 0x8d, 0xe5, 
+0xe5, 0xeb, 0x20, 0xca, 0x8c, 0xec, 0x6d, 0x6b, 0x9b, 0x5f, 0x7f, 0x60, 
+0xcd, 0x92, 0x1f, 0x7d, 0x56, 0xd8, 0x34, 0xf8, 0xb6, 0x64, 0x4e, 0x29, 
+0x9d, 0xe3, 0x58, 0x12, 0x93, 0x9e, 0x93, 0x0e, 0x8b, 0x85, 0xde, 0xb4, 
+0xdb, 0x7f, 0x05, 0x40, 0x18, 0x42, 0xe8, 0x3c, 0x0c, 0x82, 0x09, 0x83, 
+0x20, 0x24, 0x04, 0x41, 0x11, 0x07, 0xfc, 0x7b, 0xe5, 0x4b, 0x70, 0x3a, 
+0x1d, 0x20, 0x84, 0xa5, 0x42, 0x05, 0x4c, 0x98, 0x3a, 0x0b, 0x86, 0xb4, 
+0x42, 0xf8, 0xdb, 0x03, 0x97, 0x53, 0x3e, 0x22, 0x5c, 0x16, 0xe5, 0x90, 
+0x60, 0x31, 0x78, 0x2e, 0x0a, 0x21, 0x10, 0xc3, 0x07, 0xf4, 0x41, 0x3b, 
+0xdf, 0x86, 0xd7, 0xde, 0x58, 0x45, 0xcf, 0x89, 0xec, 0x6b, 0xf3, 0x3d, 
+0x5e, 0x7f, 0x78, 0xed, 0xd3, 0x3f, 0xd9, 0xb4, 0x78, 0xca, 0xc0, 0x99, 
+0xe9, 0x1a, 0x25, 0x7f, 0x8a, 0x65, 0x25, 0x6d, 0xb6, 0x25, 0x0b, 0xb9, 
+0x96, 0xc2, 0x70, 0x26, 0x84, 0x20, 0x70, 0x21, 0x08, 0x11, 0x00, 0x4c, 
+0xc8, 0x23, 0xa5, 0x40, 0xe8, 0x77, 0x9c, 0xc6, 0x8b, 0x8f, 0x57, 0xbe, 
+0x00, 0xb7, 0xdd, 0x8e, 0xf1, 0xb7, 0xdc, 0x89, 0x8c, 0xf4, 0xfe, 0xf0, 
+0xfb, 0xf8, 0x48, 0xe4, 0xc3, 0xb5, 0xdf, 0x31, 0xea, 0x22, 0x74, 0x6a, 
+0x25, 0x52, 0xf5, 0xb1, 0xc8, 0xc9, 0x48, 0x86, 0xa3, 0xdd, 0x81, 0xe7, 
+0x5f, 0x7c, 0x1d, 0xa2, 0xc8, 0xc8, 0x3e, 0x0f, 0xff, 0x4c, 0xe3, 0xd1, 
+0xf5, 0x8b, 0x7e, 0xf2, 0x75, 0x81, 0xc4, 0xc2, 0x29, 0xd9, 0xba, 0x58, 
+0xf6, 0x38, 0x03, 0x51, 0x7d, 0x4d, 0xa1, 0x05, 0x16, 0x73, 0x31, 0xbc, 
+0x41, 0x08, 0x1c, 0x17, 0xca, 0x04, 0x36, 0x04, 0x80, 0xbd, 0x02, 0xe0, 
+0x92, 0x33, 0x08, 0x43, 0x20, 0x4a, 0x37, 0x1a, 0x1b, 0xcf, 0x22, 0x33, 
+0x6d, 0x20, 0xfc, 0x7e, 0x01, 0x08, 0x3f, 0xe9, 0x43, 0x6d, 0x8c, 0x56, 
+0x8d, 0x94, 0x04, 0x1d, 0x14, 0x2c, 0x81, 0xc0, 0x0b, 0x10, 0x84, 0x00, 
+0x6c, 0x2d, 0x0e, 0x9c, 0xab, 0xb3, 0x42, 0x54, 0x07, 0x70, 0x68, 0xe7, 
+0x4e, 0x50, 0x26, 0xe0, 0x03, 0xe4, 0x9f, 0x0d, 0x47, 0x3e, 0x9d, 0xff, 
+0xb3, 0x2d, 0x8c, 0x24, 0x5c, 0x37, 0xcd, 0xac, 0x53, 0xf9, 0xbf, 0x21, 
+0x08, 0x28, 0x0b, 0xfa, 0x15, 0xe1, 0x1a, 0x73, 0x7f, 0x78, 0x68, 0x39, 
+0x70, 0x6c, 0x24, 0x13, 0x22, 0x0f, 0x47, 0x72, 0xb9, 0x25, 0x24, 0x94, 
+0x19, 0x6a, 0xa5, 0x02, 0x31, 0x3a, 0x15, 0x88, 0x8c, 0x50, 0x74, 0x65, 
+0x48, 0x10, 0x02, 0x02, 0x64, 0x49, 0x84, 0xd5, 0xe6, 0x44, 0x4d, 0xad, 
+0x15, 0x76, 0xa7, 0x1b, 0xa2, 0x40, 0x01, 0x50, 0xe7, 0x14, 0x04, 0x69, 
+0xd9, 0x1a, 0x54, 0x6e, 0xde, 0x04, 0x49, 0x26, 0xe0, 0x79, 0xe5, 0x2b, 
+0x4d, 0x47, 0x3f, 0x7b, 0xe0, 0x67, 0x5f, 0x19, 0x4a, 0x1a, 0x38, 0xb9, 
+0x50, 0x49, 0xfc, 0x47, 0x88, 0xe4, 0x57, 0x14, 0x0d, 0x1d, 0x8c, 0x82, 
+0xbc, 0x21, 0xf0, 0x38, 0x03, 0xa1, 0x2c, 0x88, 0x80, 0x60, 0x48, 0xa4, 
+0x87, 0x08, 0x1e, 0x13, 0x2a, 0xc0, 0x2f, 0x88, 0x08, 0x04, 0x02, 0xf0, 
+0xd2, 0xe8, 0x7b, 0xbc, 0x7e, 0x88, 0x62, 0xa4, 0x9b, 0xa3, 0xc7, 0x22, 
+0x75, 0x81, 0x7a, 0x58, 0x3c, 0xc3, 0x12, 0xa4, 0x64, 0x72, 0xd8, 0xbe, 
+0xe1, 0x63, 0x48, 0xbc, 0x0c, 0x5e, 0x8a, 0x59, 0x66, 0xab, 0xda, 0x38, 
+0xfb, 0xaa, 0x59, 0x1a, 0x4b, 0x29, 0xbe, 0x69, 0x10, 0xcb, 0xb8, 0xf6, 
+0x42, 0xf2, 0x71, 0x45, 0x43, 0x87, 0x22, 0x31, 0x31, 0x1f, 0xce, 0x16, 
+0x1f, 0x14, 0x0a, 0x45, 0xa8, 0x24, 0x38, 0x96, 0x0b, 0xb6, 0x91, 0x07, 
+0x65, 0x78, 0xb4, 0xc8, 0x50, 0x07, 0x64, 0x50, 0xeb, 0xd8, 0xe5, 0x85, 
+0xc4, 0x8b, 0x11, 0xf1, 0x84, 0x95, 0xa1, 0x4f, 0x93, 0xb1, 0xe9, 0xa3, 
+0x72, 0x88, 0x82, 0x04, 0x20, 0x7e, 0x95, 0xb5, 0x6a, 0xeb, 0x6d, 0x57, 
+0xdd, 0xda, 0xa0, 0x61, 0x60, 0xd9, 0x70, 0x08, 0xfe, 0x2f, 0x64, 0xc9, 
+0xc7, 0x0e, 0x18, 0x31, 0x0a, 0xc9, 0x29, 0x7d, 0xd1, 0xe6, 0xe0, 0xc1, 
+0x71, 0x8a, 0x4b, 0x1e, 0x29, 0x89, 0x48, 0xaf, 0x00, 0xea, 0x61, 0xfd, 
+0xf2, 0x95, 0xe8, 0x4b, 0x97, 0xa2, 0x4f, 0xc5, 0x03, 0x12, 0xe2, 0x0c, 
+0x3c, 0xd6, 0x97, 0xbf, 0x0e, 0x81, 0x97, 0xc0, 0x92, 0xa4, 0xb5, 0xd6, 
+0x63, 0x15, 0xd3, 0xae, 0xda, 0xc5, 0x51, 0x63, 0xd1, 0xb8, 0xd1, 0x02, 
+0x1c, 0x5b, 0x24, 0xd1, 0xcb, 0x0c, 0x1f, 0x37, 0x11, 0x29, 0x29, 0xfd, 
+0xe1, 0x75, 0x4b, 0xe0, 0x14, 0x61, 0x00, 0xb4, 0x1c, 0x2e, 0x8f, 0x15, 
+0xbe, 0x95, 0x01, 0x52, 0x87, 0xf4, 0x0f, 0x8b, 0x17, 0xa1, 0x4b, 0xf2, 
+0xe2, 0xc3, 0x65, 0xcf, 0x83, 0xe7, 0x05, 0x7a, 0x5d, 0xca, 0xe7, 0xcd, 
+0xc7, 0xbe, 0x98, 0x74, 0xd5, 0xaf, 0x0e, 0xa7, 0xf6, 0x1d, 0x3b, 0x49, 
+0x94, 0x6c, 0xeb, 0x25, 0xc9, 0xc7, 0x94, 0x4e, 0x99, 0x06, 0xa3, 0x61, 
+0x10, 0x7c, 0x1e, 0x99, 0x02, 0xb8, 0x02, 0x81, 0x09, 0x65, 0x01, 0x01, 
+0x89, 0x64, 0x40, 0xc7, 0xf4, 0x17, 0x42, 0xbd, 0x81, 0x3a, 0xd1, 0x89, 
+0xf7, 0x96, 0xfe, 0x1d, 0x7e, 0xaf, 0x1f, 0x0a, 0xce, 0xb8, 0xad, 0xb9, 
+0x7a, 0xd7, 0xd8, 0x1e, 0xb3, 0x3c, 0x6e, 0xc8, 0x2f, 0x99, 0xc6, 0xc3, 
+0xfe, 0xa1, 0x28, 0x7a, 0xc9, 0xc4, 0xe9, 0xb3, 0x60, 0x4c, 0x1f, 0x06, 
+0xde, 0x4b, 0x42, 0x99, 0xd0, 0x31, 0x0b, 0x22, 0x25, 0x10, 0x8e, 0x7e, 
+0x44, 0x3c, 0x17, 0xd7, 0x82, 0x15, 0x2f, 0x3e, 0x05, 0x6f, 0x9b, 0x07, 
+0x9c, 0x32, 0xad, 0xd2, 0x5e, 0xbd, 0x6f, 0x44, 0x8f, 0xdb, 0x1f, 0xa0, 
+0xef, 0x73, 0xc3, 0x4c, 0x19, 0xf6, 0xf2, 0x20, 0x84, 0x9b, 0x66, 0xdd, 
+0x8b, 0x0c, 0xd3, 0xf5, 0x10, 0xfd, 0x5c, 0x38, 0x0b, 0xa8, 0x5f, 0x2e, 
+0x03, 0x20, 0x18, 0xfd, 0xa0, 0x8b, 0x21, 0x67, 0xb4, 0x4d, 0x58, 0xb6, 
+0xe4, 0xcf, 0xf0, 0xb8, 0xda, 0xa0, 0x52, 0x19, 0x0f, 0xd8, 0x8e, 0xef, 
+0x1f, 0xd2, 0x63, 0x37, 0x48, 0x24, 0x14, 0xdc, 0x30, 0x1b, 0x62, 0xf3, 
+0x1b, 0xa2, 0xe8, 0x23, 0xd3, 0x67, 0x3f, 0x84, 0x4c, 0xd3, 0x48, 0xc8, 
+0x42, 0x10, 0x82, 0x22, 0xf2, 0xb2, 0x24, 0xcb, 0xa0, 0x1e, 0xae, 0x7d, 
+0x59, 0x5d, 0x87, 0x37, 0x9e, 0x5d, 0x08, 0xb7, 0xa3, 0x15, 0x4a, 0xa5, 
+0xb1, 0xca, 0x7e, 0xe2, 0x60, 0xbf, 0x1e, 0xbf, 0x43, 0x44, 0x9f, 0x77, 
+0xfd, 0x5c, 0x51, 0x6a, 0x7a, 0x59, 0x94, 0x02, 0x98, 0x39, 0x77, 0x01, 
+0xb2, 0x33, 0x4b, 0x40, 0x44, 0x55, 0x24, 0x0b, 0x20, 0x87, 0x87, 0xbd, 
+0x3c, 0x7b, 0x01, 0x4b, 0x17, 0xcf, 0x87, 0xa3, 0xc5, 0x06, 0x95, 0xc2, 
+0x58, 0x6d, 0x3f, 0x79, 0xb0, 0xb0, 0xd7, 0x6c, 0x91, 0x49, 0xca, 0x1f, 
+0x36, 0x8f, 0x17, 0x9a, 0x96, 0x48, 0x12, 0x8f, 0xbb, 0xe7, 0x2d, 0x42, 
+0x4e, 0x66, 0x19, 0x18, 0xa8, 0xc0, 0xb0, 0x1c, 0x00, 0x19, 0x3e, 0x9c, 
+0xc5, 0xab, 0x4f, 0x3f, 0x0c, 0x9b, 0xb5, 0x11, 0x0a, 0xa5, 0xe1, 0xb4, 
+0xe3, 0xe4, 0xe1, 0xbc, 0x5e, 0xb7, 0x47, 0x88, 0x66, 0xc2, 0x9f, 0x78, 
+0xa1, 0xf1, 0x19, 0x10, 0x11, 0xb3, 0x17, 0xfe, 0x0d, 0xe6, 0xcc, 0x52, 
+0x70, 0x8c, 0x16, 0xed, 0xd2, 0x69, 0xbc, 0xfc, 0xd7, 0x79, 0x68, 0xae, 
+0xaf, 0x0d, 0xbe, 0x22, 0x9f, 0x77, 0x9c, 0x39, 0x9a, 0xdb, 0x6b, 0x37, 
+0x49, 0x25, 0xf6, 0x19, 0xf8, 0x14, 0x2f, 0xb6, 0x3e, 0x2e, 0xab, 0x95, 
+0x98, 0x33, 0xff, 0x49, 0x98, 0xd2, 0x73, 0xf1, 0xca, 0xd3, 0x0b, 0x60, 
+0xad, 0x39, 0x07, 0x8e, 0xd3, 0x5f, 0x74, 0x9c, 0xa9, 0xca, 0xec, 0xf5, 
+0xbb, 0xc4, 0x12, 0x0a, 0x86, 0x2d, 0xe6, 0xd1, 0xfa, 0x28, 0x51, 0xb0, 
+0xd0, 0xc7, 0xc5, 0xc1, 0x5e, 0xdf, 0x00, 0x86, 0x89, 0x6b, 0x70, 0x9d, 
+0xf9, 0x3a, 0xbd, 0xf7, 0x6f, 0x93, 0x8b, 0x40, 0x18, 0xbc, 0x58, 0x14, 
+0x3d, 0xbf, 0x87, 0xe0, 0x53, 0x13, 0xc4, 0x54, 0xbb, 0xce, 0x55, 0x15, 
+0xfe, 0x22, 0xf7, 0x09, 0x12, 0x42, 0x58, 0xfa, 0x7f, 0x62, 0x74, 0xa3, 
+0x64, 0x14, 0x40, 0x14, 0x40, 0x14, 0x40, 0x14, 0x40, 0x14, 0x40, 0x14, 
+0x40, 0x14, 0x40, 0x14, 0x40, 0x14, 0x40, 0x14, 0xc0, 0xcf, 0x6e, 0xff, 
+0x01, 0x7e, 0x9f, 0xfd, 0xcc, 0xb3, 0x67, 0xaa, 0xaa, 0x00, 0x00, 0x00, 
+0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82, 
+};
@@ -0,0 +1,316 @@
+/* ================================================================ */
+/**
+ * @file post_bench.c
+ * Benchmark of concurrent posters.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file measures the throughput of posts appended by 1 to
+ * 64 concurrent posters with either append mode (see SMSL_APPEND_MODE in
+ * simple_message_server_logic(1)). Each poster executes the business
+ * logic given as argument once per post, as the spawning server does,
+ * with the request piped to its standard input. The posts go to the
+ * board "post_bench", whose directory is removed before and after each
+ * run. The duplicate filter is disabled, as thousands of posts within
+ * its window would saturate it. It is run by "make bench", the exit
+ * status is EXIT_FAILURE if any post failed.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pwd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define BOARD "post_bench"
+#define POSTS 1024             /* posts per run, divided among the posters */
+#define MAXPOSTERS 64
+#define MAXREQUESTLEN 256
+#define MAXPATHLEN 4096
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+static const char *const modes[] = { "flock", "atomic" };
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Remove the directory of the board
+ *
+ * \param dir zero-terminated string containing the directory [IN]
+ */
+static void remove_board(
+    const char *dir
+    )
+{
+    char path[MAXPATHLEN];
+    struct dirent *entry;
+    DIR *dp;
+
+    if ((dp = opendir(dir)) == NULL)
+    {
+        return;
+    }
+
+    while ((entry = readdir(dp)) != NULL)
+    {
+        if ((strcmp(entry->d_name, ".") != 0) && (strcmp(entry->d_name, "..") != 0))
+        {
+            (void) snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+            (void) unlink(path);
+        }
+    }
+
+    (void) closedir(dp);
+    (void) rmdir(dir);
+}
+
+/**
+ * \brief Post a message by executing the business logic
+ *
+ * \param logic zero-terminated string containing the path of the business logic [IN]
+ * \param poster number of the poster [IN]
+ * \param post number of the post of the poster [IN]
+ *
+ * \retval 0 the business logic accepted the post
+ * \retval -1 otherwise
+ */
+static int post(
+    const char *logic,
+    int poster,
+    int post
+    )
+{
+    char request[MAXREQUESTLEN];
+    int fds[2], fd, status, len;
+    pid_t pid;
+
+    /*
+     * the text is unique, thus no post is rejected as a duplicate
+     */
+    len = snprintf(
+        request,
+        sizeof(request),
+        "board=" BOARD "\nuser=poster%d\npost %d of poster %d of process %ld\n",
+        poster,
+        post,
+        poster,
+        (long) getpid()
+        );
+
+    if ((len < 0) || ((size_t) len >= sizeof(request)) || (pipe(fds) == -1))
+    {
+        return -1;
+    }
+
+    /*
+     * the request is shorter than PIPE_BUF, thus it fits into the pipe
+     */
+    if (write(fds[1], request, (size_t) len) != len)
+    {
+        (void) close(fds[0]);
+        (void) close(fds[1]);
+        return -1;
+    }
+
+    (void) close(fds[1]);
+
+    if ((pid = fork()) == -1)
+    {
+        (void) close(fds[0]);
+        return -1;
+    }
+
+    if (pid == 0)
+    {
+        if (
+            (dup2(fds[0], STDIN_FILENO) == -1) ||
+            ((fd = open("/dev/null", O_WRONLY)) == -1) ||
+            (dup2(fd, STDOUT_FILENO) == -1)
+            )
+        {
+            _exit(EXIT_FAILURE);
+        }
+
+        (void) execl(logic, logic, (char *) NULL);
+        _exit(EXIT_FAILURE);
+    }
+
+    (void) close(fds[0]);
+
+    if (
+        (waitpid(pid, &status, 0) != pid) ||
+        !WIFEXITED(status) ||
+        (WEXITSTATUS(status) != EXIT_SUCCESS)
+        )
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Measure a run of concurrent posters
+ *
+ * \param logic zero-terminated string containing the path of the business logic [IN]
+ * \param mode zero-terminated string containing the append mode [IN]
+ * \param posters number of concurrent posters [IN]
+ * \param dir zero-terminated string containing the directory of the board [IN]
+ *
+ * \return number of failed posts
+ */
+static int run(
+    const char *logic,
+    const char *mode,
+    int posters,
+    const char *dir
+    )
+{
+    struct timespec start, stop;
+    double seconds;
+    int i, j, status, failed = 0;
+    pid_t pid;
+
+    remove_board(dir);
+
+    if (setenv("SMSL_APPEND_MODE", mode, 1) == -1)
+    {
+        return POSTS;
+    }
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; i < posters; i++)
+    {
+        if ((pid = fork()) == -1)
+        {
+            failed += POSTS / posters;
+            continue;
+        }
+
+        if (pid == 0)
+        {
+            for (j = 0; j < POSTS / posters; j++)
+            {
+                if (post(logic, i, j) == -1)
+                {
+                    failed++;
+                }
+            }
+
+            /*
+             * the number of failed posts as exit status
+             */
+            _exit((failed > 255) ? 255 : failed);
+        }
+    }
+
+    while (wait(&status) != -1)
+    {
+        failed += WIFEXITED(status) ? WEXITSTATUS(status) : POSTS / posters;
+    }
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    seconds = (double) (stop.tv_sec - start.tv_sec) +
+        (double) (stop.tv_nsec - start.tv_nsec) / 1e9;
+
+    (void) printf(
+        "%-8s %3d posters %8.0f posts/s %8.1f us/post\n",
+        mode,
+        posters,
+        POSTS / seconds,
+        seconds / POSTS * 1e6 * posters
+        );
+    (void) fflush(stdout);
+
+    remove_board(dir);
+
+    return failed;
+}
+
+/**
+ * \brief Run the benchmark for both append modes
+ *
+ * \param argc the number of arguments [IN]
+ * \param argv the arguments [IN]
+ *
+ * \return EXIT_SUCCESS if all posts were accepted, EXIT_FAILURE otherwise
+ */
+int main(
+    int argc,
+    char **argv
+    )
+{
+    char dir[MAXPATHLEN];
+    struct passwd *pw;
+    size_t i;
+    int posters, failed = 0;
+
+    if (argc != 2)
+    {
+        (void) fprintf(stderr, "usage: %s logic\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if ((pw = getpwuid(getuid())) == NULL)
+    {
+        (void) fprintf(stderr, "%s: unknown user\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    (void) snprintf(dir, sizeof(dir), "%s/public_html/boards/" BOARD, pw->pw_dir);
+
+    if (
+        (setenv("SMSL_BOARDS", BOARD, 1) == -1) ||
+        (setenv("SMSL_DUPLICATE_WINDOW", "0", 1) == -1)
+        )
+    {
+        perror(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < sizeof(modes) / sizeof(*modes); i++)
+    {
+        for (posters = 1; posters <= MAXPOSTERS; posters *= 2)
+        {
+            failed += run(argv[1], modes[i], posters, dir);
+        }
+    }
+
+    if (failed > 0)
+    {
+        (void) fprintf(stderr, "%s: %d posts failed\n", argv[0], failed);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,290 @@
+/* ================================================================ */
+/**
+ * @file post_ring.c
+ * Shared ring of the most recent posts of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the ring of the last PR_SLOTS posts kept in
+ * a shared memory segment. The slots are guarded by sequence locks,
+ * the data is copied while the lock of the slot is held, thus the
+ * copies of a reader are only used if the lock did not change.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <string.h>
+
+#include "post_ring.h"
+#include "shared_segment.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+/*
+ * number of attempts of a reader to copy a slot which is being written
+ */
+#define PR_READ_ATTEMPTS 8
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Find the head of a post store
+ *
+ * The entries are probed starting at the one \a store hashes to. An
+ * unused entry is claimed for \a store if \a claim is non-zero, a
+ * concurrent claim of the same entry by another store moves on to the
+ * next one.
+ *
+ * \param ring the mapped ring [IN]
+ * \param store identity of the post store, not 0 [IN]
+ * \param claim non-zero to claim an unused entry [IN]
+ *
+ * \return pointer to the head of \a store
+ * \retval NULL the head of \a store is not kept
+ */
+static pr_head_t *find_head(
+    pr_ring_t *ring,
+    uint64_t store,
+    int claim
+    )
+{
+    pr_head_t *head;
+    uint64_t held;
+    unsigned int i;
+
+    for (i = 0; i < PR_HEADS; i++)
+    {
+        head = &ring->heads[(store + i) % PR_HEADS];
+        held = __atomic_load_n(&head->store, __ATOMIC_ACQUIRE);
+
+        /*
+         * a failed exchange reloads held with the store which has
+         * claimed the entry meanwhile
+         */
+        if (
+            (held == 0) &&
+            claim &&
+            __atomic_compare_exchange_n(
+                &head->store, &held, store, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+                )
+            )
+        {
+            return head;
+        }
+
+        if (held == store)
+        {
+            return head;
+        }
+
+        if (held == 0)
+        {
+            return NULL;  /* unused, the store has never been published */
+        }
+    }
+
+    return NULL;
+}
+
+pr_ring_t *pr_map(
+    void
+    )
+{
+    return shared_segment_map(PR_SEGMENT, sizeof(pr_ring_t));
+}
+
+void pr_publish(
+    pr_ring_t *ring,
+    uint64_t store,
+    uint64_t seq,
+    const bb_post_t *post,
+    const char *entry,
+    size_t entry_len
+    )
+{
+    pr_slot_t *slot = &ring->slots[seq % PR_SLOTS];
+    uint32_t lock = __atomic_load_n(&slot->lock, __ATOMIC_RELAXED);
+    pr_head_t *head;
+    uint64_t seen;
+    char *p;
+
+    if (
+        ((lock & 1U) == 0) &&
+        __atomic_compare_exchange_n(
+            &slot->lock, &lock, lock + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED
+            )
+        )
+    {
+        /*
+         * the odd lock has to be visible before any of the data
+         */
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        if ((slot->store != store) || (slot->seq < seq))
+        {
+            slot->store = store;
+            slot->seq = seq;
+            slot->timestamp = post->timestamp;
+            slot->user_len = (uint32_t) post->user_len;
+            slot->img_len = (post->img != NULL) ? (uint32_t) post->img_len : 0;
+            slot->msg_len = (uint32_t) post->msg_len;
+
+            p = slot->data;
+            memcpy(p, post->user, post->user_len + 1);
+            p += post->user_len + 1;
+
+            if (post->img != NULL)
+            {
+                memcpy(p, post->img, post->img_len + 1);
+                p += post->img_len + 1;
+            }
+
+            memcpy(p, post->msg, post->msg_len + 1);
+
+            slot->entry_len = (uint32_t) entry_len;
+            memcpy(slot->entry, entry, entry_len);
+        }
+
+        __atomic_store_n(&slot->lock, lock + 2, __ATOMIC_RELEASE);
+    }
+
+    if ((head = find_head(ring, store, 1)) == NULL)
+    {
+        return;  /* the subscribers look at the post store */
+    }
+
+    /*
+     * concurrent writers publish in any order, the head only moves on.
+     */
+    seen = __atomic_load_n(&head->seq, __ATOMIC_RELAXED);
+
+    while (
+        (seen < seq) &&
+        !__atomic_compare_exchange_n(
+            &head->seq, &seen, seq, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED
+            )
+        )
+    {
+        ;  /* seen has been reloaded by the failed exchange */
+    }
+}
+
+int pr_head(
+    pr_ring_t *ring,
+    uint64_t store,
+    uint64_t *seq
+    )
+{
+    pr_head_t *head;
+
+    if ((head = find_head(ring, store, 0)) == NULL)
+    {
+        return -1;
+    }
+
+    *seq = __atomic_load_n(&head->seq, __ATOMIC_ACQUIRE);
+
+    return 0;
+}
+
+int pr_read(
+    pr_ring_t *ring,
+    uint64_t store,
+    uint64_t seq,
+    bb_record_t *record,
+    char *entry,
+    size_t *entry_len
+    )
+{
+    const pr_slot_t *slot = &ring->slots[seq % PR_SLOTS];
+    uint32_t lock, user_len, img_len, msg_len, len;
+    uint64_t slot_store, slot_seq, timestamp;
+    size_t data_len;
+    int attempt;
+
+    for (attempt = 0; attempt < PR_READ_ATTEMPTS; attempt++)
+    {
+        if (((lock = __atomic_load_n(&slot->lock, __ATOMIC_ACQUIRE)) & 1U) != 0)
+        {
+            continue;  /* being written */
+        }
+
+        slot_store = slot->store;
+        slot_seq = slot->seq;
+        timestamp = slot->timestamp;
+        user_len = slot->user_len;
+        img_len = slot->img_len;
+        msg_len = slot->msg_len;
+        len = slot->entry_len;
+
+        /*
+         * the values may be torn, thus keep the copies within bounds
+         * before the lock tells whether they are valid.
+         */
+        data_len = (size_t) user_len + img_len + msg_len + 3;
+
+        if ((data_len > sizeof(slot->data)) || (len > sizeof(slot->entry)))
+        {
+            data_len = 0;
+            len = 0;
+        }
+
+        if (record != NULL)
+        {
+            memcpy(record->buf, slot->data, data_len);
+        }
+
+        if (entry != NULL)
+        {
+            memcpy(entry, slot->entry, len);
+        }
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slot->lock, __ATOMIC_RELAXED) != lock)
+        {
+            continue;  /* modified while copying */
+        }
+
+        if ((slot_seq != seq) || (slot_store != store) || (data_len == 0))
+        {
+            return -1;
+        }
+
+        if (record != NULL)
+        {
+            record->post.timestamp = timestamp;
+            record->post.user = record->buf;
+            record->post.user_len = user_len;
+            record->post.img = (img_len > 0) ? record->buf + user_len + 1 : NULL;
+            record->post.img_len = img_len;
+            record->post.msg = record->buf + user_len + 1 + ((img_len > 0) ? img_len + 1 : 0);
+            record->post.msg_len = msg_len;
+        }
+
+        if (entry_len != NULL)
+        {
+            *entry_len = len;
+        }
+
+        return 0;
+    }
+
+    return -1;
+}
+
+/*
+ * =================================================================== eof ==
+ */
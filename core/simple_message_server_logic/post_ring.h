@@ -0,0 +1,178 @@
+/* ================================================================ */
+/**
+ * @file post_ring.h
+ * Shared ring of the most recent posts of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the ring of the last PR_SLOTS posts which is
+ * kept in a shared memory segment (see shared_segment_map()), thus
+ * every instance of the business logic finds the recent posts and
+ * their rendered content entries without reading the post store.
+ *
+ * Post \a seq (the sequence number, counting from 1) is kept in slot
+ * \a seq % PR_SLOTS. Every slot is guarded by a sequence lock: the
+ * writer makes the lock odd while it modifies the slot and even again
+ * afterwards, a reader copies the slot and retries if the lock was odd
+ * or has changed meanwhile. Neither side issues a system call. A slot
+ * being written by another post is skipped by the writer, the readers
+ * fall back to the post store in that case.
+ *
+ * The sequence number of the newest post is kept for each of up to
+ * PR_HEADS post stores (e.g. the boards), thus a subscriber only looks
+ * at the head of its own store. An entry is claimed by the first post
+ * of a store and never given up, the heads of further stores are not
+ * kept.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef POST_RING_H
+#define POST_RING_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bulletin_board.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define PR_SEGMENT "post_ring"   /* name of the shared memory segment */
+#define PR_SLOTS 256U            /* number of posts kept in the ring */
+#define PR_HEADS 64U             /* number of post stores whose head is kept */
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A slot of the ring. The strings of the post are stored one after the
+ * other in \a data, each of them zero-terminated.
+ */
+typedef struct
+{
+    uint32_t lock;       /* sequence lock, odd while the slot is written */
+    uint32_t entry_len;  /* length of the rendered content entry */
+    uint64_t store;      /* identity of the post store, see pr_read() */
+    uint64_t seq;        /* sequence number of the post, 0 if empty */
+    uint64_t timestamp;
+    uint32_t user_len;
+    uint32_t img_len;    /* 0 if the post has no image */
+    uint32_t msg_len;
+    char data[BB_MAXPOSTLEN + 3];
+    char entry[BB_MAXENTRYLEN];
+} pr_slot_t;
+
+/**
+ * The head of a post store.
+ */
+typedef struct
+{
+    uint64_t store;      /* identity of the post store, 0 if unused */
+    uint64_t seq;        /* sequence number of the newest post published */
+} pr_head_t;
+
+/**
+ * The ring as mapped from the shared memory segment.
+ */
+typedef struct
+{
+    pr_slot_t slots[PR_SLOTS];
+    pr_head_t heads[PR_HEADS];
+} pr_ring_t;
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Map the ring
+ *
+ * Map the ring shared by all instances of the business logic, it is
+ * created empty if it does not exist yet.
+ *
+ * \return address of the mapped ring
+ * \retval NULL failed, errno is set
+ */
+extern pr_ring_t *pr_map(void);
+
+/**
+ * \brief Publish a post
+ *
+ * Store the post \a post with the sequence number \a seq and its
+ * rendered content entry \a entry in the ring. The post is not stored
+ * if its slot is being written concurrently or already holds a newer
+ * post.
+ *
+ * \param ring the mapped ring [IN]
+ * \param store identity of the post store holding the post [IN]
+ * \param seq sequence number of the post (counting from 1) [IN]
+ * \param post the post, must not exceed BB_MAXPOSTLEN [IN]
+ * \param entry the rendered content entry of the post [IN]
+ * \param entry_len length of \a entry, at most BB_MAXENTRYLEN [IN]
+ */
+extern void pr_publish(
+    pr_ring_t *ring,
+    uint64_t store,
+    uint64_t seq,
+    const bb_post_t *post,
+    const char *entry,
+    size_t entry_len
+    );
+
+/**
+ * \brief Get the sequence number of the newest post of a post store
+ *
+ * \param ring the mapped ring [IN]
+ * \param store identity of the post store [IN]
+ * \param seq set to the sequence number of the newest post published
+ *        for \a store [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 the head of \a store is not kept
+ */
+extern int pr_head(pr_ring_t *ring, uint64_t store, uint64_t *seq);
+
+/**
+ * \brief Read a post from the ring
+ *
+ * Take a consistent copy of the post with the sequence number \a seq.
+ * The post is only found if it has been published for the post store
+ * \a store, thus a recreated store never yields the posts of its
+ * predecessor.
+ *
+ * \param ring the mapped ring [IN]
+ * \param store identity of the post store [IN]
+ * \param seq sequence number of the post (counting from 1) [IN]
+ * \param record filled with the post, may be NULL [OUT]
+ * \param entry buffer of BB_MAXENTRYLEN bytes for the rendered content
+ *        entry, may be NULL [OUT]
+ * \param entry_len set to the length of \a entry, may be NULL [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 the ring does not hold the post
+ */
+extern int pr_read(
+    pr_ring_t *ring,
+    uint64_t store,
+    uint64_t seq,
+    bb_record_t *record,
+    char *entry,
+    size_t *entry_len
+    );
+
+#endif /* POST_RING_H */
+
+/*
+ * =================================================================== eof ==
+ */
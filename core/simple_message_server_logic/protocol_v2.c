@@ -0,0 +1,230 @@
+/* ================================================================ */
+/**
+ * @file protocol_v2.c
+ * Binary framing of the bulletin board protocol, version 2.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the encoding and decoding of the frames of
+ * protocol version 2. Integers are assembled byte by byte, thus
+ * neither the alignment of the buffers nor the byte order of the host
+ * matter.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <string.h>
+
+#include "protocol_v2.h"
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+void smp2_put_u32(
+    void *buf,
+    uint32_t value
+    )
+{
+    unsigned char *p = buf;
+
+    p[0] = (unsigned char) (value >> 24);
+    p[1] = (unsigned char) (value >> 16);
+    p[2] = (unsigned char) (value >> 8);
+    p[3] = (unsigned char) value;
+}
+
+void smp2_put_u64(
+    void *buf,
+    uint64_t value
+    )
+{
+    unsigned char *p = buf;
+
+    smp2_put_u32(p, (uint32_t) (value >> 32));
+    smp2_put_u32(p + 4, (uint32_t) value);
+}
+
+uint32_t smp2_get_u32(
+    const void *buf
+    )
+{
+    const unsigned char *p = buf;
+
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) |
+        ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+uint64_t smp2_get_u64(
+    const void *buf
+    )
+{
+    const unsigned char *p = buf;
+
+    return ((uint64_t) smp2_get_u32(p) << 32) | smp2_get_u32(p + 4);
+}
+
+/**
+ * \brief Encode a 16 bit integer in network byte order
+ *
+ * \param buf buffer of at least 2 bytes [OUT]
+ * \param value the value to be encoded [IN]
+ */
+static void put_u16(
+    unsigned char *buf,
+    uint16_t value
+    )
+{
+    buf[0] = (unsigned char) (value >> 8);
+    buf[1] = (unsigned char) value;
+}
+
+/**
+ * \brief Decode a 16 bit integer in network byte order
+ *
+ * \param buf buffer of at least 2 bytes [IN]
+ *
+ * \return the decoded value
+ */
+static uint16_t get_u16(
+    const unsigned char *buf
+    )
+{
+    return (uint16_t) ((buf[0] << 8) | buf[1]);
+}
+
+int smp2_is_frame(
+    const void *buf,
+    size_t len
+    )
+{
+    return (len >= SMP2_MAGIC_LEN) &&
+        (memcmp(buf, SMP2_MAGIC, SMP2_MAGIC_LEN) == 0);
+}
+
+size_t smp2_encode_header(
+    void *buf,
+    uint8_t type,
+    uint32_t len
+    )
+{
+    unsigned char *p = buf;
+
+    memcpy(p, SMP2_MAGIC, SMP2_MAGIC_LEN);
+    p[4] = SMP2_VERSION;
+    p[5] = type;
+    put_u16(p + 6, 0);
+    smp2_put_u32(p + 8, len);
+
+    return SMP2_HEADER_LEN;
+}
+
+int smp2_decode_header(
+    const void *buf,
+    smp2_header_t *header
+    )
+{
+    const unsigned char *p = buf;
+
+    if (
+        !smp2_is_frame(p, SMP2_HEADER_LEN) ||
+        (p[4] != SMP2_VERSION)
+        )
+    {
+        return -1;
+    }
+
+    header->version = p[4];
+    header->type = p[5];
+    header->flags = get_u16(p + 6);
+    header->len = smp2_get_u32(p + 8);
+
+    return 0;
+}
+
+size_t smp2_encode_field_header(
+    void *buf,
+    uint16_t tag,
+    uint32_t len
+    )
+{
+    unsigned char *p = buf;
+
+    put_u16(p, tag);
+    smp2_put_u32(p + 2, len);
+
+    return SMP2_FIELD_HEADER_LEN;
+}
+
+size_t smp2_encode_field(
+    void *buf,
+    uint16_t tag,
+    const void *value,
+    uint32_t len
+    )
+{
+    unsigned char *p = buf;
+
+    (void) smp2_encode_field_header(p, tag, len);
+
+    if (len > 0)
+    {
+        memcpy(p + SMP2_FIELD_HEADER_LEN, value, len);
+    }
+
+    return SMP2_FIELD_HEADER_LEN + (size_t) len;
+}
+
+void smp2_decode_field_header(
+    const void *buf,
+    smp2_field_t *field
+    )
+{
+    const unsigned char *p = buf;
+
+    field->tag = get_u16(p);
+    field->len = smp2_get_u32(p + 2);
+    field->value = p + SMP2_FIELD_HEADER_LEN;
+}
+
+int smp2_next_field(
+    const unsigned char **pos,
+    const unsigned char *end,
+    smp2_field_t *field
+    )
+{
+    const unsigned char *p = *pos;
+
+    if (p == end)
+    {
+        return 0;
+    }
+
+    if ((size_t) (end - p) < SMP2_FIELD_HEADER_LEN)
+    {
+        return -1;
+    }
+
+    smp2_decode_field_header(p, field);
+
+    if (field->len > (size_t) (end - field->value))
+    {
+        return -1;
+    }
+
+    *pos = field->value + field->len;
+
+    return 1;
+}
+
+/*
+ * =================================================================== eof ==
+ */
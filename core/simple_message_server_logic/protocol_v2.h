@@ -0,0 +1,282 @@
+/* ================================================================ */
+/**
+ * @file protocol_v2.h
+ * Binary framing of the bulletin board protocol, version 2.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the encoding and decoding of the frames of
+ * protocol version 2, which is shared by the business logic and the
+ * client.
+ *
+ * Every frame starts with a fixed header of SMP2_HEADER_LEN bytes, all
+ * integers are unsigned and in network byte order:
+ *
+ * <pre>
+ *  0: magic   "SMP2" (4 bytes)
+ *  4: version SMP2_VERSION (1 byte)
+ *  5: type    SMP2_FRAME_* (1 byte)
+ *  6: flags   0, ignored by the receiver (2 bytes)
+ *  8: length  of the payload following the header (4 bytes)
+ * </pre>
+ *
+ * The payload is a sequence of fields, each of them consisting of a
+ * tag (2 bytes), the length of the value (4 bytes) and the value. The
+ * receiver skips fields with unknown tags.
+ *
+ * A request is a single SMP2_FRAME_REQUEST frame. The response is a
+ * SMP2_FRAME_STATUS frame followed by one SMP2_FRAME_FILE frame per
+ * file and is terminated by an empty SMP2_FRAME_END frame. A batch
+ * request carries one SMP2_FIELD_RECORD field per post instead of the
+ * fields user, img and msg, the status frame of its response holds the
+ * status of every record. A connection
+ * carries any number of requests until the client closes its side, the
+ * responses are sent in the order of the requests.
+ *
+ * If a request carries the field accept_framing with the value
+ * "chunked", the posts of a delta, search or posts by user response are
+ * sent as chunked file, i.e. rendered while the file is written: its
+ * file frame carries the field chunked and an empty data field, the
+ * contents follow in SMP2_FRAME_CHUNK frames. An empty chunk frame ends
+ * the file.
+ *
+ * If a post request carries the field accept_ranges, the status frame
+ * of the response carries the field id. Should the connection be
+ * closed before the response has been received completely, a request
+ * carrying the field resume with this id, the name of the file being
+ * received and the number of bytes received of it repeats the response
+ * without the files preceding this file. Its frame carries the field
+ * offset and the rest of the file only.
+ *
+ * A subscription request ends the sequence of requests: the server
+ * answers it like a delta request and pushes a further response for
+ * every commit of new posts until the client closes the connection.
+ *
+ * A server which does not support version 2 rejects the request (the
+ * header contains non-printable characters) with a version 1 response,
+ * i.e. one starting with "status=". The client retries the request
+ * with version 1 on a new connection in that case.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef PROTOCOL_V2_H
+#define PROTOCOL_V2_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define SMP2_MAGIC "SMP2"
+#define SMP2_MAGIC_LEN 4
+#define SMP2_VERSION 2
+
+#define SMP2_HEADER_LEN 12        /* length of the frame header */
+#define SMP2_FIELD_HEADER_LEN 6   /* length of tag and length of a field */
+
+/*
+ * limits of a batch request, i.e. a request frame of record fields
+ */
+#define SMP2_MAXBATCHLEN (1024U * 1024U)  /* maximum payload length */
+#define SMP2_MAXBATCHRECORDS 1024U        /* maximum number of records */
+
+/*
+ * maximum length of the name of a board (field board resp. line "board="
+ * of version 1)
+ */
+#define SMP2_MAXBOARDLEN 32U
+
+/*
+ * frame types
+ */
+#define SMP2_FRAME_REQUEST 1      /* client request */
+#define SMP2_FRAME_STATUS  2      /* execution status of the request */
+#define SMP2_FRAME_FILE    3      /* a file of the response */
+#define SMP2_FRAME_END     4      /* end of the response, no payload */
+#define SMP2_FRAME_CHUNK   5      /* part of a chunked file, the payload is the data */
+
+/*
+ * fields of SMP2_FRAME_REQUEST
+ */
+#define SMP2_FIELD_USER            1   /* name of the posting user */
+#define SMP2_FIELD_IMG             2   /* image URL, optional */
+#define SMP2_FIELD_MSG             3   /* message */
+#define SMP2_FIELD_SINCE           4   /* delta request, 8 byte sequence number */
+#define SMP2_FIELD_METRICS         5   /* metrics request, empty */
+#define SMP2_FIELD_ACCEPT_ENCODING 6   /* accepted encoding, e.g. "deflate" */
+#define SMP2_FIELD_RECORD          7   /* batch record, value: fields user, img, msg */
+#define SMP2_FIELD_SUBSCRIBE       8   /* subscription, empty or 8 byte sequence number */
+#define SMP2_FIELD_SEARCH          9   /* search request, words to be searched for */
+#define SMP2_FIELD_POSTS_BY        10  /* posts by user request, name of the user */
+#define SMP2_FIELD_BOARD           11  /* name of the board, optional (default board) */
+#define SMP2_FIELD_ACCEPT_RANGES   12  /* the client resumes interrupted responses, empty */
+#define SMP2_FIELD_RESUME          13  /* resume request, 8 byte id, 8 byte offset and name of the file */
+#define SMP2_FIELD_ACCEPT_FRAMING  14  /* accepted framing of files, e.g. "chunked" */
+
+/*
+ * fields of SMP2_FRAME_STATUS
+ */
+#define SMP2_FIELD_STATUS 16      /* 4 byte execution status */
+#define SMP2_FIELD_SEQ    17      /* 8 byte sequence number (delta, search and posts by request) */
+#define SMP2_FIELD_RECORD_STATUS 18  /* 4 byte execution status of every batch record */
+#define SMP2_FIELD_DROPPED       19  /* 8 byte number of posts skipped (subscription) */
+#define SMP2_FIELD_ID            20  /* 8 byte id of a resumable response (post) */
+
+/*
+ * fields of SMP2_FRAME_FILE, SMP2_FIELD_DATA is always the last one
+ */
+#define SMP2_FIELD_NAME     32    /* name of the file */
+#define SMP2_FIELD_ENCODING 33    /* encoding of the data, optional */
+#define SMP2_FIELD_DATA     34    /* contents of the file */
+#define SMP2_FIELD_OFFSET   35    /* 8 byte offset of the data within the file (resumed response) */
+#define SMP2_FIELD_CHUNKED  36    /* the data follows in chunk frames, empty */
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A decoded frame header.
+ */
+typedef struct
+{
+    uint8_t version;
+    uint8_t type;
+    uint16_t flags;
+    uint32_t len;      /* length of the payload */
+} smp2_header_t;
+
+/**
+ * A decoded field. \a value points into the decoded payload.
+ */
+typedef struct
+{
+    uint16_t tag;
+    uint32_t len;
+    const unsigned char *value;
+} smp2_field_t;
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Check whether a buffer starts with a frame of version 2
+ *
+ * \param buf pointer to the received data [IN]
+ * \param len number of bytes pointed to by \a buf [IN]
+ *
+ * \retval 1 \a buf starts with the magic of version 2
+ * \retval 0 otherwise
+ */
+extern int smp2_is_frame(const void *buf, size_t len);
+
+/**
+ * \brief Encode a frame header
+ *
+ * \param buf buffer of at least SMP2_HEADER_LEN bytes [OUT]
+ * \param type type of the frame [IN]
+ * \param len length of the payload [IN]
+ *
+ * \return SMP2_HEADER_LEN
+ */
+extern size_t smp2_encode_header(void *buf, uint8_t type, uint32_t len);
+
+/**
+ * \brief Decode a frame header
+ *
+ * \param buf buffer of at least SMP2_HEADER_LEN bytes [IN]
+ * \param header the decoded header [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 wrong magic or version
+ */
+extern int smp2_decode_header(const void *buf, smp2_header_t *header);
+
+/**
+ * \brief Encode the tag and length of a field
+ *
+ * The value of \a len bytes is expected right after the encoded bytes.
+ *
+ * \param buf buffer of at least SMP2_FIELD_HEADER_LEN bytes [OUT]
+ * \param tag tag of the field [IN]
+ * \param len length of the value [IN]
+ *
+ * \return SMP2_FIELD_HEADER_LEN
+ */
+extern size_t smp2_encode_field_header(void *buf, uint16_t tag, uint32_t len);
+
+/**
+ * \brief Encode a field
+ *
+ * \param buf buffer of at least SMP2_FIELD_HEADER_LEN + \a len bytes [OUT]
+ * \param tag tag of the field [IN]
+ * \param value pointer to the value [IN]
+ * \param len length of the value [IN]
+ *
+ * \return number of bytes encoded
+ */
+extern size_t smp2_encode_field(
+    void *buf, uint16_t tag, const void *value, uint32_t len
+    );
+
+/**
+ * \brief Decode the tag and length of a field
+ *
+ * \param buf buffer of at least SMP2_FIELD_HEADER_LEN bytes [IN]
+ * \param field the decoded field, \a value is set to the byte following
+ *        the tag and length [OUT]
+ */
+extern void smp2_decode_field_header(const void *buf, smp2_field_t *field);
+
+/**
+ * \brief Decode the next field of a payload
+ *
+ * \param pos position of the next field, advanced past the field [IN/OUT]
+ * \param end end of the payload [IN]
+ * \param field the decoded field [OUT]
+ *
+ * \retval 1 a field was decoded
+ * \retval 0 end of the payload
+ * \retval -1 the field exceeds the payload
+ */
+extern int smp2_next_field(
+    const unsigned char **pos, const unsigned char *end, smp2_field_t *field
+    );
+
+/**
+ * \brief Encode a 32 bit integer in network byte order
+ */
+extern void smp2_put_u32(void *buf, uint32_t value);
+
+/**
+ * \brief Encode a 64 bit integer in network byte order
+ */
+extern void smp2_put_u64(void *buf, uint64_t value);
+
+/**
+ * \brief Decode a 32 bit integer in network byte order
+ */
+extern uint32_t smp2_get_u32(const void *buf);
+
+/**
+ * \brief Decode a 64 bit integer in network byte order
+ */
+extern uint64_t smp2_get_u64(const void *buf);
+
+#endif /* PROTOCOL_V2_H */
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,237 @@
+/* ================================================================ */
+/**
+ * @file protocol_v2_test.c
+ * Round-trip tests of the framing of protocol version 2.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file checks that every encoder of protocol_v2.h is
+ * undone by its decoder, and that the decoders reject frames with a
+ * bad magic or version and fields exceeding the payload. It is run by
+ * "make test" and prints every failed check, the exit status is
+ * EXIT_FAILURE if any check failed.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "protocol_v2.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+static unsigned int failures = 0;
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Record the outcome of a check
+ *
+ * \param ok non-zero if the check passed [IN]
+ * \param expr zero-terminated string containing the checked expression [IN]
+ * \param line line of the check [IN]
+ */
+static void check(
+    int ok,
+    const char *expr,
+    int line
+    )
+{
+    if (!ok)
+    {
+        (void) fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, line, expr);
+        failures++;
+    }
+}
+
+/**
+ * \brief Round-trip the 32 and 64 bit integers
+ */
+static void test_integers(
+    void
+    )
+{
+    static const uint32_t values32[] = { 0, 1, 0xffU, 0x100U, 0x12345678U, 0x80000000U, UINT32_MAX };
+    static const uint64_t values64[] = { 0, 1, 0xffffffffU, 0x100000000U, 0x0123456789abcdefU, UINT64_MAX };
+    unsigned char buf[8];
+    size_t i;
+
+    for (i = 0; i < sizeof(values32) / sizeof(*values32); i++)
+    {
+        smp2_put_u32(buf, values32[i]);
+        CHECK(smp2_get_u32(buf) == values32[i]);
+    }
+
+    for (i = 0; i < sizeof(values64) / sizeof(*values64); i++)
+    {
+        smp2_put_u64(buf, values64[i]);
+        CHECK(smp2_get_u64(buf) == values64[i]);
+    }
+
+    /*
+     * network byte order, the most significant byte first
+     */
+    smp2_put_u32(buf, 0x01020304U);
+    CHECK(memcmp(buf, "\x01\x02\x03\x04", 4) == 0);
+    smp2_put_u64(buf, 0x0102030405060708U);
+    CHECK(memcmp(buf, "\x01\x02\x03\x04\x05\x06\x07\x08", 8) == 0);
+}
+
+/**
+ * \brief Round-trip the frame header and reject bad ones
+ */
+static void test_header(
+    void
+    )
+{
+    unsigned char buf[SMP2_HEADER_LEN];
+    smp2_header_t header;
+
+    CHECK(smp2_encode_header(buf, SMP2_FRAME_FILE, 0xfedcba98U) == SMP2_HEADER_LEN);
+    CHECK(smp2_is_frame(buf, sizeof(buf)));
+    CHECK(smp2_decode_header(buf, &header) == 0);
+    CHECK(header.version == SMP2_VERSION);
+    CHECK(header.type == SMP2_FRAME_FILE);
+    CHECK(header.flags == 0);
+    CHECK(header.len == 0xfedcba98U);
+
+    CHECK(smp2_encode_header(buf, SMP2_FRAME_END, 0) == SMP2_HEADER_LEN);
+    CHECK(smp2_decode_header(buf, &header) == 0);
+    CHECK((header.type == SMP2_FRAME_END) && (header.len == 0));
+
+    /*
+     * too short to carry the magic
+     */
+    CHECK(!smp2_is_frame(buf, SMP2_MAGIC_LEN - 1));
+
+    buf[0] = 's';
+    CHECK(!smp2_is_frame(buf, sizeof(buf)));
+    CHECK(smp2_decode_header(buf, &header) == -1);
+
+    /*
+     * a version 1 request is no frame either
+     */
+    memcpy(buf, "user=tes", SMP2_MAGIC_LEN + 4);
+    CHECK(!smp2_is_frame(buf, sizeof(buf)));
+    CHECK(smp2_decode_header(buf, &header) == -1);
+
+    (void) smp2_encode_header(buf, SMP2_FRAME_REQUEST, 0);
+    buf[4] = SMP2_VERSION + 1;
+    CHECK(smp2_decode_header(buf, &header) == -1);
+}
+
+/**
+ * \brief Round-trip a payload of fields and reject truncated ones
+ */
+static void test_fields(
+    void
+    )
+{
+    static const char user[] = "tester";
+    static const char msg[] = "hello, world";
+    unsigned char buf[64];
+    const unsigned char *pos, *end;
+    smp2_field_t field;
+    size_t len = 0;
+
+    len += smp2_encode_field(buf + len, SMP2_FIELD_USER, user, sizeof(user) - 1);
+    len += smp2_encode_field(buf + len, SMP2_FIELD_METRICS, NULL, 0);
+    len += smp2_encode_field(buf + len, SMP2_FIELD_MSG, msg, sizeof(msg) - 1);
+    CHECK(len == 3 * SMP2_FIELD_HEADER_LEN + sizeof(user) - 1 + sizeof(msg) - 1);
+
+    pos = buf;
+    end = buf + len;
+
+    CHECK(smp2_next_field(&pos, end, &field) == 1);
+    CHECK((field.tag == SMP2_FIELD_USER) && (field.len == sizeof(user) - 1));
+    CHECK(memcmp(field.value, user, sizeof(user) - 1) == 0);
+
+    CHECK(smp2_next_field(&pos, end, &field) == 1);
+    CHECK((field.tag == SMP2_FIELD_METRICS) && (field.len == 0));
+
+    CHECK(smp2_next_field(&pos, end, &field) == 1);
+    CHECK((field.tag == SMP2_FIELD_MSG) && (field.len == sizeof(msg) - 1));
+    CHECK(memcmp(field.value, msg, sizeof(msg) - 1) == 0);
+
+    CHECK(smp2_next_field(&pos, end, &field) == 0);
+    CHECK(pos == end);
+
+    /*
+     * the header of a field followed by its value equals an encoded field
+     */
+    CHECK(smp2_encode_field_header(buf + len, SMP2_FIELD_USER, sizeof(user) - 1) == SMP2_FIELD_HEADER_LEN);
+    memcpy(buf + len + SMP2_FIELD_HEADER_LEN, user, sizeof(user) - 1);
+    CHECK(memcmp(buf + len, buf, SMP2_FIELD_HEADER_LEN + sizeof(user) - 1) == 0);
+
+    smp2_decode_field_header(buf, &field);
+    CHECK((field.tag == SMP2_FIELD_USER) && (field.value == buf + SMP2_FIELD_HEADER_LEN));
+
+    /*
+     * the value exceeds the payload by a single byte
+     */
+    pos = buf;
+    end = buf + SMP2_FIELD_HEADER_LEN + sizeof(user) - 2;
+    CHECK(smp2_next_field(&pos, end, &field) == -1);
+    CHECK(pos == buf);
+
+    /*
+     * the payload ends within the tag and length
+     */
+    pos = buf;
+    end = buf + SMP2_FIELD_HEADER_LEN - 1;
+    CHECK(smp2_next_field(&pos, end, &field) == -1);
+
+    /*
+     * a length beyond the address space of the payload
+     */
+    (void) smp2_encode_field_header(buf, SMP2_FIELD_MSG, UINT32_MAX);
+    pos = buf;
+    end = buf + sizeof(buf);
+    CHECK(smp2_next_field(&pos, end, &field) == -1);
+}
+
+/**
+ * \brief Run the tests
+ *
+ * \return EXIT_SUCCESS if all checks passed, EXIT_FAILURE otherwise
+ */
+int main(
+    void
+    )
+{
+    test_integers();
+    test_header();
+    test_fields();
+
+    if (failures > 0)
+    {
+        (void) fprintf(stderr, "%s: %u checks failed\n", __FILE__, failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,1219 @@
+/* ================================================================ */
+/**
+ * @file search_index.c
+ * Full-text search index of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the inverted index over the messages of
+ * the post store (see search_index.h for the file layout).
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+
+#include "search_index.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MAXPATHLEN _POSIX_PATH_MAX
+
+#define SI_MAGIC "SMSI"
+#define SI_MAGIC_LEN 4
+#define SI_VERSION 1U
+#define SI_HEADER_LEN 32
+#define SI_TERM_ENTRY_LEN 32
+
+#define MAXVARINTLEN 10      /* bytes of a 64 bit varint */
+#define MAXENTITYLEN 10      /* characters of an HTML entity between & and ; */
+#define MAXUPDATEPOSTS 4096U /* posts added by one rewrite of the index */
+#define INITIALPAIRS 1024U
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A mapped index file. \a base is NULL if there is no valid index, it
+ * covers no posts then.
+ */
+typedef struct
+{
+    const unsigned char *base;
+    size_t len;
+    uint64_t posts;
+    uint64_t terms;
+} index_t;
+
+/**
+ * A term of a post to be added to the index.
+ */
+typedef struct
+{
+    char term[SI_MAXTERMLEN];
+    uint32_t term_len;
+    uint64_t post;
+} pair_t;
+
+/**
+ * A term of the updated index: the postings of the current index (if
+ * any) followed by the posts of the pairs [\a first, \a next).
+ */
+typedef struct
+{
+    const char *term;
+    uint32_t term_len;
+    const unsigned char *postings;  /* NULL for a new term */
+    uint32_t postings_len;
+    uint64_t postings_last;         /* last post of \a postings */
+    uint32_t len;                   /* length of the merged postings */
+    uint32_t count;                 /* number of posts of the merged postings */
+    uint64_t last;                  /* last post of the merged postings */
+    size_t first;
+    size_t next;
+} merge_t;
+
+/**
+ * A position in the postings of a term.
+ */
+typedef struct
+{
+    const unsigned char *pos;
+    const unsigned char *end;
+    uint64_t post;       /* current post */
+    uint32_t count;
+    int valid;           /* 0 past the last post */
+} cursor_t;
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Build the path of a file of the index
+ *
+ * \param file buffer for the path [OUT]
+ * \param len size of the buffer pointed to by \a file [IN]
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param name zero-terminated string containing the name of the file [IN]
+ *
+ * \retval 0 success
+ * \retval -1 the path is too long, errno is set
+ */
+static int make_path(
+    char *file,
+    size_t len,
+    const char *dir,
+    const char *name
+    )
+{
+    int cnt;
+
+    cnt = snprintf(file, len, "%s/%s", dir, name);
+
+    if ((cnt < 0) || ((size_t) cnt >= len))
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    return 0;
+}
+
+static uint32_t get_u32(
+    const unsigned char *p
+    )
+{
+    uint32_t value;
+
+    memcpy(&value, p, sizeof(value));
+
+    return value;
+}
+
+static uint64_t get_u64(
+    const unsigned char *p
+    )
+{
+    uint64_t value;
+
+    memcpy(&value, p, sizeof(value));
+
+    return value;
+}
+
+/**
+ * \brief Encode a varint
+ *
+ * \param buf buffer of at least MAXVARINTLEN bytes [OUT]
+ * \param value the value to be encoded [IN]
+ *
+ * \return number of bytes encoded
+ */
+static size_t put_varint(
+    unsigned char *buf,
+    uint64_t value
+    )
+{
+    size_t len = 0;
+
+    while (value >= 0x80U)
+    {
+        buf[len++] = (unsigned char) (value | 0x80U);
+        value >>= 7;
+    }
+
+    buf[len++] = (unsigned char) value;
+
+    return len;
+}
+
+/**
+ * \brief Get the length of the encoded varint
+ */
+static size_t varint_len(
+    uint64_t value
+    )
+{
+    size_t len = 1;
+
+    while (value >= 0x80U)
+    {
+        value >>= 7;
+        len++;
+    }
+
+    return len;
+}
+
+/**
+ * \brief Decode a varint
+ *
+ * \param pos position of the varint, advanced past it [IN/OUT]
+ * \param end end of the buffer [IN]
+ * \param value the decoded value [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 the varint is truncated or too long
+ */
+static int get_varint(
+    const unsigned char **pos,
+    const unsigned char *end,
+    uint64_t *value
+    )
+{
+    const unsigned char *p = *pos;
+    unsigned int shift = 0;
+
+    *value = 0;
+
+    while ((p < end) && (shift < 7 * MAXVARINTLEN))
+    {
+        *value |= (uint64_t) (*p & 0x7FU) << shift;
+
+        if ((*p++ & 0x80U) == 0)
+        {
+            *pos = p;
+            return 0;
+        }
+
+        shift += 7;
+    }
+
+    return -1;
+}
+
+static int is_term_char(
+    unsigned char c
+    )
+{
+    return ((c >= 'a') && (c <= 'z')) ||
+        ((c >= 'A') && (c <= 'Z')) ||
+        ((c >= '0') && (c <= '9')) ||
+        (c >= 0x80U);
+}
+
+size_t si_next_term(
+    const char **pos,
+    const char *end,
+    char *term
+    )
+{
+    const char *p = *pos;
+    const char *q;
+    size_t len = 0;
+
+    while (p < end)
+    {
+        if (*p == '<')
+        {
+            /*
+             * skip the tag, the messages contain whitelisted tags only
+             */
+            while ((p < end) && (*p != '>'))
+            {
+                p++;
+            }
+            continue;
+        }
+
+        if (*p == '&')
+        {
+            for (q = p + 1; (q < end) && (q - p <= MAXENTITYLEN); q++)
+            {
+                if (!is_term_char((unsigned char) *q) && (*q != '#'))
+                {
+                    break;
+                }
+            }
+
+            if ((q < end) && (*q == ';'))
+            {
+                p = q + 1;
+                continue;
+            }
+        }
+
+        if (is_term_char((unsigned char) *p))
+        {
+            break;
+        }
+
+        p++;
+    }
+
+    for (; (p < end) && is_term_char((unsigned char) *p); p++)
+    {
+        if (len < SI_MAXTERMLEN)
+        {
+            term[len++] = ((*p >= 'A') && (*p <= 'Z')) ? (char) (*p - 'A' + 'a') : *p;
+        }
+    }
+
+    *pos = p;
+
+    return len;
+}
+
+/**
+ * \brief Compare two terms
+ */
+static int compare_terms(
+    const char *a,
+    size_t a_len,
+    const char *b,
+    size_t b_len
+    )
+{
+    int cmp = memcmp(a, b, (a_len < b_len) ? a_len : b_len);
+
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+
+    return (a_len > b_len) - (a_len < b_len);
+}
+
+/**
+ * \brief Order pairs by term and post, for qsort()
+ */
+static int compare_pairs(
+    const void *a,
+    const void *b
+    )
+{
+    const pair_t *pa = a;
+    const pair_t *pb = b;
+    int cmp = compare_terms(pa->term, pa->term_len, pb->term, pb->term_len);
+
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+
+    return (pa->post > pb->post) - (pa->post < pb->post);
+}
+
+/**
+ * \brief Map the index file
+ *
+ * An index which is missing, malformed, covers more posts than the
+ * store holds or has been built for another store is treated as empty.
+ *
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param store the opened store [IN]
+ * \param count number of posts in the store [IN]
+ * \param index the mapped index [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int map_index(
+    const char *dir,
+    bb_store_t *store,
+    uint64_t count,
+    index_t *index
+    )
+{
+    char file[MAXPATHLEN];
+    struct stat statbuf;
+    void *base;
+    int fd, saved_errno;
+
+    index->base = NULL;
+    index->len = 0;
+    index->posts = 0;
+    index->terms = 0;
+
+    if (make_path(file, sizeof(file), dir, SI_INDEX_FILE) == -1)
+    {
+        return -1;
+    }
+
+    if ((fd = open(file, O_RDONLY)) == -1)
+    {
+        return (errno == ENOENT) ? 0 : -1;
+    }
+
+    if (fstat(fd, &statbuf) == -1)
+    {
+        saved_errno = errno;
+        (void) close(fd);
+        errno = saved_errno;
+        return -1;
+    }
+
+    if (statbuf.st_size < SI_HEADER_LEN)
+    {
+        (void) close(fd);
+        return 0;
+    }
+
+    base = mmap(NULL, (size_t) statbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    saved_errno = errno;
+    (void) close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        errno = saved_errno;
+        return -1;
+    }
+
+    index->base = base;
+    index->len = (size_t) statbuf.st_size;
+    index->posts = get_u64(index->base + 16);
+    index->terms = get_u64(index->base + 24);
+
+    if (
+        (memcmp(index->base, SI_MAGIC, SI_MAGIC_LEN) != 0) ||
+        (get_u32(index->base + 4) != SI_VERSION) ||
+        (get_u64(index->base + 8) != bb_id(store)) ||
+        (index->posts > count) ||
+        (index->terms > (index->len - SI_HEADER_LEN) / SI_TERM_ENTRY_LEN)
+        )
+    {
+        (void) munmap(base, index->len);
+        index->base = NULL;
+        index->len = 0;
+        index->posts = 0;
+        index->terms = 0;
+    }
+
+    return 0;
+}
+
+static void unmap_index(
+    index_t *index
+    )
+{
+    if (index->base != NULL)
+    {
+        (void) munmap((void *) index->base, index->len);
+        index->base = NULL;
+    }
+}
+
+/**
+ * \brief Get the term of an entry of the term table
+ *
+ * \param index the mapped index [IN]
+ * \param i number of the entry [IN]
+ * \param len set to the length of the term [OUT]
+ *
+ * \return pointer to the term
+ * \retval NULL the entry is malformed
+ */
+static const char *get_term(
+    const index_t *index,
+    uint64_t i,
+    uint32_t *len
+    )
+{
+    const unsigned char *entry = index->base + SI_HEADER_LEN + i * SI_TERM_ENTRY_LEN;
+    uint32_t offset = get_u32(entry + 24);
+
+    *len = get_u32(entry + 28);
+
+    if ((offset > index->len) || (*len > index->len - offset))
+    {
+        return NULL;
+    }
+
+    return (const char *) index->base + offset;
+}
+
+/**
+ * \brief Get the postings of an entry of the term table
+ *
+ * \param index the mapped index [IN]
+ * \param i number of the entry [IN]
+ * \param merge filled with the postings, their number of posts and last
+ *        post [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 the entry is malformed
+ */
+static int get_postings(
+    const index_t *index,
+    uint64_t i,
+    merge_t *merge
+    )
+{
+    const unsigned char *entry = index->base + SI_HEADER_LEN + i * SI_TERM_ENTRY_LEN;
+    uint64_t offset = get_u64(entry);
+
+    merge->postings_last = get_u64(entry + 8);
+    merge->postings_len = get_u32(entry + 16);
+    merge->count = get_u32(entry + 20);
+
+    if (
+        (merge->count == 0) ||
+        (offset > index->len) ||
+        (merge->postings_len > index->len - offset)
+        )
+    {
+        return -1;
+    }
+
+    merge->postings = index->base + offset;
+
+    return 0;
+}
+
+/**
+ * \brief Find a term in the index
+ *
+ * \param index the mapped index [IN]
+ * \param term the term [IN]
+ * \param len length of the term [IN]
+ * \param cursor positioned at the first post of the term [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 the term is not found
+ */
+static int find_term(
+    const index_t *index,
+    const char *term,
+    size_t len,
+    cursor_t *cursor
+    )
+{
+    uint64_t low = 0, high = index->terms, mid;
+    const char *t;
+    uint32_t t_len;
+    merge_t merge;
+    int cmp;
+
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+
+        if ((t = get_term(index, mid, &t_len)) == NULL)
+        {
+            return -1;  /* malformed index */
+        }
+
+        if ((cmp = compare_terms(t, t_len, term, len)) == 0)
+        {
+            if (get_postings(index, mid, &merge) == -1)
+            {
+                return -1;
+            }
+
+            cursor->pos = merge.postings;
+            cursor->end = merge.postings + merge.postings_len;
+            cursor->count = merge.count;
+            cursor->valid = (get_varint(&cursor->pos, cursor->end, &cursor->post) == 0);
+
+            return 0;
+        }
+
+        if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Advance a cursor to the next post
+ */
+static void next_post(
+    cursor_t *cursor
+    )
+{
+    uint64_t delta;
+
+    if (
+        (cursor->pos >= cursor->end) ||
+        (get_varint(&cursor->pos, cursor->end, &delta) == -1) ||
+        (delta == 0)
+        )
+    {
+        cursor->valid = 0;
+        return;
+    }
+
+    cursor->post += delta;
+}
+
+/**
+ * \brief Collect the terms of posts not covered by the index
+ *
+ * \param store the opened store [IN]
+ * \param from number of the first post [IN]
+ * \param to number of the post following the last one [IN]
+ * \param pairs set to the sorted distinct pairs of term and post,
+ *        allocated with malloc() [OUT]
+ * \param count set to the number of pairs [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int collect_pairs(
+    bb_store_t *store,
+    uint64_t from,
+    uint64_t to,
+    pair_t **pairs,
+    size_t *count
+    )
+{
+    bb_record_t record;
+    pair_t *p = NULL, *tmp;
+    size_t n = 0, size = 0, i, j;
+    const char *pos, *end;
+    char term[SI_MAXTERMLEN];
+    size_t len;
+    uint64_t post;
+
+    for (post = from; post < to; post++)
+    {
+        if (bb_read(store, post, &record) == -1)
+        {
+            free(p);
+            return -1;
+        }
+
+        pos = record.post.msg;
+        end = record.post.msg + record.post.msg_len;
+
+        while ((len = si_next_term(&pos, end, term)) > 0)
+        {
+            if (n == size)
+            {
+                size = (size == 0) ? INITIALPAIRS : 2 * size;
+
+                if ((tmp = realloc(p, size * sizeof(*p))) == NULL)
+                {
+                    free(p);
+                    errno = ENOMEM;
+                    return -1;
+                }
+
+                p = tmp;
+            }
+
+            memcpy(p[n].term, term, len);
+            p[n].term_len = (uint32_t) len;
+            p[n].post = post;
+            n++;
+        }
+    }
+
+    if (n > 0)
+    {
+        qsort(p, n, sizeof(*p), compare_pairs);
+    }
+
+    /*
+     * a term occurring several times in a post is indexed once
+     */
+    for (i = 0, j = 0; i < n; i++)
+    {
+        if ((j == 0) || (compare_pairs(&p[j - 1], &p[i]) != 0))
+        {
+            p[j++] = p[i];
+        }
+    }
+
+    *pairs = p;
+    *count = j;
+
+    return 0;
+}
+
+/**
+ * \brief Write the postings of a term of the updated index
+ *
+ * \param fp the index file [IN]
+ * \param merge the term [IN]
+ * \param pairs the new pairs [IN]
+ */
+static void write_postings(
+    FILE *fp,
+    const merge_t *merge,
+    const pair_t *pairs
+    )
+{
+    unsigned char buf[MAXVARINTLEN];
+    uint64_t last = 0;
+    size_t i;
+    int first = (merge->postings == NULL);
+
+    if (!first)
+    {
+        (void) fwrite(merge->postings, 1, merge->postings_len, fp);
+        last = merge->postings_last;
+    }
+
+    for (i = merge->first; i < merge->next; i++)
+    {
+        (void) fwrite(buf, 1, put_varint(buf, first ? pairs[i].post : pairs[i].post - last), fp);
+        last = pairs[i].post;
+        first = 0;
+    }
+}
+
+/**
+ * \brief Write the updated index
+ *
+ * Merge the terms of the posts from the number of posts covered by \a
+ * index up to \a to (excl.) into the index and replace the index file.
+ *
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param store the opened store [IN]
+ * \param index the current index [IN]
+ * \param to number of the post following the last one to be added [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int write_index(
+    const char *dir,
+    bb_store_t *store,
+    const index_t *index,
+    uint64_t to
+    )
+{
+    char file[MAXPATHLEN], tmp_file[MAXPATHLEN];
+    unsigned char header[SI_HEADER_LEN];
+    unsigned char entry[SI_TERM_ENTRY_LEN];
+    pair_t *pairs = NULL;
+    merge_t *merges = NULL, *m;
+    size_t pair_count = 0, merge_count = 0, i, j;
+    uint64_t old = 0, terms_offset, postings_offset, value;
+    const char *term;
+    uint32_t term_len, u32;
+    FILE *fp;
+    int cmp, saved_errno;
+    int rc = -1;
+
+    if (
+        (make_path(file, sizeof(file), dir, SI_INDEX_FILE) == -1) ||
+        (make_path(tmp_file, sizeof(tmp_file), dir, SI_INDEX_TMP_FILE) == -1) ||
+        (collect_pairs(store, index->posts, to, &pairs, &pair_count) == -1)
+        )
+    {
+        return -1;
+    }
+
+    if ((merges = malloc((index->terms + pair_count + 1) * sizeof(*merges))) == NULL)
+    {
+        free(pairs);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    /*
+     * merge the sorted term table with the sorted pairs
+     */
+    i = 0;
+
+    while ((old < index->terms) || (i < pair_count))
+    {
+        m = &merges[merge_count];
+        m->postings = NULL;
+        m->postings_len = 0;
+        m->postings_last = 0;
+        m->count = 0;
+        m->first = i;
+        m->next = i;
+
+        if (old < index->terms)
+        {
+            if ((term = get_term(index, old, &term_len)) == NULL)
+            {
+                old++;
+                continue;  /* a malformed entry is dropped */
+            }
+
+            cmp = (i < pair_count) ?
+                compare_terms(term, term_len, pairs[i].term, pairs[i].term_len) : -1;
+        }
+        else
+        {
+            term = pairs[i].term;
+            term_len = pairs[i].term_len;
+            cmp = 1;
+        }
+
+        if (cmp <= 0)
+        {
+            /*
+             * the new posts follow all posts covered by the index
+             */
+            if (
+                (get_postings(index, old, m) == -1) ||
+                ((cmp == 0) && (m->postings_last >= pairs[i].post))
+                )
+            {
+                old++;
+                continue;
+            }
+
+            old++;
+        }
+        else
+        {
+            term = pairs[i].term;
+            term_len = pairs[i].term_len;
+        }
+
+        m->term = term;
+        m->term_len = term_len;
+        m->len = m->postings_len;
+        m->last = m->postings_last;
+
+        if (cmp >= 0)
+        {
+            for (
+                j = i;
+                (j < pair_count) &&
+                    (compare_terms(term, term_len, pairs[j].term, pairs[j].term_len) == 0);
+                j++
+                )
+            {
+                value = (m->postings == NULL && j == i) ? pairs[j].post : pairs[j].post - m->last;
+                m->len += (uint32_t) varint_len(value);
+                m->count++;
+                m->last = pairs[j].post;
+            }
+
+            m->next = j;
+            i = j;
+        }
+
+        merge_count++;
+    }
+
+    /*
+     * the postings of a term of the current index are copied as they
+     * are, the posts of the new pairs are appended.
+     */
+    terms_offset = SI_HEADER_LEN + (uint64_t) merge_count * SI_TERM_ENTRY_LEN;
+    postings_offset = terms_offset;
+
+    for (j = 0; j < merge_count; j++)
+    {
+        postings_offset += merges[j].term_len;
+    }
+
+    if (postings_offset > UINT32_MAX)
+    {
+        errno = EFBIG;
+        goto out;
+    }
+
+    if ((fp = fopen(tmp_file, "w")) == NULL)
+    {
+        goto out;
+    }
+
+    memcpy(header, SI_MAGIC, SI_MAGIC_LEN);
+    u32 = SI_VERSION;
+    memcpy(header + 4, &u32, sizeof(u32));
+    value = bb_id(store);
+    memcpy(header + 8, &value, sizeof(value));
+    memcpy(header + 16, &to, sizeof(to));
+    value = merge_count;
+    memcpy(header + 24, &value, sizeof(value));
+    (void) fwrite(header, 1, sizeof(header), fp);
+
+    for (j = 0; j < merge_count; j++)
+    {
+        m = &merges[j];
+
+        memcpy(entry, &postings_offset, sizeof(postings_offset));
+        memcpy(entry + 8, &m->last, sizeof(m->last));
+        memcpy(entry + 16, &m->len, sizeof(m->len));
+        memcpy(entry + 20, &m->count, sizeof(m->count));
+        u32 = (uint32_t) terms_offset;
+        memcpy(entry + 24, &u32, sizeof(u32));
+        memcpy(entry + 28, &m->term_len, sizeof(m->term_len));
+        (void) fwrite(entry, 1, sizeof(entry), fp);
+
+        terms_offset += m->term_len;
+        postings_offset += m->len;
+    }
+
+    for (j = 0; j < merge_count; j++)
+    {
+        (void) fwrite(merges[j].term, 1, merges[j].term_len, fp);
+    }
+
+    for (j = 0; j < merge_count; j++)
+    {
+        write_postings(fp, &merges[j], pairs);
+    }
+
+    if (ferror(fp))
+    {
+        saved_errno = errno;
+        (void) fclose(fp);
+        (void) unlink(tmp_file);
+        errno = saved_errno;
+        goto out;
+    }
+
+    if (fclose(fp) == EOF)
+    {
+        saved_errno = errno;
+        (void) unlink(tmp_file);
+        errno = saved_errno;
+        goto out;
+    }
+
+    /*
+     * readers keep the previous file mapped until they are done
+     */
+    if (rename(tmp_file, file) == -1)
+    {
+        saved_errno = errno;
+        (void) unlink(tmp_file);
+        errno = saved_errno;
+        goto out;
+    }
+
+    rc = 0;
+
+out:
+    saved_errno = errno;
+    free(merges);
+    free(pairs);
+    errno = saved_errno;
+
+    return rc;
+}
+
+int si_update(
+    const char *dir,
+    bb_store_t *store,
+    uint64_t pending
+    )
+{
+    char file[MAXPATHLEN];
+    index_t index;
+    int64_t count;
+    int fd, saved_errno;
+    int rc = 0;
+
+    if ((count = bb_count(store)) == -1)
+    {
+        return -1;
+    }
+
+    if (map_index(dir, store, (uint64_t) count, &index) == -1)
+    {
+        return -1;
+    }
+
+    unmap_index(&index);
+
+    if (((uint64_t) count == index.posts) || ((uint64_t) count - index.posts < pending))
+    {
+        return 0;
+    }
+
+    if (
+        (make_path(file, sizeof(file), dir, SI_LOCK_FILE) == -1) ||
+        ((fd = open(file, O_RDWR | O_CREAT, 0644)) == -1)
+        )
+    {
+        return -1;
+    }
+
+    if (flock(fd, LOCK_EX | LOCK_NB) == -1)
+    {
+        saved_errno = errno;
+        (void) close(fd);
+        errno = saved_errno;
+
+        return (errno == EWOULDBLOCK) ? 0 : -1;  /* another process updates */
+    }
+
+    /*
+     * the index may have been updated in the meantime, a large number
+     * of posts (e.g. after the index has been removed) is added in
+     * several steps.
+     */
+    for (;;)
+    {
+        if (map_index(dir, store, (uint64_t) count, &index) == -1)
+        {
+            rc = -1;
+            break;
+        }
+
+        if (((uint64_t) count == index.posts) || ((uint64_t) count - index.posts < pending))
+        {
+            unmap_index(&index);
+            break;
+        }
+
+        rc = write_index(
+            dir,
+            store,
+            &index,
+            ((uint64_t) count - index.posts > MAXUPDATEPOSTS) ?
+                index.posts + MAXUPDATEPOSTS : (uint64_t) count
+            );
+        unmap_index(&index);
+
+        if (rc == -1)
+        {
+            break;
+        }
+    }
+
+    saved_errno = errno;
+    (void) flock(fd, LOCK_UN);
+    (void) close(fd);
+    errno = saved_errno;
+
+    return rc;
+}
+
+int si_search(
+    const char *dir,
+    bb_store_t *store,
+    const char *query,
+    size_t query_len,
+    size_t max,
+    uint64_t **matches,
+    size_t *count
+    )
+{
+    char terms[SI_MAXQUERYTERMS][SI_MAXTERMLEN];
+    size_t term_lens[SI_MAXQUERYTERMS];
+    cursor_t cursors[SI_MAXQUERYTERMS];
+    char term[SI_MAXTERMLEN];
+    bb_record_t record;
+    index_t index;
+    const char *pos = query, *end = query + query_len;
+    uint64_t *found, *result;
+    uint64_t total = 0, post, posts;
+    uint32_t mask;
+    size_t n = 0, len, i, driver = 0;
+    int64_t store_count;
+    int saved_errno, ok;
+
+    *matches = NULL;
+    *count = 0;
+
+    while ((n < SI_MAXQUERYTERMS) && ((len = si_next_term(&pos, end, term)) > 0))
+    {
+        memcpy(terms[n], term, len);
+        term_lens[n++] = len;
+    }
+
+    if (n == 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (max == 0)
+    {
+        return 0;
+    }
+
+    if ((store_count = bb_count(store)) == -1)
+    {
+        return -1;
+    }
+
+    posts = (uint64_t) store_count;
+
+    /*
+     * the newest matches are kept in a ring of max entries
+     */
+    if ((found = malloc(max * sizeof(*found))) == NULL)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (map_index(dir, store, posts, &index) == -1)
+    {
+        free(found);
+        return -1;
+    }
+
+    /*
+     * intersect the postings, driven by the term with the fewest posts
+     */
+    ok = (index.base != NULL);
+
+    for (i = 0; ok && (i < n); i++)
+    {
+        ok = (find_term(&index, terms[i], term_lens[i], &cursors[i]) == 0);
+
+        if (ok && (cursors[i].count < cursors[driver].count))
+        {
+            driver = i;
+        }
+    }
+
+    while (ok && cursors[driver].valid && (cursors[driver].post < index.posts))
+    {
+        post = cursors[driver].post;
+
+        for (i = 0; ok && (i < n); i++)
+        {
+            while (cursors[i].valid && (cursors[i].post < post))
+            {
+                next_post(&cursors[i]);
+            }
+
+            ok = cursors[i].valid;
+        }
+
+        for (i = 0; ok && (i < n) && (cursors[i].post == post); i++)
+        {
+            ;
+        }
+
+        if (ok && (i == n))
+        {
+            found[total++ % max] = post;
+        }
+
+        next_post(&cursors[driver]);
+    }
+
+    /*
+     * search the posts not covered by the index directly
+     */
+    for (post = index.posts; post < posts; post++)
+    {
+        if (bb_read(store, post, &record) == -1)
+        {
+            saved_errno = errno;
+            unmap_index(&index);
+            free(found);
+            errno = saved_errno;
+            return -1;
+        }
+
+        pos = record.post.msg;
+        end = record.post.msg + record.post.msg_len;
+        mask = 0;
+
+        while ((len = si_next_term(&pos, end, term)) > 0)
+        {
+            for (i = 0; i < n; i++)
+            {
+                if (compare_terms(term, len, terms[i], term_lens[i]) == 0)
+                {
+                    mask |= 1U << i;
+                }
+            }
+        }
+
+        if (mask == (1U << n) - 1)
+        {
+            found[total++ % max] = post;
+        }
+    }
+
+    unmap_index(&index);
+
+    if (total <= max)
+    {
+        *matches = found;
+        *count = (size_t) total;
+        return 0;
+    }
+
+    /*
+     * unroll the ring, its oldest entry is the next one to be replaced
+     */
+    if ((result = malloc(max * sizeof(*result))) == NULL)
+    {
+        free(found);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    i = (size_t) (total % max);
+    memcpy(result, found + i, (max - i) * sizeof(*result));
+    memcpy(result + (max - i), found, i * sizeof(*result));
+    free(found);
+
+    *matches = result;
+    *count = max;
+
+    return 0;
+}
+
+/*
+ * =================================================================== eof ==
+ */
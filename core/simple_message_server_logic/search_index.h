@@ -0,0 +1,140 @@
+/* ================================================================ */
+/**
+ * @file search_index.h
+ * Full-text search index of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the inverted index over the messages of the
+ * post store. The index file maps every term to the sorted list of the
+ * numbers of the posts containing it (its postings). It covers the
+ * first posts of the store, the posts appended since are indexed by
+ * \a si_update() in bulk and scanned directly by \a si_search() until
+ * then.
+ *
+ * Layout of the index file (native byte order):
+ *
+ * <pre>
+ *  0: magic   "SMSI" (4 bytes)
+ *  4: uint32_t version SI_VERSION
+ *  8: uint64_t identity of the post store, see bb_id()
+ * 16: uint64_t number of posts covered by the index
+ * 24: uint64_t number of terms
+ * 32: term table, one entry of SI_TERM_ENTRY_LEN bytes per term sorted
+ *     by term:
+ *       0: uint64_t offset of the postings in the file
+ *       8: uint64_t number of the last post of the postings
+ *      16: uint32_t length of the postings
+ *      20: uint32_t number of posts in the postings
+ *      24: uint32_t offset of the term in the file
+ *      28: uint32_t length of the term
+ *     the terms (not zero-terminated) and the postings follow.
+ * </pre>
+ *
+ * The postings of a term are varints (7 bits per byte, least
+ * significant first, the high bit marks a following byte): the number
+ * of the first post followed by the differences to the respective
+ * previous post. The file is written anew and renamed into place on
+ * every update, readers map it and never see a partial file.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bulletin_board.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define SI_INDEX_FILE "bulletin_board_search.idx"
+#define SI_INDEX_TMP_FILE "bulletin_board_search.idx.tmp"
+#define SI_LOCK_FILE "bulletin_board_search.lock"
+
+#define SI_MAXTERMLEN 32     /* longer terms are truncated */
+#define SI_MAXQUERYTERMS 16  /* maximum number of terms of a query */
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Get the next term of a text
+ *
+ * A term is a sequence of ASCII letters and digits and non-ASCII bytes,
+ * ASCII letters are converted to lower case. HTML tags and entities
+ * are skipped.
+ *
+ * \param pos position in the text, advanced past the term [IN/OUT]
+ * \param end end of the text [IN]
+ * \param term buffer of SI_MAXTERMLEN bytes for the term [OUT]
+ *
+ * \return length of the term
+ * \retval 0 there are no more terms
+ */
+extern size_t si_next_term(const char **pos, const char *end, char *term);
+
+/**
+ * \brief Update the index
+ *
+ * Add the posts of the store which are not covered by the index yet,
+ * if there are at least \a pending of them. The update is skipped if
+ * another process is updating the index at the same time.
+ *
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param store the opened store [IN]
+ * \param pending minimum number of posts not covered by the index [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+extern int si_update(const char *dir, bb_store_t *store, uint64_t pending);
+
+/**
+ * \brief Search the posts of the store
+ *
+ * Find the posts whose messages contain all terms of \a query. The
+ * postings of the index are intersected, the posts not covered by the
+ * index are read from the store and searched directly.
+ *
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param store the opened store [IN]
+ * \param query the query [IN]
+ * \param query_len length of \a query [IN]
+ * \param max maximum number of posts to be returned [IN]
+ * \param matches set to the numbers of the newest matching posts
+ *        (counting from 0) in ascending order, allocated with malloc()
+ *        [OUT]
+ * \param count set to the number of posts in \a matches [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set (EINVAL: the query has no term)
+ */
+extern int si_search(
+    const char *dir,
+    bb_store_t *store,
+    const char *query,
+    size_t query_len,
+    size_t max,
+    uint64_t **matches,
+    size_t *count
+    );
+
+#endif /* SEARCH_INDEX_H */
+
+/*
+ * =================================================================== eof ==
+ */
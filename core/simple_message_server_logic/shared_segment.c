@@ -0,0 +1,113 @@
+/* ================================================================ */
+/**
+ * @file shared_segment.c
+ * Shared memory segments of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the helpers for the POSIX shared memory
+ * segments used by the business logic.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "shared_segment.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MAXSEGMENTNAMELEN 64
+
+/*
+ * the segments are private to the user running the business logic
+ */
+#define SEGMENT_NAME_FORMAT "/simple_message_server_logic.%lu.%s"
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+void *shared_segment_map(
+    const char *name,
+    size_t size
+    )
+{
+    char segment[MAXSEGMENTNAMELEN];
+    struct stat statbuf;
+    void *addr;
+    int fd, cnt, saved_errno;
+
+    cnt = snprintf(
+        segment,
+        sizeof(segment),
+        SEGMENT_NAME_FORMAT,
+        (unsigned long) getuid(),
+        name
+        );
+
+    if ((cnt < 0) || ((size_t) cnt >= sizeof(segment)))
+    {
+        errno = ENAMETOOLONG;
+        return NULL;
+    }
+
+    if ((fd = shm_open(segment, O_RDWR | O_CREAT, 0600)) == -1)
+    {
+        return NULL;
+    }
+
+    /*
+     * concurrent creators only ever grow the segment, thus a segment
+     * which is already in use is never truncated.
+     */
+    if (
+        (fstat(fd, &statbuf) == -1) ||
+        (
+            ((size_t) statbuf.st_size < size) &&
+            (ftruncate(fd, (off_t) size) == -1)
+            )
+        )
+    {
+        saved_errno = errno;
+        (void) close(fd);
+        errno = saved_errno;
+        return NULL;
+    }
+
+    addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    saved_errno = errno;
+    (void) close(fd);  /* the mapping stays valid */
+    errno = saved_errno;
+
+    return (addr == MAP_FAILED) ? NULL : addr;
+}
+
+void shared_segment_unmap(
+    void *addr,
+    size_t size
+    )
+{
+    (void) munmap(addr, size);
+}
+
+/*
+ * =================================================================== eof ==
+ */
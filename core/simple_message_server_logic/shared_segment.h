@@ -0,0 +1,59 @@
+/* ================================================================ */
+/**
+ * @file shared_segment.h
+ * Shared memory segments of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the helpers for the POSIX shared memory
+ * segments which outlive a single run of the business logic, e.g. the
+ * counters and histograms reported by the metrics request.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef SHARED_SEGMENT_H
+#define SHARED_SEGMENT_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Map a shared memory segment
+ *
+ * Map the shared memory segment \a name of the calling user. The
+ * segment is created if it does not exist yet; newly created (or
+ * enlarged) parts of the segment are filled with zeros.
+ *
+ * \param name zero-terminated string containing the name of the segment [IN]
+ * \param size size of the segment in bytes [IN]
+ *
+ * \return address of the mapped segment
+ * \retval NULL failed, errno is set
+ */
+extern void *shared_segment_map(const char *name, size_t size);
+
+/**
+ * \brief Unmap a shared memory segment
+ *
+ * \param addr address returned by shared_segment_map() [IN]
+ * \param size size passed to shared_segment_map() [IN]
+ */
+extern void shared_segment_unmap(void *addr, size_t size);
+
+#endif /* SHARED_SEGMENT_H */
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,286 @@
+/* ================================================================ */
+/**
+ * @file simple_message_board_render.c
+ * Render pages of the bulletin board from the binary post store.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This program renders a range of pages of the bulletin board as HTML
+ * content entries. Page 1 holds the newest posts. Thanks to the index
+ * of the post store only the posts of the requested pages are read.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <error.h>
+
+#include "bulletin_board.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MAXPATHLEN _POSIX_PATH_MAX
+#define DEFAULT_PAGE_SIZE 50UL
+
+#define ERROR_EXIT(format, ...)						\
+  error_at_line(EXIT_FAILURE, errno, __FILE__, __LINE__, format, ## __VA_ARGS__)
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+/*
+ * global storage for content of argv[0]
+ */
+static const char *cmd = "<not yet set>";
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Print a usage message
+ *
+ * Prints a usage message to \a stream and terminate program with \a exit_code
+ *
+ * \param fp stdio stream to write usage message to [IN]
+ * \param exit_code exit code returned to the environment [IN]
+ */
+static void usage(
+    FILE *fp,
+    int exit_code
+    )
+{
+    (void) fprintf(
+        fp,
+        "usage: %s [options]\n"
+        "options:\n"
+        "\t-d, --dir <dir>           directory of the post store "
+        "(default ~/public_html)\n"
+        "\t-s, --page-size <posts>   number of posts per page (default %lu)\n"
+        "\t-p, --pages <first[:last]> pages to render, page 1 holds the "
+        "newest posts (default 1)\n"
+        "\t-h, --help\n",
+        cmd,
+        DEFAULT_PAGE_SIZE
+        );
+
+    exit(exit_code);
+}
+
+/**
+ * \brief Convert a string into a positive number
+ *
+ * \param s zero-terminated string to be converted [IN]
+ * \param endp set to the first character after the number [OUT]
+ *
+ * \return the number
+ * \retval 0 \a s does not start with a positive number
+ */
+static unsigned long parse_positive(
+    const char *s,
+    char **endp
+    )
+{
+    unsigned long value;
+
+    errno = 0;
+    value = strtoul(s, endp, 10);
+
+    if ((errno != 0) || (*endp == s) || (*s == '-'))
+    {
+        return 0;
+    }
+
+    return value;
+}
+
+/**
+ * \brief Get the number of posts older than the newest pages
+ *
+ * \param count total number of posts [IN]
+ * \param pages number of the newest pages [IN]
+ * \param page_size number of posts per page [IN]
+ *
+ * \return number of posts which are older than the newest \a pages pages
+ */
+static uint64_t posts_before_pages(
+    uint64_t count,
+    unsigned long pages,
+    unsigned long page_size
+    )
+{
+    /*
+     * pages * page_size exceeds count (and might overflow) if pages is
+     * larger than the number of complete pages.
+     */
+    if (pages > count / page_size)
+    {
+        return 0;
+    }
+
+    return count - (uint64_t) pages * page_size;
+}
+
+/**
+ *
+ * \brief Main entry point of program.
+ *
+ * This function is the main entry point of the program.
+ *
+ * \param argc - number of command line arguments.
+ * \param argv - array of command line arguments.
+ *
+ * \return Information about succes or failure in the execution
+ * \retval EXIT_FAILURE failed execution.
+ * \retval EXIT_SUCCESS successful execution
+ */
+int main(
+    int argc,
+    char **argv
+    )
+{
+    int c;
+    char dir[MAXPATHLEN];
+    char *eptr;
+    const char *home;
+    unsigned long page_size = DEFAULT_PAGE_SIZE;
+    unsigned long first_page = 1, last_page = 1;
+    uint64_t first, last, i;
+    int64_t count;
+    bb_store_t store;
+    bb_record_t record;
+    char entry[BB_MAXENTRYLEN];
+    int len;
+    struct option long_options[] =
+    {
+        {"dir", 1, NULL, 'd'},
+        {"page-size", 1, NULL, 's'},
+        {"pages", 1, NULL, 'p'},
+        {"help", 0, NULL, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    cmd = argv[0];
+
+    if ((home = getenv("HOME")) == NULL)
+    {
+        home = ".";
+    }
+
+    (void) snprintf(dir, sizeof(dir), "%s/public_html", home);
+
+    while ((c = getopt_long(argc, argv, "d:s:p:h", long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'd':
+                (void) snprintf(dir, sizeof(dir), "%s", optarg);
+                break;
+            case 's':
+                if (
+                    ((page_size = parse_positive(optarg, &eptr)) == 0) ||
+                    (*eptr != '\0')
+                    )
+                {
+                    usage(stderr, EXIT_FAILURE);
+                }
+                break;
+            case 'p':
+                if ((first_page = parse_positive(optarg, &eptr)) == 0)
+                {
+                    usage(stderr, EXIT_FAILURE);
+                }
+                last_page = first_page;
+                if (
+                    (*eptr == ':') &&
+                    ((last_page = parse_positive(eptr + 1, &eptr)) == 0)
+                    )
+                {
+                    usage(stderr, EXIT_FAILURE);
+                }
+                if ((*eptr != '\0') || (last_page < first_page))
+                {
+                    usage(stderr, EXIT_FAILURE);
+                }
+                break;
+            case 'h':
+                usage(stdout, EXIT_SUCCESS);
+                break;
+            case '?':
+            default:
+                usage(stderr, EXIT_FAILURE);
+                break;
+        }
+    }
+
+    if (optind < argc)
+    {
+        usage(stderr, EXIT_FAILURE);
+    }
+
+    if (bb_open(&store, dir, BB_READ) == -1)
+    {
+        ERROR_EXIT("%s: Unable to open post store in %s.", __func__, dir);
+    }
+
+    if ((count = bb_count(&store)) == -1)
+    {
+        ERROR_EXIT("%s: Unable to read index of post store.", __func__);
+    }
+
+    /*
+     * page 1 holds the newest posts, the posts of the selected pages
+     * are rendered from the oldest to the newest one (as on the
+     * bulletin board).
+     */
+    last = posts_before_pages((uint64_t) count, first_page - 1, page_size);
+    first = posts_before_pages((uint64_t) count, last_page, page_size);
+
+    for (i = first; i < last; i++)
+    {
+        if (bb_read(&store, i, &record) == -1)
+        {
+            ERROR_EXIT("%s: Unable to read post %lu.", __func__, (unsigned long) i);
+        }
+
+        if ((len = bb_render(&record.post, entry, sizeof(entry))) == -1)
+        {
+            ERROR_EXIT("%s: Unable to render post %lu.", __func__, (unsigned long) i);
+        }
+
+        if (fwrite(entry, sizeof(char), (size_t) len, stdout) != (size_t) len)
+        {
+            ERROR_EXIT("%s: fwrite() failed.", __func__);
+        }
+    }
+
+    bb_close(&store);
+
+    if (fclose(stdout) == EOF)
+    {
+        ERROR_EXIT("%s: fclose() failed.", __func__);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+/*
+ * =================================================================== eof ==
+ */
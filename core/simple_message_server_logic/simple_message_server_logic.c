@@ -37,40 +37,100 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netdb.h>
 #include <sys/times.h>
 #include <ctype.h>
 #include <sys/file.h>
+#include <glob.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <linux/errqueue.h>
+#include <zlib.h>
 
 /*
- * include embedded PNGs and HTML pages.
+ * include embedded PNGs, HTML pages and compiled HTML templates.
  */
 #include "vcs_tcpip_bulletin_board.php.h"
 #include "vcs_tcpip_bulletin_board_response_ok.thtml.h"
 #include "vcs_tcpip_bulletin_board_response_error.thtml.h"
 #include "ok.png.h"
 #include "error.png.h"
-#include "content_entry_with_img.thtml.h"
-#include "content_entry_without_img.thtml.h"
+#include "vcs_tcpip_bulletin_board_snapshot.thtml.h"
+
+#include "bulletin_board.h"
+#include "shared_segment.h"
+#include "post_ring.h"
+#include "dup_filter.h"
+#include "heavy_hitters.h"
+#include "search_index.h"
+#include "user_index.h"
+#include "template.h"
+#include "protocol_v2.h"
+#include "utf8_validate.h"
+#include "memory_store.h"
 
 /*
  * --------------------------------------------------------------- defines --
  */
 
 #define MAXERRORMSG 256
+#define MAXERRORPATHLEN 128 /* maximum length of a path quoted in errormsg */
 #define MAXTAGLEN 16
 #define MAXMESSAGELEN 1024
 #define MAXPATHLEN _POSIX_PATH_MAX
 #define MAXFILESIZEDIGITS 20
 #define MAXSTATUSDIGITS 10
 #define MAXURLLEN 4096
+#define MAXSEQDIGITS 20
+#define DELTA_MAXPOSTS 500U
 
 #define BULLETIN_BOARD_MAIN_FILE "vcs_tcpip_bulletin_board.php"
 #define BULLETIN_BOARD_CONTENT_FILE "bulletin_board_content.dat"
+#define BULLETIN_BOARD_SEGMENT_FILE "bulletin_board_content.%06lu.dat"
+#define BULLETIN_BOARD_SEGMENT_GLOB "bulletin_board_content.[0-9]*.dat"
+#define BULLETIN_BOARD_ARCHIVE_FILE "bulletin_board_archive.dat.gz"
+#define BULLETIN_BOARD_SNAPSHOT_FILE "vcs_tcpip_bulletin_board.html"
+#define BULLETIN_BOARD_SNAPSHOT_TMP_FILE "vcs_tcpip_bulletin_board.html.tmp"
+#define BULLETIN_BOARD_SNAPSHOT_LOCK_FILE "vcs_tcpip_bulletin_board.html.lock"
+#define BULLETIN_BOARD_SYNC_LOCK_FILE "bulletin_board_sync.lock"
+#define METRICS_SEGMENT "metrics"
+
+/*
+ * defaults for the rotation of the content file into segments
+ * (see SMSL_SEGMENT_SIZE, SMSL_SEGMENT_AGE and SMSL_SEGMENT_KEEP)
+ */
+#define DEFAULT_SEGMENT_SIZE (64L * 1024L)
+#define DEFAULT_SEGMENT_AGE 0L
+#define DEFAULT_SEGMENT_KEEP 8L
+
+/*
+ * default number of posts in the static snapshot (see SMSL_SNAPSHOT_POSTS)
+ */
+#define DEFAULT_SNAPSHOT_POSTS 50L
+
+/*
+ * default number of posts not covered by the search index which are
+ * added to it at once (see SMSL_SEARCH_PENDING)
+ */
+#define DEFAULT_SEARCH_PENDING 64L
+
+/*
+ * default duplicate detection: copies of a message by the same user
+ * accepted within the window in seconds (0 disables the detection) and
+ * the memory of the shared filter in KiB (see SMSL_DUPLICATE_*)
+ */
+#define DEFAULT_DUPLICATE_WINDOW 60L
+#define DEFAULT_DUPLICATE_LIMIT 1L
+#define DEFAULT_DUPLICATE_MEMORY 1024L
+#define MAX_DUPLICATE_MEMORY (1024L * 1024L)
 
 #define SMSL_E_OK      0
 #define SMSL_E_FAILED -1  /* a general problem occured */
 #define SMSL_E_INVAL   1  /* invalid input */
 #define SMSL_E_OVERLOW 2  /* given input too long */
+#define SMSL_E_DUPLICATE 3  /* message posted again within the duplicate window */
 
 #define CHUNKSIZE 1024U
 #define ADDITIONAL_BLANK_CHUNKS (1024U * 1024U)
@@ -79,7 +139,9 @@
  * The program supports different tests which can be activated
  * via the environment variable SMSL_TESTCASE. Constants for
  * the testcases are given below, for a description see testcase_info[]
- * or use the --help option of the program.
+ * or use the --help option of the program. A production build
+ * (-DSMSL_NO_TESTCASES) ignores SMSL_TESTCASE, the branches of the
+ * testcases and the random chunking of the responses are compiled out.
  */
 #define TESTCASE_NONE                0
 #define TESTCASE_CHECK_ARGV          1
@@ -93,6 +155,171 @@
 #define TESTCASE_MAX TESTCASE_HUGE_FILE
 #define TESTCASE_MIN TESTCASE_NONE
 
+/*
+ * The way entries are appended to the content file can be selected
+ * via the environment variable SMSL_APPEND_MODE ("flock" or "atomic").
+ */
+#define APPEND_MODE_FLOCK  0  /* exclusive flock() around the write() */
+#define APPEND_MODE_ATOMIC 1  /* shared flock(), single O_APPEND write() */
+
+/*
+ * The durability of a post before it is acknowledged can be selected
+ * via the environment variable SMSL_DURABILITY ("none", "group" or
+ * "strict").
+ */
+#define DURABILITY_NONE   0  /* leave the write-back to the kernel */
+#define DURABILITY_GROUP  1  /* one fdatasync() for concurrent posts */
+#define DURABILITY_STRICT 2  /* one fdatasync() per post */
+
+/*
+ * default time in milliseconds the leader of a group commit waits for
+ * further posts before syncing (see SMSL_GROUP_COMMIT_DELAY)
+ */
+#define DEFAULT_GROUP_COMMIT_DELAY 0L
+#define MAX_GROUP_COMMIT_DELAY 1000L
+
+/*
+ * fsync latency histogram: bucket i counts the syncs which took
+ * [2^i, 2^(i+1)) microseconds, bucket 0 also counts faster ones.
+ */
+#define FSYNC_HISTOGRAM_BUCKETS 32
+
+/*
+ * maximum length of a line of the metrics listing a key of the top
+ * list of a sketch, see collect_top()
+ */
+#define TOP_LINE_LEN (48 + HH_MAXLABELLEN)
+
+/*
+ * Besides posting a message (first line "user=...") the client may
+ * request the posts after a given sequence number (first line
+ * "since=<seq>"), the metrics of the server (first line "metrics="),
+ * the posts containing all words of a query (first line "search=<words>"),
+ * the posts of a user (first line "posts_by=<user>") or the rest of an
+ * interrupted OK response (first line "resume=<id>", see
+ * KEYWORD_ACCEPT_RANGES).
+ */
+#define REQUEST_POST    0
+#define REQUEST_DELTA   1
+#define REQUEST_METRICS 2
+#define REQUEST_BATCH   3  /* several posts, protocol version 2 only */
+#define REQUEST_SUBSCRIBE 4  /* push new posts, protocol version 2 only */
+#define REQUEST_SEARCH  5
+#define REQUEST_POSTS_BY 6
+#define REQUEST_RESUME  7
+
+#define KEYWORD_SINCE "since="
+#define KEYWORD_METRICS "metrics="
+#define KEYWORD_SEARCH "search="
+#define KEYWORD_POSTS_BY "posts_by="
+#define KEYWORD_RESUME "resume="
+#define KEYWORD_FILE "file="
+#define KEYWORD_OFFSET "offset="
+
+/*
+ * A request may start with the line "accept-encoding=deflate". In that
+ * case the HTML response (and the padding of TESTCASE_HUGE_FILE) is
+ * sent as raw deflate stream, announced by the line "encoding=deflate"
+ * between the lines "file=" and "len=".
+ */
+#define KEYWORD_ACCEPT_ENCODING "accept-encoding="
+
+#define ENCODING_IDENTITY 0
+#define ENCODING_DEFLATE  1
+
+/*
+ * A request may also start with the line "accept-framing=chunked". In
+ * that case the posts of a delta, search or posts by user response are
+ * rendered while the file is written: the line "len=chunked" is
+ * followed by chunks "<n>\n<n bytes>" of at most CHUNK_MAXPOSTS posts
+ * each, the chunk "0\n" ends the file. Requests of version 2 use the
+ * field accept_framing, the chunks are sent as chunk frames then (see
+ * protocol_v2.h).
+ */
+#define KEYWORD_ACCEPT_FRAMING "accept-framing="
+
+#define FRAMING_LENGTH  0
+#define FRAMING_CHUNKED 1
+
+#define CHUNK_MAXPOSTS 16U
+
+/*
+ * A request of version 1 may also start with the line
+ * "accept-ranges=bytes". In that case the OK response to a post carries
+ * the line "id=<n>" after the status line, n being the sequence number
+ * of the post. If the connection is closed before the response has been
+ * received completely, the request "resume=<n>\nfile=<name>\noffset=<k>"
+ * repeats the response without the files preceding the file <name>,
+ * which is sent from byte k on. Its header carries the line
+ * "offset=<k>" before the line "len=" giving the remaining length.
+ * Requests of version 2 use the fields accept_ranges, id, resume and
+ * offset instead (see protocol_v2.h).
+ */
+#define KEYWORD_ACCEPT_RANGES "accept-ranges="
+
+#define RANGES_NONE  0
+#define RANGES_BYTES 1
+
+/*
+ * Besides the default board in the public_html directory, the boards
+ * named in the environment variable SMSL_BOARDS (separated by commas)
+ * may be addressed with the option line "board=<name>" (field board of
+ * version 2). Every board is kept in the directory "boards/<name>" with
+ * a content file, post store, indexes and locks of its own, thus posts
+ * to different boards are appended in parallel. The names are routed
+ * to their board via a hash table of BOARD_TABLE_SIZE slots.
+ */
+#define KEYWORD_BOARD "board="
+#define BOARDS_DIR "boards"
+
+#define MAX_BOARDS 64U
+#define BOARD_TABLE_SIZE 128U  /* a power of two, at least twice MAX_BOARDS */
+
+/*
+ * Requests starting with the magic of protocol version 2 (see
+ * protocol_v2.h) are answered with binary frames, all others with the
+ * text lines of version 1.
+ */
+#define PROTOCOL_V1 1
+#define PROTOCOL_V2 2
+
+/*
+ * maximum length of the fields of the status frame of version 2
+ */
+#define MAXSTATUSFRAMELEN \
+    (SMP2_HEADER_LEN + 5 * SMP2_FIELD_HEADER_LEN + sizeof(uint32_t) + 3 * sizeof(uint64_t))
+
+/*
+ * a subscriber checks every SUBSCRIBE_POLL_INTERVAL milliseconds whether
+ * its client is still connected, and is disconnected if it could not
+ * send a response within SUBSCRIBE_SEND_TIMEOUT seconds.
+ */
+#define SUBSCRIBE_POLL_INTERVAL 1000L
+#define SUBSCRIBE_SEND_TIMEOUT 30L
+
+/*
+ * a subscriber whose head in the post ring has not moved on opens the
+ * post store every SUBSCRIBE_STORE_INTERVAL seconds nevertheless, thus
+ * it notices a recreated store, which has another identity.
+ */
+#define SUBSCRIBE_STORE_INTERVAL 10L
+
+/*
+ * number of blank chunks compressed into one deflate block of the
+ * padding of TESTCASE_HUGE_FILE
+ */
+#define BLANK_CHUNKS_PER_BLOCK 64U
+
+/*
+ * large payloads (e.g. the padding of TESTCASE_HUGE_FILE) are written
+ * by stream_pattern() from a buffer of STREAM_BUFFER_LEN bytes. at most
+ * STREAM_MAX_PENDING sends with MSG_ZEROCOPY await their completion,
+ * the progress is reported every STREAM_PROGRESS_INTERVAL seconds.
+ */
+#define STREAM_BUFFER_LEN (1024U * 1024U)
+#define STREAM_MAX_PENDING 16U
+#define STREAM_PROGRESS_INTERVAL 1L
+
 #define ERROR(format, ...) \
   error_at_line(EXIT_SUCCESS, errno, __FILE__, __LINE__, format, ## __VA_ARGS__)
 
@@ -109,10 +336,89 @@ typedef struct
     const char *description;
 } testcase_info_t;
 
+/*
+ * a processed client request and the data for its response
+ */
+typedef struct
+{
+    int type;           /* REQUEST_POST, REQUEST_DELTA, REQUEST_METRICS, ... */
+    uint64_t seq;       /* sequence number of the newest post */
+    uint64_t store_id;  /* identity of the store of a delta, 0 if unknown */
+    char *body;         /* rendered posts after the requested seq, found posts or metrics */
+    size_t body_len;
+    int *record_status; /* status of every record of a batch */
+    size_t record_count;
+    uint64_t dropped;   /* posts skipped by a lagging subscriber */
+    bb_store_t store;   /* store of the posts rendered while responding */
+    uint64_t *posts;    /* numbers of the posts rendered while responding, NULL if body is rendered */
+    size_t post_count;
+} request_t;
+
+/*
+ * the position an OK response is resumed at (see KEYWORD_ACCEPT_RANGES)
+ */
+typedef struct
+{
+    int active;             /* the response is resumed */
+    char file[MAXPATHLEN];  /* file to be resumed, empty once it has been reached */
+    size_t offset;          /* offset in the file */
+} resume_t;
+
+/*
+ * a large payload being written by stream_pattern()
+ */
+typedef struct
+{
+    int zerocopy;           /* sends use MSG_ZEROCOPY */
+    uint32_t issued;        /* sends with MSG_ZEROCOPY */
+    uint32_t completed;     /* sends whose buffer has been released */
+    size_t written;         /* bytes written so far */
+    size_t total;           /* bytes of the payload */
+    time_t reported;        /* time of the last progress report */
+} stream_t;
+
+/*
+ * a board named in SMSL_BOARDS
+ */
+typedef struct
+{
+    char name[SMP2_MAXBOARDLEN + 1];
+    size_t name_len;
+    char dir[sizeof(BOARDS_DIR) + SMP2_MAXBOARDLEN + 2];  /* "boards/<name>/" */
+    int created;            /* the directory has been created by this process */
+} board_t;
+
+/*
+ * the numbers of the last started and completed group sync of a board
+ */
+typedef struct
+{
+    uint64_t started;
+    uint64_t completed;
+} sync_round_t;
+
+/*
+ * counters shared by all instances of the business logic (see
+ * shared_segment_map())
+ */
+typedef struct
+{
+    uint64_t sync_started;      /* number of the last started group sync */
+    uint64_t sync_completed;    /* number of the last completed group sync */
+    uint64_t posts_synced;      /* posts acknowledged after a sync */
+    uint64_t fsync_count;       /* syncs performed */
+    uint64_t fsync_errors;      /* failed syncs */
+    uint64_t fsync_histogram[FSYNC_HISTOGRAM_BUCKETS];
+    uint32_t post_events;       /* incremented (futex) on every commit of posts */
+    uint64_t duplicates_rejected;   /* posts rejected by the duplicate filter */
+    sync_round_t board_sync[MAX_BOARDS];    /* group syncs of the boards of SMSL_BOARDS */
+} metrics_t;
+
 /*
  * --------------------------------------------------------------- globals --
  */
 
+#ifndef SMSL_NO_TESTCASES
 const testcase_info_t testcase_info[] =
 {
     {
@@ -157,6 +463,132 @@ const testcase_info_t testcase_info[] =
  * selected test case
  */
 static int testcase = TESTCASE_NONE;
+#else
+/*
+ * no test case in a production build, every branch of a test case is
+ * dropped by the compiler
+ */
+static const int testcase = TESTCASE_NONE;
+#endif
+
+/*
+ * selected append mode for the content file
+ */
+static int append_mode = APPEND_MODE_FLOCK;
+
+/*
+ * rotation policy of the content file: maximum size of the active
+ * segment in bytes, maximum age of the active segment in seconds
+ * (0 disables rotation by age) and number of rotated segments kept
+ * in public_html before they are moved into the archive.
+ */
+static long segment_size = DEFAULT_SEGMENT_SIZE;
+static long segment_age = DEFAULT_SEGMENT_AGE;
+static long segment_keep = DEFAULT_SEGMENT_KEEP;
+
+/*
+ * number of latest posts in the static snapshot of the bulletin board
+ * (0 disables the snapshot)
+ */
+static long snapshot_posts = DEFAULT_SNAPSHOT_POSTS;
+
+/*
+ * number of posts not covered by the search index which are added to
+ * it at once, see SMSL_SEARCH_PENDING
+ */
+static long search_pending = DEFAULT_SEARCH_PENDING;
+
+/*
+ * duplicate detection, see SMSL_DUPLICATE_WINDOW, SMSL_DUPLICATE_LIMIT
+ * and SMSL_DUPLICATE_MEMORY
+ */
+static long duplicate_window = DEFAULT_DUPLICATE_WINDOW;
+static long duplicate_limit = DEFAULT_DUPLICATE_LIMIT;
+static long duplicate_memory = DEFAULT_DUPLICATE_MEMORY;
+
+/*
+ * selected durability policy and group commit delay in milliseconds
+ */
+static int durability = DURABILITY_NONE;
+static long group_commit_delay = DEFAULT_GROUP_COMMIT_DELAY;
+
+/*
+ * backend keeping the posts, selected via the environment variable
+ * SMSL_STORAGE ("file", "memory" or "null"). Besides the post store
+ * only the file backend writes the content file, the indexes and the
+ * snapshot, thus the others measure the transport without disk I/O.
+ */
+static const bb_backend_t *storage = &bb_file_backend;
+
+/*
+ * encoding of the response accepted by the client
+ */
+static int response_encoding = ENCODING_IDENTITY;
+
+/*
+ * framing of the files of the response accepted by the client
+ */
+static int response_framing = FRAMING_LENGTH;
+
+/*
+ * the client resumes interrupted responses
+ */
+static int response_ranges = RANGES_NONE;
+
+/*
+ * position of the OK response requested by a resume request
+ */
+static resume_t resume;
+
+/*
+ * the boards of SMSL_BOARDS and the routing table, which maps the hash
+ * of a name to the index of its board + 1 (0 marks a free slot, the
+ * collisions are resolved by linear probing)
+ */
+static board_t boards[MAX_BOARDS];
+static size_t board_count = 0;
+static uint8_t board_table[BOARD_TABLE_SIZE];
+
+/*
+ * board addressed by the request, NULL for the default board
+ */
+static board_t *board = NULL;
+
+/*
+ * protocol version of the request and thus of the response
+ */
+static int protocol = PROTOCOL_V1;
+
+/*
+ * set if the connection may carry a further request, i.e. the last
+ * request was a complete frame of protocol version 2
+ */
+static int keep_connection = 0;
+
+/*
+ * shared metrics, NULL if not mapped (yet)
+ */
+static metrics_t *metrics = NULL;
+
+/*
+ * shared ring of the recent posts, NULL if not mapped (yet)
+ */
+static pr_ring_t *post_ring = NULL;
+
+/*
+ * shared duplicate filter, NULL if not mapped (yet)
+ */
+static df_filter_t *dup_filter = NULL;
+
+/*
+ * shared sketches of the heaviest users, NULL if not mapped (yet)
+ */
+static hh_table_t *heavy_hitters = NULL;
+
+/*
+ * numeric address of the client, empty if stdin is no socket
+ */
+static char peer_address[NI_MAXHOST] = "";
 
 /*
  * list of allowed html tags for the client message
@@ -200,6 +632,7 @@ static void usage(
     int exit_code
     )
 {
+#ifndef SMSL_NO_TESTCASES
     size_t i;
 
     (void) fprintf(
@@ -226,10 +659,76 @@ static void usage(
         "\t* rename simple_message_server_logic to check if a failure\n"
         "\t  of exec() is handled correctly.\n"
         );
+#else
+    (void) fprintf(
+        fp,
+        "usage: %s option\n"
+        "options:\n"
+        "\t-h, --help\n\n"
+        "This is a production build, SMSL_TESTCASE is ignored.\n",
+	cmd
+        );
+#endif
+
+    (void) fprintf(
+        fp,
+        "\nThe environment variable SMSL_APPEND_MODE selects how entries are\n"
+        "appended to the content file:\n"
+        "\tflock  - exclusive lock around each write (default)\n"
+        "\tatomic - single O_APPEND write per entry under a shared lock\n"
+        "\nThe content file is rotated into segments according to:\n"
+        "\tSMSL_SEGMENT_SIZE - maximum size in bytes (default %ld)\n"
+        "\tSMSL_SEGMENT_AGE  - maximum age in seconds, 0 = unlimited "
+        "(default %ld)\n"
+        "\tSMSL_SEGMENT_KEEP - rotated segments kept before archiving "
+        "(default %ld)\n"
+        "\nSMSL_SNAPSHOT_POSTS sets the number of posts in the static\n"
+        "snapshot %s, 0 disables it (default %ld).\n"
+        "SMSL_SEARCH_PENDING sets the number of new posts added to the\n"
+        "search index at once (default %ld).\n"
+        "\nCopies of a message posted by the same user are rejected according to:\n"
+        "\tSMSL_DUPLICATE_WINDOW - time in seconds copies are counted, 0 disables\n"
+        "\t                        the detection (default %ld)\n"
+        "\tSMSL_DUPLICATE_LIMIT  - copies accepted within the window "
+        "(default %ld, at most %u)\n"
+        "\tSMSL_DUPLICATE_MEMORY - size of the shared filter in KiB "
+        "(default %ld, at most %ld)\n"
+        "\nThe environment variable SMSL_DURABILITY selects when a post is\n"
+        "acknowledged:\n"
+        "\tnone   - after the write, no fdatasync() (default)\n"
+        "\tgroup  - after an fdatasync() shared with concurrent posts\n"
+        "\tstrict - after an fdatasync() of its own\n"
+        "SMSL_GROUP_COMMIT_DELAY sets the time in ms a group waits for\n"
+        "further posts before syncing (default %ld, at most %ld).\n"
+        "\nThe environment variable SMSL_STORAGE selects where posts are kept:\n"
+        "\tfile   - post store, content file and indexes on disk (default)\n"
+        "\tmemory - the last %u posts in shared memory only\n"
+        "\tnull   - posts are discarded\n"
+        "Posts kept in memory or discarded do not show up on the web page,\n"
+        "search and posts_by requests fail with status -1 then.\n"
+        "\nSMSL_BOARDS lists the names of further boards (separated by commas,\n"
+        "at most %u), addressed by the request line \"board=<name>\".\n",
+        DEFAULT_SEGMENT_SIZE,
+        DEFAULT_SEGMENT_AGE,
+        DEFAULT_SEGMENT_KEEP,
+        BULLETIN_BOARD_SNAPSHOT_FILE,
+        DEFAULT_SNAPSHOT_POSTS,
+        DEFAULT_SEARCH_PENDING,
+        DEFAULT_DUPLICATE_WINDOW,
+        DEFAULT_DUPLICATE_LIMIT,
+        DF_MAXCOUNT - 1,
+        DEFAULT_DUPLICATE_MEMORY,
+        MAX_DUPLICATE_MEMORY,
+        DEFAULT_GROUP_COMMIT_DELAY,
+        MAX_GROUP_COMMIT_DELAY,
+        MS_SLOTS,
+        MAX_BOARDS
+        );
 
     exit(exit_code);
 }
 
+#ifndef SMSL_NO_TESTCASES
 /**
  * \brief Set seed for random number generator
  *
@@ -299,1097 +798,6039 @@ static int get_testcase(
 	
     return testcase_number;
 }
+#endif /* SMSL_NO_TESTCASES */
 
 /**
- * \brief Assert that all non-standard file descriptors are closed
+ * \brief Get the append mode for the content file
  *
- * Assert that all files expect stdin, stdout and stderr are
- * closed (especially the connected socket form the forking
- * server).
+ * Retrieve the append mode for the content file from the environment
+ * variable SMSL_APPEND_MODE.
  *
- * note: FD_SETSIZE (see select()) is used as maximum number of
- * open file descriptors even the system may support an higher number
- * of open files.
+ * \return the append mode to be used
+ * \retval APPEND_MODE_FLOCK SMSL_APPEND_MODE is "flock" or not set
+ * \retval APPEND_MODE_ATOMIC SMSL_APPEND_MODE is "atomic"
+ * \retval -1 SMSL_APPEND_MODE contains an unknown mode
  */
-static void assert_files_closed(
+static int get_append_mode(
     void
     )
 {
-    int i;
-    struct stat statbuf;
+    const char *s;
 
-    for (i = STDERR_FILENO + 1; i < FD_SETSIZE; i++)
+    if ((s = getenv("SMSL_APPEND_MODE")) == NULL)
     {
-        if (fstat(i, &statbuf) == 0)
-	{
-	    ERROR_EXIT(
-		"%s: Some files above STDERR_FILENO "
-                "are still open.",
-		__func__
-		);
-        }
+        return APPEND_MODE_FLOCK;
+    }
+
+    if (strcmp(s, "flock") == 0)
+    {
+        return APPEND_MODE_FLOCK;
+    }
+
+    if (strcmp(s, "atomic") == 0)
+    {
+        return APPEND_MODE_ATOMIC;
     }
+
+    return -1;
 }
 
 /**
- * \brief Get the URL for the bulletin board web page and the home directory
+ * \brief Get the durability policy
  *
- * Retrieve the URL for the bulletin board web page and the home directory for
- * the calling user.
+ * Retrieve the durability policy for posts from the environment
+ * variable SMSL_DURABILITY.
  *
- * \param url pointer to buffer to be filled with the URL [IN]
- * \param url_len size of the buffer pointed to by \a url [IN]
- * \param homedir pointer to buffer to be filled with the path to the user's home dir [IN]
- * \param homedir_len size of the buffer pointed to by \a homedir [IN]
+ * \return the durability policy to be used
+ * \retval DURABILITY_NONE SMSL_DURABILITY is "none" or not set
+ * \retval DURABILITY_GROUP SMSL_DURABILITY is "group"
+ * \retval DURABILITY_STRICT SMSL_DURABILITY is "strict"
+ * \retval -1 SMSL_DURABILITY contains an unknown policy
  */
-static void get_url_and_homedir(
-    char *url,
-    size_t url_len,
-    char *homedir,
-    size_t homedir_len
+static int get_durability(
+    void
     )
 {
-    struct passwd *pw;
-    char host[HOST_NAME_MAX];
-    int cnt;
+    const char *s;
 
-    errno = 0;
-    if ((pw = getpwuid(getuid())) == NULL)
+    if ((s = getenv("SMSL_DURABILITY")) == NULL)
     {
-        ERROR_EXIT(
-	    "%s: getpwuid() failed.",
-	    __func__
-	    );
+        return DURABILITY_NONE;
     }
 
-    if (gethostname(host, sizeof(host) - 1) == -1)
+    if (strcmp(s, "none") == 0)
     {
-        ERROR_EXIT(
-	    "%s: gethostname() failed.",
-	    __func__
-	    );
+        return DURABILITY_NONE;
     }
 
-    host[sizeof(host) - 1] = 0;
-
-    cnt = snprintf(
-	url,
-	url_len,
-	"http://%s/~%s/%s",
-	host,
-	pw->pw_name,
-	BULLETIN_BOARD_MAIN_FILE
-	);
-
-    if (cnt < 0)
-    {
-        ERROR_EXIT(
-	    "%s: snprintf() failed.",
-	    __func__
-	    );
-    }
-    else if ((size_t) cnt >= url_len)
+    if (strcmp(s, "group") == 0)
     {
-        ERROR_EXIT(
-	    "%s: snprintf() failed - buffer too small.",
-	    __func__
-	    );
+        return DURABILITY_GROUP;
     }
 
-    if (strlen(pw->pw_dir) >= homedir_len)
+    if (strcmp(s, "strict") == 0)
     {
-        ERROR_EXIT(
-	    "%s: buffer for homedir too small.",
-	    __func__
-	    );
+        return DURABILITY_STRICT;
     }
 
-    strncpy(homedir, pw->pw_dir, homedir_len - 1);
-    homedir[homedir_len - 1] = 0; /* force string termination */
+    return -1;
 }
 
 /**
- * \brief Turn off the nagle algorithm on stdout
+ * \brief Get the storage backend
  *
- * Check whether stdout is actually a socket and if so, turn off the
- * nagle algorithm on that socket.
+ * Retrieve the backend keeping the posts from the environment variable
+ * SMSL_STORAGE.
+ *
+ * \return the storage backend to be used
+ * \retval &bb_file_backend SMSL_STORAGE is "file" or not set
+ * \retval &ms_backend SMSL_STORAGE is "memory"
+ * \retval &bb_null_backend SMSL_STORAGE is "null"
+ * \retval NULL SMSL_STORAGE contains an unknown backend
  */
-static void turn_off_nagle_algorithm(
+static const bb_backend_t *get_storage(
     void
     )
 {
-    struct stat statbuf;
-    int yes = 1;
+    const bb_backend_t *const backends[] = { &bb_file_backend, &ms_backend, &bb_null_backend };
+    const char *s;
+    size_t i;
 
-    /*
-     * Check if stdout is a socket. If not we can omit the
-     * setsockopt() call to turn off the Nagle algorithm.
-     */
-    if (fstat(STDOUT_FILENO, &statbuf) == -1)
+    if ((s = getenv("SMSL_STORAGE")) == NULL)
     {
-        ERROR_EXIT(
-	    "%s: fstat() failed.",
-	    __func__
-	    );
+        return &bb_file_backend;
     }
 
-    if (!S_ISSOCK(statbuf.st_mode))
+    for (i = 0; i < sizeof(backends) / sizeof(*backends); i++)
     {
-        return;  /* no socket */
+        if (strcmp(s, backends[i]->name) == 0)
+        {
+            return backends[i];
+        }
     }
 
-    if (setsockopt(
-            STDOUT_FILENO, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes)
-            ) == -1)
-    {
-        ERROR_EXIT(
-	    "%s: setsockopt() failed.",
-	    __func__
-	    );
-    }
+    return NULL;
 }
 
 /**
- * \brief Create main bulletin board web page
- *
- * Create main bulletin board web page in users public_html directory
- * in case it does not exist.
+ * \brief Hash the name of a board
  *
- * \param homedir zero-terminated string with the path of the user's home directory [IN]
+ * \param name the name [IN]
+ * \param len length of \a name [IN]
  *
- * \retval 0 success
- * \retval -1 main page not created
+ * \return the FNV-1a hash of the name
  */
-static int create_main_page(
-    const char *homedir
+static uint32_t hash_board(
+    const char *name,
+    size_t len
     )
 {
-    char file[MAXPATHLEN];
-    int cnt;
-    int fd;
-
-    cnt = snprintf(
-	file,
-	sizeof(file),
-	"%s/public_html/%s",
-	homedir,
-	BULLETIN_BOARD_MAIN_FILE
-	);
-
-    if (cnt < 0)
-    {
-        ERROR_EXIT(
-	    "%s: snprintf() failed.",
-	    __func__
-	    );
-    }
-    else if ((size_t) cnt >= sizeof(file))
-    {
-        ERROR_EXIT(
-	    "%s: snprintf() failed - buffer too small.",
-	    __func__
-	    );
-    }
-
-    if ((fd = open(file, O_RDWR | O_CREAT | O_EXCL, 0644)) == -1)
-    {
-        if ((errno == EEXIST))
-	{
-            return 0;
-                /* the file already exists. nothing to do. */
-        }
-        else {
-            ERROR(
-	        "%s: Creation of %s failed.",
-		__func__,
-		file
-		);
-            return -1;
-        }
-    }
-
-    if (
-	write(
-            fd,
-	    vcs_tcpip_bulletin_board_php,
-            sizeof(vcs_tcpip_bulletin_board_php)
-            ) != sizeof(vcs_tcpip_bulletin_board_php)
-	)
-    {
-        ERROR(
-	    "%s: Write to %s failed.",
-	    __func__,
-	    file
-	    );
-        (void) close(fd);
-        (void) unlink(file);
-        return -1;
-    }
+    uint32_t hash = 2166136261U;
+    size_t i;
 
-    if (close(fd) == -1)
+    for (i = 0; i < len; i++)
     {
-        ERROR(
-	    "%s: Close of %s failed.",
-	    __func__,
-	    file
-	    );
-	return -1;
+        hash ^= (unsigned char) name[i];
+        hash *= 16777619U;
     }
 
-    return 0;
+    return hash;
 }
 
 /**
- * \brief Write provided buffer in chunks of random size
+ * \brief Look up a board
  *
- * Write the given buffer (\a buf) of size \a len in chunks of random
- * size to enforce short reads on the client side. In case
- * SMSL_TESTCASE is set to the numeric value of TESTCASE_WRITE_DELAY,
- * introduce 0.2 seconds delay between the writing of each chunk.
+ * \param name the name of the board, not necessarily zero-terminated [IN]
+ * \param len length of \a name [IN]
  *
- * \param buf pointer to the buffer to write [IN]
- * \param len length to the buffer pointed to by \a buf [IN]
+ * \return the board
+ * \retval NULL the name is not listed in SMSL_BOARDS
  */
-static void write_in_chunks(
-    const void *buf,
+static board_t *find_board(
+    const char *name,
     size_t len
     )
 {
-    const char *b = (const char *) buf;
-    ssize_t cnt;
+    uint32_t i = hash_board(name, len);
+    uint8_t slot;
 
-    while (len)
+    while ((slot = board_table[i & (BOARD_TABLE_SIZE - 1)]) != 0)
     {
-        if ((cnt = write(STDOUT_FILENO, b, get_random_max(len))) == -1)
+        if (
+            (boards[slot - 1].name_len == len) &&
+            (memcmp(boards[slot - 1].name, name, len) == 0)
+            )
         {
-	    /* error response will fail too, thus just exit. */
-            ERROR_EXIT(
-   	        "%s: write() failed.",
-		__func__
-		);
+            return &boards[slot - 1];
         }
 
-        len -= cnt;
-        b += cnt;
-
-        if (testcase == TESTCASE_WRITE_DELAY)
-	{
-            usleep(200000);
-	}
+        i++;
     }
+
+    return NULL;
 }
 
 /**
- * \brief Write execution status of business logic
+ * \brief Get the boards
  *
- * Write the provided execution status (\a status) of the business
- * logic to stdout using \a write_in_chunks().
+ * Retrieve the names of the boards from the environment variable
+ * SMSL_BOARDS and enter them into the routing table. A name consists of
+ * 1 to SMP2_MAXBOARDLEN letters, digits, '-' and '_'.
  *
- * \param status execution status of the business logic [IN]
+ * \retval 0 success, SMSL_BOARDS is not set or lists valid names
+ * \retval -1 SMSL_BOARDS contains an invalid or duplicate name or more
+ *         than MAX_BOARDS names
  */
-static void write_status(int status)
+static int get_boards(
+    void
+    )
 {
-    static const char * const fmt_status = "status=%d\n";
-    char s[MAXSTATUSDIGITS + sizeof(fmt_status)];
-    int cnt;
-
-    cnt = snprintf(s, sizeof(s), fmt_status, status);
+    const char *s, *end;
+    board_t *b;
+    uint32_t i;
+    size_t len, j;
 
-    if (cnt < 0)
+    if ((s = getenv("SMSL_BOARDS")) == NULL)
     {
-        ERROR_EXIT(
-	    "%s: snprintf() failed.",
-	    __func__
-	    );
+        return 0;
     }
-    else if ((size_t) cnt >= sizeof(s))
+
+    for (; ; s = end + 1)
     {
-        ERROR_EXIT(
-	    "%s: snprintf() failed - buffer too small.",
-	    __func__
-	    );
+        if ((end = strchr(s, ',')) == NULL)
+        {
+            end = s + strlen(s);
+        }
+
+        len = (size_t) (end - s);
+
+        if (
+            (len == 0) ||
+            (len > SMP2_MAXBOARDLEN) ||
+            (board_count == MAX_BOARDS) ||
+            (find_board(s, len) != NULL)
+            )
+        {
+            return -1;
+        }
+
+        for (j = 0; j < len; j++)
+        {
+            if (!isalnum((unsigned char) s[j]) && (s[j] != '-') && (s[j] != '_'))
+            {
+                return -1;
+            }
+        }
+
+        b = &boards[board_count];
+        memcpy(b->name, s, len);
+        b->name[len] = '\0';
+        b->name_len = len;
+        (void) snprintf(b->dir, sizeof(b->dir), "%s/%.*s/", BOARDS_DIR, (int) len, s);
+
+        for (i = hash_board(s, len); board_table[i & (BOARD_TABLE_SIZE - 1)] != 0; i++)
+        {
+            ;  /* the table is never more than half full */
+        }
+
+        board_table[i & (BOARD_TABLE_SIZE - 1)] = (uint8_t) ++board_count;
+
+        if (*end == '\0')
+        {
+            return 0;
+        }
     }
+}
 
-    write_in_chunks(s, strlen(s));
+/**
+ * \brief Get the directory of the addressed board
+ *
+ * \return the directory of the board relative to the public_html
+ *         directory incl. a trailing slash, the empty string for the
+ *         default board
+ */
+static const char *board_dir(
+    void
+    )
+{
+    return (board != NULL) ? board->dir : "";
 }
 
 /**
- * \brief Write file header and file content
+ * \brief Get the URL of the web page of the addressed board
  *
- * Write the file header for the file \a filename of length \a len to
- * stdout using \a write_in_chunks(). The contents of the file are
- * provided in the buffer pointed to by \a buf.
+ * \param url zero-terminated string containing the URL to the bulletin board web page [IN]
+ * \param buf pointer to buffer to be filled with the URL of the board [OUT]
+ * \param len size of the buffer pointed to by \a buf [IN]
  *
- * \param filename name of the file to be written [IN]
- * \param buf pointer to the buffer containing the file contents [IN]
- * \param len length of the file (and thus size of the buffer) [IN]
- * \param additional_blank_chunks additional chunks of blanks to be
- * added at then end of the HTML file [IN]
+ * \return \a url for the default board (or if the URL of the board is
+ *         too long), \a buf containing the URL of the main page in the
+ *         directory of the board otherwise
  */
-static void download_file(
-    const char *filename, const void *buf, size_t len,
-    unsigned additional_blank_chunks
+static const char *board_url(
+    const char *url,
+    char *buf,
+    size_t len
     )
 {
-    static const char * const fmt_file = "file=%s\nlen=%zu\n";
-    char s[MAXFILESIZEDIGITS + MAXPATHLEN + sizeof(fmt_file)];
+    const size_t base_len = strlen(url) - strlen(BULLETIN_BOARD_MAIN_FILE);
     int cnt;
 
-    /*
-     * create header containing keywords "file" and "len".
-     */
+    if (board == NULL)
+    {
+        return url;
+    }
+
     cnt = snprintf(
-	s,
-	sizeof(s),
-	fmt_file,
-	filename,
-	(testcase == TESTCASE_SMALLER_LENGTH) ? (len - len/3) :
-	len
+	buf,
+	len,
+	"%.*s%s%s",
+	(int) base_len,
+	url,
+	board->dir,
+	BULLETIN_BOARD_MAIN_FILE
 	);
 
-    if (cnt < 0)
-    {
-        ERROR_EXIT(
-	    "%s: snprintf() failed.",
-	    __func__
-	    );
-    }
-    else if ((size_t) cnt >= sizeof(s))
+    if ((cnt < 0) || ((size_t) cnt >= len))
     {
-        ERROR_EXIT(
-	    "%s: snprintf() failed - buffer too small.",
-	    __func__
-	    );
+        return url;
     }
 
-    /*
-     * write header with keywords "file" and "len"
-     */
-    write_in_chunks(s, strlen(s));
+    return buf;
+}
 
-    /*
-     * in case we want to simulate a "connection closed by peer"
-     * we only sent half of the ok.png image. Afterwards the
-     * program exits and closes the connection automatically.
-     */
-    if ((testcase == TESTCASE_PREMATURE_CLOSE) && (buf == ok_png))
+/**
+ * \brief Get a numeric setting from the environment
+ *
+ * Retrieve a non-negative number from the environment variable \a name.
+ *
+ * \param name name of the environment variable [IN]
+ * \param dflt value returned if the variable is not set [IN]
+ * \param max upper bound for the value [IN]
+ *
+ * \return the value of the setting
+ * \retval -1 the variable is no number within [0 .. \a max]
+ */
+static long get_env_number(
+    const char *name,
+    long dflt,
+    long max
+    )
+{
+    const char *s;
+    char *eptr;
+    long value;
+
+    if ((s = getenv(name)) == NULL)
     {
-        len /= 2;
+        return dflt;
     }
 
-    if (buf != NULL)
+    errno = 0;
+    value = strtol(s, &eptr, 10);
+
+    if (
+	(errno != 0) ||
+	(eptr == s) ||
+	(*eptr != '\0') ||
+	(value < 0) ||
+	(value > max)
+	)
     {
-	/*
-	 * write content of file
-	 */
-	write_in_chunks(buf, len);
+	return -1;
     }
 
-    /*
-     * in case we want to simulate a really *huge* file
-     * we append a few spaces ....
-     */
-    if (testcase == TESTCASE_HUGE_FILE)
+    return value;
+}
+
+/**
+ * \brief Assert that all non-standard file descriptors are closed
+ *
+ * Assert that all files expect stdin, stdout and stderr are
+ * closed (especially the connected socket form the forking
+ * server).
+ *
+ * note: FD_SETSIZE (see select()) is used as maximum number of
+ * open file descriptors even the system may support an higher number
+ * of open files.
+ */
+static void assert_files_closed(
+    void
+    )
+{
+    int i;
+    struct stat statbuf;
+
+    for (i = STDERR_FILENO + 1; i < FD_SETSIZE; i++)
     {
-	for (unsigned i = 0; i < additional_blank_chunks; ++i)
+        if (fstat(i, &statbuf) == 0)
 	{
-	    (void) fprintf(stderr, "Writing chunk %u of %u ...\n", i, additional_blank_chunks); 
-	    if (write(STDOUT_FILENO, chunk_of_blanks, sizeof(chunk_of_blanks)) == -1)
-	    {
-    	        /* error response will fail too, thus just exit. */
-	        ERROR_EXIT(
-		    "%s: write() failed.",
-		    __func__
-		    );
-	    }
-	}
+	    ERROR_EXIT(
+		"%s: Some files above STDERR_FILENO "
+                "are still open.",
+		__func__
+		);
+        }
+    }
+}
+
+/**
+ * \brief Get the URL for the bulletin board web page and the home directory
+ *
+ * Retrieve the URL for the bulletin board web page and the home directory for
+ * the calling user.
+ *
+ * \param url pointer to buffer to be filled with the URL [IN]
+ * \param url_len size of the buffer pointed to by \a url [IN]
+ * \param homedir pointer to buffer to be filled with the path to the user's home dir [IN]
+ * \param homedir_len size of the buffer pointed to by \a homedir [IN]
+ */
+static void get_url_and_homedir(
+    char *url,
+    size_t url_len,
+    char *homedir,
+    size_t homedir_len
+    )
+{
+    struct passwd *pw;
+    char host[HOST_NAME_MAX];
+    int cnt;
+
+    errno = 0;
+    if ((pw = getpwuid(getuid())) == NULL)
+    {
+        ERROR_EXIT(
+	    "%s: getpwuid() failed.",
+	    __func__
+	    );
+    }
+
+    if (gethostname(host, sizeof(host) - 1) == -1)
+    {
+        ERROR_EXIT(
+	    "%s: gethostname() failed.",
+	    __func__
+	    );
+    }
+
+    host[sizeof(host) - 1] = 0;
+
+    cnt = snprintf(
+	url,
+	url_len,
+	"http://%s/~%s/%s",
+	host,
+	pw->pw_name,
+	BULLETIN_BOARD_MAIN_FILE
+	);
+
+    if (cnt < 0)
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed.",
+	    __func__
+	    );
+    }
+    else if ((size_t) cnt >= url_len)
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed - buffer too small.",
+	    __func__
+	    );
+    }
+
+    if (strlen(pw->pw_dir) >= homedir_len)
+    {
+        ERROR_EXIT(
+	    "%s: buffer for homedir too small.",
+	    __func__
+	    );
+    }
+
+    strncpy(homedir, pw->pw_dir, homedir_len - 1);
+    homedir[homedir_len - 1] = 0; /* force string termination */
+}
+
+/**
+ * \brief Turn off the nagle algorithm on stdout
+ *
+ * Check whether stdout is actually a socket and if so, turn off the
+ * nagle algorithm on that socket.
+ */
+static void turn_off_nagle_algorithm(
+    void
+    )
+{
+    struct stat statbuf;
+    int yes = 1;
+
+    /*
+     * Check if stdout is a socket. If not we can omit the
+     * setsockopt() call to turn off the Nagle algorithm.
+     */
+    if (fstat(STDOUT_FILENO, &statbuf) == -1)
+    {
+        ERROR_EXIT(
+	    "%s: fstat() failed.",
+	    __func__
+	    );
+    }
+
+    if (!S_ISSOCK(statbuf.st_mode))
+    {
+        return;  /* no socket */
+    }
+
+    if (setsockopt(
+            STDOUT_FILENO, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes)
+            ) == -1)
+    {
+        ERROR_EXIT(
+	    "%s: setsockopt() failed.",
+	    __func__
+	    );
+    }
+}
+
+/**
+ * \brief Get the address of the client
+ *
+ * Store the numeric address of the peer of stdin in \a peer_address,
+ * it is left empty if stdin is no socket.
+ */
+static void get_peer_address(
+    void
+    )
+{
+    struct sockaddr_storage addr;
+    socklen_t addr_len = sizeof(addr);
+
+    if (
+        (getpeername(STDIN_FILENO, (struct sockaddr *) &addr, &addr_len) == -1) ||
+        (getnameinfo(
+            (struct sockaddr *) &addr, addr_len,
+            peer_address, sizeof(peer_address),
+            NULL, 0, NI_NUMERICHOST
+            ) != 0)
+        )
+    {
+        peer_address[0] = '\0';  /* no socket or no internet address */
+    }
+}
+
+/**
+ * \brief Create main bulletin board web page
+ *
+ * Create main bulletin board web page in users public_html directory
+ * (resp. the directory of the addressed board) in case it does not exist.
+ *
+ * \param homedir zero-terminated string with the path of the user's home directory [IN]
+ *
+ * \retval 0 success
+ * \retval -1 main page not created
+ */
+static int create_main_page(
+    const char *homedir
+    )
+{
+    char file[MAXPATHLEN];
+    int cnt;
+    int fd;
+
+    cnt = snprintf(
+	file,
+	sizeof(file),
+	"%s/public_html/%s%s",
+	homedir,
+	board_dir(),
+	BULLETIN_BOARD_MAIN_FILE
+	);
+
+    if (cnt < 0)
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed.",
+	    __func__
+	    );
+    }
+    else if ((size_t) cnt >= sizeof(file))
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed - buffer too small.",
+	    __func__
+	    );
+    }
+
+    if ((fd = open(file, O_RDWR | O_CREAT | O_EXCL, 0644)) == -1)
+    {
+        if ((errno == EEXIST))
+	{
+            return 0;
+                /* the file already exists. nothing to do. */
+        }
+        else {
+            ERROR(
+	        "%s: Creation of %s failed.",
+		__func__,
+		file
+		);
+            return -1;
+        }
+    }
+
+    if (
+	write(
+            fd,
+	    vcs_tcpip_bulletin_board_php,
+            sizeof(vcs_tcpip_bulletin_board_php)
+            ) != sizeof(vcs_tcpip_bulletin_board_php)
+	)
+    {
+        ERROR(
+	    "%s: Write to %s failed.",
+	    __func__,
+	    file
+	    );
+        (void) close(fd);
+        (void) unlink(file);
+        return -1;
+    }
+
+    if (close(fd) == -1)
+    {
+        ERROR(
+	    "%s: Close of %s failed.",
+	    __func__,
+	    file
+	    );
+	return -1;
     }
+
+    return 0;
+}
+
+/**
+ * \brief Write provided buffer in chunks of random size
+ *
+ * Write the given buffer (\a buf) of size \a len in chunks of random
+ * size to enforce short reads on the client side. In case
+ * SMSL_TESTCASE is set to the numeric value of TESTCASE_WRITE_DELAY,
+ * introduce 0.2 seconds delay between the writing of each chunk. A
+ * production build writes as much as possible at a time.
+ *
+ * \param buf pointer to the buffer to write [IN]
+ * \param len length to the buffer pointed to by \a buf [IN]
+ */
+static void write_in_chunks(
+    const void *buf,
+    size_t len
+    )
+{
+    const char *b = (const char *) buf;
+    ssize_t cnt;
+
+    while (len)
+    {
+#ifndef SMSL_NO_TESTCASES
+        cnt = write(STDOUT_FILENO, b, get_random_max(len));
+#else
+        cnt = write(STDOUT_FILENO, b, len);
+#endif
+
+        if (cnt == -1)
+        {
+	    /* error response will fail too, thus just exit. */
+            ERROR_EXIT(
+   	        "%s: write() failed.",
+		__func__
+		);
+        }
+
+        len -= cnt;
+        b += cnt;
+
+        if (testcase == TESTCASE_WRITE_DELAY)
+	{
+            usleep(200000);
+	}
+    }
+}
+
+/**
+ * \brief Get the seconds of the monotonic clock
+ *
+ * \return seconds elapsed since an unspecified point in the past
+ */
+static time_t monotonic_seconds(
+    void
+    )
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec;
+}
+
+/**
+ * \brief Report the progress of a large payload
+ *
+ * Report the bytes written so far on stderr, at most once every
+ * STREAM_PROGRESS_INTERVAL seconds unless the payload is complete.
+ *
+ * \param stream the payload being written [IN/OUT]
+ */
+static void stream_report(
+    stream_t *stream
+    )
+{
+    const time_t now = monotonic_seconds();
+
+    if (
+        (stream->written < stream->total) &&
+        (now - stream->reported < STREAM_PROGRESS_INTERVAL)
+        )
+    {
+        return;
+    }
+
+    stream->reported = now;
+
+    (void) fprintf(
+        stderr,
+        "%s: %zu of %zu KiB written%s\n",
+        __func__,
+        stream->written / 1024U,
+        stream->total / 1024U,
+        stream->zerocopy ? " (zerocopy)" : ""
+        );
+}
+
+/**
+ * \brief Collect the completions of the zerocopy sends
+ *
+ * Read the notifications of released buffers from the error queue of
+ * stdout. A send whose data has been copied by the kernel anyway (e.g.
+ * on the loopback device) ends the use of MSG_ZEROCOPY, a copy is
+ * cheaper without the notifications.
+ *
+ * \param stream the payload being written [IN/OUT]
+ * \param timeout time in milliseconds to wait for a notification, -1
+ *        to wait indefinitely [IN]
+ */
+static void stream_reap(
+    stream_t *stream,
+    int timeout
+    )
+{
+    struct pollfd pfd = { STDOUT_FILENO, 0, 0 };
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64];
+    struct msghdr msg;
+    struct cmsghdr *cm;
+    const struct sock_extended_err *serr;
+
+    if (poll(&pfd, 1, timeout) <= 0)
+    {
+        return;  /* no notification (POLLERR is reported unrequested) */
+    }
+
+    for (;;)
+    {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        if (recvmsg(STDOUT_FILENO, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return;  /* queue drained */
+        }
+
+        for (cm = CMSG_FIRSTHDR(&msg); cm != NULL; cm = CMSG_NXTHDR(&msg, cm))
+        {
+            serr = (const struct sock_extended_err *) CMSG_DATA(cm);
+
+            if ((serr->ee_errno != 0) || (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY))
+            {
+                continue;
+            }
+
+            /*
+             * the notification covers the sends [ee_info, ee_data],
+             * the counters wrap around.
+             */
+            if ((int32_t) (serr->ee_data + 1 - stream->completed) > 0)
+            {
+                stream->completed = serr->ee_data + 1;
+            }
+
+            if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+            {
+                stream->zerocopy = 0;
+            }
+        }
+    }
+}
+
+/**
+ * \brief Write a part of a large payload
+ *
+ * Write \a len bytes of \a buf to stdout, with MSG_ZEROCOPY as long as
+ * it is in use. The buffer must not be changed until stream_finish()
+ * has returned.
+ *
+ * \param stream the payload being written [IN/OUT]
+ * \param buf the data to be written [IN]
+ * \param len length of \a buf [IN]
+ */
+static void stream_write(
+    stream_t *stream,
+    const char *buf,
+    size_t len
+    )
+{
+    ssize_t cnt;
+
+    while (len > 0)
+    {
+        if (stream->zerocopy && (stream->issued - stream->completed >= STREAM_MAX_PENDING))
+        {
+            stream_reap(stream, -1);
+            continue;
+        }
+
+        cnt = stream->zerocopy ?
+            send(STDOUT_FILENO, buf, len, MSG_ZEROCOPY) :
+            write(STDOUT_FILENO, buf, len);
+
+        if (cnt == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (stream->zerocopy && (errno == ENOBUFS))
+            {
+                /*
+                 * out of memory for the notifications, wait for the
+                 * pending sends or copy if there are none.
+                 */
+                if (stream->issued == stream->completed)
+                {
+                    stream->zerocopy = 0;
+                }
+                else
+                {
+                    stream_reap(stream, -1);
+                }
+                continue;
+            }
+
+	    /* error response will fail too, thus just exit. */
+            ERROR_EXIT(
+   	        "%s: write() failed.",
+		__func__
+		);
+        }
+
+        if (stream->zerocopy)
+        {
+            stream->issued++;
+        }
+
+        buf += cnt;
+        len -= (size_t) cnt;
+        stream->written += (size_t) cnt;
+
+        stream_report(stream);
+    }
+}
+
+/**
+ * \brief Write a pattern repeatedly as large payload
+ *
+ * Write \a count copies of \a pattern to stdout. The copies are
+ * assembled in a buffer of about STREAM_BUFFER_LEN bytes which is
+ * written with MSG_ZEROCOPY if stdout is a socket supporting it (see
+ * stream_write()) and with plain writes of the whole buffer otherwise.
+ * The progress is reported on stderr (see stream_report()).
+ *
+ * \param pattern the data to be repeated [IN]
+ * \param pattern_len length of \a pattern [IN]
+ * \param count number of copies of \a pattern [IN]
+ */
+static void stream_pattern(
+    const void *pattern,
+    size_t pattern_len,
+    size_t count
+    )
+{
+    const int yes = 1;
+    stream_t stream;
+    size_t copies, buf_len, i;
+    char *buf;
+
+    if ((pattern_len == 0) || (count == 0))
+    {
+        return;
+    }
+
+    copies = (pattern_len < STREAM_BUFFER_LEN) ? STREAM_BUFFER_LEN / pattern_len : 1;
+
+    if (copies > count)
+    {
+        copies = count;
+    }
+
+    buf_len = copies * pattern_len;
+
+    if ((buf = malloc(buf_len)) == NULL)
+    {
+        ERROR_EXIT(
+	    "%s: malloc() failed.",
+	    __func__
+	    );
+    }
+
+    for (i = 0; i < copies; i++)
+    {
+        memcpy(buf + i * pattern_len, pattern, pattern_len);
+    }
+
+    memset(&stream, 0, sizeof(stream));
+    stream.total = pattern_len * count;
+    stream.reported = monotonic_seconds();
+    stream.zerocopy =
+        (setsockopt(STDOUT_FILENO, SOL_SOCKET, SO_ZEROCOPY, &yes, sizeof(yes)) == 0);
+
+    for (i = 0; i < count; i += copies)
+    {
+        stream_write(&stream, buf, ((count - i < copies) ? count - i : copies) * pattern_len);
+    }
+
+    /*
+     * the buffer may only be released after the kernel has released it
+     */
+    while (stream.issued != stream.completed)
+    {
+        stream_reap(&stream, -1);
+    }
+
+    free(buf);
+}
+
+/**
+ * \brief Write the status frame of protocol version 2
+ *
+ * Write the status frame carrying the execution status \a status to
+ * stdout using \a write_in_chunks(). Unless \a request is NULL the
+ * frame carries the sequence number of a delta or subscription
+ * response, the id of a post if the client resumes responses, the
+ * number of posts dropped for a lagging subscriber and the status of
+ * the records of a batch in a single field.
+ *
+ * \param status execution status of the business logic [IN]
+ * \param request the processed request or NULL [IN]
+ */
+static void write_status_frame(
+    int status,
+    const request_t *request
+    )
+{
+    unsigned char frame[MAXSTATUSFRAMELEN];
+    unsigned char value[sizeof(uint64_t)];
+    unsigned char *records = NULL;
+    size_t len = SMP2_HEADER_LEN;
+    size_t records_len = 0, i;
+
+    smp2_put_u32(value, (uint32_t) status);
+    len += smp2_encode_field(frame + len, SMP2_FIELD_STATUS, value, sizeof(uint32_t));
+
+    if (
+        (request != NULL) &&
+        (
+            (request->type == REQUEST_DELTA) ||
+            (request->type == REQUEST_SUBSCRIBE) ||
+            (request->type == REQUEST_SEARCH) ||
+            (request->type == REQUEST_POSTS_BY)
+            )
+        )
+    {
+        smp2_put_u64(value, request->seq);
+        len += smp2_encode_field(frame + len, SMP2_FIELD_SEQ, value, sizeof(uint64_t));
+    }
+
+    if (
+        (request != NULL) &&
+        (request->type == REQUEST_POST) &&
+        (response_ranges == RANGES_BYTES) &&
+        (request->seq != 0)
+        )
+    {
+        smp2_put_u64(value, request->seq);
+        len += smp2_encode_field(frame + len, SMP2_FIELD_ID, value, sizeof(uint64_t));
+    }
+
+    if ((request != NULL) && (request->dropped > 0))
+    {
+        smp2_put_u64(value, request->dropped);
+        len += smp2_encode_field(frame + len, SMP2_FIELD_DROPPED, value, sizeof(uint64_t));
+    }
+
+    if ((request != NULL) && (request->record_status != NULL))
+    {
+        records_len = request->record_count * sizeof(uint32_t);
+
+        if ((records = malloc(records_len)) == NULL)
+        {
+            ERROR_EXIT(
+	        "%s: malloc() failed.",
+	        __func__
+	        );
+        }
+
+        for (i = 0; i < request->record_count; i++)
+        {
+            smp2_put_u32(records + i * sizeof(uint32_t), (uint32_t) request->record_status[i]);
+        }
+
+        len += smp2_encode_field_header(
+            frame + len, SMP2_FIELD_RECORD_STATUS, (uint32_t) records_len
+            );
+    }
+
+    (void) smp2_encode_header(
+        frame,
+        SMP2_FRAME_STATUS,
+        (uint32_t) (len - SMP2_HEADER_LEN + records_len)
+        );
+
+    write_in_chunks(frame, len);
+
+    if (records != NULL)
+    {
+        write_in_chunks(records, records_len);
+        free(records);
+    }
+}
+
+/**
+ * \brief Terminate the response
+ *
+ * Write the end frame in case of protocol version 2. The response of
+ * version 1 is terminated by closing the connection.
+ */
+static void write_end(
+    void
+    )
+{
+    unsigned char frame[SMP2_HEADER_LEN];
+
+    if (protocol != PROTOCOL_V2)
+    {
+        return;
+    }
+
+    write_in_chunks(frame, smp2_encode_header(frame, SMP2_FRAME_END, 0));
+}
+
+/**
+ * \brief Write execution status of business logic
+ *
+ * Write the provided execution status (\a status) of the business
+ * logic to stdout using \a write_in_chunks().
+ *
+ * \param status execution status of the business logic [IN]
+ */
+static void write_status(int status)
+{
+    static const char fmt_status[] = "status=%d\n";
+    char s[MAXSTATUSDIGITS + sizeof(fmt_status)];
+    int cnt;
+
+    if (protocol == PROTOCOL_V2)
+    {
+        write_status_frame(status, NULL);
+        return;
+    }
+
+    cnt = snprintf(s, sizeof(s), fmt_status, status);
+
+    if (cnt < 0)
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed.",
+	    __func__
+	    );
+    }
+    else if ((size_t) cnt >= sizeof(s))
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed - buffer too small.",
+	    __func__
+	    );
+    }
+
+    write_in_chunks(s, strlen(s));
+}
+
+/**
+ * \brief Write the header of a file frame of protocol version 2
+ *
+ * Write the frame header and the fields preceding the contents of the
+ * file \a filename to stdout using \a write_in_chunks(). The \a len
+ * bytes of the contents have to be written right afterwards.
+ *
+ * \param filename name of the file to be written [IN]
+ * \param encoding zero-terminated string containing the encoding of the contents or NULL [IN]
+ * \param offset offset of the contents within the file of a resumed response, 0 if none [IN]
+ * \param len length of the contents [IN]
+ * \param chunked the contents follow in chunk frames instead, \a len is 0 then [IN]
+ */
+static void write_file_frame_header(
+    const char *filename, const char *encoding, size_t offset, size_t len, int chunked
+    )
+{
+    unsigned char frame[
+        SMP2_HEADER_LEN + 5 * SMP2_FIELD_HEADER_LEN + 2 * MAXPATHLEN + sizeof(uint64_t)
+        ];
+    unsigned char value[sizeof(uint64_t)];
+    const size_t filename_len = strlen(filename);
+    const size_t encoding_len = (encoding != NULL) ? strlen(encoding) : 0;
+    size_t header_len = SMP2_HEADER_LEN;
+
+    if ((filename_len > MAXPATHLEN) || (encoding_len > MAXPATHLEN))
+    {
+        ERROR_EXIT(
+	    "%s: file name or encoding too long.",
+	    __func__
+	    );
+    }
+
+    header_len += smp2_encode_field(
+        frame + header_len, SMP2_FIELD_NAME, filename, (uint32_t) filename_len
+        );
+
+    if (encoding != NULL)
+    {
+        header_len += smp2_encode_field(
+            frame + header_len, SMP2_FIELD_ENCODING, encoding, (uint32_t) encoding_len
+            );
+    }
+
+    if (offset != 0)
+    {
+        smp2_put_u64(value, (uint64_t) offset);
+        header_len += smp2_encode_field(
+            frame + header_len, SMP2_FIELD_OFFSET, value, sizeof(uint64_t)
+            );
+    }
+
+    if (chunked)
+    {
+        header_len += smp2_encode_field(frame + header_len, SMP2_FIELD_CHUNKED, NULL, 0);
+    }
+
+    /*
+     * the data field is the last one of the frame, its value follows
+     * the header of the frame.
+     */
+    header_len += smp2_encode_field_header(
+        frame + header_len, SMP2_FIELD_DATA, (uint32_t) len
+        );
+
+    if (header_len - SMP2_HEADER_LEN + len > UINT32_MAX)
+    {
+        ERROR_EXIT(
+	    "%s: file %s too large for a frame.",
+	    __func__,
+	    filename
+	    );
+    }
+
+    (void) smp2_encode_header(
+        frame,
+        SMP2_FRAME_FILE,
+        (uint32_t) (header_len - SMP2_HEADER_LEN + len)
+        );
+
+    write_in_chunks(frame, header_len);
+}
+
+/**
+ * \brief Write file header and encoded file content
+ *
+ * Write the file header for the file \a filename of length \a len to
+ * stdout using \a write_in_chunks(). The contents of the file are
+ * provided in the buffer pointed to by \a buf. Unless \a encoding is
+ * NULL the header contains the line "encoding=<encoding>", \a len and
+ * \a buf refer to the encoded contents then.
+ *
+ * \param filename name of the file to be written [IN]
+ * \param encoding zero-terminated string containing the encoding of the contents or NULL [IN]
+ * \param buf pointer to the buffer containing the file contents [IN]
+ * \param len length of the file (and thus size of the buffer) [IN]
+ * \param additional_blank_chunks additional chunks of blanks to be
+ * added at then end of the HTML file [IN]
+ */
+static void download_encoded_file(
+    const char *filename, const char *encoding, const void *buf, size_t len,
+    unsigned additional_blank_chunks
+    )
+{
+    static const char fmt_file[] = "file=%s\n%s%s%s%slen=%zu\n";
+    char s[2 * MAXFILESIZEDIGITS + 2 * MAXPATHLEN + sizeof(fmt_file) + sizeof(KEYWORD_OFFSET)];
+    char offset_line[MAXFILESIZEDIGITS + sizeof(KEYWORD_OFFSET) + 1] = "";
+    size_t announced_len, offset = 0;
+    int premature_close = (testcase == TESTCASE_PREMATURE_CLOSE) && (buf == ok_png);
+    int cnt;
+
+    if (resume.file[0] != '\0')
+    {
+        if (strcmp(filename, resume.file) != 0)
+        {
+            return;  /* received by the client before the interruption */
+        }
+
+        if (resume.offset > len)
+        {
+            ERROR_EXIT(
+	        "%s: offset %zu beyond the end of file %s.",
+	        __func__,
+	        resume.offset,
+	        filename
+	        );
+        }
+
+        offset = resume.offset;
+        (void) snprintf(offset_line, sizeof(offset_line), KEYWORD_OFFSET "%zu\n", offset);
+
+        buf = (const char *) buf + offset;
+        len -= offset;
+        resume.file[0] = '\0';
+    }
+
+    /*
+     * a resumed response is never interrupted again.
+     */
+    if (resume.active)
+    {
+        premature_close = 0;
+    }
+
+    announced_len = (testcase == TESTCASE_SMALLER_LENGTH) ? (len - len/3) : len;
+
+    if (protocol == PROTOCOL_V2)
+    {
+	write_file_frame_header(filename, encoding, offset, announced_len, 0);
+    }
+    else
+    {
+	/*
+	 * create header containing keywords "file", "encoding" and "len".
+	 */
+	cnt = snprintf(
+	    s,
+	    sizeof(s),
+	    fmt_file,
+	    filename,
+	    (encoding != NULL) ? "encoding=" : "",
+	    (encoding != NULL) ? encoding : "",
+	    (encoding != NULL) ? "\n" : "",
+	    offset_line,
+	    announced_len
+	    );
+
+	if (cnt < 0)
+	{
+	    ERROR_EXIT(
+		"%s: snprintf() failed.",
+		__func__
+		);
+	}
+	else if ((size_t) cnt >= sizeof(s))
+	{
+	    ERROR_EXIT(
+		"%s: snprintf() failed - buffer too small.",
+		__func__
+		);
+	}
+
+	/*
+	 * write header with keywords "file" and "len"
+	 */
+	write_in_chunks(s, strlen(s));
+    }
+
+    /*
+     * in case we want to simulate a "connection closed by peer"
+     * we only sent half of the ok.png image. Afterwards the
+     * program exits and closes the connection automatically.
+     */
+    if (premature_close)
+    {
+        len /= 2;
+    }
+
+    if (buf != NULL)
+    {
+	/*
+	 * write content of file
+	 */
+	write_in_chunks(buf, len);
+    }
+
+    /*
+     * in case we want to simulate a really *huge* file
+     * we append a few spaces ....
+     */
+    if (testcase == TESTCASE_HUGE_FILE)
+    {
+	stream_pattern(chunk_of_blanks, sizeof(chunk_of_blanks), additional_blank_chunks);
+    }
+}
+
+/**
+ * \brief Write file header and file content
+ *
+ * Write the file header for the file \a filename of length \a len to
+ * stdout using \a write_in_chunks(). The contents of the file are
+ * provided in the buffer pointed to by \a buf.
+ *
+ * \param filename name of the file to be written [IN]
+ * \param buf pointer to the buffer containing the file contents [IN]
+ * \param len length of the file (and thus size of the buffer) [IN]
+ * \param additional_blank_chunks additional chunks of blanks to be
+ * added at then end of the HTML file [IN]
+ */
+static void download_file(
+    const char *filename, const void *buf, size_t len,
+    unsigned additional_blank_chunks
+    )
+{
+    download_encoded_file(filename, NULL, buf, len, additional_blank_chunks);
+}
+
+/**
+ * \brief Write the header of a chunked file
+ *
+ * Write the file header for the file \a filename whose length is not
+ * known in advance to stdout using \a write_in_chunks(). The line
+ * "len=chunked" resp. the file frame carrying the field chunked is
+ * followed by the contents written by \a download_chunk().
+ *
+ * \param filename name of the file to be written [IN]
+ */
+static void download_chunked_header(
+    const char *filename
+    )
+{
+    static const char fmt_file[] = "file=%s\nlen=chunked\n";
+    char s[MAXPATHLEN + sizeof(fmt_file)];
+    int cnt;
+
+    if (protocol == PROTOCOL_V2)
+    {
+        write_file_frame_header(filename, NULL, 0, 0, 1);
+        return;
+    }
+
+    cnt = snprintf(s, sizeof(s), fmt_file, filename);
+
+    if ((cnt < 0) || ((size_t) cnt >= sizeof(s)))
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed.",
+	    __func__
+	    );
+    }
+
+    write_in_chunks(s, (size_t) cnt);
+}
+
+/**
+ * \brief Write a chunk of a chunked file
+ *
+ * Write the line "<len>" resp. the header of a chunk frame followed by
+ * \a len bytes of the buffer pointed to by \a buf to stdout using \a
+ * write_in_chunks(). A chunk of length 0 ends the file.
+ *
+ * \param buf pointer to the buffer containing the chunk [IN]
+ * \param len length of the chunk [IN]
+ */
+static void download_chunk(
+    const void *buf,
+    size_t len
+    )
+{
+    char s[MAXFILESIZEDIGITS + 2];
+    int cnt;
+
+    if (protocol == PROTOCOL_V2)
+    {
+        cnt = (int) smp2_encode_header(s, SMP2_FRAME_CHUNK, (uint32_t) len);
+    }
+    else
+    {
+        cnt = snprintf(s, sizeof(s), "%zu\n", len);
+    }
+
+    if ((cnt < 0) || ((size_t) cnt >= sizeof(s)))
+    {
+        ERROR_EXIT(
+	    "%s: snprintf() failed.",
+	    __func__
+	    );
+    }
+
+    write_in_chunks(s, (size_t) cnt);
+    write_in_chunks(buf, len);
+}
+
+/**
+ * \brief Write the HTML response file
+ *
+ * Render the response template \a tpl with the arguments \a args and
+ * write it using \a download_encoded_file(). If the client accepts
+ * compressed responses, the response is assembled from the literal
+ * segments compressed at build time.
+ *
+ * \param tpl the compiled response template [IN]
+ * \param args one argument per placeholder of \a tpl [IN]
+ */
+static void download_html_response(
+    const template_t *tpl,
+    const template_arg_t *args
+    )
+{
+    const int deflated = (response_encoding == ENCODING_DEFLATE);
+    const size_t len = deflated ?
+	template_deflated_length(tpl, args) :
+	template_length(tpl, args) + 1;
+    ssize_t cnt;
+
+    char html_response[len];
+
+    cnt = deflated ?
+	template_render_deflated(tpl, args, html_response, len) :
+	template_render(tpl, args, html_response, len);
+
+    if (cnt < 0)
+    {
+        ERROR_EXIT(
+	    "%s: rendering of response template failed.",
+	    __func__
+	    );
+    }
+
+    download_encoded_file(
+        "vcs_tcpip_bulletin_board_response.html",
+        deflated ? "deflate" : NULL,
+        html_response,
+        (size_t) cnt,
+	0
+        );
+}
+
+/**
+ * \brief Write the padding of TESTCASE_HUGE_FILE
+ *
+ * Write the huge file of blanks. If the client accepts compressed
+ * responses, a deflate block of BLANK_CHUNKS_PER_BLOCK chunks of blanks
+ * is compressed once and repeated.
+ */
+static void download_padding(
+    void
+    )
+{
+    static const char final_block[] = { 0x01, 0x00, 0x00, (char) 0xff, (char) 0xff };
+    unsigned char block[CHUNKSIZE];
+    z_stream z;
+    size_t block_len;
+    unsigned i;
+
+    if (response_encoding != ENCODING_DEFLATE)
+    {
+	download_file(
+	    "/dev/null",
+	    NULL,
+	    ADDITIONAL_BLANK_CHUNKS * sizeof(chunk_of_blanks),
+	    ADDITIONAL_BLANK_CHUNKS
+	    );
+	return;
+    }
+
+    /*
+     * every block ends on a byte boundary (Z_SYNC_FLUSH) without
+     * referring to its predecessors, thus the blocks can be repeated.
+     */
+    memset(&z, 0, sizeof(z));
+    if (deflateInit2(&z, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        ERROR_EXIT(
+	    "%s: deflateInit2() failed.",
+	    __func__
+	    );
+    }
+
+    z.next_out = block;
+    z.avail_out = sizeof(block);
+
+    for (i = 0; i < BLANK_CHUNKS_PER_BLOCK; i++)
+    {
+        z.next_in = (unsigned char *) chunk_of_blanks;
+        z.avail_in = sizeof(chunk_of_blanks);
+
+        if (deflate(&z, (i + 1 < BLANK_CHUNKS_PER_BLOCK) ? Z_NO_FLUSH : Z_SYNC_FLUSH) != Z_OK)
+        {
+            ERROR_EXIT(
+	        "%s: deflate() failed.",
+	        __func__
+	        );
+        }
+    }
+
+    block_len = sizeof(block) - z.avail_out;
+    (void) deflateEnd(&z);
+
+    if (z.avail_out == 0)
+    {
+        ERROR_EXIT(
+	    "%s: compressed padding exceeds %zu bytes.",
+	    __func__,
+	    sizeof(block)
+	    );
+    }
+
+    download_encoded_file(
+        "/dev/null",
+        "deflate",
+        NULL,
+        (ADDITIONAL_BLANK_CHUNKS / BLANK_CHUNKS_PER_BLOCK) * block_len +
+	sizeof(final_block),
+        0
+        );
+
+    stream_pattern(block, block_len, ADDITIONAL_BLANK_CHUNKS / BLANK_CHUNKS_PER_BLOCK);
+    write_in_chunks(final_block, sizeof(final_block));
+}
+
+/**
+ * \brief Write an error response
+ *
+ * Write an error response as answer to the client's request to
+ * stdout using \a write_status() and \a download_file().
+ *
+ * \param status execution status of the business logic [IN]
+ */
+static void error_response(
+    int status
+    )
+{
+    const template_arg_t args[] = { { errormsg, strlen(errormsg) } };
+
+    /*
+     * an error response is always sent completely
+     */
+    memset(&resume, 0, sizeof(resume));
+
+    /*
+     * signal failure to client
+     */
+    write_status(status);
+
+    /*
+     * write html file with the error message
+     */
+    download_html_response(&vcs_tcpip_bulletin_board_response_error_thtml, args);
+
+    errormsg[0] = 0; /* clear error message */
+
+    if (testcase == TESTCASE_HTML_ONLY_REPLY)
+    {
+        return;  /* omit image */
+    }
+
+    if (testcase == TESTCASE_HUGE_FILE)
+    {
+	download_padding();
+    }
+
+    /*
+     * write error.png
+     */
+    download_file("error.png", error_png, sizeof(error_png), 0);
+}
+
+/**
+ * \brief Write the files of an OK response
+ *
+ * Write the HTML file and ok.png of an OK response to stdout using \a
+ * download_html_response() and \a download_file().
+ *
+ * \param url zero-terminated string containing the URL to the bulletin board web page [IN]
+ */
+static void download_ok_files(
+    const char *url
+    )
+{
+    /*
+     * in the prepared html response we have the url twice as
+     * placeholder.
+     */
+    const size_t url_len = strlen(url);
+    const template_arg_t args[] = { { url, url_len }, { url, url_len } };
+
+    /*
+     * write html file
+     */
+    download_html_response(&vcs_tcpip_bulletin_board_response_ok_thtml, args);
+
+    if (testcase == TESTCASE_HTML_ONLY_REPLY)
+    {
+        return;  /* omit image */
+    }
+
+    /*
+     * the padding precedes ok.png, it is omitted if the response is
+     * resumed at ok.png.
+     */
+    if ((testcase == TESTCASE_HUGE_FILE) && (resume.file[0] == '\0'))
+    {
+	download_padding();
+    }
+    /*
+     * write ok.png
+     */
+    download_file("ok.png", ok_png, sizeof(ok_png), 0);
+}
+
+/**
+ * \brief Write an OK response
+ *
+ * Write an OK response as answer to the client's request to
+ * stdout using \a write_status() and \a download_file(). If the client
+ * resumes interrupted responses, the status of a post carries its
+ * sequence number as id of the response: the line "id=<id>" follows
+ * the status line resp. the status frame carries the field id.
+ *
+ * \param url zero-terminated string containing the URL to the bulletin board web page [IN]
+ * \param request the processed request [IN]
+ */
+static void ok_response(
+    const char *url,
+    const request_t *request
+    )
+{
+    static const char fmt_id[] = "id=%llu\n";
+    char s[MAXSEQDIGITS + sizeof(fmt_id)];
+    int cnt;
+
+    /*
+     * signal success to client
+     */
+    if (protocol == PROTOCOL_V2)
+    {
+        write_status_frame(SMSL_E_OK, request);
+    }
+    else
+    {
+        write_status(SMSL_E_OK);
+    }
+
+    if (
+        (protocol == PROTOCOL_V1) &&
+        (response_ranges == RANGES_BYTES) &&
+        (request->type == REQUEST_POST) &&
+        (request->seq != 0)
+        )
+    {
+        cnt = snprintf(s, sizeof(s), fmt_id, (unsigned long long) request->seq);
+
+        if ((cnt < 0) || ((size_t) cnt >= sizeof(s)))
+        {
+            ERROR_EXIT(
+	        "%s: snprintf() failed.",
+	        __func__
+	        );
+        }
+
+        write_in_chunks(s, (size_t) cnt);
+    }
+
+    download_ok_files(url);
+}
+
+/**
+ * \brief Write a batch response
+ *
+ * Write the response to a batch request to stdout: the status frame
+ * carries the status of every record, the files are those of an OK
+ * response.
+ *
+ * \param url zero-terminated string containing the URL to the bulletin board web page [IN]
+ * \param request the processed batch request [IN]
+ */
+static void batch_response(
+    const char *url,
+    request_t *request
+    )
+{
+    write_status_frame(SMSL_E_OK, request);
+
+    download_ok_files(url);
+
+    free(request->record_status);
+    request->record_status = NULL;
+}
+
+/**
+ * \brief Write a metrics response
+ *
+ * Write the response to a metrics request to stdout using \a
+ * write_status() and \a download_file(). The status line is followed
+ * by the file bulletin_board_metrics.txt containing the metrics.
+ *
+ * \param request the processed metrics request [IN]
+ */
+static void metrics_response(
+    request_t *request
+    )
+{
+    write_status(SMSL_E_OK);
+
+    download_file(
+        "bulletin_board_metrics.txt",
+        request->body,
+        request->body_len,
+        0
+        );
+
+    free(request->body);
+    request->body = NULL;
+}
+
+/**
+ * \brief Search next tag in the given string
+ *
+ * Search the next HTML tag in the zero-terminated string \a s and return
+ * a pointer to the start and the end of the tag via \a beginp and \a endp.
+ * In case that no tag is found beginp and endp are not changed.
+ *
+ * \param s zero-terminated string which shall be searched trough [IN]
+ * \param beginp pointer to the begin of the tag [OUT]
+ * \param endp pointer to the end of the tag [OUT]
+ *
+ * \return Information whether or not a tag was found.
+ * \retval 0 a tag was found
+ * \retval -1 no tag found
+ */
+static int search_next_tag(
+    const char *s,
+    const char **beginp,
+    const char **endp
+    )
+{
+    const char *beg = NULL;
+
+    /*
+     * a tag starts with a '<' and ends with '>'.
+     * first we have to find the start of a tag.
+     */
+    for (; *s != 0; s++)
+    {
+        if (*s == '<')
+	{
+            beg = s; /* start of a tag found */
+            break;
+        }
+    }
+
+    /*
+     * now search the end of the tag.
+     */
+    for (; *s != 0; s++)
+    {
+        if (*s == '>')
+	{
+            *beginp = beg; /* end of a tag found */
+            *endp = s;
+            return 0;
+        }
+        
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Validate client input
+ *
+ * Checks if the data received from the client is UTF-8 text without
+ * control characters (see utf8_validate()) and does not contain
+ * unsupported HTML tags.
+ *
+ * \param buf pointer to the buffer conatining the client's input data [IN]
+ * \param len size fo the buffer pointed to by \a buf.
+ * 
+ * \return Information whether or not the input is accepted.
+ * \retval 0 input is valid
+ * \retval 1 input rejected
+ */
+static int validate_input(
+    const char *buf,
+    size_t len
+    )
+{
+    size_t i;
+    const char *cp, *tag_begin, *tag_end;
+    char tag[MAXTAGLEN];
+    int tag_valid;
+
+    if ((i = utf8_validate(buf, len)) < len)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            ((unsigned char) buf[i] < 0x80U) ?
+            "Request contains non printable character "
+            "0x%.2X at position %zu\n" :
+            "Request contains invalid or non printable UTF-8 sequence "
+            "starting with 0x%.2X at position %zu\n",
+            (unsigned char) buf[i], i
+            );
+        return -1; /* input contains a non-printable character. */
+    }
+
+    /*
+     * check if input is null-terminated.
+     * this case should never occur...
+     */
+    if (buf[len] != 0)
+    {
+        ERROR_EXIT(
+	    "%s: fatal error. - Input is not null-terminated.",
+	    __func__
+	    );
+    }
+
+    /*
+     * check for allowed html tags
+     */
+    for (
+	cp = buf;
+	search_next_tag(cp, &tag_begin, &tag_end) == 0;
+         cp = tag_end + 1
+	)
+    {
+        const size_t tag_len = tag_end - tag_begin + 1;
+
+        tag_valid = 0;
+        for (
+	    i = 0;
+	    i < (sizeof(allowed_tags) / sizeof(*allowed_tags));
+	    i++
+	    )
+        {
+            if (
+		strncmp(
+                    allowed_tags[i],
+		    tag_begin,
+		    tag_len
+                    ) == 0
+		)
+            {
+                tag_valid = 1;
+                break;
+            }
+        }
+        if (tag_len >= MAXTAGLEN - 1)
+        {
+            (void) strncpy(tag, tag_begin, MAXTAGLEN - 5);
+            tag[MAXTAGLEN - 5] = '.';
+            tag[MAXTAGLEN - 4] = '.';
+            tag[MAXTAGLEN - 3] = '.';
+            tag[MAXTAGLEN - 2] = '>';
+            tag[MAXTAGLEN - 1] = '\0';
+        }
+        else
+        {
+            (void) strncpy(tag, tag_begin, tag_len);
+            tag[tag_len] = '\0';
+        }
+
+        if (!tag_valid)
+        {
+            (void) snprintf(
+                errormsg,
+		sizeof(errormsg),
+                "Contains unsupported HTML tag <pre>%s</pre>\n",
+                tag
+                );
+            return -1;  /* found tag not supported / allowed */
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Replace first '\n' with '\0'
+ *
+ * Search for the first '\n' and replace it with '\0'.
+ *
+ * \param s zero-terminated string containing at least one '\n'
+ *
+ * \return Information on whether or not the replacement was done
+ * \retval 0 success - the first '\n' was replaced with '\0' 
+ * \retval -1 no newline is found and thus no newline replaced
+ */
+static int terminate_string_at_newline(
+    char *s
+    )
+{
+    for (; *s; s++)
+    {
+        if (*s == '\n')
+        {
+            *s = 0;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * \brief Parse and split client input
+ *
+ * Parse and split client input into user, message and the optional
+ * image. Note: this function modifies the passed string by replacing
+ * some '\n' with null-terminators to split the passed string into the
+ * three parts mentioned above. The pointer passed back point into the
+ * buffer if the associated keyword is found or set to NULL otherwise.
+ *
+ * \param buf zero-terminated string containing the data from
+ *            the client [IN]
+ * \param userp set to the begin of the user name or
+ *              to NULL if the keyword "user=" is not found. [OUT]
+ * \param imgp set to the begin of the image url or
+ *             to NULL if the keyword "img=" is not found. [OUT]
+ * \param msgp set to the begin of the message or
+ *             to NULL if this part of the input is empty. [OUT]
+ *
+ * \return Information on whether or not the client input was valid
+ * \retval 0 the input is valid and contains at least a user name
+ *           and a message
+ * \retval -1 input is invalid
+ */
+static int split_input(
+    char *buf,
+    const char **userp,
+    const char **imgp,
+    const char **msgp
+    )
+{
+    char *user, *img, *msg;
+    const char *kw_user = "user=";
+    const char *kw_img = "img=";
+
+    /*
+     * the input shall have the following format:
+     *
+     * user=<username>
+     * img=<URL>
+     * <message>
+     * :
+     * :
+     * EOF
+     *
+     * img is optional and must follow user if present.
+     */
+
+    if (strncmp(buf, kw_user, strlen(kw_user)) != 0)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Keyword <code>user</code> is missing in first line of request\n"
+            );
+        return -1;
+    }
+
+    user = buf + strlen(kw_user);
+    if (terminate_string_at_newline(user))
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Line with keyword <code>user</code> is not newline terminated\n"
+            );
+        return -1;  /* no newline replaced */
+    }
+
+    img = user + strlen(user) + 1;
+    if (strncmp(img, kw_img, strlen(kw_img)) != 0)
+    {
+        img = NULL;
+    }
+    else
+    {
+        img += strlen(kw_img);
+
+        if (terminate_string_at_newline(img))
+        {
+            (void) snprintf(
+                errormsg,
+		sizeof(errormsg),
+                "Line with keyword <code>img</code> is not newline terminated\n"
+                );
+            return -1;  /* no newline replaced */
+        }
+    }
+
+    /*
+     * now find begin of message
+     */
+    msg = (img != NULL) ? img : user;
+    msg += strlen(msg) + 1;
+
+    /*
+     * perform some checks
+     */
+    if (strlen(user) == 0)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Keyword <code>user</code> ist present but username is missing\n"
+            );
+        return -1;
+    }
+
+    if (strlen(msg) == 0)
+    {
+        (void) snprintf(
+	    errormsg,
+	    sizeof(errormsg),
+	    "Message is empty\n");
+        return -1;
+    }
+
+    if ((img != NULL) && (strlen(img) == 0))
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Keyword <code>img</code> ist present, but URL to image is missing\n");
+        return -1;
+    }
+
+    *userp = user;
+    *imgp = img;
+    *msgp = msg;
+
+    return 0;
+}
+
+/**
+ * \brief Build the name of a file in the public_html directory
+ *
+ * Build the path of the file \a name located in the public_html
+ * directory in the user's \a homedir, i.e. in the directory of the
+ * board addressed by the request (see SMSL_BOARDS). In case of an
+ * error the error message for the client is set.
+ *
+ * \param file pointer to buffer to be filled with the path [OUT]
+ * \param file_len size of the buffer pointed to by \a file [IN]
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param name zero-terminated string containing the name of the file [IN]
+ *
+ * \retval 0 success
+ * \retval -1 path does not fit into \a file
+ */
+static int make_public_filename(
+    char *file,
+    size_t file_len,
+    const char *homedir,
+    const char *name
+    )
+{
+    int cnt;
+
+    cnt = snprintf(file, file_len, "%s/public_html/%s%s", homedir, board_dir(), name);
+
+    if ((cnt < 0) || ((size_t) cnt >= file_len))
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+	    "Filename for bulleting board file (incl. path) is too long - "
+	    "only a maximum of %zu bytes are supported\n",
+            file_len
+            );
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Select the board addressed by the request
+ *
+ * Look up the board \a name and make it the board of the request. The
+ * directory and the main page of the board are created unless this has
+ * been done already.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param name the name of the board, not necessarily zero-terminated [IN]
+ * \param len length of \a name [IN]
+ *
+ * \return Information on whether or not the board has been selected
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_INVAL the board is not listed in SMSL_BOARDS
+ * \retval SMSL_E_FAILED the directory of the board could not be created
+ */
+static int select_board(
+    const char *homedir,
+    const char *name,
+    size_t len
+    )
+{
+    char dir[MAXPATHLEN];
+    board_t *found;
+
+    board = NULL;
+
+    if ((found = find_board(name, len)) == NULL)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unknown board <code>%.*s</code>\n",
+	    (int) ((len < SMP2_MAXBOARDLEN) ? len : SMP2_MAXBOARDLEN),
+	    name
+            );
+        return SMSL_E_INVAL;
+    }
+
+    if (!found->created)
+    {
+        if (
+            (make_public_filename(dir, sizeof(dir), homedir, BOARDS_DIR) == -1) ||
+            ((mkdir(dir, 0755) == -1) && (errno != EEXIST))
+            )
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Unable to create directory <code>%s</code> - <pre>%s</pre>\n",
+	        BOARDS_DIR,
+	        strerror(errno)
+                );
+            return SMSL_E_FAILED;
+        }
+
+        board = found;
+
+        if (
+            (make_public_filename(dir, sizeof(dir), homedir, "") == -1) ||
+            ((mkdir(dir, 0755) == -1) && (errno != EEXIST))
+            )
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Unable to create directory <code>%s</code> - <pre>%s</pre>\n",
+	        found->dir,
+	        strerror(errno)
+                );
+            board = NULL;
+            return SMSL_E_FAILED;
+        }
+
+        if (create_main_page(homedir) == -1)
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Server could not create main HTML page\n"
+                );
+            board = NULL;
+            return SMSL_E_FAILED;
+        }
+
+        found->created = 1;
+    }
+
+    board = found;
+
+    return SMSL_E_OK;
+}
+
+/**
+ * \brief Get the shared metrics
+ *
+ * Map the metrics shared by all instances of the business logic on
+ * first use.
+ *
+ * \return pointer to the shared metrics
+ * \retval NULL the metrics segment could not be mapped
+ */
+static metrics_t *get_metrics(
+    void
+    )
+{
+    if (metrics == NULL)
+    {
+        metrics = shared_segment_map(METRICS_SEGMENT, sizeof(*metrics));
+    }
+
+    return metrics;
+}
+
+/**
+ * \brief Flush files to stable storage
+ *
+ * Call fdatasync() for all \a count file descriptors in \a fds and
+ * account the time taken in the fsync latency histogram of the shared
+ * metrics.
+ *
+ * \param fds the file descriptors to be synced [IN]
+ * \param count number of file descriptors in \a fds [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int sync_files(
+    const int *fds,
+    size_t count
+    )
+{
+    struct timespec start, end;
+    metrics_t *m = get_metrics();
+    uint64_t us;
+    unsigned int bucket = 0;
+    size_t i;
+    int rc = 0;
+    int saved_errno;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; (i < count) && (rc == 0); i++)
+    {
+        rc = fdatasync(fds[i]);
+    }
+
+    saved_errno = errno;
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (m != NULL)
+    {
+        us = (uint64_t) (end.tv_sec - start.tv_sec) * 1000000U +
+            (uint64_t) (end.tv_nsec / 1000) - (uint64_t) (start.tv_nsec / 1000);
+
+        while ((us > 1) && (bucket < FSYNC_HISTOGRAM_BUCKETS - 1))
+        {
+            us >>= 1;
+            bucket++;
+        }
+
+        __atomic_add_fetch(&m->fsync_histogram[bucket], 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(
+            (rc == 0) ? &m->fsync_count : &m->fsync_errors,
+            1,
+            __ATOMIC_RELAXED
+            );
+    }
+
+    errno = saved_errno;
+
+    return rc;
+}
+
+/**
+ * \brief Sync files as part of a group commit
+ *
+ * Concurrent posts share a single sync: the first post taking the sync
+ * lock becomes the leader and syncs its files, which are the very same
+ * files the other posts have written to. All posts which finished
+ * their writes before the leader started the sync are durable as soon
+ * as it has completed, they only need to take the lock to find out.
+ * If SMSL_GROUP_COMMIT_DELAY is set, the leader waits the given time
+ * before syncing to let further posts join the group.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param fds the file descriptors to be synced [IN]
+ * \param count number of file descriptors in \a fds [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int group_commit(
+    const char *homedir,
+    const int *fds,
+    size_t count
+    )
+{
+    char file[MAXPATHLEN];
+    struct timespec delay;
+    metrics_t *m;
+    uint64_t *started, *completed;
+    uint64_t target, round;
+    int fd, rc, saved_errno;
+
+    /*
+     * without the shared state (or the lock) every post syncs on its own.
+     */
+    if ((m = get_metrics()) == NULL)
+    {
+        return sync_files(fds, count);
+    }
+
+    /*
+     * every board has a sync lock of its own, thus its own sync numbers.
+     */
+    started = &m->sync_started;
+    completed = &m->sync_completed;
+
+    if (board != NULL)
+    {
+        started = &m->board_sync[board - boards].started;
+        completed = &m->board_sync[board - boards].completed;
+    }
+
+    /*
+     * our data is written, thus any sync started from now on covers it.
+     */
+    target = __atomic_load_n(started, __ATOMIC_ACQUIRE) + 1;
+
+    if (
+        (make_public_filename(file, sizeof(file), homedir, BULLETIN_BOARD_SYNC_LOCK_FILE) == -1) ||
+        ((fd = open(file, O_RDWR | O_CREAT, 0644)) == -1)
+        )
+    {
+        return sync_files(fds, count);
+    }
+
+    if (flock(fd, LOCK_EX) == -1)
+    {
+        (void) close(fd);
+        return sync_files(fds, count);
+    }
+
+    if (__atomic_load_n(completed, __ATOMIC_ACQUIRE) >= target)
+    {
+        (void) close(fd);  /* unlock performed automatically with close */
+        return 0;
+    }
+
+    if (group_commit_delay > 0)
+    {
+        delay.tv_sec = group_commit_delay / 1000;
+        delay.tv_nsec = (group_commit_delay % 1000) * 1000000L;
+        (void) nanosleep(&delay, NULL);
+    }
+
+    /*
+     * only the holder of the lock modifies the sync numbers.
+     */
+    round = __atomic_add_fetch(started, 1, __ATOMIC_ACQ_REL);
+
+    if ((rc = sync_files(fds, count)) == 0)
+    {
+        __atomic_store_n(completed, round, __ATOMIC_RELEASE);
+    }
+
+    saved_errno = errno;
+    (void) close(fd);  /* unlock performed automatically with close */
+    errno = saved_errno;
+
+    return rc;
+}
+
+/**
+ * \brief Make written posts durable
+ *
+ * Flush the files given by \a fds according to the durability policy
+ * selected with SMSL_DURABILITY. The post must not be acknowledged
+ * before this function returned successfully.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param fds the file descriptors the post has been written to [IN]
+ * \param count number of file descriptors in \a fds [IN]
+ * \param posts number of posts written to \a fds [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int make_durable(
+    const char *homedir,
+    const int *fds,
+    size_t count,
+    size_t posts
+    )
+{
+    metrics_t *m;
+    int rc;
+
+    switch (durability)
+    {
+        case DURABILITY_GROUP:
+            rc = group_commit(homedir, fds, count);
+            break;
+        case DURABILITY_STRICT:
+            rc = sync_files(fds, count);
+            break;
+        case DURABILITY_NONE:
+        default:
+            return 0;
+    }
+
+    if (rc == -1)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to sync post to disk - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        return -1;
+    }
+
+    if ((m = get_metrics()) != NULL)
+    {
+        __atomic_add_fetch(&m->posts_synced, posts, __ATOMIC_RELAXED);
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Notify the subscribers of committed posts
+ *
+ * Increment the post events of the shared metrics and wake all
+ * subscribers waiting for them with a single futex wake-up.
+ */
+static void notify_subscribers(
+    void
+    )
+{
+    metrics_t *m;
+
+    if ((m = get_metrics()) == NULL)
+    {
+        return;  /* the subscribers poll in that case */
+    }
+
+    (void) __atomic_add_fetch(&m->post_events, 1, __ATOMIC_RELEASE);
+    (void) syscall(SYS_futex, &m->post_events, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * \brief Wait for committed posts
+ *
+ * Wait until the post events of the shared metrics differ from \a
+ * events, i.e. until posts have been committed since \a events has
+ * been read, or SUBSCRIBE_POLL_INTERVAL milliseconds have passed.
+ *
+ * \param events post events read before checking for new posts [IN]
+ *
+ * \retval 1 posts may have been committed
+ * \retval 0 the time has passed without any commit
+ */
+static int wait_for_posts(
+    uint32_t events
+    )
+{
+    struct timespec timeout;
+    struct pollfd pfd;
+    metrics_t *m;
+
+    if ((m = get_metrics()) == NULL)
+    {
+        pfd.fd = STDIN_FILENO;
+        pfd.events = POLLIN;
+        (void) poll(&pfd, 1, (int) SUBSCRIBE_POLL_INTERVAL);
+        return 1;
+    }
+
+    timeout.tv_sec = SUBSCRIBE_POLL_INTERVAL / 1000;
+    timeout.tv_nsec = (SUBSCRIBE_POLL_INTERVAL % 1000) * 1000000L;
+
+    /*
+     * returns at once if the events have changed in the meantime
+     */
+    if (
+        (syscall(SYS_futex, &m->post_events, FUTEX_WAIT, events, &timeout, NULL, 0) == -1) &&
+        (errno == ETIMEDOUT)
+        )
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Get the shared post ring
+ *
+ * Map the ring of the recent posts shared by all instances of the
+ * business logic on first use.
+ *
+ * \return pointer to the shared post ring
+ * \retval NULL the post ring could not be mapped
+ */
+static pr_ring_t *get_post_ring(
+    void
+    )
+{
+    if (post_ring == NULL)
+    {
+        post_ring = pr_map();
+    }
+
+    return post_ring;
+}
+
+/**
+ * \brief Get the shared duplicate filter
+ *
+ * Map the filter of the recent posts shared by all instances of the
+ * business logic on first use.
+ *
+ * \return pointer to the shared duplicate filter
+ * \retval NULL the filter could not be mapped
+ */
+static df_filter_t *get_dup_filter(
+    void
+    )
+{
+    if (dup_filter == NULL)
+    {
+        dup_filter = df_map(
+            (size_t) duplicate_memory * 1024U,
+            (unsigned long) duplicate_window
+            );
+    }
+
+    return dup_filter;
+}
+
+/**
+ * \brief Check whether a post is a duplicate
+ *
+ * Count the post in the shared duplicate filter unless the same user
+ * has posted the same message \a duplicate_limit times within the last
+ * \a duplicate_window seconds already. The check is done before the
+ * post store is locked, thus a flood of copies is rejected without
+ * touching the files. A filter which cannot be mapped is reported on
+ * stderr and admits every post. A post which cannot be stored has to be
+ * withdrawn by \a withdraw_duplicate(), thus it may be posted again.
+ *
+ * \param user the name of the posting user [IN]
+ * \param user_len length of \a user [IN]
+ * \param msg the message [IN]
+ * \param msg_len length of \a msg [IN]
+ * \param now the current time [IN]
+ *
+ * \retval 0 the post is no duplicate
+ * \retval -1 the post is a duplicate
+ */
+static int check_duplicate(
+    const char *user,
+    size_t user_len,
+    const char *msg,
+    size_t msg_len,
+    time_t now
+    )
+{
+    df_filter_t *filter;
+    metrics_t *m;
+
+    if (duplicate_window == 0)
+    {
+        return 0;
+    }
+
+    if ((filter = get_dup_filter()) == NULL)
+    {
+        ERROR("%s: Unable to map duplicate filter.", __func__);
+        return 0;
+    }
+
+    if (
+        df_admit(
+            filter,
+            df_hash(user, user_len, msg, msg_len),
+            (uint64_t) now,
+            (unsigned long) duplicate_limit
+            )
+        )
+    {
+        return 0;
+    }
+
+    if ((m = get_metrics()) != NULL)
+    {
+        __atomic_add_fetch(&m->duplicates_rejected, 1, __ATOMIC_RELAXED);
+    }
+
+    (void) snprintf(
+        errormsg,
+	sizeof(errormsg),
+        "Message has already been posted by this user within the last "
+        "%ld seconds\n",
+	duplicate_window
+        );
+
+    return -1;
+}
+
+/**
+ * \brief Withdraw a post admitted by the duplicate filter
+ *
+ * Uncount a post admitted by \a check_duplicate() which could not be
+ * stored, thus a retry of the client is not rejected as a duplicate.
+ *
+ * \param user the name of the posting user [IN]
+ * \param user_len length of \a user [IN]
+ * \param msg the message [IN]
+ * \param msg_len length of \a msg [IN]
+ * \param now the time passed to \a check_duplicate() [IN]
+ */
+static void withdraw_duplicate(
+    const char *user,
+    size_t user_len,
+    const char *msg,
+    size_t msg_len,
+    time_t now
+    )
+{
+    df_filter_t *filter;
+
+    if ((duplicate_window == 0) || ((filter = get_dup_filter()) == NULL))
+    {
+        return;
+    }
+
+    df_withdraw(filter, df_hash(user, user_len, msg, msg_len), (uint64_t) now);
+}
+
+/**
+ * \brief Get the shared sketches of the heaviest users
+ *
+ * Map the sketches shared by all instances of the business logic on
+ * first use.
+ *
+ * \return pointer to the shared sketches
+ * \retval NULL the sketches could not be mapped
+ */
+static hh_table_t *get_heavy_hitters(
+    void
+    )
+{
+    if (heavy_hitters == NULL)
+    {
+        heavy_hitters = hh_map();
+    }
+
+    return heavy_hitters;
+}
+
+/**
+ * \brief Count an accepted request
+ *
+ * Count the request in the sketch of the client addresses. A request
+ * received from anything but a socket is not counted.
+ */
+static void count_request(
+    void
+    )
+{
+    hh_table_t *table;
+
+    if ((peer_address[0] != '\0') && ((table = get_heavy_hitters()) != NULL))
+    {
+        hh_count(&table->sketches[HH_ADDRESSES], peer_address, strlen(peer_address));
+    }
+}
+
+/**
+ * \brief Count a committed post
+ *
+ * Count the post in the sketches of the posting users and of the posted
+ * messages. Sketches which cannot be mapped are skipped silently, the
+ * post has been committed anyway.
+ *
+ * \param user the name of the posting user [IN]
+ * \param user_len length of \a user [IN]
+ * \param msg the message [IN]
+ * \param msg_len length of \a msg [IN]
+ */
+static void count_post(
+    const char *user,
+    size_t user_len,
+    const char *msg,
+    size_t msg_len
+    )
+{
+    hh_table_t *table;
+
+    if ((table = get_heavy_hitters()) == NULL)
+    {
+        return;
+    }
+
+    hh_count(&table->sketches[HH_USERS], user, user_len);
+    hh_count(&table->sketches[HH_MESSAGES], msg, msg_len);
+}
+
+/**
+ * \brief Publish committed posts in the shared post ring
+ *
+ * \param store the post store holding the posts [IN]
+ * \param first number of the first post in the store (counting from 0) [IN]
+ * \param posts the posts [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param content the rendered content entries of the posts [IN]
+ * \param entry_lens length of the content entry of every post [IN]
+ */
+static void publish_posts(
+    const bb_store_t *store,
+    uint64_t first,
+    const bb_post_t *posts,
+    size_t count,
+    const char *content,
+    const size_t *entry_lens
+    )
+{
+    pr_ring_t *ring;
+    uint64_t id;
+    size_t i;
+
+    if (((ring = get_post_ring()) == NULL) || ((id = bb_id(store)) == 0))
+    {
+        return;  /* the readers use the post store */
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        pr_publish(ring, id, first + i + 1, &posts[i], content, entry_lens[i]);
+        content += entry_lens[i];
+    }
+}
+
+/**
+ * \brief Render a post of the post store
+ *
+ * Copy the content entry of post number \a number (counting from 0)
+ * from the shared post ring, or read and render it from the post store
+ * if the ring does not hold it (any more).
+ *
+ * \param store the opened post store [IN]
+ * \param id identity of the store as returned by \a bb_id() [IN]
+ * \param number number of the post [IN]
+ * \param buf buffer of BB_MAXENTRYLEN bytes for the content entry [OUT]
+ *
+ * \return length of the content entry
+ * \retval -1 the post could not be read
+ */
+static int render_post(
+    bb_store_t *store,
+    uint64_t id,
+    uint64_t number,
+    char *buf
+    )
+{
+    pr_ring_t *ring = get_post_ring();
+    bb_record_t record;
+    size_t len;
+
+    if (
+        (ring != NULL) &&
+        (id != 0) &&
+        (pr_read(ring, id, number + 1, NULL, buf, &len) == 0)
+        )
+    {
+        return (int) len;
+    }
+
+    if (bb_read(store, number, &record) == -1)
+    {
+        return -1;
+    }
+
+    return bb_render(&record.post, buf, BB_MAXENTRYLEN);
+}
+
+/**
+ * \brief Write the posts of a response as chunked file
+ *
+ * Render the posts whose numbers were stored in \a request by \a
+ * defer_posts() and write them as chunks of at most CHUNK_MAXPOSTS
+ * posts, thus the client receives the first posts before the last ones
+ * have been read. A post which cannot be read any more terminates the
+ * connection without the final chunk, the client notices the truncated
+ * file.
+ *
+ * \param filename name of the file to be written [IN]
+ * \param request the processed request [IN]
+ */
+static void download_posts_chunked(
+    const char *filename,
+    request_t *request
+    )
+{
+    const uint64_t id = bb_id(&request->store);
+    char *buf;
+    size_t i, len = 0;
+    int cnt;
+
+    if ((buf = malloc(CHUNK_MAXPOSTS * BB_MAXENTRYLEN)) == NULL)
+    {
+        ERROR_EXIT(
+	    "%s: malloc() failed.",
+	    __func__
+	    );
+    }
+
+    download_chunked_header(filename);
+
+    for (i = 0; i < request->post_count; i++)
+    {
+        cnt = render_post(&request->store, id, request->posts[i], buf + len);
+
+        /*
+         * a post overwritten in a store keeping only the newest posts is
+         * skipped, the status has been sent already.
+         */
+        if ((cnt == -1) && (errno == ENOENT) && (request->store.backend->kept != 0))
+        {
+            cnt = 0;
+        }
+        else if (cnt == -1)
+        {
+            ERROR_EXIT(
+	        "%s: unable to read post %llu from post store.",
+	        __func__,
+	        (unsigned long long) request->posts[i] + 1
+	        );
+        }
+
+        len += (size_t) cnt;
+
+        if ((i + 1) % CHUNK_MAXPOSTS == 0)
+        {
+            download_chunk(buf, len);
+            len = 0;
+        }
+    }
+
+    if (len > 0)
+    {
+        download_chunk(buf, len);
+    }
+
+    download_chunk(NULL, 0);
+
+    free(buf);
+}
+
+/**
+ * \brief Write a delta response
+ *
+ * Write the response to a delta request to stdout using \a
+ * write_status() and \a download_file(). The status line is followed
+ * by the line "seq=<n>" carrying the sequence number of the newest post
+ * contained in the response. Only if there are new posts the file
+ * bulletin_board_delta.html with their HTML content entries follows,
+ * as chunked file if the posts have been left to be rendered now.
+ * A search request is answered alike with the number of posts searched
+ * and the file bulletin_board_search.html containing the posts found, a
+ * posts by user request with the file bulletin_board_posts_by.html.
+ *
+ * \param request the processed delta, search or posts by user request [IN]
+ */
+static void delta_response(
+    request_t *request
+    )
+{
+    static const char fmt_seq[] = "seq=%llu\n";
+    const char * const filename =
+        (request->type == REQUEST_SEARCH) ? "bulletin_board_search.html" :
+        (request->type == REQUEST_POSTS_BY) ? "bulletin_board_posts_by.html" :
+            "bulletin_board_delta.html";
+    char s[MAXSEQDIGITS + sizeof(fmt_seq)];
+    int cnt;
+
+    if (protocol == PROTOCOL_V2)
+    {
+        /*
+         * the sequence number is a field of the status frame
+         */
+        write_status_frame(SMSL_E_OK, request);
+    }
+    else
+    {
+        write_status(SMSL_E_OK);
+
+        cnt = snprintf(s, sizeof(s), fmt_seq, (unsigned long long) request->seq);
+
+        if ((cnt < 0) || ((size_t) cnt >= sizeof(s)))
+        {
+            ERROR_EXIT(
+	        "%s: snprintf() failed.",
+	        __func__
+	        );
+        }
+
+        write_in_chunks(s, (size_t) cnt);
+    }
+
+    if (request->posts != NULL)
+    {
+        download_posts_chunked(filename, request);
+
+        free(request->posts);
+        request->posts = NULL;
+        request->post_count = 0;
+        bb_close(&request->store);
+    }
+    else if (request->body_len > 0)
+    {
+        download_file(filename, request->body, request->body_len, 0);
+    }
+
+    free(request->body);
+    request->body = NULL;
+}
+
+/**
+ * \brief Add committed posts to the search index
+ *
+ * The index is rewritten as soon as \a search_pending posts are not
+ * covered by it, searches read the posts not covered from the store.
+ * Failures are reported on stderr only, as the posts are already
+ * stored.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param store the post store holding the posts [IN]
+ */
+static void update_search_index(
+    const char *homedir,
+    bb_store_t *store
+    )
+{
+    char dir[MAXPATHLEN];
+
+    if (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+    {
+        ERROR("%s: Path of search index too long.", __func__);
+        return;
+    }
+
+    if (si_update(dir, store, (uint64_t) search_pending) == -1)
+    {
+        ERROR("%s: Unable to update search index.", __func__);
+    }
+}
+
+/**
+ * \brief Add committed posts to the user index
+ *
+ * Failures are reported on stderr only, as the posts are already
+ * stored. The posts not covered by the index are added by the next
+ * update, lookups read them from the store until then.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param store the post store holding the posts [IN]
+ */
+static void update_user_index(
+    const char *homedir,
+    bb_store_t *store
+    )
+{
+    char dir[MAXPATHLEN];
+
+    if (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+    {
+        ERROR("%s: Path of user index too long.", __func__);
+        return;
+    }
+
+    if (ui_update(dir, store) == -1)
+    {
+        ERROR("%s: Unable to update user index.", __func__);
+    }
+}
+
+/**
+ * \brief Sync the public_html directory
+ *
+ * Make the directory entries of newly created or renamed files in the
+ * public_html directory durable.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int sync_directory(
+    const char *homedir
+    )
+{
+    char dir[MAXPATHLEN];
+    int fd, rc;
+
+    if (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+    {
+        return -1;
+    }
+
+    if (
+        ((fd = open(dir, O_RDONLY | O_DIRECTORY)) == -1) ||
+        ((rc = sync_files(&fd, 1)) == -1)
+        )
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to sync directory <code>%.*s</code> - <pre>%s</pre>\n",
+	    MAXERRORPATHLEN,
+	    dir,
+	    strerror(errno)
+            );
+        if (fd != -1)
+        {
+            (void) close(fd);
+        }
+        return -1;
+    }
+
+    (void) close(fd);
+
+    return rc;
+}
+
+/**
+ * \brief Find the rotated segments of the content file
+ *
+ * Search the public_html directory in the user's \a homedir for
+ * rotated segments of the content file. As the segment number is
+ * zero-padded the list is sorted from the oldest to the newest segment.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param segments glob buffer to be filled with the segment names, to be
+ *        released with globfree() upon success [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int find_segments(
+    const char *homedir,
+    glob_t *segments
+    )
+{
+    char pattern[MAXPATHLEN];
+    int rc;
+
+    if (
+	make_public_filename(
+	    pattern,
+	    sizeof(pattern),
+	    homedir,
+	    BULLETIN_BOARD_SEGMENT_GLOB
+	    ) == -1
+	)
+    {
+        return -1;
+    }
+
+    rc = glob(pattern, 0, NULL, segments);
+
+    if ((rc != 0) && (rc != GLOB_NOMATCH))
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to search segments of the content file\n"
+            );
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Move the oldest segments into the archive
+ *
+ * In case more than \a segment_keep rotated segments exist in the
+ * public_html directory, the oldest ones are compressed and appended to
+ * the archive file (as separate gzip members) and removed afterwards.
+ * The archive is locked exclusively, so concurrent rotations do not
+ * archive the same segment twice.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int archive_segments(
+    const char *homedir
+    )
+{
+    char file[MAXPATHLEN];
+    char buf[CHUNKSIZE * 8];
+    glob_t segments;
+    gzFile gz;
+    size_t i;
+    ssize_t cnt;
+    int fd, segfd;
+    int rc = 0;
+
+    /*
+     * cheap check without the lock first - usually there is nothing
+     * to archive.
+     */
+    if (find_segments(homedir, &segments) == -1)
+    {
+        return -1;
+    }
+
+    i = segments.gl_pathc;
+    globfree(&segments);
+
+    if (i <= (size_t) segment_keep)
+    {
+        return 0;
+    }
+
+    if (make_public_filename(
+	    file,
+	    sizeof(file),
+	    homedir,
+	    BULLETIN_BOARD_ARCHIVE_FILE
+	    ) == -1)
+    {
+        return -1;
+    }
+
+    if ((fd = open(file, O_WRONLY | O_APPEND | O_CREAT, 0644)) == -1)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to open archive - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        return -1;
+    }
+
+    if (flock(fd, LOCK_EX) == -1)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to lock archive - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        (void) close(fd);
+        return -1;
+    }
+
+    /*
+     * search the segments only after the lock has been acquired -
+     * someone else might just have archived some of them.
+     */
+    if (find_segments(homedir, &segments) == -1)
+    {
+        (void) close(fd);
+        return -1;
+    }
+
+    if ((gz = gzdopen(dup(fd), "ab")) == NULL)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to compress archive\n"
+            );
+        globfree(&segments);
+        (void) close(fd);
+        return -1;
+    }
+
+    for (
+	i = 0;
+	(rc == 0) && (i + (size_t) segment_keep < segments.gl_pathc);
+	i++
+	)
+    {
+        if ((segfd = open(segments.gl_pathv[i], O_RDONLY)) == -1)
+        {
+            rc = -1;
+            break;
+        }
+
+        while ((cnt = read(segfd, buf, sizeof(buf))) > 0)
+        {
+            if (gzwrite(gz, buf, (unsigned) cnt) != (int) cnt)
+            {
+                cnt = -1;
+                break;
+            }
+        }
+
+        (void) close(segfd);
+
+        /*
+         * the segment is removed only after it is completely contained
+         * in the archive.
+         */
+        if (
+            (cnt == -1) ||
+            (gzflush(gz, Z_FINISH) != Z_OK) ||
+            (unlink(segments.gl_pathv[i]) == -1)
+            )
+        {
+            rc = -1;
+        }
+    }
+
+    if ((gzclose(gz) != Z_OK) || (rc == -1))
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to archive segments of the content file\n"
+            );
+        rc = -1;
+    }
+
+    globfree(&segments);
+    (void) close(fd);  /* unlock performed automatically with close */
+
+    return rc;
+}
+
+/**
+ * \brief Rotate the active content file into a new segment
+ *
+ * Rename the active content file \a file into the next segment and
+ * archive old segments according to the retention policy. The caller
+ * has to hold an exclusive lock on the active content file.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param file zero-terminated string containing the path to the active content file [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int rotate_content_file(
+    const char *homedir,
+    const char *file
+    )
+{
+    char segment[MAXPATHLEN];
+    char name[sizeof(BULLETIN_BOARD_SEGMENT_FILE) + MAXFILESIZEDIGITS];
+    const char *last;
+    unsigned long number = 0;
+    glob_t segments;
+
+    if (find_segments(homedir, &segments) == -1)
+    {
+        return -1;
+    }
+
+    if (segments.gl_pathc > 0)
+    {
+        last = strrchr(segments.gl_pathv[segments.gl_pathc - 1], '/');
+        if (sscanf(last, "/bulletin_board_content.%lu.dat", &number) == 1)
+        {
+            number++;
+        }
+    }
+
+    globfree(&segments);
+
+    (void) snprintf(name, sizeof(name), BULLETIN_BOARD_SEGMENT_FILE, number);
+
+    if (make_public_filename(segment, sizeof(segment), homedir, name) == -1)
+    {
+        return -1;
+    }
+
+    if (rename(file, segment) == -1)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to rotate content file - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        return -1;
+    }
+
+    return archive_segments(homedir);
+}
+
+/**
+ * \brief Check whether the active content file has to be rotated
+ *
+ * \param statbuf status of the active content file [IN]
+ *
+ * \return Information on whether or not a rotation is due
+ * \retval 1 the segment exceeds its size or its time period is over
+ * \retval 0 the segment may still be appended to
+ */
+static int segment_rotation_due(
+    const struct stat *statbuf
+    )
+{
+    if (statbuf->st_size == 0)
+    {
+        return 0;
+    }
+
+    if (statbuf->st_size >= segment_size)
+    {
+        return 1;
+    }
+
+    /*
+     * segments are bounded to periods of segment_age seconds: the
+     * segment is closed once the last write happened in an earlier
+     * period.
+     */
+    return (segment_age > 0) &&
+        ((time(NULL) / segment_age) != (statbuf->st_mtime / segment_age));
+}
+
+/**
+ * \brief Open the active content file for appending
+ *
+ * Open the active content file \a file with O_APPEND. If SMSL_APPEND_MODE
+ * is "flock" the file is returned locked exclusively, if it is "atomic"
+ * the file is returned with a shared lock, which keeps it from being
+ * rotated while the entries are written. Before the file is returned it
+ * is rotated into a segment if the rotation policy demands. Writers
+ * which opened the active file before a concurrent rotation detect the
+ * rename once they hold the lock and reopen the new active file.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param file zero-terminated string containing the path to the active content file [IN]
+ *
+ * \return file descriptor of the active content file
+ * \retval -1 failed
+ */
+static int open_content_file(
+    const char *homedir,
+    const char *file
+    )
+{
+    struct stat statbuf, pathbuf;
+    int fd;
+    int lock;
+
+    for (;;)
+    {
+        if ((fd = open(file, O_WRONLY | O_APPEND | O_CREAT, 0644)) == -1)
+        {
+            (void) snprintf(
+                errormsg,
+                sizeof(errormsg),
+                "Unable to open file <code>%.*s</code> - <pre>%s</pre>\n",
+                MAXERRORPATHLEN,
+                file,
+                strerror(errno)
+                );
+            return -1;
+        }
+
+        /*
+         * in atomic mode we rely on O_APPEND: the kernel positions every
+         * write() at the end of file, so a single write() of the whole
+         * entry can not be interleaved with entries of concurrent writers.
+         * they share the lock, it only excludes the rotation, which
+         * would otherwise rename (and archive) the file underneath the
+         * write.
+         */
+        lock = (append_mode == APPEND_MODE_FLOCK) ? LOCK_EX : LOCK_SH;
+
+        if (flock(fd, lock) == -1)
+        {
+            (void) snprintf(
+                errormsg,
+                sizeof(errormsg),
+                "Unable to lock file <code>%.*s</code> - <pre>%s</pre>\n",
+                MAXERRORPATHLEN,
+                file,
+                strerror(errno)
+                );
+            (void) close(fd);
+            return -1;
+        }
+
+        if (fstat(fd, &statbuf) == -1)
+        {
+            (void) snprintf(
+                errormsg,
+                sizeof(errormsg),
+                "Unable to stat file <code>%.*s</code> - <pre>%s</pre>\n",
+                MAXERRORPATHLEN,
+                file,
+                strerror(errno)
+                );
+            (void) close(fd);
+            return -1;
+        }
+
+        /*
+         * while we waited for the lock the file might have been rotated
+         * by someone else. in that case the new active file is opened.
+         */
+        if (
+            (stat(file, &pathbuf) == -1) ||
+            (pathbuf.st_ino != statbuf.st_ino) ||
+            (pathbuf.st_dev != statbuf.st_dev)
+            )
+        {
+            (void) close(fd);
+            continue;
+        }
+
+        if (!segment_rotation_due(&statbuf))
+        {
+            /*
+             * the directory entry of a new content file (and the
+             * rename of its predecessor) has to be durable as well.
+             */
+            if (
+                (statbuf.st_size == 0) &&
+                (durability != DURABILITY_NONE) &&
+                (sync_directory(homedir) == -1)
+                )
+            {
+                (void) close(fd);
+                return -1;
+            }
+
+            return fd;
+        }
+
+        /*
+         * the shared lock is converted into an exclusive one, which
+         * waits for the writes in progress. the conversion releases the
+         * shared lock first, thus two writers converting at the same
+         * time do not deadlock - the second one finds the file rotated.
+         */
+        if ((lock == LOCK_SH) && (flock(fd, LOCK_EX) == -1))
+        {
+            (void) snprintf(
+                errormsg,
+                sizeof(errormsg),
+                "Unable to lock file <code>%.*s</code> - <pre>%s</pre>\n",
+                MAXERRORPATHLEN,
+                file,
+                strerror(errno)
+                );
+            (void) close(fd);
+            return -1;
+        }
+
+        /*
+         * posts acknowledged by a group sync of the next segment must
+         * not remain unsynced in this one.
+         */
+        if ((durability != DURABILITY_NONE) && (sync_files(&fd, 1) == -1))
+        {
+            (void) snprintf(
+                errormsg,
+                sizeof(errormsg),
+                "Unable to sync file <code>%.*s</code> - <pre>%s</pre>\n",
+                MAXERRORPATHLEN,
+                file,
+                strerror(errno)
+                );
+            (void) close(fd);
+            return -1;
+        }
+
+        /*
+         * rotate only if the file is still the active one. otherwise it
+         * has already been rotated while we waited for the lock.
+         */
+        if (
+            (stat(file, &pathbuf) == 0) &&
+            (pathbuf.st_ino == statbuf.st_ino) &&
+            (pathbuf.st_dev == statbuf.st_dev) &&
+            (rotate_content_file(homedir, file) == -1)
+            )
+        {
+            (void) close(fd);
+            return -1;
+        }
+
+        (void) close(fd);  /* unlock performed automatically with close */
+    }
+}
+
+/**
+ * \brief Append posts to the binary post store
+ *
+ * Append the \a count posts given by \a posts to the binary post store
+ * located in the public_html directory in the user's \a homedir. On
+ * success the store is left open for syncing, the caller has to close
+ * it.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param posts the posts to be stored [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param store the opened post store [OUT]
+ * \param first set to the number of the first stored post [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int store_posts(
+    const char *homedir,
+    const bb_post_t *posts,
+    size_t count,
+    bb_store_t *store,
+    uint64_t *first
+    )
+{
+    char dir[MAXPATHLEN];
+    int rc;
+
+    if (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+    {
+        return -1;
+    }
+
+    if (
+        ((rc = bb_open(store, dir, BB_WRITE)) == 0) &&
+        ((rc = bb_append(store, posts, count, first)) == -1)
+        )
+    {
+        bb_close(store);
+    }
+
+    if (rc == -1)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to store post - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+    }
+
+    return rc;
+}
+
+/**
+ * \brief Append rendered posts to the post store and the content file
+ *
+ * Append the rendered content entries \a content of the \a count posts
+ * given by \a posts to the bulletin board content file located in the
+ * public_html directory in the user's \a homedir and the posts to the
+ * binary post store.
+ *
+ * The content entries are appended with a single write() to the content
+ * file opened with O_APPEND. Unless SMSL_APPEND_MODE is "atomic" the
+ * write is additionally guarded by an exclusive flock(), otherwise by a
+ * shared one which only excludes the rotation of the file. The posts are
+ * stored once their entries have been written. If that fails in flock
+ * mode, the entries are removed from the content file again. Finally the
+ * post store and the content file are synced according to
+ * SMSL_DURABILITY, the committed posts are published in the shared
+ * post ring and added to the search and user indexes. Unless the
+ * backend selected with SMSL_STORAGE is "file" the posts are only
+ * appended to the post store and published.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param posts the posts to be appended [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param content the rendered content entries of the posts [IN]
+ * \param content_wr_count length of \a content [IN]
+ * \param entry_lens length of the content entry of every post [IN]
+ * \param seq set to the sequence number of the last appended post [OUT]
+ *
+ * \return Information on whether or not the writing was successful
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int append_posts(
+    const char *homedir,
+    const bb_post_t *posts,
+    size_t count,
+    const char *content,
+    size_t content_wr_count,
+    const size_t *entry_lens,
+    uint64_t *seq
+    )
+{
+    char file[MAXPATHLEN];
+    int fd;
+    int cnt;
+    ssize_t wr_count;
+    bb_store_t store;
+    struct stat statbuf, pathbuf;
+    int fds[3];
+    uint64_t first;
+    off_t content_end = -1;
+
+    /*
+     * the other backends keep the posts off the disk, thus there is
+     * neither a content file nor an index to be updated.
+     */
+    if (storage != &bb_file_backend)
+    {
+        if (store_posts(homedir, posts, count, &store, &first) == -1)
+        {
+            return -1;
+        }
+
+        /*
+         * the null backend numbers no posts, thus its posts get no
+         * sequence number and their responses no id.
+         */
+        *seq = (bb_count(&store) > 0) ? first + count : 0;
+
+        if ((durability != DURABILITY_NONE) && (bb_flush(&store) == -1))
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Unable to flush post - <pre>%s</pre>\n",
+	        strerror(errno)
+                );
+            bb_close(&store);
+            return -1;
+        }
+
+        publish_posts(&store, first, posts, count, content, entry_lens);
+        notify_subscribers();
+        bb_close(&store);
+        return 0;
+    }
+
+    cnt = snprintf(
+            file,
+	    sizeof(file),
+	    "%s/public_html/%s%s",
+	    homedir,
+	    board_dir(),
+            BULLETIN_BOARD_CONTENT_FILE
+            );
+
+    if (cnt < 0)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "%s: snprintf() failed - <pre>%s</pre>\n",
+	    cmd,
+            strerror(errno)
+            );
+        return -1;
+    }
+    else if ((size_t) cnt >= sizeof(file))
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+	    "Filename for bulleting board file (incl. path) is too long - "
+	    "only a maximum of %d bytes are supported\n",
+            MAXPATHLEN
+            );
+        return -1;
+    }
+
+    if ((fd = open_content_file(homedir, file)) == -1)
+    {
+        return -1;
+    }
+
+    /*
+     * the file is locked in flock mode, thus nobody appends behind our
+     * back and the entries can be taken back if the posts can not be
+     * stored.
+     */
+    if (append_mode == APPEND_MODE_FLOCK)
+    {
+        content_end = lseek(fd, 0, SEEK_END);
+    }
+
+    /*
+     * a short write would leave a partial entry in the file, which
+     * the web front-end skips - thus report it as an error.
+     */
+    if (
+	((wr_count = write(fd, content, content_wr_count)) == -1) ||
+	((size_t) wr_count != content_wr_count)
+	)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to write to file <code>%.*s</code> - <pre>%s</pre>\n",
+	    MAXERRORPATHLEN,
+	    file,
+	    (wr_count == -1) ? strerror(errno) : "short write"
+            );
+        (void) close(fd);
+        return -1;
+    }
+
+    /*
+     * the posts are committed to the store only after their content
+     * entries have been written, thus delta, search and posts by
+     * requests never return posts whose entries could not be written.
+     */
+    if (store_posts(homedir, posts, count, &store, &first) == -1)
+    {
+        if ((content_end != -1) && (ftruncate(fd, content_end) == -1))
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Unable to store post and to remove its entry - <pre>%s</pre>\n",
+	        strerror(errno)
+                );
+        }
+
+        (void) close(fd);
+        return -1;
+    }
+
+    *seq = first + count;
+
+    /*
+     * the others may append while we wait for the sync. in case our
+     * content file has been rotated in the meantime, the leader of a
+     * group commit syncs the next segment, thus sync ours on our own.
+     */
+    (void) flock(fd, LOCK_UN);
+
+    fds[0] = store.data_fd;
+    fds[1] = store.index_fd;
+    fds[2] = fd;
+
+    if (
+        (durability == DURABILITY_GROUP) &&
+        (fstat(fd, &statbuf) == 0) &&
+        (
+            (stat(file, &pathbuf) == -1) ||
+            (pathbuf.st_ino != statbuf.st_ino) ||
+            (pathbuf.st_dev != statbuf.st_dev)
+            ) &&
+        (sync_files(&fd, 1) == -1)
+        )
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to sync file <code>%.*s</code> - <pre>%s</pre>\n",
+	    MAXERRORPATHLEN,
+	    file,
+	    strerror(errno)
+            );
+        (void) close(fd);
+        bb_close(&store);
+        return -1;
+    }
+
+    if (make_durable(homedir, fds, sizeof(fds) / sizeof(*fds), count) == -1)
+    {
+        (void) close(fd);
+        bb_close(&store);
+        return -1;
+    }
+
+    publish_posts(&store, first, posts, count, content, entry_lens);
+    notify_subscribers();
+    update_search_index(homedir, &store);
+    update_user_index(homedir, &store);
+    bb_close(&store);
+
+    if (close(fd) == -1)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to close file <code>%.*s</code> - <pre>%s</pre>\n",
+	    MAXERRORPATHLEN,
+	    file,
+	    strerror(errno)
+            );
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Write client message into bulletin board content file
+ *
+ * Write the client message \a msg, sent by \a user together with the
+ * URL to the optional image (\a img) into to the bulletin board content file
+ * located in the public_html directory in the user's \a homedir.
+ *
+ * The entry is rendered completely in memory and appended using \a
+ * append_posts().
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param user zero-terminated string containing the user name [IN]
+ * \param img zero-terminated string containing the URL of the image to be used [IN]
+ * \param msg zero-terminated string containing the message to be added [IN]
+ * \param seq set to the sequence number of the post [OUT]
+ *
+ * \return Information on whether or not the writing was successful
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int post_message(
+    const char *homedir,
+    const char *user,
+    const char *img,
+    const char *msg,
+    uint64_t *seq
+    )
+{
+    int cnt;
+    size_t len;
+    char content_entry[BB_MAXENTRYLEN];
+    bb_post_t post;
+
+    post.timestamp = (uint64_t) time(NULL);
+    post.user = user;
+    post.user_len = strlen(user);
+    post.img = img;
+    post.img_len = (img != NULL) ? strlen(img) : 0;
+    post.msg = msg;
+    post.msg_len = strlen(msg);
+
+    cnt = bb_render(&post, content_entry, sizeof(content_entry));
+
+    if (cnt < 0)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Message too long - only a maximum of %d bytes (incl. username) "
+            "are supported\n",
+            MAXMESSAGELEN
+            );
+        return -1;
+    }
+
+    len = (size_t) cnt;
+
+    return append_posts(homedir, &post, 1, content_entry, len, &len, seq);
+}
+
+/**
+ * \brief Write a batch of posts into bulletin board content file
+ *
+ * Render the content entries of the \a count posts given by \a posts
+ * into a single buffer and append them using \a append_posts(), i.e.
+ * with a single write() under a single lock. The posts must not exceed
+ * BB_MAXPOSTLEN.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param posts the posts to be added [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ *
+ * \return Information on whether or not the writing was successful
+ * \retval 0 success
+ * \retval -1 failed
+ */
+static int post_messages(
+    const char *homedir,
+    const bb_post_t *posts,
+    size_t count
+    )
+{
+    char *content = NULL, *p;
+    size_t *entry_lens;
+    size_t len = 0, size = 0, i;
+    uint64_t seq;
+    int cnt, rc;
+
+    if ((entry_lens = malloc(count * sizeof(*entry_lens))) == NULL)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Out of memory rendering %zu posts\n",
+	    count
+            );
+        return -1;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        /*
+         * a content entry never exceeds BB_MAXENTRYLEN, thus there is
+         * always room for the next one.
+         */
+        if (size - len < BB_MAXENTRYLEN)
+        {
+            size = (size == 0) ? 4 * BB_MAXENTRYLEN : 2 * size;
+
+            if ((p = realloc(content, size)) == NULL)
+            {
+                (void) snprintf(
+                    errormsg,
+	            sizeof(errormsg),
+                    "Out of memory rendering %zu posts\n",
+	            count
+                    );
+                free(content);
+                free(entry_lens);
+                return -1;
+            }
+
+            content = p;
+        }
+
+        if ((cnt = bb_render(&posts[i], content + len, size - len)) < 0)
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Post %zu too long - only a maximum of %d bytes (incl. username) "
+                "are supported\n",
+                i + 1,
+                BB_MAXPOSTLEN
+                );
+            free(content);
+            free(entry_lens);
+            return -1;
+        }
+
+        entry_lens[i] = (size_t) cnt;
+        len += (size_t) cnt;
+    }
+
+    rc = append_posts(homedir, posts, count, content, len, entry_lens, &seq);
+    free(content);
+    free(entry_lens);
+
+    return rc;
+}
+
+/**
+ * \brief Write the static snapshot of the bulletin board
+ *
+ * Render the latest \a snapshot_posts posts of the post \a store into
+ * a temporary file and atomically replace the static snapshot with it.
+ * The caller has to hold the snapshot lock.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param store the opened post store [IN]
+ *
+ * \return number of posts in the store at the time of the snapshot
+ * \retval -1 failed
+ */
+static int64_t write_snapshot(
+    const char *homedir,
+    bb_store_t *store
+    )
+{
+    char file[MAXPATHLEN], tmpfile[MAXPATHLEN];
+    char entry[BB_MAXENTRYLEN];
+    const template_t *tpl = &vcs_tcpip_bulletin_board_snapshot_thtml;
+    const template_segment_t *seg;
+    int64_t count;
+    uint64_t i, id = bb_id(store);
+    FILE *fp;
+    int len;
+
+    if (
+	(make_public_filename(
+	    file, sizeof(file), homedir, BULLETIN_BOARD_SNAPSHOT_FILE
+	    ) == -1) ||
+	(make_public_filename(
+	    tmpfile, sizeof(tmpfile), homedir, BULLETIN_BOARD_SNAPSHOT_TMP_FILE
+	    ) == -1) ||
+	((count = bb_count(store)) == -1) ||
+	((fp = fopen(tmpfile, "w")) == NULL)
+	)
+    {
+        return -1;
+    }
+
+    /*
+     * the entries replace the placeholder of the page template.
+     */
+    for (seg = tpl->segments; seg < tpl->segments + tpl->count; seg++)
+    {
+        if (seg->type == TEMPLATE_LITERAL)
+        {
+            (void) fwrite(seg->text, sizeof(char), seg->len, fp);
+            continue;
+        }
+
+        for (
+	    i = (count > snapshot_posts) ? (uint64_t) (count - snapshot_posts) : 0;
+	    i < (uint64_t) count;
+	    i++
+	    )
+        {
+            if ((len = render_post(store, id, i, entry)) == -1)
+            {
+                (void) fclose(fp);
+                (void) unlink(tmpfile);
+                return -1;
+            }
+
+            (void) fwrite(entry, sizeof(char), (size_t) len, fp);
+        }
+    }
+
+    if (ferror(fp) || (fclose(fp) == EOF))
+    {
+        (void) unlink(tmpfile);
+        return -1;
+    }
+
+    if (rename(tmpfile, file) == -1)
+    {
+        (void) unlink(tmpfile);
+        return -1;
+    }
+
+    return count;
+}
+
+/**
+ * \brief Update the static snapshot of the bulletin board
+ *
+ * Regenerate the static snapshot after a post. Concurrent posts are
+ * grouped: if another process is updating the snapshot right now, this
+ * process does not wait - the other one checks for new posts after
+ * releasing the lock and picks them up.
+ *
+ * Failures are reported on stderr only, as the post itself is already
+ * stored. The snapshot is only kept for the file backend (see
+ * SMSL_STORAGE).
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ */
+static void update_snapshot(
+    const char *homedir
+    )
+{
+    char dir[MAXPATHLEN], lockfile[MAXPATHLEN];
+    bb_store_t store;
+    int64_t rendered = -1;
+    int fd;
+
+    if ((snapshot_posts == 0) || (storage != &bb_file_backend))
+    {
+        return;
+    }
+
+    if (
+	(make_public_filename(dir, sizeof(dir), homedir, ".") == -1) ||
+	(make_public_filename(
+	    lockfile, sizeof(lockfile), homedir, BULLETIN_BOARD_SNAPSHOT_LOCK_FILE
+	    ) == -1)
+	)
+    {
+        ERROR("%s: Path of snapshot too long.", __func__);
+        return;
+    }
+
+    if (bb_open(&store, dir, BB_READ) == -1)
+    {
+        ERROR("%s: Unable to open post store.", __func__);
+        return;
+    }
+
+    if ((fd = open(lockfile, O_RDWR | O_CREAT, 0644)) == -1)
+    {
+        ERROR("%s: Unable to open %s.", __func__, lockfile);
+        bb_close(&store);
+        return;
+    }
+
+    /*
+     * posts arriving after the check below are handled by their own
+     * process, which in turn finds the lock released.
+     */
+    while (flock(fd, LOCK_EX | LOCK_NB) == 0)
+    {
+        do
+        {
+            rendered = write_snapshot(homedir, &store);
+        } while ((rendered != -1) && (rendered != bb_count(&store)));
+
+        (void) flock(fd, LOCK_UN);
+
+        if (rendered == -1)
+        {
+            ERROR("%s: Unable to write snapshot.", __func__);
+            break;
+        }
+
+        if (rendered == bb_count(&store))
+        {
+            break;
+        }
+    }
+
+    (void) close(fd);
+    bb_close(&store);
+}
+
+/**
+ * \brief Parse a delta request
+ *
+ * Parse the sequence number of a delta request, i.e. the part after the
+ * keyword "since=". The line may optionally be terminated by a newline.
+ *
+ * \param s zero-terminated string following the keyword [IN]
+ * \param seqp set to the parsed sequence number [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 the request is malformed
+ */
+static int parse_delta_request(
+    const char *s,
+    uint64_t *seqp
+    )
+{
+    char *eptr;
+    unsigned long long seq;
+
+    errno = 0;
+    seq = strtoull(s, &eptr, 10);
+
+    if (
+	(errno != 0) ||
+	(eptr == s) ||
+	!isdigit((unsigned char) *s) ||
+	((*eptr == '\n') ? (eptr[1] != '\0') : (*eptr != '\0'))
+	)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Keyword <code>since</code> requires a sequence number\n"
+            );
+        return -1;
+    }
+
+    *seqp = (uint64_t) seq;
+
+    return 0;
+}
+
+/**
+ * \brief Set the position an OK response is resumed at
+ *
+ * The file \a filename must be one of the files of an OK response, its
+ * name and the offset \a offset are stored in resume.
+ *
+ * \param filename the name of the file, not necessarily zero-terminated [IN]
+ * \param len length of \a filename [IN]
+ * \param offset number of bytes of the file received by the client [IN]
+ *
+ * \retval 0 success
+ * \retval -1 the file is no file of an OK response
+ */
+static int set_resume_position(
+    const char *filename,
+    size_t len,
+    uint64_t offset
+    )
+{
+    if (
+        !((len == strlen("vcs_tcpip_bulletin_board_response.html")) &&
+          (strncmp(filename, "vcs_tcpip_bulletin_board_response.html", len) == 0)) &&
+        !((len == strlen("ok.png")) && (strncmp(filename, "ok.png", len) == 0))
+        )
+    {
+        return -1;
+    }
+
+    memcpy(resume.file, filename, len);
+    resume.file[len] = '\0';
+    resume.offset = (size_t) offset;
+
+    return 0;
+}
+
+/**
+ * \brief Parse a resume request
+ *
+ * Parse the part after the keyword "resume=" of a resume request, i.e.
+ * the response id and the lines "file=<name>" and "offset=<n>". The
+ * last line may optionally be terminated by a newline. The position is
+ * stored in resume by \a set_resume_position().
+ *
+ * \param s zero-terminated string following the keyword [IN]
+ * \param idp set to the parsed response id [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 the request is malformed
+ */
+static int parse_resume_request(
+    const char *s,
+    uint64_t *idp
+    )
+{
+    char *eptr;
+    const char *filename = NULL;
+    unsigned long long id, offset = 0;
+    size_t len = 0;
+    int valid;
+
+    errno = 0;
+    id = strtoull(s, &eptr, 10);
+
+    valid =
+        (errno == 0) &&
+        isdigit((unsigned char) *s) &&
+        (id != 0) &&
+        (strncmp(eptr, "\n" KEYWORD_FILE, strlen("\n" KEYWORD_FILE)) == 0);
+
+    if (valid)
+    {
+        s = eptr + strlen("\n" KEYWORD_FILE);
+        len = strcspn(s, "\n");
+
+        valid = (strncmp(s + len, "\n" KEYWORD_OFFSET, strlen("\n" KEYWORD_OFFSET)) == 0);
+    }
+
+    if (valid)
+    {
+        filename = s;
+
+        s += len + strlen("\n" KEYWORD_OFFSET);
+        errno = 0;
+        offset = strtoull(s, &eptr, 10);
+
+        valid =
+            (errno == 0) &&
+            isdigit((unsigned char) *s) &&
+            ((*eptr == '\n') ? (eptr[1] == '\0') : (*eptr == '\0')) &&
+            (set_resume_position(filename, len, (uint64_t) offset) == 0);
+    }
+
+    if (!valid)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Keyword <code>resume</code> requires a response id followed by "
+            "the lines <code>file=</code> naming a file of an OK response "
+            "and <code>offset=</code>\n"
+            );
+        return -1;
+    }
+
+    *idp = (uint64_t) id;
+
+    return 0;
+}
+
+/**
+ * \brief Leave the posts of a response to be rendered while responding
+ *
+ * If the client accepts chunked files, store the opened post store
+ * \a store and the numbers of the posts \a posts in \a request instead
+ * of rendering them, \a delta_response() renders and writes them one
+ * chunk at a time. \a request takes over \a store and \a posts then.
+ *
+ * \param store the opened post store [IN]
+ * \param posts the numbers of the posts (counting from 0) [IN]
+ * \param count number of posts pointed to by \a posts [IN]
+ * \param request filled with the store and the posts [OUT]
+ *
+ * \retval 1 the posts are rendered while responding
+ * \retval 0 the posts have to be rendered now
+ */
+static int defer_posts(
+    bb_store_t *store,
+    uint64_t *posts,
+    size_t count,
+    request_t *request
+    )
+{
+    /*
+     * a subscriber waits for a response with a rendered body
+     */
+    if (
+        (response_framing != FRAMING_CHUNKED) ||
+        (count == 0) ||
+        (request->type == REQUEST_SUBSCRIBE)
+        )
+    {
+        return 0;
+    }
+
+    request->store = *store;
+    request->posts = posts;
+    request->post_count = count;
+
+    return 1;
+}
+
+/**
+ * \brief Collect the posts after a sequence number
+ *
+ * Render the posts with a sequence number larger than \a since from the
+ * post store (sequence numbers start at 1). At most DELTA_MAXPOSTS posts
+ * are returned, the client continues with the sequence number of the
+ * last returned post. A subscriber lagging behind by more posts skips
+ * the older ones instead, their number is stored in \a request. If
+ * there are no new posts no store record is read at all.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param since the sequence number of the last post known by the client [IN]
+ * \param request filled with the sequence number of the last returned
+ *        post and the rendered posts [OUT]
+ *
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_FAILED the post store could not be read
+ */
+static int collect_delta(
+    const char *homedir,
+    uint64_t since,
+    request_t *request
+    )
+{
+    char dir[MAXPATHLEN];
+    bb_store_t store;
+    int64_t count;
+    uint64_t i, last, id;
+    uint64_t *posts;
+    int len;
+
+    request->seq = 0;
+    request->store_id = 0;
+    request->body = NULL;
+    request->body_len = 0;
+    request->posts = NULL;
+
+    if (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+    {
+        return SMSL_E_FAILED;
+    }
+
+    if (bb_open(&store, dir, BB_READ) == -1)
+    {
+        if (errno == ENOENT)
+        {
+            return SMSL_E_OK;  /* nothing posted yet */
+        }
+
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to open post store - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        return SMSL_E_FAILED;
+    }
+
+    if ((count = bb_count(&store)) == -1)
+    {
+        bb_close(&store);
+        return SMSL_E_FAILED;
+    }
+
+    id = bb_id(&store);
+    request->store_id = id;
+
+    /*
+     * a sequence number beyond the end of the store (e.g. the store has
+     * been reset) just yields the current sequence number.
+     */
+    last = (uint64_t) count;
+
+    /*
+     * a backend keeping only the newest posts (memory) cannot return
+     * the older ones, they are skipped like those of a lagging
+     * subscriber.
+     */
+    if ((store.backend->kept != 0) && (since < last) && ((last - since) > store.backend->kept))
+    {
+        request->dropped = last - store.backend->kept - since;
+        since = last - store.backend->kept;
+    }
+
+    if (since < last && (last - since) > DELTA_MAXPOSTS)
+    {
+        if (request->type == REQUEST_SUBSCRIBE)
+        {
+            request->dropped += last - DELTA_MAXPOSTS - since;
+            since = last - DELTA_MAXPOSTS;
+        }
+        else
+        {
+            last = since + DELTA_MAXPOSTS;
+        }
+    }
+
+    request->seq = last;
+
+    if (since >= last)
+    {
+        bb_close(&store);
+        return SMSL_E_OK;  /* no change */
+    }
+
+    if (response_framing == FRAMING_CHUNKED)
+    {
+        if ((posts = malloc((last - since) * sizeof(uint64_t))) == NULL)
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Out of memory\n"
+                );
+            bb_close(&store);
+            return SMSL_E_FAILED;
+        }
+
+        for (i = since; i < last; i++)
+        {
+            posts[i - since] = i;
+        }
+
+        if (defer_posts(&store, posts, (size_t) (last - since), request))
+        {
+            return SMSL_E_OK;
+        }
+
+        free(posts);
+    }
+
+    if ((request->body = malloc((last - since) * BB_MAXENTRYLEN)) == NULL)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Out of memory\n"
+            );
+        bb_close(&store);
+        return SMSL_E_FAILED;
+    }
+
+    for (i = since; i < last; i++)
+    {
+        len = render_post(&store, id, i, request->body + request->body_len);
+
+        /*
+         * the post may have been overwritten since the store was counted
+         */
+        if ((len == -1) && (errno == ENOENT) && (store.backend->kept != 0))
+        {
+            request->dropped++;
+            continue;
+        }
+
+        if (len == -1)
+        {
+            (void) snprintf(
+                errormsg,
+		sizeof(errormsg),
+                "Unable to read post %llu from post store\n",
+		(unsigned long long) i + 1
+                );
+            bb_close(&store);
+            return SMSL_E_FAILED;
+        }
+
+        request->body_len += (size_t) len;
+    }
+
+    bb_close(&store);
+
+    return SMSL_E_OK;
+}
+
+/**
+ * \brief Render the posts found by a query
+ *
+ * Render the posts given by their numbers \a matches as HTML content
+ * entries into the body of \a request.
+ *
+ * \param store the post store holding the posts [IN]
+ * \param matches the numbers of the posts (counting from 0) [IN]
+ * \param count number of posts pointed to by \a matches [IN]
+ * \param request filled with the rendered posts [OUT]
+ *
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_FAILED a post could not be read
+ */
+static int render_matches(
+    bb_store_t *store,
+    const uint64_t *matches,
+    size_t count,
+    request_t *request
+    )
+{
+    uint64_t id;
+    size_t i;
+    int len;
+
+    if (count == 0)
+    {
+        return SMSL_E_OK;
+    }
+
+    if ((request->body = malloc(count * BB_MAXENTRYLEN)) == NULL)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Out of memory\n"
+            );
+        return SMSL_E_FAILED;
+    }
+
+    id = bb_id(store);
+
+    for (i = 0; i < count; i++)
+    {
+        if ((len = render_post(store, id, matches[i], request->body + request->body_len)) == -1)
+        {
+            (void) snprintf(
+                errormsg,
+		sizeof(errormsg),
+                "Unable to read post %llu from post store\n",
+		(unsigned long long) matches[i] + 1
+                );
+            free(request->body);
+            request->body = NULL;
+            request->body_len = 0;
+            return SMSL_E_FAILED;
+        }
+
+        request->body_len += (size_t) len;
+    }
+
+    return SMSL_E_OK;
+}
+
+/**
+ * \brief Check whether the indexes of the post store are maintained
+ *
+ * The search and user indexes are only updated by the file backend,
+ * the requests relying on them are refused by the other ones.
+ *
+ * \param keyword zero-terminated string containing the name of the request [IN]
+ *
+ * \retval SMSL_E_OK the file backend is selected
+ * \retval SMSL_E_FAILED another backend is selected
+ */
+static int check_indexed_storage(
+    const char *keyword
+    )
+{
+    if (storage == &bb_file_backend)
+    {
+        return SMSL_E_OK;
+    }
+
+    (void) snprintf(
+        errormsg,
+	sizeof(errormsg),
+        "Keyword <code>%s</code> is not supported by the storage backend "
+	"<code>%s</code>\n",
+	keyword,
+	storage->name
+        );
+    return SMSL_E_FAILED;
+}
+
+/**
+ * \brief Collect the posts containing the words of a query
+ *
+ * Search the post store for the posts whose messages contain all words
+ * of \a query (case-insensitive, see si_next_term()) using the search
+ * index and render the newest DELTA_MAXPOSTS of them in ascending
+ * order.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param query the words to be searched for [IN]
+ * \param query_len length of \a query [IN]
+ * \param request filled with the number of posts searched and the
+ *        rendered posts found [OUT]
+ *
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_INVAL the query contains no word
+ * \retval SMSL_E_FAILED the post store could not be searched or is not
+ *         indexed
+ */
+static int collect_search(
+    const char *homedir,
+    const char *query,
+    size_t query_len,
+    request_t *request
+    )
+{
+    char dir[MAXPATHLEN];
+    char term[SI_MAXTERMLEN];
+    const char *pos = query;
+    bb_store_t store;
+    uint64_t *matches;
+    size_t count;
+    int64_t posts;
+    int rc;
+
+    request->type = REQUEST_SEARCH;
+    request->seq = 0;
+    request->body = NULL;
+    request->body_len = 0;
+    request->posts = NULL;
+
+    if (si_next_term(&pos, query + query_len, term) == 0)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Keyword <code>search</code> requires at least one word\n"
+            );
+        return SMSL_E_INVAL;
+    }
+
+    if (
+        (check_indexed_storage("search") != SMSL_E_OK) ||
+        (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+        )
+    {
+        return SMSL_E_FAILED;
+    }
+
+    if (bb_open(&store, dir, BB_READ) == -1)
+    {
+        if (errno == ENOENT)
+        {
+            return SMSL_E_OK;  /* nothing posted yet */
+        }
+
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to open post store - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        return SMSL_E_FAILED;
+    }
+
+    if (
+        ((posts = bb_count(&store)) == -1) ||
+        (si_search(dir, &store, query, query_len, DELTA_MAXPOSTS, &matches, &count) == -1)
+        )
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to search post store - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        bb_close(&store);
+        return SMSL_E_FAILED;
+    }
+
+    request->seq = (uint64_t) posts;
+
+    if (defer_posts(&store, matches, count, request))
+    {
+        return SMSL_E_OK;
+    }
+
+    rc = render_matches(&store, matches, count, request);
+
+    free(matches);
+    bb_close(&store);
+
+    return rc;
+}
+
+/**
+ * \brief Collect the posts of a user
+ *
+ * Look up the posts of the user \a user (compared exactly) using the
+ * user index and render the newest DELTA_MAXPOSTS of them in ascending
+ * order.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param user the name of the user [IN]
+ * \param user_len length of \a user [IN]
+ * \param request filled with the number of posts in the store and the
+ *        rendered posts of the user [OUT]
+ *
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_FAILED the post store could not be read or is not
+ *         indexed
+ */
+static int collect_posts_by(
+    const char *homedir,
+    const char *user,
+    size_t user_len,
+    request_t *request
+    )
+{
+    char dir[MAXPATHLEN];
+    bb_store_t store;
+    uint64_t *matches;
+    size_t count;
+    int64_t posts;
+    int rc;
+
+    request->type = REQUEST_POSTS_BY;
+    request->seq = 0;
+    request->body = NULL;
+    request->body_len = 0;
+    request->posts = NULL;
+
+    if (
+        (check_indexed_storage("posts_by") != SMSL_E_OK) ||
+        (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+        )
+    {
+        return SMSL_E_FAILED;
+    }
+
+    if (bb_open(&store, dir, BB_READ) == -1)
+    {
+        if (errno == ENOENT)
+        {
+            return SMSL_E_OK;  /* nothing posted yet */
+        }
+
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to open post store - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        return SMSL_E_FAILED;
+    }
+
+    if (
+        ((posts = bb_count(&store)) == -1) ||
+        (ui_lookup(dir, &store, user, user_len, DELTA_MAXPOSTS, &matches, &count) == -1)
+        )
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unable to look up posts of user - <pre>%s</pre>\n",
+	    strerror(errno)
+            );
+        bb_close(&store);
+        return SMSL_E_FAILED;
+    }
+
+    request->seq = (uint64_t) posts;
+
+    if (defer_posts(&store, matches, count, request))
+    {
+        return SMSL_E_OK;
+    }
+
+    rc = render_matches(&store, matches, count, request);
+
+    free(matches);
+    bb_close(&store);
+
+    return rc;
+}
+
+/**
+ * \brief Check the response id of a resume request
+ *
+ * The response id of an OK response is the sequence number of the post,
+ * thus the id is known if the post store holds a post of that number.
+ *
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param id the response id [IN]
+ * \param request filled with the response id [OUT]
+ *
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_INVAL the response id is unknown
+ * \retval SMSL_E_FAILED the post store could not be read
+ */
+static int collect_resume(
+    const char *homedir,
+    uint64_t id,
+    request_t *request
+    )
+{
+    char dir[MAXPATHLEN];
+    bb_store_t store;
+    int64_t posts;
+
+    request->type = REQUEST_RESUME;
+    request->seq = id;
+    resume.active = 1;
+
+    if (make_public_filename(dir, sizeof(dir), homedir, ".") == -1)
+    {
+        return SMSL_E_FAILED;
+    }
+
+    if (bb_open(&store, dir, BB_READ) == -1)
+    {
+        posts = 0;  /* nothing posted yet */
+
+        if (errno != ENOENT)
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Unable to open post store - <pre>%s</pre>\n",
+	        strerror(errno)
+                );
+            return SMSL_E_FAILED;
+        }
+    }
+    else
+    {
+        posts = bb_count(&store);
+        bb_close(&store);
+
+        if (posts == -1)
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Unable to read post store - <pre>%s</pre>\n",
+	        strerror(errno)
+                );
+            return SMSL_E_FAILED;
+        }
+    }
+
+    if (id > (uint64_t) posts)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Unknown response id %llu\n",
+	    (unsigned long long) id
+            );
+        return SMSL_E_INVAL;
+    }
+
+    return SMSL_E_OK;
 }
 
 /**
- * \brief Write an error response
+ * \brief Collect the top list of a sketch
  *
- * Write an error response as answer to the client's request to
- * stdout using \a write_status() and \a download_file().
+ * Append the keys of the highest counts of the sketch \a sketch to the
+ * metrics as lines "<name>[<rank>]=<count> <key>" preceded by the line
+ * "<name>_total=<count>". Control characters of a key are given as '?',
+ * a key longer than HH_MAXLABELLEN bytes is truncated.
  *
- * \param status execution status of the business logic [IN]
+ * \param request the metrics rendered so far [IN/OUT]
+ * \param len size of the body of \a request [IN]
+ * \param name name of the sketch [IN]
+ * \param sketch the mapped sketch [IN]
  */
-static void error_response(
-    int status
+static void collect_top(
+    request_t *request,
+    size_t len,
+    const char *name,
+    hh_sketch_t *sketch
     )
 {
+    hh_entry_t top[HH_TOPK];
+    char label[HH_MAXLABELLEN];
+    size_t top_len, i, j, label_len;
     int cnt;
-    size_t len;
-
-    len = sizeof(vcs_tcpip_bulletin_board_response_error_thtml)
-            + strlen(errormsg);
 
-    char html_response[len];
-
-    /*
-     * encode error message
-     */
     cnt = snprintf(
-        html_response,
-	len,
-        (const char *) vcs_tcpip_bulletin_board_response_error_thtml,
-        errormsg
+        request->body + request->body_len,
+        len - request->body_len,
+        "%s_total=%llu\n",
+        name,
+        (unsigned long long) __atomic_load_n(&sketch->total, __ATOMIC_RELAXED)
         );
 
-    if (cnt < 0)
-    {
-        ERROR_EXIT(
-	    "%s: snprintf() failed.",
-	    __func__
-	    );
-    }
+    request->body_len += (size_t) cnt;
 
-    /*
-     * signal failure to client
-     */
-    write_status(status);
+    top_len = hh_top(sketch, top);
 
-    /*
-     * write html file
-     */
-    download_file(
-        "vcs_tcpip_bulletin_board_response.html",
-        html_response,
-        strlen(html_response),
-	0
-        );
+    for (i = 0; i < top_len; i++)
+    {
+        label_len = (top[i].label_len < HH_MAXLABELLEN) ? top[i].label_len : HH_MAXLABELLEN;
 
-    errormsg[0] = 0; /* clear error message */
+        for (j = 0; j < label_len; j++)
+        {
+            label[j] = iscntrl((unsigned char) top[i].label[j]) ? '?' : top[i].label[j];
+        }
 
-    if (testcase == TESTCASE_HTML_ONLY_REPLY)
-    {
-        return;  /* omit image */
-    }
+        cnt = snprintf(
+            request->body + request->body_len,
+            len - request->body_len,
+            "%s[%zu]=%llu %.*s\n",
+            name,
+            i + 1,
+            (unsigned long long) top[i].count,
+            (int) label_len,
+            label
+            );
 
-    if (testcase == TESTCASE_HUGE_FILE)
-    {
-	download_file(
-	    "/dev/null",
-	    NULL,
-	    ADDITIONAL_BLANK_CHUNKS * sizeof(chunk_of_blanks),
-	    ADDITIONAL_BLANK_CHUNKS
-	    );
+        request->body_len += (size_t) cnt;
     }
-
-    /*
-     * write error.png
-     */
-    download_file("error.png", error_png, sizeof(error_png), 0);
 }
 
 /**
- * \brief Write an OK response
+ * \brief Collect the metrics of the server
  *
- * Write an OK response as answer to the client's request to
- * stdout using \a write_status() and \a download_file().
+ * Render the shared metrics as lines of the form "name=value". The
+ * fsync latency histogram is given as one line per non-empty bucket
+ * "fsync_latency_us[<lower>,<upper>)=<count>". The top lists of the
+ * posting users, the client addresses and the posted messages follow
+ * (see collect_top()), they are left out if the sketches cannot be
+ * mapped.
  *
- * \param url zero-terminated string containing the URL to the bulletin board web page [IN]
+ * \param request filled with the rendered metrics [OUT]
+ *
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_FAILED the metrics are not available
  */
-static void ok_response(
-    const char *url
+static int collect_metrics(
+    request_t *request
     )
 {
+    static const char * const policies[] = { "none", "group", "strict" };
+    const size_t len =
+        (FSYNC_HISTOGRAM_BUCKETS + 8) * 64 + HH_SKETCHES * (HH_TOPK + 1) * TOP_LINE_LEN;
+    metrics_t *m;
+    hh_table_t *table;
+    unsigned int i;
+    uint64_t count, syncs;
     int cnt;
-    size_t len;
-
-    /*
-     * in the prepared html response we have %s twice as placeholder
-     * for the url.
-     */
-    len = sizeof(vcs_tcpip_bulletin_board_response_ok_thtml)
-            + 2 * strlen(url);
-
-    char html_response[len];
 
-    cnt = snprintf(
-            html_response,
-	    len,
-            (const char *) vcs_tcpip_bulletin_board_response_ok_thtml,
-            url,
-	    url
+    if (
+	((m = get_metrics()) == NULL) ||
+	((request->body = malloc(len)) == NULL)
+	)
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Metrics not available - <pre>%s</pre>\n",
+	    strerror(errno)
             );
+        return SMSL_E_FAILED;
+    }
 
-    if (cnt < 0)
+    syncs = __atomic_load_n(&m->sync_completed, __ATOMIC_RELAXED);
+
+    for (i = 0; i < MAX_BOARDS; i++)
     {
-        ERROR_EXIT(
-	    "%s: snprintf() failed.",
-	    __func__
-	    );
+        syncs += __atomic_load_n(&m->board_sync[i].completed, __ATOMIC_RELAXED);
     }
 
-    /*
-     * signal success to client
-     */
-    write_status(SMSL_E_OK);
-
-    /*
-     * write html file
-     */
-    download_file(
-        "vcs_tcpip_bulletin_board_response.html",
-        html_response,
-	strlen(html_response),
-	0
+    cnt = snprintf(
+        request->body,
+        len,
+        "durability=%s\n"
+        "group_commit_delay_ms=%ld\n"
+        "posts_synced=%llu\n"
+        "group_syncs=%llu\n"
+        "fsync_count=%llu\n"
+        "fsync_errors=%llu\n"
+        "duplicates_rejected=%llu\n",
+        policies[durability],
+        group_commit_delay,
+        (unsigned long long) __atomic_load_n(&m->posts_synced, __ATOMIC_RELAXED),
+        (unsigned long long) syncs,
+        (unsigned long long) __atomic_load_n(&m->fsync_count, __ATOMIC_RELAXED),
+        (unsigned long long) __atomic_load_n(&m->fsync_errors, __ATOMIC_RELAXED),
+        (unsigned long long) __atomic_load_n(&m->duplicates_rejected, __ATOMIC_RELAXED)
         );
 
-    if (testcase == TESTCASE_HTML_ONLY_REPLY)
+    request->body_len = (size_t) cnt;
+
+    for (i = 0; i < FSYNC_HISTOGRAM_BUCKETS; i++)
     {
-        return;  /* omit image */
+        if ((count = __atomic_load_n(&m->fsync_histogram[i], __ATOMIC_RELAXED)) == 0)
+        {
+            continue;
+        }
+
+        cnt = snprintf(
+            request->body + request->body_len,
+            len - request->body_len,
+            "fsync_latency_us[%llu,%llu)=%llu\n",
+            (i == 0) ? 0ULL : 1ULL << i,
+            1ULL << (i + 1),
+            (unsigned long long) count
+            );
+
+        request->body_len += (size_t) cnt;
     }
 
-    if (testcase == TESTCASE_HUGE_FILE)
+    if ((table = get_heavy_hitters()) != NULL)
     {
-	download_file(
-	    "/dev/null",
-	    NULL,
-	    ADDITIONAL_BLANK_CHUNKS * sizeof(chunk_of_blanks),
-	    ADDITIONAL_BLANK_CHUNKS
-	    );
+        collect_top(request, len, "top_users", &table->sketches[HH_USERS]);
+        collect_top(request, len, "top_addresses", &table->sketches[HH_ADDRESSES]);
+        collect_top(request, len, "top_messages", &table->sketches[HH_MESSAGES]);
     }
-    /*
-     * write ok.png
-     */
-    download_file("ok.png", ok_png, sizeof(ok_png), 0);
+
+    return SMSL_E_OK;
 }
 
 /**
- * \brief Search next tag in the given string
- *
- * Search the next HTML tag in the zero-terminated string \a s and return
- * a pointer to the start and the end of the tag via \a beginp and \a endp.
- * In case that no tag is found beginp and endp are not changed.
+ * \brief Push new posts to a subscriber
  *
- * \param s zero-terminated string which shall be searched trough [IN]
- * \param beginp pointer to the begin of the tag [OUT]
- * \param endp pointer to the end of the tag [OUT]
+ * Write the response to the subscription \a request like a delta
+ * response and keep on writing a further response as soon as new posts
+ * have been committed, until the client closes the connection. All
+ * subscribers are woken by a single futex wake-up per commit (see \a
+ * notify_subscribers()). A subscriber which lags behind by more than
+ * DELTA_MAXPOSTS posts skips the older ones and reports their number,
+ * a client which does not read its responses within
+ * SUBSCRIBE_SEND_TIMEOUT seconds is disconnected. The new posts are
+ * rendered from the shared post ring as long as it holds them, an idle
+ * subscriber only looks at the head of its post store in the ring.
  *
- * \return Information whether or not a tag was found.
- * \retval 0 a tag was found
- * \retval -1 no tag found
+ * \param homedir zero-terminated string containing the path to the user's home directory [IN]
+ * \param request the processed subscription request [IN]
  */
-static int search_next_tag(
-    const char *s,
-    const char **beginp,
-    const char **endp
+static void subscribe_response(
+    const char *homedir,
+    request_t *request
     )
 {
-    const char *beg = NULL;
+    const struct timeval timeout = { SUBSCRIBE_SEND_TIMEOUT, 0 };
+    struct pollfd pfd;
+    metrics_t *m = get_metrics();
+    pr_ring_t *ring = get_post_ring();
+    uint32_t events;
+    uint64_t since, head;
+    time_t opened = 0;
+    int ready, pending, woken;
 
-    /*
-     * a tag starts with a '<' and ends with '>'.
-     * first we have to find the start of a tag.
-     */
-    for (; *s != 0; s++)
-    {
-        if (*s == '<')
-	{
-            beg = s; /* start of a tag found */
-            break;
-        }
-    }
+    (void) setsockopt(STDOUT_FILENO, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
 
-    /*
-     * now search the end of the tag.
-     */
-    for (; *s != 0; s++)
+    pfd.fd = STDIN_FILENO;
+    pfd.events = POLLIN;
+
+    for (;;)
     {
-        if (*s == '>')
-	{
-            *beginp = beg; /* end of a tag found */
-            *endp = s;
-            return 0;
-        }
-        
-    }
+        delta_response(request);
+        write_end();
+
+        since = request->seq;
+        request->dropped = 0;
+        pending = 1;
+
+        /*
+         * the client must not send anything after the subscription,
+         * thus readable input means it has closed the connection.
+         */
+        do
+        {
+            if (((ready = poll(&pfd, 1, 0)) > 0) || ((ready == -1) && (errno != EINTR)))
+            {
+                return;
+            }
 
-    return -1;
+            events = (m != NULL) ? __atomic_load_n(&m->post_events, __ATOMIC_ACQUIRE) : 0;
+
+            if (pending)
+            {
+                if (collect_delta(homedir, since, request) != SMSL_E_OK)
+                {
+                    error_response(SMSL_E_FAILED);
+                    write_end();
+                    return;
+                }
+
+                opened = time(NULL);
+            }
+
+            /*
+             * nothing has been committed to the store of the subscriber
+             * if its head in the ring has not moved on, no matter
+             * whether the wait timed out or another board has been
+             * posted to, the post store is not opened then (see
+             * SUBSCRIBE_STORE_INTERVAL). Without a head the store is
+             * opened on every wake-up.
+             */
+            if (request->body_len == 0)
+            {
+                woken = wait_for_posts(events);
+
+                if (
+                    (ring != NULL) &&
+                    (request->store_id != 0) &&
+                    (pr_head(ring, request->store_id, &head) == 0)
+                    )
+                {
+                    pending = (head > since) || (time(NULL) - opened >= SUBSCRIBE_STORE_INTERVAL);
+                }
+                else
+                {
+                    pending = woken || (ring == NULL);
+                }
+            }
+        } while (request->body_len == 0);
+    }
 }
 
 /**
- * \brief Validate client input
+ * \brief Parse the option lines preceding the request
  *
- * Checks if the data received from the client consists of
- * printable characters and does not contain unsupported HTML tags.
+ * Consume the lines "accept-encoding=<encoding>",
+ * "accept-framing=<framing>", "accept-ranges=<unit>" and "board=<name>"
+ * at the beginning of the request pointed to by \a *req and advance \a
+ * *req to the first line of the request proper. Unknown values of the
+ * accept options are ignored, the response is not encoded, its files
+ * carry their length and it is not resumable then. The name of the board
+ * is checked by the caller.
  *
- * \param buf pointer to the buffer conatining the client's input data [IN]
- * \param len size fo the buffer pointed to by \a buf.
- * 
- * \return Information whether or not the input is accepted.
- * \retval 0 input is valid
- * \retval 1 input rejected
+ * \param req pointer to the zero-terminated request [IN/OUT]
+ * \param name set to the name of the board, NULL if the line is missing [OUT]
+ * \param name_len set to the length of \a name [OUT]
  */
-static int validate_input(
-    const char *buf,
-    size_t len
+static void parse_request_options(
+    char **req,
+    const char **name,
+    size_t *name_len
     )
 {
-    size_t i;
-    const char *cp, *tag_begin, *tag_end;
-    char tag[MAXTAGLEN];
-    int tag_valid;
-
-    for (i = 0; i < len; i++)
+    static const struct
     {
-        if (!isprint(buf[i]) && !isspace(buf[i]))
-        {
-            (void) snprintf(
-                errormsg,
-		sizeof(errormsg),
-                "Request contains non printable character "
-                "0x%.2X at position %zu\n",
-                buf[i], i
-                );
-            return -1; /* input contains a non-printable character. */
-        }
-    }
-
-    /*
-     * check if input is null-terminated.
-     * this case should never occur...
-     */
-    if (buf[len] != 0)
+        const char *keyword;
+        const char *value;  /* the only value accepted */
+        int *option;
+        int setting;        /* assigned to option if the value is accepted */
+    } options[] =
     {
-        ERROR_EXIT(
-	    "%s: fatal error. - Input is not null-terminated.",
-	    __func__
-	    );
-    }
+        { KEYWORD_ACCEPT_ENCODING, "deflate", &response_encoding, ENCODING_DEFLATE },
+        { KEYWORD_ACCEPT_FRAMING, "chunked", &response_framing, FRAMING_CHUNKED },
+        { KEYWORD_ACCEPT_RANGES, "bytes", &response_ranges, RANGES_BYTES }
+    };
+    const size_t count = sizeof(options) / sizeof(*options);
+    char *p = *req;
+    char *eol;
+    size_t len, i;
 
-    /*
-     * check for allowed html tags
-     */
-    for (
-	cp = buf;
-	search_next_tag(cp, &tag_begin, &tag_end) == 0;
-         cp = tag_end + 1
-	)
-    {
-        const size_t tag_len = tag_end - tag_begin + 1;
+    *name = NULL;
+    *name_len = 0;
 
-        tag_valid = 0;
-        for (
-	    i = 0;
-	    i < (sizeof(allowed_tags) / sizeof(*allowed_tags));
-	    i++
-	    )
+    for (;;)
+    {
+        /*
+         * the options may be given in any order
+         */
+        for (i = 0; i < count; i++)
         {
-            if (
-		strncmp(
-                    allowed_tags[i],
-		    tag_begin,
-		    tag_len
-                    ) == 0
-		)
+            if (strncmp(p, options[i].keyword, strlen(options[i].keyword)) == 0)
             {
-                tag_valid = 1;
                 break;
             }
         }
-        if (tag_len >= MAXTAGLEN - 1)
+
+        if (i < count)
         {
-            (void) strncpy(tag, tag_begin, MAXTAGLEN - 5);
-            tag[MAXTAGLEN - 5] = '.';
-            tag[MAXTAGLEN - 4] = '.';
-            tag[MAXTAGLEN - 3] = '.';
-            tag[MAXTAGLEN - 2] = '>';
-            tag[MAXTAGLEN - 1] = '\0';
+            p += strlen(options[i].keyword);
+        }
+        else if (strncmp(p, KEYWORD_BOARD, strlen(KEYWORD_BOARD)) == 0)
+        {
+            p += strlen(KEYWORD_BOARD);
         }
         else
         {
-            (void) strncpy(tag, tag_begin, tag_len);
-            tag[tag_len] = '\0';
+            break;
         }
 
-        if (!tag_valid)
+        if ((eol = strchr(p, '\n')) == NULL)
         {
-            (void) snprintf(
-                errormsg,
-		sizeof(errormsg),
-                "Contains unsupported HTML tag <pre>%s</pre>\n",
-                tag
-                );
-            return -1;  /* found tag not supported / allowed */
+            eol = p + strlen(p);
         }
+
+        len = (size_t) (eol - p);
+
+        if (i == count)
+        {
+            *name = p;
+            *name_len = len;
+        }
+        else if ((len == strlen(options[i].value)) && (strncmp(p, options[i].value, len) == 0))
+        {
+            *options[i].option = options[i].setting;
+        }
+
+        p = (*eol == '\n') ? eol + 1 : eol;
     }
 
-    return 0;
+    *req = p;
 }
 
 /**
- * \brief Replace first '\n' with '\0'
+ * \brief Validate a field of a request of protocol version 2
  *
- * Search for the first '\n' and replace it with '\0'.
+ * Check the zero-terminated value \a s of the field \a name like the
+ * corresponding part of a request of version 1. Besides the checks of
+ * \a validate_input() the value must not be empty and - unless
+ * \a multiline is set - must not contain a newline.
  *
- * \param s zero-terminated string containing at least one '\n'
+ * \param name zero-terminated string containing the name of the field [IN]
+ * \param s zero-terminated string containing the value of the field [IN]
+ * \param len length of \a s [IN]
+ * \param multiline non-zero if \a s may contain newlines [IN]
  *
- * \return Information on whether or not the replacement was done
- * \retval 0 success - the first '\n' was replaced with '\0' 
- * \retval -1 no newline is found and thus no newline replaced
+ * \retval 0 the value is valid
+ * \retval -1 the value is rejected
  */
-static int terminate_string_at_newline(
-    char *s
+static int validate_field(
+    const char *name,
+    const char *s,
+    size_t len,
+    int multiline
     )
 {
-    for (; *s; s++)
+    if ((len == 0) || (strlen(s) != len))
     {
-        if (*s == '\n')
-        {
-            *s = 0;
-            return 0;
-        }
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Field <code>%s</code> is empty or contains a null character\n",
+	    name
+            );
+        return -1;
     }
-    return -1;
+
+    if (!multiline && (strchr(s, '\n') != NULL))
+    {
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Field <code>%s</code> contains a newline\n",
+	    name
+            );
+        return -1;
+    }
+
+    return validate_input(s, len);
 }
 
 /**
- * \brief Parse and split client input
+ * \brief Process a batch request of protocol version 2
  *
- * Parse and split client input into user, message and the optional
- * image. Note: this function modifies the passed string by replacing
- * some '\n' with null-terminators to split the passed string into the
- * three parts mentioned above. The pointer passed back point into the
- * buffer if the associated keyword is found or set to NULL otherwise.
+ * Decode and validate every record field of the batch request frame
+ * between \a pos and \a end, and append the valid records with a
+ * single write using \a post_messages(). The status of every record is
+ * stored in \a request, invalid records and duplicates (see \a
+ * check_duplicate()) are skipped.
  *
- * \param buf zero-terminated string containing the data from
- *            the client [IN]
- * \param userp set to the begin of the user name or
- *              to NULL if the keyword "user=" is not found. [OUT]
- * \param imgp set to the begin of the image url or
- *             to NULL if the keyword "img=" is not found. [OUT]
- * \param msgp set to the begin of the message or
- *             to NULL if this part of the input is empty. [OUT]
+ * \param homedir zero-terminated string containing the path to the user's
+ *        home directory [IN]
+ * \param pos first field of the request frame [IN]
+ * \param end end of the request frame [IN]
+ * \param count number of record fields of the request frame [IN]
+ * \param request filled with the status of every record [OUT]
  *
- * \return Information on whether or not the client input was valid
- * \retval 0 the input is valid and contains at least a user name
- *           and a message
- * \retval -1 input is invalid
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK the valid records have been stored
+ * \retval SMSL_E_FAILED a general error occured
+ * \retval SMSL_E_INVAL no record is valid
  */
-static int split_input(
-    char *buf,
-    const char **userp,
-    const char **imgp,
-    const char **msgp
+static int process_batch(
+    const char *homedir,
+    const unsigned char *pos,
+    const unsigned char *end,
+    size_t count,
+    request_t *request
     )
 {
-    char *user, *img, *msg;
-    const char *kw_user = "user=";
-    const char *kw_img = "img=";
+    const time_t now = time(NULL);
+    bb_post_t *posts;
+    char *strings, *p;
+    const unsigned char *record_pos;
+    smp2_field_t field, record_field;
+    size_t i = 0, valid = 0;
+    int rc = SMSL_E_OK;
+
+    request->type = REQUEST_BATCH;
+    request->record_count = count;
 
     /*
-     * the input shall have the following format:
-     *
-     * user=<username>
-     * img=<URL>
-     * <message>
-     * :
-     * :
-     * EOF
-     *
-     * img is optional and must follow user if present.
+     * every nested field takes SMP2_FIELD_HEADER_LEN bytes besides its
+     * value, thus the terminated copies never exceed the frame.
      */
+    posts = malloc(count * sizeof(*posts));
+    strings = malloc((size_t) (end - pos));
+    request->record_status = malloc(count * sizeof(*request->record_status));
 
-    if (strncmp(buf, kw_user, strlen(kw_user)) != 0)
+    if ((posts == NULL) || (strings == NULL) || (request->record_status == NULL))
     {
         (void) snprintf(
             errormsg,
 	    sizeof(errormsg),
-            "Keyword <code>user</code> is missing in first line of request\n"
+            "Out of memory processing %zu records\n",
+	    count
             );
-        return -1;
+        free(posts);
+        free(strings);
+        free(request->record_status);
+        request->record_status = NULL;
+        return SMSL_E_FAILED;
     }
 
-    user = buf + strlen(kw_user);
-    if (terminate_string_at_newline(user))
-    {
-        (void) snprintf(
-            errormsg,
-	    sizeof(errormsg),
-            "Line with keyword <code>user</code> is not newline terminated\n"
-            );
-        return -1;  /* no newline replaced */
-    }
+    p = strings;
 
-    img = user + strlen(user) + 1;
-    if (strncmp(img, kw_img, strlen(kw_img)) != 0)
-    {
-        img = NULL;
-    }
-    else
+    while (smp2_next_field(&pos, end, &field) == 1)
     {
-        img += strlen(kw_img);
+        if (field.tag != SMP2_FIELD_RECORD)
+        {
+            continue;
+        }
 
-        if (terminate_string_at_newline(img))
+        memset(&posts[valid], 0, sizeof(posts[valid]));
+        posts[valid].timestamp = (uint64_t) now;
+        request->record_status[i] = SMSL_E_OK;
+        record_pos = field.value;
+
+        while ((rc = smp2_next_field(&record_pos, field.value + field.len, &record_field)) == 1)
         {
-            (void) snprintf(
-                errormsg,
-		sizeof(errormsg),
-                "Line with keyword <code>img</code> is not newline terminated\n"
-                );
-            return -1;  /* no newline replaced */
+            if (
+                (record_field.tag != SMP2_FIELD_USER) &&
+                (record_field.tag != SMP2_FIELD_IMG) &&
+                (record_field.tag != SMP2_FIELD_MSG)
+                )
+            {
+                continue;  /* unknown fields are skipped */
+            }
+
+            memcpy(p, record_field.value, record_field.len);
+            p[record_field.len] = '\0';
+
+            if (record_field.tag == SMP2_FIELD_USER)
+            {
+                posts[valid].user = p;
+                posts[valid].user_len = record_field.len;
+            }
+            else if (record_field.tag == SMP2_FIELD_IMG)
+            {
+                posts[valid].img = p;
+                posts[valid].img_len = record_field.len;
+            }
+            else
+            {
+                posts[valid].msg = p;
+                posts[valid].msg_len = record_field.len;
+            }
+
+            p += record_field.len + 1;
+        }
+
+        if (
+            (rc == -1) ||
+            (posts[valid].user == NULL) ||
+            (posts[valid].msg == NULL) ||
+            (validate_field("user", posts[valid].user, posts[valid].user_len, 0) == -1) ||
+            (
+                (posts[valid].img != NULL) &&
+                (validate_field("img", posts[valid].img, posts[valid].img_len, 0) == -1)
+                ) ||
+            (validate_field("msg", posts[valid].msg, posts[valid].msg_len, 1) == -1)
+            )
+        {
+            request->record_status[i] = SMSL_E_INVAL;
+        }
+        else if (
+            posts[valid].user_len + posts[valid].img_len + posts[valid].msg_len >
+            BB_MAXPOSTLEN
+            )
+        {
+            request->record_status[i] = SMSL_E_OVERLOW;
+        }
+        else if (
+            check_duplicate(
+                posts[valid].user,
+                posts[valid].user_len,
+                posts[valid].msg,
+                posts[valid].msg_len,
+                now
+                ) == -1
+            )
+        {
+            request->record_status[i] = SMSL_E_DUPLICATE;
         }
+        else
+        {
+            valid++;
+        }
+
+        i++;
     }
 
-    /*
-     * now find begin of message
-     */
-    msg = (img != NULL) ? img : user;
-    msg += strlen(msg) + 1;
+    rc = SMSL_E_OK;
 
-    /*
-     * perform some checks
-     */
-    if (strlen(user) == 0)
+    if (valid == 0)
     {
         (void) snprintf(
             errormsg,
 	    sizeof(errormsg),
-            "Keyword <code>user</code> ist present but username is missing\n"
+            "None of the %zu records of the batch is valid\n",
+	    count
             );
-        return -1;
+        rc = SMSL_E_INVAL;
     }
+    else if (post_messages(homedir, posts, valid) == -1)
+    {
+        for (i = 0; i < valid; i++)
+        {
+            withdraw_duplicate(posts[i].user, posts[i].user_len, posts[i].msg, posts[i].msg_len, now);
+        }
 
-    if (strlen(msg) == 0)
+        rc = SMSL_E_INVAL;    /* write to content file failed */
+    }
+    else
     {
-        (void) snprintf(
-	    errormsg,
-	    sizeof(errormsg),
-	    "Message is empty\n");
-        return -1;
+        for (i = 0; i < valid; i++)
+        {
+            count_post(posts[i].user, posts[i].user_len, posts[i].msg, posts[i].msg_len);
+        }
     }
 
-    if ((img != NULL) && (strlen(img) == 0))
+    free(posts);
+    free(strings);
+
+    if (rc != SMSL_E_OK)
     {
-        (void) snprintf(
-            errormsg,
-	    sizeof(errormsg),
-            "Keyword <code>img</code> ist present, but URL to image is missing\n");
-        return -1;
+        free(request->record_status);
+        request->record_status = NULL;
+        return rc;
     }
 
-    *userp = user;
-    *imgp = img;
-    *msgp = msg;
+    update_snapshot(homedir);
 
-    return 0;
+    return SMSL_E_OK;
 }
 
 /**
- * \brief Write client message into bulletin board content file
+ * \brief Process a request of protocol version 2
  *
- * Write the client message \a msg, sent by \a user together with the
- * URL to the optional image (\a img) into to the bulletin board content file
- * located in the public_html directory in the user's \a homedir.
+ * Decode the request frame in \a buf, validate its fields and process
+ * it like a request of version 1: a delta request (field since), a
+ * metrics request (field metrics) or a post. A frame with record
+ * fields is processed as batch by \a process_batch(), a subscription
+ * (field subscribe) like a delta request. The field board addresses a
+ * board of SMSL_BOARDS. Fields with unknown tags are skipped.
  *
- * \param homedir zero-terminated string containing the path to the user's home directory [IN]
- * \param user zero-terminated string containing the user name [IN]
- * \param img zero-terminated string containing the URL of the image to be used [IN]
- * \param msg zero-terminated string containing the message to be added [IN]
+ * \param homedir zero-terminated string containing the path to the user's
+ *        home directory [IN]
+ * \param buf pointer to the received request [IN]
+ * \param len number of bytes pointed to by \a buf [IN]
+ * \param request filled with the type of the request and the data for
+ *        the response [OUT]
  *
- * \return Information on whether or not the writing was successful
- * \retval 0 success
- * \retval -1 failed
+ * \return Information on whether or not the processing was successful
+ * \retval SMSL_E_OK success
+ * \retval SMSL_E_FAILED a general error occured
+ * \retval SMSL_E_INVAL input invalid / not accepted
+ * \retval SMSL_E_OVERLOW a request other than a batch exceeds MAXMESSAGELEN
+ * \retval SMSL_E_DUPLICATE the message is a duplicate, see check_duplicate()
  */
-static int post_message(
+static int process_v2_request(
     const char *homedir,
-    const char *user,
-    const char *img,
-    const char *msg
+    const char *buf,
+    size_t len,
+    request_t *request
     )
 {
-    char file[MAXPATHLEN];
-    FILE *fp;
-    int cnt;
-    char content_entry[sizeof(content_entry_with_img_thtml)
-                        + MAXMESSAGELEN];
-    size_t content_wr_count;
-
     /*
-     * in the content entry template we have some %s to fill in
-     * user, image and message.
+     * the values are copied and terminated. every field takes
+     * SMP2_FIELD_HEADER_LEN bytes besides its value in the request, thus
+     * the copies never exceed the length of a request other than a batch
+     * - even if a field occurs twice. a batch may exceed MAXMESSAGELEN,
+     * thus the fields copied regardless of the records are checked
+     * against the space left.
      */
-    if (img != NULL)
+    char strings[MAXMESSAGELEN];
+    char *p = strings;
+    char *user = NULL, *img = NULL, *msg = NULL, *search = NULL, *posts_by = NULL;
+    size_t user_len = 0, img_len = 0, msg_len = 0, search_len = 0, posts_by_len = 0;
+    const unsigned char *board_name = NULL;
+    size_t board_len = 0;
+    const unsigned char *pos, *end;
+    smp2_header_t header;
+    smp2_field_t field;
+    int rc, has_since = 0, has_metrics = 0, has_subscribe = 0;
+    uint64_t since = 0, resume_id = 0;
+    size_t records = 0;
+    time_t now;
+
+    if (
+	(len < SMP2_HEADER_LEN) ||
+	(smp2_decode_header(buf, &header) == -1) ||
+	(header.type != SMP2_FRAME_REQUEST) ||
+	(header.len != len - SMP2_HEADER_LEN)
+	)
     {
-        cnt = snprintf(
-	    content_entry,
-	    sizeof(content_entry),
-	    (const char *) content_entry_with_img_thtml,
-	    img,
-	    user,
-	    user,
-	    msg
+        (void) snprintf(
+            errormsg,
+	    sizeof(errormsg),
+            "Malformed request frame of protocol version %d\n",
+	    SMP2_VERSION
             );
+        return SMSL_E_INVAL;
     }
-    else
+
+    pos = (const unsigned char *) buf + SMP2_HEADER_LEN;
+    end = (const unsigned char *) buf + len;
+
+    /*
+     * count the records of a batch in advance, only a batch may exceed
+     * MAXMESSAGELEN.
+     */
+    while ((rc = smp2_next_field(&pos, end, &field)) == 1)
     {
-        cnt = snprintf(
-	    content_entry,
-	    sizeof(content_entry),
-	    (const char *) content_entry_without_img_thtml,
-	    user,
-	    msg
-            );
+        records += (field.tag == SMP2_FIELD_RECORD);
     }
 
-    if (cnt < 0)
+    if ((records == 0) && (len >= MAXMESSAGELEN))
     {
         (void) snprintf(
             errormsg,
 	    sizeof(errormsg),
-            "%s: snprintf() failed - <pre>%s</pre>\n",
-	    cmd,
-            strerror(errno)
+	    "Server input buffer overflow - "
+	    "processing of input messages is limited to %u bytes\n",
+	    MAXMESSAGELEN
             );
-        return -1;
+        return SMSL_E_OVERLOW;
     }
-    else if ((size_t) cnt >= sizeof(content_entry))
+
+    if (records > SMP2_MAXBATCHRECORDS)
     {
         (void) snprintf(
             errormsg,
 	    sizeof(errormsg),
-            "Message too long - only a maximum of %d bytes (incl. username) "
-            "are supported\n",
-            MAXMESSAGELEN
+	    "Batch exceeds the maximum of %u records\n",
+	    SMP2_MAXBATCHRECORDS
             );
-        return -1;
+        return SMSL_E_OVERLOW;
     }
 
-    content_wr_count = (size_t) cnt;
+    pos = (const unsigned char *) buf + SMP2_HEADER_LEN;
 
-    cnt = snprintf(
-            file,
-	    sizeof(file),
-	    "%s/public_html/%s",
-	    homedir,
-            BULLETIN_BOARD_CONTENT_FILE
-            );
+    while ((rc = smp2_next_field(&pos, end, &field)) == 1)
+    {
+        switch (field.tag)
+        {
+            case SMP2_FIELD_USER:
+            case SMP2_FIELD_IMG:
+            case SMP2_FIELD_MSG:
+                if (records > 0)
+                {
+                    break;  /* a batch carries them in its records */
+                }
+
+                memcpy(p, field.value, field.len);
+                p[field.len] = '\0';
+
+                if (field.tag == SMP2_FIELD_USER)
+                {
+                    user = p;
+                    user_len = field.len;
+                }
+                else if (field.tag == SMP2_FIELD_IMG)
+                {
+                    img = p;
+                    img_len = field.len;
+                }
+                else
+                {
+                    msg = p;
+                    msg_len = field.len;
+                }
+
+                p += field.len + 1;
+                break;
+
+            case SMP2_FIELD_SINCE:
+                if (field.len != sizeof(uint64_t))
+                {
+                    rc = -1;
+                    break;
+                }
+
+                since = smp2_get_u64(field.value);
+                has_since = 1;
+                break;
+
+            case SMP2_FIELD_METRICS:
+                has_metrics = 1;
+                break;
+
+            case SMP2_FIELD_SEARCH:
+                if (records > 0)
+                {
+                    (void) snprintf(
+                        errormsg,
+		        sizeof(errormsg),
+                        "Field <code>search</code> is not allowed in a batch\n"
+                        );
+                    return SMSL_E_INVAL;
+                }
+
+                if (field.len >= (size_t) (strings + sizeof(strings) - p))
+                {
+                    rc = -1;
+                    break;
+                }
+
+                memcpy(p, field.value, field.len);
+                p[field.len] = '\0';
+                search = p;
+                search_len = field.len;
+                p += field.len + 1;
+                break;
+
+            case SMP2_FIELD_POSTS_BY:
+                if (records > 0)
+                {
+                    (void) snprintf(
+                        errormsg,
+		        sizeof(errormsg),
+                        "Field <code>posts_by</code> is not allowed in a batch\n"
+                        );
+                    return SMSL_E_INVAL;
+                }
+
+                if (field.len >= (size_t) (strings + sizeof(strings) - p))
+                {
+                    rc = -1;
+                    break;
+                }
+
+                memcpy(p, field.value, field.len);
+                p[field.len] = '\0';
+                posts_by = p;
+                posts_by_len = field.len;
+                p += field.len + 1;
+                break;
+
+            case SMP2_FIELD_SUBSCRIBE:
+                /*
+                 * without a sequence number only posts committed from
+                 * now on are pushed.
+                 */
+                if (field.len == 0)
+                {
+                    since = UINT64_MAX;
+                }
+                else if (field.len == sizeof(uint64_t))
+                {
+                    since = smp2_get_u64(field.value);
+                }
+                else
+                {
+                    rc = -1;
+                    break;
+                }
+
+                has_subscribe = 1;
+                break;
+
+            case SMP2_FIELD_ACCEPT_ENCODING:
+                if (
+                    (field.len == strlen("deflate")) &&
+                    (memcmp(field.value, "deflate", field.len) == 0)
+                    )
+                {
+                    response_encoding = ENCODING_DEFLATE;
+                }
+                break;
+
+            case SMP2_FIELD_BOARD:
+                board_name = field.value;
+                board_len = field.len;
+                break;
+
+            case SMP2_FIELD_ACCEPT_FRAMING:
+                if (
+                    (field.len == strlen("chunked")) &&
+                    (memcmp(field.value, "chunked", field.len) == 0)
+                    )
+                {
+                    response_framing = FRAMING_CHUNKED;
+                }
+                break;
+
+            case SMP2_FIELD_ACCEPT_RANGES:
+                response_ranges = RANGES_BYTES;
+                break;
+
+            case SMP2_FIELD_RESUME:
+                resume_id = (field.len > 2 * sizeof(uint64_t)) ? smp2_get_u64(field.value) : 0;
+
+                if (
+                    (resume_id == 0) ||
+                    (set_resume_position(
+                        (const char *) field.value + 2 * sizeof(uint64_t),
+                        field.len - 2 * sizeof(uint64_t),
+                        smp2_get_u64(field.value + sizeof(uint64_t))
+                        ) == -1)
+                    )
+                {
+                    (void) snprintf(
+                        errormsg,
+		        sizeof(errormsg),
+                        "Field <code>resume</code> requires a response id, an "
+                        "offset and the name of a file of an OK response\n"
+                        );
+                    return SMSL_E_INVAL;
+                }
+                break;
+
+            case SMP2_FIELD_RECORD:
+                break;  /* processed by process_batch() */
+
+            default:
+                break;  /* unknown fields are skipped */
+        }
+
+        if (rc == -1)
+        {
+            break;
+        }
+    }
 
-    if (cnt < 0)
+    if (rc == -1)
     {
         (void) snprintf(
             errormsg,
 	    sizeof(errormsg),
-            "%s: snprintf() failed - <pre>%s</pre>\n",
-	    cmd,
-            strerror(errno)
+            "Malformed field in request frame of protocol version %d\n",
+	    SMP2_VERSION
             );
-        return -1;
+        return SMSL_E_INVAL;
     }
-    else if ((size_t) cnt >= sizeof(file))
+
+    if (
+        (board_name != NULL) &&
+        ((rc = select_board(homedir, (const char *) board_name, board_len)) != SMSL_E_OK)
+        )
     {
-        (void) snprintf(
-            errormsg,
-	    sizeof(errormsg),
-	    "Filename for bulleting board file (incl. path) is too long - "
-	    "only a maximum of %d bytes are supported\n",
-            MAXPATHLEN
-            );
-        return -1;
+        return rc;
     }
 
-    if ((fp = fopen(file, "a+")) == NULL)
+    if (records > 0)
     {
-        (void) snprintf(
-            errormsg,
-	    sizeof(errormsg),
-            "Unable to open file <code>%s</code> - <pre>%s</pre>\n",
-	    file,
-	    strerror(errno)
+        return process_batch(
+            homedir,
+            (const unsigned char *) buf + SMP2_HEADER_LEN,
+            end,
+            records,
+            request
             );
-        return -1;
     }
 
-    if (flock(fileno(fp), LOCK_EX) == -1)
+    if (resume_id != 0)
+    {
+        return collect_resume(homedir, resume_id, request);
+    }
+
+    if (has_subscribe)
+    {
+        request->type = REQUEST_SUBSCRIBE;
+        return collect_delta(homedir, since, request);
+    }
+
+    if (has_since)
+    {
+        request->type = REQUEST_DELTA;
+        return collect_delta(homedir, since, request);
+    }
+
+    if (has_metrics)
+    {
+        request->type = REQUEST_METRICS;
+        return collect_metrics(request);
+    }
+
+    if (search != NULL)
+    {
+        if (validate_field("search", search, search_len, 0) == -1)
+        {
+            return SMSL_E_INVAL;    /* input malformed */
+        }
+
+        return collect_search(homedir, search, search_len, request);
+    }
+
+    if (posts_by != NULL)
+    {
+        if (validate_field("posts_by", posts_by, posts_by_len, 0) == -1)
+        {
+            return SMSL_E_INVAL;    /* input malformed */
+        }
+
+        return collect_posts_by(homedir, posts_by, posts_by_len, request);
+    }
+
+    if ((user == NULL) || (msg == NULL))
     {
         (void) snprintf(
             errormsg,
 	    sizeof(errormsg),
-            "Upable to lock file <code>%s</code> - <pre>%s</pre>\n",
-	    file,
-	    strerror(errno)
+            "Field <code>user</code> or <code>msg</code> is missing\n"
             );
-        (void) fclose(fp);
-        return -1;
+        return SMSL_E_INVAL;
     }
 
     if (
-	fwrite(
-	    content_entry,
-	    sizeof(char),
-	    content_wr_count,
-	    fp
-	    ) != content_wr_count)
+	(validate_field("user", user, user_len, 0) == -1) ||
+	((img != NULL) && (validate_field("img", img, img_len, 0) == -1)) ||
+	(validate_field("msg", msg, msg_len, 1) == -1)
+	)
     {
-        (void) snprintf(
-            errormsg,
-	    sizeof(errormsg),
-            "Unbale to write to file <code>%s</code> - <pre>%s</pre>\n",
-	    file,
-	    strerror(errno)
-            );
-        (void) fclose(fp);
-        return -1;
+        return SMSL_E_INVAL;    /* input malformed */
     }
 
-    if (fclose(fp) == EOF)  /* unlock performed automatically with close */
+    now = time(NULL);
+
+    if (check_duplicate(user, user_len, msg, msg_len, now) == -1)
     {
-        (void) snprintf(
-            errormsg,
-	    sizeof(errormsg),
-            "Unable to close (flush) file <code>%s</code> - <pre>%s</pre>\n",
-	    file,
-	    strerror(errno)
-            );
-        return -1;
+        return SMSL_E_DUPLICATE;
+    }
+
+    if (post_message(homedir, user, img, msg, &request->seq))
+    {
+        withdraw_duplicate(user, user_len, msg, msg_len, now);
+        return SMSL_E_INVAL;    /* write to content file failed */
+    }
+
+    count_post(user, user_len, msg, msg_len);
+    update_snapshot(homedir);
+
+    return SMSL_E_OK;
+}
+
+/**
+ * \brief Discard pending input
+ *
+ * Read and discard the next \a len bytes from stdin, e.g. the payload
+ * of a frame which exceeds the input buffer.
+ *
+ * \param len number of bytes to be discarded [IN]
+ *
+ * \retval 0 success
+ * \retval -1 stdin ended before
+ */
+static int discard_input(
+    size_t len
+    )
+{
+    char buf[CHUNKSIZE];
+    size_t cnt;
+
+    while (len > 0)
+    {
+        cnt = (len < sizeof(buf)) ? len : sizeof(buf);
+
+        if (fread(buf, sizeof(char), cnt, stdin) != cnt)
+        {
+            return -1;
+        }
+
+        len -= cnt;
     }
 
     return 0;
 }
 
+/**
+ * \brief Check whether the client sends a further request
+ *
+ * Wait until the client either sends the next request or closes its
+ * side of the connection.
+ *
+ * \return Information whether or not a further request is pending
+ * \retval 1 the next request is pending
+ * \retval 0 the client closed the connection
+ */
+static int more_requests(
+    void
+    )
+{
+    int c;
+
+    if ((c = getc(stdin)) == EOF)
+    {
+        return 0;
+    }
+
+    (void) ungetc(c, stdin);
+
+    return 1;
+}
+
 /**
  * \brief Read, validate and store the client request message.
  *
  * Read the client's input request from stdin, validate this input by
  * calling \a validate_input() and \a split_input(), and store the
  * client message into bulletin board content file by calling \a
- * post_message().
+ * post_message(). A request of protocol version 1 ends with the input,
+ * a request of version 2 ends with its frame.
  *
  * \param homedir zero-terminated string containing the path to the user's
           home directory [IN]
  * \param mainpagecreated value indicating if main page has been
  *        created successfully (0 in that case; -1 upon failue) [OUT]
+ * \param request filled with the type of the request and the data for
+ *        the response [OUT]
  *
  * \return Information on whether or not the processing was successful
  * \retval SMSL_E_OK success
  * \retval SMSL_E_FAILED a general error occured
  * \retval SMSL_E_INVAL input invalid / not accepted
  * \retval SMSL_E_OVERFLOW given input exceeds internal buffer size
+ * \retval SMSL_E_DUPLICATE the message is a duplicate, see check_duplicate()
  */
 static int process_message(
     const char *homedir,
-    int mainpagecreated
+    int mainpagecreated,
+    request_t *request
     )
 {
     char buf[MAXMESSAGELEN];
-    int cnt;
-    const char *user, *img, *msg;
-
+    char *req = buf;
+    char *frame = buf;
+    size_t cnt, len, board_len;
+    int rc = SMSL_E_OK;
+    const char *user, *img, *msg, *board_name;
+    uint64_t since, id;
+    smp2_header_t header;
+    time_t now;
+
+    memset(request, 0, sizeof(*request));
     memset(buf, 0, sizeof(buf));
-    if ((cnt = fread(buf, sizeof(char), sizeof(buf) - 1, stdin)) <= 0)
+
+    /*
+     * read the header of a frame of protocol version 2 resp. the
+     * beginning of a request of version 1.
+     */
+    if ((cnt = fread(buf, sizeof(char), SMP2_HEADER_LEN, stdin)) == 0)
     {
         return SMSL_E_INVAL;  /* nothing read at all */
     }
 
+    /*
+     * answer in the protocol version of the request, even if it is
+     * rejected.
+     */
+    if (smp2_is_frame(buf, cnt))
+    {
+        protocol = PROTOCOL_V2;
+
+        if (
+	    (cnt < SMP2_HEADER_LEN) ||
+	    (smp2_decode_header(buf, &header) == -1)
+	    )
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Malformed frame header of protocol version %d\n",
+	        SMP2_VERSION
+                );
+            return SMSL_E_INVAL;  /* the frames are out of sync */
+        }
+
+        /*
+         * the request ends with its frame, the connection may carry
+         * further requests.
+         */
+        if (header.len > SMP2_MAXBATCHLEN)
+        {
+            keep_connection = (discard_input(header.len) == 0);
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+	        "Server input buffer overflow - "
+	        "processing of input messages is limited to %u bytes\n",
+	        SMP2_MAXBATCHLEN
+                );
+            return SMSL_E_OVERLOW;
+        }
+
+        /*
+         * only a batch request exceeds the input buffer, which is
+         * checked by process_v2_request().
+         */
+        if (header.len > sizeof(buf) - 1 - SMP2_HEADER_LEN)
+        {
+            if ((frame = malloc(SMP2_HEADER_LEN + header.len + 1)) == NULL)
+            {
+                keep_connection = (discard_input(header.len) == 0);
+                (void) snprintf(
+                    errormsg,
+	            sizeof(errormsg),
+                    "Out of memory reading a request frame of %u bytes\n",
+	            (unsigned) header.len
+                    );
+                return SMSL_E_FAILED;
+            }
+
+            memcpy(frame, buf, cnt);
+        }
+
+        if (fread(frame + cnt, sizeof(char), header.len, stdin) != header.len)
+        {
+            (void) snprintf(
+                errormsg,
+	        sizeof(errormsg),
+                "Request frame is truncated\n"
+                );
+
+            if (frame != buf)
+            {
+                free(frame);
+            }
+
+            return SMSL_E_INVAL;
+        }
+
+        frame[cnt + header.len] = '\0';
+
+        cnt += header.len;
+        keep_connection = 1;
+    }
+    else
+    {
+        cnt += fread(buf + cnt, sizeof(char), sizeof(buf) - 1 - cnt, stdin);
+    }
+
     /*
      * if we are at EOF the user input is finished. otherwise
      * there is more input pending which would overflow our internal
      * buffer.
      */
-    if (!feof(stdin))
+    if ((protocol == PROTOCOL_V1) && !feof(stdin))
     {
         (void) snprintf(
             errormsg,
@@ -1412,7 +6853,21 @@ static int process_message(
 	    sizeof(errormsg),
             "Server could not create main HTML page\n"
             );
-	return SMSL_E_FAILED;
+        rc = SMSL_E_FAILED;
+    }
+    else if (protocol == PROTOCOL_V2)
+    {
+        rc = process_v2_request(homedir, frame, cnt, request);
+    }
+
+    if (frame != buf)
+    {
+        free(frame);
+    }
+
+    if ((mainpagecreated != 0) || (protocol == PROTOCOL_V2))
+    {
+        return rc;
     }
 
     if (validate_input(buf, cnt) == -1)
@@ -1420,16 +6875,105 @@ static int process_message(
         return SMSL_E_INVAL;    /* input malformed */
     }
 
-    if (split_input(buf, &user, &img, &msg) == -1)
+    parse_request_options(&req, &board_name, &board_len);
+
+    if (
+        (board_name != NULL) &&
+        ((rc = select_board(homedir, board_name, board_len)) != SMSL_E_OK)
+        )
+    {
+        return rc;
+    }
+
+    if (strncmp(req, KEYWORD_SINCE, strlen(KEYWORD_SINCE)) == 0)
+    {
+        request->type = REQUEST_DELTA;
+
+        if (parse_delta_request(req + strlen(KEYWORD_SINCE), &since) == -1)
+        {
+            return SMSL_E_INVAL;    /* input malformed */
+        }
+
+        return collect_delta(homedir, since, request);
+    }
+
+    if (
+	(strcmp(req, KEYWORD_METRICS) == 0) ||
+	(strcmp(req, KEYWORD_METRICS "\n") == 0)
+	)
+    {
+        request->type = REQUEST_METRICS;
+
+        return collect_metrics(request);
+    }
+
+    if (strncmp(req, KEYWORD_SEARCH, strlen(KEYWORD_SEARCH)) == 0)
+    {
+        req += strlen(KEYWORD_SEARCH);
+        len = strcspn(req, "\n");
+
+        if ((req[len] == '\n') && (req[len + 1] != '\0'))
+        {
+            (void) snprintf(
+                errormsg,
+		sizeof(errormsg),
+                "Keyword <code>search</code> requires a single line\n"
+                );
+            return SMSL_E_INVAL;    /* input malformed */
+        }
+
+        return collect_search(homedir, req, len, request);
+    }
+
+    if (strncmp(req, KEYWORD_RESUME, strlen(KEYWORD_RESUME)) == 0)
+    {
+        if (parse_resume_request(req + strlen(KEYWORD_RESUME), &id) == -1)
+        {
+            return SMSL_E_INVAL;    /* input malformed */
+        }
+
+        return collect_resume(homedir, id, request);
+    }
+
+    if (strncmp(req, KEYWORD_POSTS_BY, strlen(KEYWORD_POSTS_BY)) == 0)
+    {
+        req += strlen(KEYWORD_POSTS_BY);
+        len = strcspn(req, "\n");
+
+        if ((len == 0) || ((req[len] == '\n') && (req[len + 1] != '\0')))
+        {
+            (void) snprintf(
+                errormsg,
+		sizeof(errormsg),
+                "Keyword <code>posts_by</code> requires a user on a single line\n"
+                );
+            return SMSL_E_INVAL;    /* input malformed */
+        }
+
+        return collect_posts_by(homedir, req, len, request);
+    }
+
+    if (split_input(req, &user, &img, &msg) == -1)
     {
         return SMSL_E_INVAL;    /* input malformed */
     }
 
-    if (post_message(homedir, user, img, msg))
+    now = time(NULL);
+
+    if (check_duplicate(user, strlen(user), msg, strlen(msg), now) == -1)
+    {
+        return SMSL_E_DUPLICATE;
+    }
+
+    if (post_message(homedir, user, img, msg, &request->seq))
     {
+        withdraw_duplicate(user, strlen(user), msg, strlen(msg), now);
         return SMSL_E_INVAL;    /* write to content file failed */
     }
 
+    count_post(user, strlen(user), msg, strlen(msg));
+    update_snapshot(homedir);
+
     return SMSL_E_OK;
 }
 
@@ -1451,9 +6995,11 @@ int main(
     char **argv
     )
 {
-    int c, status;
+    int c, status, boards_valid;
+    int failed = 0;
     int mainpagecreated = -1;
-    char url[MAXURLLEN], homedir[MAXPATHLEN];
+    char url[MAXURLLEN], page[MAXURLLEN], homedir[MAXPATHLEN];
+    request_t request;
     struct option long_options[] =
     {
         {"help", 0, NULL, 'h'},
@@ -1489,12 +7035,62 @@ int main(
         usage(stderr, EXIT_FAILURE);
     }
 
+#ifndef SMSL_NO_TESTCASES
     testcase = get_testcase();
 
     if (testcase == -1)
     {
 	usage(stderr, EXIT_FAILURE);
     }
+#endif
+
+    append_mode = get_append_mode();
+
+    if (append_mode == -1)
+    {
+	usage(stderr, EXIT_FAILURE);
+    }
+
+    segment_size = get_env_number("SMSL_SEGMENT_SIZE", DEFAULT_SEGMENT_SIZE, LONG_MAX);
+    segment_age = get_env_number("SMSL_SEGMENT_AGE", DEFAULT_SEGMENT_AGE, LONG_MAX);
+    segment_keep = get_env_number("SMSL_SEGMENT_KEEP", DEFAULT_SEGMENT_KEEP, INT_MAX);
+
+    snapshot_posts = get_env_number("SMSL_SNAPSHOT_POSTS", DEFAULT_SNAPSHOT_POSTS, INT_MAX);
+    search_pending = get_env_number("SMSL_SEARCH_PENDING", DEFAULT_SEARCH_PENDING, INT_MAX);
+
+    duplicate_window = get_env_number("SMSL_DUPLICATE_WINDOW", DEFAULT_DUPLICATE_WINDOW, INT_MAX);
+    duplicate_limit = get_env_number("SMSL_DUPLICATE_LIMIT", DEFAULT_DUPLICATE_LIMIT, DF_MAXCOUNT - 1);
+    duplicate_memory = get_env_number("SMSL_DUPLICATE_MEMORY", DEFAULT_DUPLICATE_MEMORY, MAX_DUPLICATE_MEMORY);
+
+    durability = get_durability();
+    group_commit_delay = get_env_number(
+	"SMSL_GROUP_COMMIT_DELAY",
+	DEFAULT_GROUP_COMMIT_DELAY,
+	MAX_GROUP_COMMIT_DELAY
+	);
+
+    storage = get_storage();
+    boards_valid = get_boards();
+
+    if (
+	(segment_size <= 0) ||
+	(segment_age == -1) ||
+	(segment_keep == -1) ||
+	(snapshot_posts == -1) ||
+	(search_pending <= 0) ||
+	(duplicate_window == -1) ||
+	(duplicate_limit <= 0) ||
+	(duplicate_memory <= 0) ||
+	(durability == -1) ||
+	(group_commit_delay == -1) ||
+	(storage == NULL) ||
+	(boards_valid == -1)
+	)
+    {
+	usage(stderr, EXIT_FAILURE);
+    }
+
+    bb_use_backend(storage);
 
     memset(chunk_of_blanks, ' ', sizeof(chunk_of_blanks));
 
@@ -1512,20 +7108,72 @@ int main(
         assert_files_closed();
     }
 
+#ifndef SMSL_NO_TESTCASES
     set_seed_for_random_number_generation();
+#endif
     turn_off_nagle_algorithm();
+    get_peer_address();
 
     get_url_and_homedir(url, sizeof(url), homedir, sizeof(homedir));
 
     mainpagecreated = create_main_page(homedir);
 
-    if ((status = process_message(homedir, mainpagecreated)) == SMSL_E_OK)
+    /*
+     * a connection of protocol version 2 carries a sequence of request
+     * frames until the client closes its side. the responses are
+     * written in the order of the requests, thus the client may send
+     * the next request before the response to the previous one.
+     */
+    do
     {
-        ok_response(url);
-    }
-    else
+        keep_connection = 0;
+        response_encoding = ENCODING_IDENTITY;
+        response_framing = FRAMING_LENGTH;
+        response_ranges = RANGES_NONE;
+        memset(&resume, 0, sizeof(resume));
+        board = NULL;
+
+        if ((status = process_message(homedir, mainpagecreated, &request)) == SMSL_E_OK)
+        {
+            count_request();
+
+            if (
+                (request.type == REQUEST_DELTA) ||
+                (request.type == REQUEST_SEARCH) ||
+                (request.type == REQUEST_POSTS_BY)
+                )
+            {
+                delta_response(&request);
+            }
+            else if (request.type == REQUEST_METRICS)
+            {
+                metrics_response(&request);
+            }
+            else if (request.type == REQUEST_BATCH)
+            {
+                batch_response(board_url(url, page, sizeof(page)), &request);
+            }
+            else if (request.type == REQUEST_SUBSCRIBE)
+            {
+                subscribe_response(homedir, &request);
+                keep_connection = 0;
+            }
+            else
+            {
+                ok_response(board_url(url, page, sizeof(page)), &request);
+            }
+        }
+        else
+        {
+            error_response(status);
+            failed = 1;
+        }
+
+        write_end();
+    } while (keep_connection && more_requests());
+
+    if (failed)
     {
-        error_response(status);
         return EXIT_FAILURE;
     }
 
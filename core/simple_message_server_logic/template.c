@@ -0,0 +1,254 @@
+/* ================================================================ */
+/**
+ * @file template.c
+ * Compiled HTML templates of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the rendering of the templates compiled
+ * by "bin2c -t".
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <string.h>
+
+#include "template.h"
+#include "html_escape.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+/*
+ * a stored deflate block: header byte (BFINAL, BTYPE 00), LEN and NLEN
+ * (little endian), followed by at most 65535 bytes of data.
+ */
+#define STORED_HEADER_LEN 5
+#define STORED_MAXLEN 65535U
+
+/*
+ * escaped HTML arguments are split into slices which fit into a
+ * single stored block in any case.
+ */
+#define HTML_SLICE_LEN (STORED_MAXLEN / HTML_ESCAPE_MAXEXPANSION)
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+size_t template_length(
+    const template_t *tpl,
+    const template_arg_t *args
+    )
+{
+    const template_segment_t *seg = tpl->segments;
+    const template_segment_t *end = seg + tpl->count;
+    size_t len = tpl->literal_len;
+
+    for (; seg < end; seg++)
+    {
+        if (seg->type == TEMPLATE_STRING)
+        {
+            len += (args++)->len;
+        }
+        else if (seg->type == TEMPLATE_HTML)
+        {
+            len += html_escaped_length(args->s, args->len);
+            args++;
+        }
+    }
+
+    return len;
+}
+
+ssize_t template_render(
+    const template_t *tpl,
+    const template_arg_t *args,
+    char *buf,
+    size_t len
+    )
+{
+    const template_segment_t *seg = tpl->segments;
+    const template_segment_t *end = seg + tpl->count;
+    char *p = buf;
+    size_t left;
+    ssize_t cnt;
+
+    if (len == 0)
+    {
+        return -1;
+    }
+
+    left = len - 1;  /* room for the terminating zero */
+
+    /*
+     * escaped arguments are written right into the buffer, thus the
+     * space left is checked segment by segment.
+     */
+    for (; seg < end; seg++)
+    {
+        if (seg->type == TEMPLATE_HTML)
+        {
+            if ((cnt = html_escape(p, left, args->s, args->len)) == -1)
+            {
+                return -1;
+            }
+            args++;
+        }
+        else
+        {
+            const char *text = (seg->type == TEMPLATE_LITERAL) ? seg->text : args->s;
+
+            cnt = (ssize_t) ((seg->type == TEMPLATE_LITERAL) ? seg->len : (args++)->len);
+
+            if ((size_t) cnt > left)
+            {
+                return -1;
+            }
+
+            memcpy(p, text, (size_t) cnt);
+        }
+
+        p += cnt;
+        left -= (size_t) cnt;
+    }
+
+    *p = '\0';
+
+    return p - buf;
+}
+
+/**
+ * \brief Get the length of data sent as stored deflate blocks
+ *
+ * \param len length of the data [IN]
+ *
+ * \return length of the stored blocks incl. their headers
+ */
+static size_t stored_length(
+    size_t len
+    )
+{
+    return len + STORED_HEADER_LEN * ((len + STORED_MAXLEN - 1) / STORED_MAXLEN);
+}
+
+/**
+ * \brief Write the header of a stored deflate block
+ *
+ * \param p buffer for the header [OUT]
+ * \param len length of the block [IN]
+ * \param final 1 for the final block of the stream, 0 otherwise [IN]
+ */
+static void stored_header(
+    char *p,
+    size_t len,
+    int final
+    )
+{
+    p[0] = (char) final;
+    p[1] = (char) (len & 0xff);
+    p[2] = (char) (len >> 8);
+    p[3] = (char) (~len & 0xff);
+    p[4] = (char) ((~len >> 8) & 0xff);
+}
+
+size_t template_deflated_length(
+    const template_t *tpl,
+    const template_arg_t *args
+    )
+{
+    const template_segment_t *seg = tpl->segments;
+    const template_segment_t *end = seg + tpl->count;
+    size_t len = tpl->deflated_len + STORED_HEADER_LEN;  /* final block */
+    size_t off, slice;
+
+    for (; seg < end; seg++)
+    {
+        if (seg->type == TEMPLATE_STRING)
+        {
+            len += stored_length((args++)->len);
+        }
+        else if (seg->type == TEMPLATE_HTML)
+        {
+            for (off = 0; off < args->len; off += slice)
+            {
+                slice = (args->len - off < HTML_SLICE_LEN) ? args->len - off : HTML_SLICE_LEN;
+                len += stored_length(html_escaped_length(args->s + off, slice));
+            }
+            args++;
+        }
+    }
+
+    return len;
+}
+
+ssize_t template_render_deflated(
+    const template_t *tpl,
+    const template_arg_t *args,
+    char *buf,
+    size_t len
+    )
+{
+    const template_segment_t *seg = tpl->segments;
+    const template_segment_t *end = seg + tpl->count;
+    char *p = buf;
+    size_t off, slice, block;
+    ssize_t cnt;
+
+    if (template_deflated_length(tpl, args) > len)
+    {
+        return -1;
+    }
+
+    /*
+     * the buffer is known to be large enough, thus no further checks.
+     */
+    for (; seg < end; seg++)
+    {
+        if (seg->type == TEMPLATE_LITERAL)
+        {
+            memcpy(p, seg->deflated, seg->deflated_len);
+            p += seg->deflated_len;
+        }
+        else if (seg->type == TEMPLATE_STRING)
+        {
+            for (off = 0; off < args->len; off += block)
+            {
+                block = (args->len - off < STORED_MAXLEN) ? args->len - off : STORED_MAXLEN;
+                stored_header(p, block, 0);
+                memcpy(p + STORED_HEADER_LEN, args->s + off, block);
+                p += STORED_HEADER_LEN + block;
+            }
+            args++;
+        }
+        else
+        {
+            for (off = 0; off < args->len; off += slice)
+            {
+                slice = (args->len - off < HTML_SLICE_LEN) ? args->len - off : HTML_SLICE_LEN;
+                cnt = html_escape(p + STORED_HEADER_LEN, STORED_MAXLEN, args->s + off, slice);
+                stored_header(p, (size_t) cnt, 0);
+                p += STORED_HEADER_LEN + (size_t) cnt;
+            }
+            args++;
+        }
+    }
+
+    stored_header(p, 0, 1);
+    p += STORED_HEADER_LEN;
+
+    return p - buf;
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,151 @@
+/* ================================================================ */
+/**
+ * @file template.h
+ * Compiled HTML templates of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * The .thtml templates are compiled by "bin2c -t" at build time into a
+ * table of literal segments and placeholders. Each "%s" of a template
+ * becomes a placeholder which is replaced by the next argument, each
+ * "%h" one which is replaced by the next argument escaped for HTML
+ * (see html_escape.h), "%%" stands for a literal '%'. Rendering a
+ * template merely copies the segments, the length of the literal text
+ * is known in advance.
+ *
+ * Every literal segment is additionally compressed at build time into
+ * a raw deflate stream (RFC 1951) which ends on a byte boundary. A
+ * compressed response is assembled from these streams and the
+ * arguments sent as stored blocks without any compression at runtime.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef TEMPLATE_H
+#define TEMPLATE_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define TEMPLATE_LITERAL 0  /* literal text of the template */
+#define TEMPLATE_STRING  1  /* placeholder "%s" */
+#define TEMPLATE_HTML    2  /* placeholder "%h" */
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A segment of a compiled template. \a text, \a len and the deflated
+ * text are only used for literal segments.
+ */
+typedef struct
+{
+    int type;
+    const char *text;
+    size_t len;
+    const unsigned char *deflated;
+    size_t deflated_len;
+} template_segment_t;
+
+/**
+ * A compiled template.
+ */
+typedef struct
+{
+    const template_segment_t *segments;
+    size_t count;               /* number of segments */
+    size_t literal_len;         /* total length of the literal segments */
+    size_t placeholders;        /* number of placeholders */
+    size_t deflated_len;        /* total length of the deflated literals */
+} template_t;
+
+/**
+ * An argument replacing a placeholder.
+ */
+typedef struct
+{
+    const char *s;
+    size_t len;
+} template_arg_t;
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Get the length of a rendered template
+ *
+ * \param tpl the compiled template [IN]
+ * \param args one argument per placeholder of \a tpl [IN]
+ *
+ * \return the length of the rendered template (excl. terminating zero)
+ */
+extern size_t template_length(const template_t *tpl, const template_arg_t *args);
+
+/**
+ * \brief Render a template into a buffer
+ *
+ * Render the template \a tpl with the arguments \a args into \a buf and
+ * terminate it with a zero.
+ *
+ * \param tpl the compiled template [IN]
+ * \param args one argument per placeholder of \a tpl [IN]
+ * \param buf buffer for the rendered template [OUT]
+ * \param len size of the buffer pointed to by \a buf [IN]
+ *
+ * \return number of bytes rendered (excl. terminating zero)
+ * \retval -1 the rendered template does not fit into \a buf
+ */
+extern ssize_t template_render(
+    const template_t *tpl, const template_arg_t *args, char *buf, size_t len
+    );
+
+/**
+ * \brief Get the length of a rendered and deflated template
+ *
+ * \param tpl the compiled template [IN]
+ * \param args one argument per placeholder of \a tpl [IN]
+ *
+ * \return the length of the raw deflate stream of the rendered template
+ */
+extern size_t template_deflated_length(
+    const template_t *tpl, const template_arg_t *args
+    );
+
+/**
+ * \brief Render a template as raw deflate stream
+ *
+ * Render the template \a tpl with the arguments \a args into \a buf as
+ * complete raw deflate stream (RFC 1951), e.g. for clients which
+ * accept compressed responses.
+ *
+ * \param tpl the compiled template [IN]
+ * \param args one argument per placeholder of \a tpl [IN]
+ * \param buf buffer for the deflate stream [OUT]
+ * \param len size of the buffer pointed to by \a buf [IN]
+ *
+ * \return number of bytes rendered
+ * \retval -1 the deflate stream does not fit into \a buf
+ */
+extern ssize_t template_render_deflated(
+    const template_t *tpl, const template_arg_t *args, char *buf, size_t len
+    );
+
+#endif /* TEMPLATE_H */
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,824 @@
+/* ================================================================ */
+/**
+ * @file user_index.c
+ * Index of the posts of every user of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the hash table of the users of the post
+ * store and their chained postings (see user_index.h for the file
+ * layout). New users and postings are appended to the index file and
+ * linked afterwards, the writer holds an exclusive flock() of the file,
+ * the readers a shared one.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+
+#include "user_index.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define MAXPATHLEN _POSIX_PATH_MAX
+
+#define UI_MAGIC "SMUI"
+#define UI_MAGIC_LEN 4
+#define UI_VERSION 1U
+#define UI_HEADER_LEN 32
+#define UI_TABLE_LEN (UI_HEADER_LEN + UI_BUCKETS * sizeof(uint64_t))
+#define UI_USER_LEN 48
+#define UI_POSTING_LEN 16
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+/**
+ * A user read from the index file.
+ */
+typedef struct
+{
+    uint64_t offset;     /* offset of the user in the file, 0 if not found */
+    uint64_t next;
+    uint64_t last;       /* offset of the last posting */
+    uint64_t last_post;
+    uint64_t posts;
+} user_t;
+
+/**
+ * The header of the index file.
+ */
+typedef struct
+{
+    uint64_t posts;      /* number of posts covered */
+    uint64_t users;
+} header_t;
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Build the path of the index file
+ *
+ * \param file buffer for the path [OUT]
+ * \param len size of the buffer pointed to by \a file [IN]
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ *
+ * \retval 0 success
+ * \retval -1 the path is too long, errno is set
+ */
+static int make_path(
+    char *file,
+    size_t len,
+    const char *dir
+    )
+{
+    int cnt;
+
+    cnt = snprintf(file, len, "%s/%s", dir, UI_INDEX_FILE);
+
+    if ((cnt < 0) || ((size_t) cnt >= len))
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Hash the name of a user (FNV-1a)
+ *
+ * \param user the name of the user [IN]
+ * \param len length of \a user [IN]
+ *
+ * \return the hash of the name
+ */
+static uint64_t hash_user(
+    const char *user,
+    size_t len
+    )
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash ^= (unsigned char) user[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Read exactly \a len bytes at offset \a offset
+ *
+ * \param fd file descriptor to read from [IN]
+ * \param buf buffer to be filled [OUT]
+ * \param len number of bytes to read [IN]
+ * \param offset position in the file to read from [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set (EIO: the file ends before)
+ */
+static int read_at(
+    int fd,
+    void *buf,
+    size_t len,
+    uint64_t offset
+    )
+{
+    ssize_t cnt;
+
+    if ((cnt = pread(fd, buf, len, (off_t) offset)) == -1)
+    {
+        return -1;
+    }
+
+    if ((size_t) cnt != len)
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Write exactly \a len bytes at offset \a offset
+ *
+ * \param fd file descriptor to write to [IN]
+ * \param buf buffer to be written [IN]
+ * \param len number of bytes to write [IN]
+ * \param offset position in the file to write to [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int write_at(
+    int fd,
+    const void *buf,
+    size_t len,
+    uint64_t offset
+    )
+{
+    ssize_t cnt;
+
+    if ((cnt = pwrite(fd, buf, len, (off_t) offset)) == -1)
+    {
+        return -1;
+    }
+
+    if ((size_t) cnt != len)
+    {
+        errno = EIO;  /* short write on a regular file - disk full */
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Read the header of the index file
+ *
+ * A header which is malformed, covers more posts than the store holds
+ * or has been built for another store is not valid.
+ *
+ * \param fd file descriptor of the index file [IN]
+ * \param store the opened store [IN]
+ * \param count number of posts in the store [IN]
+ * \param header filled with the header [OUT]
+ *
+ * \return whether the header is valid
+ * \retval 1 valid
+ * \retval 0 not valid
+ * \retval -1 failed, errno is set
+ */
+static int read_header(
+    int fd,
+    bb_store_t *store,
+    uint64_t count,
+    header_t *header
+    )
+{
+    unsigned char buf[UI_HEADER_LEN];
+    struct stat statbuf;
+    uint32_t version;
+    uint64_t id;
+
+    if (fstat(fd, &statbuf) == -1)
+    {
+        return -1;
+    }
+
+    if ((uint64_t) statbuf.st_size < UI_TABLE_LEN)
+    {
+        return 0;
+    }
+
+    if (read_at(fd, buf, sizeof(buf), 0) == -1)
+    {
+        return -1;
+    }
+
+    memcpy(&version, buf + 4, sizeof(version));
+    memcpy(&id, buf + 8, sizeof(id));
+    memcpy(&header->posts, buf + 16, sizeof(header->posts));
+    memcpy(&header->users, buf + 24, sizeof(header->users));
+
+    return (
+        (memcmp(buf, UI_MAGIC, UI_MAGIC_LEN) == 0) &&
+        (version == UI_VERSION) &&
+        (id == bb_id(store)) &&
+        (header->posts <= count)
+        );
+}
+
+/**
+ * \brief Write the header of the index file
+ *
+ * \param fd file descriptor of the index file [IN]
+ * \param store the opened store [IN]
+ * \param header the header [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int write_header(
+    int fd,
+    bb_store_t *store,
+    const header_t *header
+    )
+{
+    unsigned char buf[UI_HEADER_LEN];
+    const uint32_t version = UI_VERSION;
+    const uint64_t id = bb_id(store);
+
+    memcpy(buf, UI_MAGIC, UI_MAGIC_LEN);
+    memcpy(buf + 4, &version, sizeof(version));
+    memcpy(buf + 8, &id, sizeof(id));
+    memcpy(buf + 16, &header->posts, sizeof(header->posts));
+    memcpy(buf + 24, &header->users, sizeof(header->users));
+
+    return write_at(fd, buf, sizeof(buf), 0);
+}
+
+/**
+ * \brief Get the offset of the bucket of a user in the hash table
+ *
+ * \param hash hash of the name of the user [IN]
+ *
+ * \return offset of the bucket in the index file
+ */
+static uint64_t bucket_offset(
+    uint64_t hash
+    )
+{
+    return UI_HEADER_LEN + (hash & (UI_BUCKETS - 1)) * sizeof(uint64_t);
+}
+
+/**
+ * \brief Find a user in the index file
+ *
+ * The users of a bucket are chained from the newest to the oldest, the
+ * names are only compared for equal hashes.
+ *
+ * \param fd file descriptor of the index file [IN]
+ * \param user the name of the user [IN]
+ * \param len length of \a user [IN]
+ * \param hash hash of \a user [IN]
+ * \param found filled with the user, its offset is 0 if the user has
+ *        not been found [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int find_user(
+    int fd,
+    const char *user,
+    size_t len,
+    uint64_t hash,
+    user_t *found
+    )
+{
+    unsigned char buf[UI_USER_LEN];
+    char name[BB_MAXPOSTLEN];
+    uint64_t offset, user_hash;
+    uint32_t name_len;
+
+    memset(found, 0, sizeof(*found));
+
+    if (read_at(fd, &offset, sizeof(offset), bucket_offset(hash)) == -1)
+    {
+        return -1;
+    }
+
+    /*
+     * a user is always linked to users added before, a chain pointing
+     * forward is damaged and ends there.
+     */
+    while (offset >= UI_TABLE_LEN)
+    {
+        if (read_at(fd, buf, sizeof(buf), offset) == -1)
+        {
+            return -1;
+        }
+
+        memcpy(&found->next, buf, sizeof(found->next));
+        memcpy(&user_hash, buf + 8, sizeof(user_hash));
+        memcpy(&name_len, buf + 40, sizeof(name_len));
+
+        if (
+            (user_hash == hash) &&
+            (name_len == len) &&
+            (len <= sizeof(name)) &&
+            (read_at(fd, name, len, offset + UI_USER_LEN) == 0) &&
+            (memcmp(name, user, len) == 0)
+            )
+        {
+            found->offset = offset;
+            memcpy(&found->last, buf + 16, sizeof(found->last));
+            memcpy(&found->last_post, buf + 24, sizeof(found->last_post));
+            memcpy(&found->posts, buf + 32, sizeof(found->posts));
+            return 0;
+        }
+
+        if (found->next >= offset)
+        {
+            break;
+        }
+
+        offset = found->next;
+    }
+
+    memset(found, 0, sizeof(*found));
+
+    return 0;
+}
+
+/**
+ * \brief Add a post to the index file
+ *
+ * The user (if new) and the posting are appended to the file before
+ * they are linked, an interrupted update leaves unreachable bytes only.
+ * A post which has already been added by an interrupted update is
+ * skipped.
+ *
+ * \param fd file descriptor of the index file [IN]
+ * \param end end of the index file, advanced by the appended bytes [IN/OUT]
+ * \param header the header, the number of users is updated [IN/OUT]
+ * \param number the number of the post [IN]
+ * \param post the post [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+static int add_post(
+    int fd,
+    uint64_t *end,
+    header_t *header,
+    uint64_t number,
+    const bb_post_t *post
+    )
+{
+    unsigned char buf[UI_USER_LEN + BB_MAXPOSTLEN];
+    const uint64_t hash = hash_user(post->user, post->user_len);
+    const uint32_t name_len = (uint32_t) post->user_len;
+    uint64_t fields[3];
+    uint64_t posting[2];
+    user_t user;
+
+    if (find_user(fd, post->user, post->user_len, hash, &user) == -1)
+    {
+        return -1;
+    }
+
+    if (user.offset == 0)
+    {
+        /*
+         * the new user becomes the first of its bucket
+         */
+        if (read_at(fd, &user.next, sizeof(user.next), bucket_offset(hash)) == -1)
+        {
+            return -1;
+        }
+
+        memset(buf, 0, UI_USER_LEN);
+        memcpy(buf, &user.next, sizeof(user.next));
+        memcpy(buf + 8, &hash, sizeof(hash));
+        memcpy(buf + 40, &name_len, sizeof(name_len));
+        memcpy(buf + UI_USER_LEN, post->user, post->user_len);
+
+        if (
+            (write_at(fd, buf, UI_USER_LEN + post->user_len, *end) == -1) ||
+            (write_at(fd, end, sizeof(*end), bucket_offset(hash)) == -1)
+            )
+        {
+            return -1;
+        }
+
+        user.offset = *end;
+        *end += UI_USER_LEN + post->user_len;
+        header->users++;
+    }
+    else if ((user.posts > 0) && (user.last_post >= number))
+    {
+        return 0;
+    }
+
+    posting[0] = number;
+    posting[1] = user.last;
+
+    fields[0] = *end;
+    fields[1] = number;
+    fields[2] = user.posts + 1;
+
+    if (
+        (write_at(fd, posting, sizeof(posting), *end) == -1) ||
+        (write_at(fd, fields, sizeof(fields), user.offset + 16) == -1)
+        )
+    {
+        return -1;
+    }
+
+    *end += UI_POSTING_LEN;
+
+    return 0;
+}
+
+int ui_update(
+    const char *dir,
+    bb_store_t *store
+    )
+{
+    char file[MAXPATHLEN];
+    unsigned char *table;
+    struct stat statbuf;
+    bb_record_t record;
+    header_t header;
+    uint64_t end, post;
+    int64_t count;
+    int fd, saved_errno, valid;
+    int rc = -1;
+
+    if ((count = bb_count(store)) == -1)
+    {
+        return -1;
+    }
+
+    if (
+        (make_path(file, sizeof(file), dir) == -1) ||
+        ((fd = open(file, O_RDWR | O_CREAT, 0644)) == -1)
+        )
+    {
+        return -1;
+    }
+
+    if (flock(fd, LOCK_EX) == -1)
+    {
+        goto out;
+    }
+
+    if ((valid = read_header(fd, store, (uint64_t) count, &header)) == -1)
+    {
+        goto unlock;
+    }
+
+    if (!valid)
+    {
+        /*
+         * create the index anew with an empty hash table
+         */
+        if ((table = calloc(1, UI_TABLE_LEN)) == NULL)
+        {
+            errno = ENOMEM;
+            goto unlock;
+        }
+
+        header.posts = 0;
+        header.users = 0;
+
+        if (
+            (ftruncate(fd, 0) == -1) ||
+            (write_at(fd, table, UI_TABLE_LEN, 0) == -1) ||
+            (write_header(fd, store, &header) == -1)
+            )
+        {
+            saved_errno = errno;
+            free(table);
+            errno = saved_errno;
+            goto unlock;
+        }
+
+        free(table);
+    }
+
+    if (header.posts == (uint64_t) count)
+    {
+        rc = 0;
+        goto unlock;
+    }
+
+    if (fstat(fd, &statbuf) == -1)
+    {
+        goto unlock;
+    }
+
+    end = (uint64_t) statbuf.st_size;
+
+    for (post = header.posts; post < (uint64_t) count; post++)
+    {
+        if (
+            (bb_read(store, post, &record) == -1) ||
+            (add_post(fd, &end, &header, post, &record.post) == -1)
+            )
+        {
+            break;
+        }
+
+        header.posts = post + 1;
+    }
+
+    /*
+     * the posts added so far are covered even if a later one failed
+     */
+    saved_errno = errno;
+
+    if (write_header(fd, store, &header) == -1)
+    {
+        goto unlock;
+    }
+
+    if (post != (uint64_t) count)
+    {
+        errno = saved_errno;
+        goto unlock;
+    }
+
+    rc = 0;
+
+unlock:
+    saved_errno = errno;
+    (void) flock(fd, LOCK_UN);
+    errno = saved_errno;
+
+out:
+    saved_errno = errno;
+    (void) close(fd);
+    errno = saved_errno;
+
+    return rc;
+}
+
+/**
+ * \brief Follow the postings of a user
+ *
+ * Collect the newest \a max posts of the user below \a covered from
+ * the newest to the oldest into \a found. A posting which does not
+ * precede its successor in the file and in the store ends the postings
+ * as the chain is damaged.
+ *
+ * \param fd file descriptor of the index file [IN]
+ * \param user the user [IN]
+ * \param covered number of posts covered by the index [IN]
+ * \param max maximum number of posts to be collected [IN]
+ * \param found buffer of \a max post numbers [OUT]
+ *
+ * \return number of posts collected
+ * \retval -1 failed, errno is set
+ */
+static ssize_t follow_postings(
+    int fd,
+    const user_t *user,
+    uint64_t covered,
+    size_t max,
+    uint64_t *found
+    )
+{
+    uint64_t posting[2];
+    uint64_t offset = user->last, limit = covered;
+    size_t n = 0;
+
+    while ((n < max) && (offset >= UI_TABLE_LEN))
+    {
+        if (read_at(fd, posting, sizeof(posting), offset) == -1)
+        {
+            return -1;
+        }
+
+        if (posting[0] >= limit)
+        {
+            break;
+        }
+
+        found[n++] = posting[0];
+        limit = posting[0];
+
+        if (posting[1] >= offset)
+        {
+            break;
+        }
+
+        offset = posting[1];
+    }
+
+    return (ssize_t) n;
+}
+
+int ui_lookup(
+    const char *dir,
+    bb_store_t *store,
+    const char *user,
+    size_t user_len,
+    size_t max,
+    uint64_t **matches,
+    size_t *count
+    )
+{
+    char file[MAXPATHLEN];
+    bb_record_t record;
+    header_t header;
+    user_t found;
+    uint64_t *result, *recent = NULL;
+    uint64_t posts, post, total = 0;
+    size_t n, i, j;
+    ssize_t indexed = 0;
+    int64_t store_count;
+    int fd, saved_errno, valid = 0;
+
+    *matches = NULL;
+    *count = 0;
+
+    if (max == 0)
+    {
+        return 0;
+    }
+
+    if ((store_count = bb_count(store)) == -1)
+    {
+        return -1;
+    }
+
+    posts = (uint64_t) store_count;
+
+    if (
+        ((result = malloc(max * sizeof(*result))) == NULL) ||
+        ((recent = malloc(max * sizeof(*recent))) == NULL)
+        )
+    {
+        free(result);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (make_path(file, sizeof(file), dir) == -1)
+    {
+        goto fail;
+    }
+
+    if ((fd = open(file, O_RDONLY)) == -1)
+    {
+        if (errno != ENOENT)
+        {
+            goto fail;
+        }
+    }
+    else if (flock(fd, LOCK_SH) == -1)
+    {
+        saved_errno = errno;
+        (void) close(fd);
+        errno = saved_errno;
+        goto fail;
+    }
+
+    if (
+        (fd != -1) &&
+        (
+            ((valid = read_header(fd, store, posts, &header)) == -1) ||
+            (
+                valid &&
+                (find_user(fd, user, user_len, hash_user(user, user_len), &found) == -1)
+                )
+            )
+        )
+    {
+        goto unlock;
+    }
+
+    if (!valid)
+    {
+        header.posts = 0;
+    }
+
+    /*
+     * the newest posts are those not covered by the index yet, they
+     * are kept in a ring of max entries
+     */
+    for (post = header.posts; post < posts; post++)
+    {
+        if (bb_read(store, post, &record) == -1)
+        {
+            goto unlock;
+        }
+
+        if (
+            (record.post.user_len == user_len) &&
+            (memcmp(record.post.user, user, user_len) == 0)
+            )
+        {
+            recent[total++ % max] = post;
+        }
+    }
+
+    n = (total < max) ? (size_t) total : max;
+
+    /*
+     * the older posts follow the postings from the newest backwards
+     */
+    if (
+        valid &&
+        (found.offset != 0) &&
+        (n < max) &&
+        ((indexed = follow_postings(fd, &found, header.posts, max - n, result)) == -1)
+        )
+    {
+        goto unlock;
+    }
+
+    if (fd != -1)
+    {
+        (void) flock(fd, LOCK_UN);
+        (void) close(fd);
+    }
+
+    /*
+     * reverse the posts of the index and append those of the ring, its
+     * oldest entry is the next one to be replaced
+     */
+    for (i = 0, j = (size_t) indexed; i + 1 < j; i++, j--)
+    {
+        post = result[i];
+        result[i] = result[j - 1];
+        result[j - 1] = post;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        result[(size_t) indexed + i] = recent[(size_t) ((total - n + i) % max)];
+    }
+
+    free(recent);
+
+    *matches = result;
+    *count = (size_t) indexed + n;
+
+    return 0;
+
+unlock:
+    saved_errno = errno;
+
+    if (fd != -1)
+    {
+        (void) flock(fd, LOCK_UN);
+        (void) close(fd);
+    }
+
+    errno = saved_errno;
+
+fail:
+    saved_errno = errno;
+    free(result);
+    free(recent);
+    errno = saved_errno;
+
+    return -1;
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,125 @@
+/* ================================================================ */
+/**
+ * @file user_index.h
+ * Index of the posts of every user of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the secondary index mapping every user to the
+ * list of the numbers of its posts. It is updated with every committed
+ * post, thus the posts of a user are found without reading the posts
+ * of any other user.
+ *
+ * Layout of the index file (native byte order):
+ *
+ * <pre>
+ *  0: magic   "SMUI" (4 bytes)
+ *  4: uint32_t version UI_VERSION
+ *  8: uint64_t identity of the post store, see bb_id()
+ * 16: uint64_t number of posts covered by the index
+ * 24: uint64_t number of users
+ * 32: hash table of UI_BUCKETS uint64_t offsets of the first user of
+ *     every bucket, 0 if the bucket is empty
+ * </pre>
+ *
+ * The users and postings follow in the order they have been added:
+ *
+ * <pre>
+ * user (UI_USER_LEN bytes followed by the name):
+ *       0: uint64_t offset of the next user of the bucket, 0 if none
+ *       8: uint64_t hash of the name
+ *      16: uint64_t offset of the last posting of the user
+ *      24: uint64_t number of the last post of the user
+ *      32: uint64_t number of posts of the user
+ *      40: uint32_t length of the name
+ *      44: uint32_t unused
+ *      48: the name (not zero-terminated)
+ * posting (UI_POSTING_LEN bytes):
+ *       0: uint64_t number of the post
+ *       8: uint64_t offset of the previous posting of the user, 0 if none
+ * </pre>
+ *
+ * The postings of a user are chained from the newest to the oldest, the
+ * newest posts of a user are found in time proportional to their
+ * number.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef USER_INDEX_H
+#define USER_INDEX_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bulletin_board.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define UI_INDEX_FILE "bulletin_board_users.idx"
+
+#define UI_BUCKETS 4096U  /* buckets of the hash table, a power of 2 */
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Update the index
+ *
+ * Add the posts of the store which are not covered by the index yet.
+ * The index is created anew if it does not exist or belongs to another
+ * store.
+ *
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param store the opened store [IN]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+extern int ui_update(const char *dir, bb_store_t *store);
+
+/**
+ * \brief Find the posts of a user
+ *
+ * Find the posts of the user \a user following its postings, the posts
+ * not covered by the index are read from the store.
+ *
+ * \param dir zero-terminated string containing the directory of the store [IN]
+ * \param store the opened store [IN]
+ * \param user the name of the user [IN]
+ * \param user_len length of \a user [IN]
+ * \param max maximum number of posts to be returned [IN]
+ * \param matches set to the numbers of the newest posts of the user
+ *        (counting from 0) in ascending order, allocated with malloc()
+ *        [OUT]
+ * \param count set to the number of posts in \a matches [OUT]
+ *
+ * \retval 0 success
+ * \retval -1 failed, errno is set
+ */
+extern int ui_lookup(
+    const char *dir,
+    bb_store_t *store,
+    const char *user,
+    size_t user_len,
+    size_t max,
+    uint64_t **matches,
+    size_t *count
+    );
+
+#endif /* USER_INDEX_H */
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,206 @@
+/* ================================================================ */
+/**
+ * @file utf8_validate.c
+ * UTF-8 validation of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file contains the validation of the text received from
+ * the clients. Runs of printable ASCII characters are skipped 16 bytes
+ * at a time with SSE2 (if available), thus plain ASCII text is checked
+ * at about the speed of reading it. Multibyte sequences are checked one
+ * at a time against the ranges of well-formed sequences given in table
+ * 3-7 of the Unicode standard.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "utf8_validate.h"
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Check whether a byte is a printable or white space ASCII character
+ *
+ * \param c the byte [IN]
+ *
+ * \return non-zero if \a c is accepted on its own
+ */
+static int is_plain(
+    unsigned char c
+    )
+{
+    return ((c >= 0x20U) && (c < 0x7fU)) || ((c >= '\t') && (c <= '\r'));
+}
+
+/**
+ * \brief Get the length of the leading run of plain ASCII characters
+ *
+ * \param s the text to be scanned [IN]
+ * \param len length of \a s [IN]
+ *
+ * \return number of leading characters of \a s accepted by is_plain()
+ */
+static size_t plain_run(
+    const char *s,
+    size_t len
+    )
+{
+    size_t i = 0;
+
+#ifdef __SSE2__
+    /*
+     * the comparisons are signed, thus bytes from 0x80 on are less than
+     * any of the bounds.
+     */
+    const __m128i printable_low = _mm_set1_epi8(0x1f);
+    const __m128i printable_high = _mm_set1_epi8(0x7f);
+    const __m128i space_low = _mm_set1_epi8('\t' - 1);
+    const __m128i space_high = _mm_set1_epi8('\r' + 1);
+    __m128i v, m;
+    int mask;
+
+    for (; i + 16 <= len; i += 16)
+    {
+        v = _mm_loadu_si128((const __m128i *) (s + i));
+        m = _mm_or_si128(
+            _mm_and_si128(_mm_cmpgt_epi8(v, printable_low), _mm_cmplt_epi8(v, printable_high)),
+            _mm_and_si128(_mm_cmpgt_epi8(v, space_low), _mm_cmplt_epi8(v, space_high))
+            );
+
+        if ((mask = _mm_movemask_epi8(m)) != 0xffff)
+        {
+            return i + (size_t) __builtin_ctz((unsigned int) ~mask);
+        }
+    }
+#endif
+
+    /*
+     * scalar fallback and the tail of less than 16 bytes
+     */
+    while ((i < len) && is_plain((unsigned char) s[i]))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/**
+ * \brief Get the length of a multibyte sequence
+ *
+ * \param s the sequence, starting with a byte from 0x80 on [IN]
+ * \param len bytes available at \a s [IN]
+ *
+ * \return length of the sequence
+ * \retval 0 the sequence is malformed, truncated or encodes a C1
+ *         control character
+ */
+static size_t sequence_len(
+    const unsigned char *s,
+    size_t len
+    )
+{
+    unsigned char low = 0x80U, high = 0xbfU;  /* range of the second byte */
+    size_t n, i;
+
+    if ((s[0] >= 0xc2U) && (s[0] <= 0xdfU))
+    {
+        n = 2;
+
+        if (s[0] == 0xc2U)
+        {
+            low = 0xa0U;  /* U+0080 to U+009F are control characters */
+        }
+    }
+    else if ((s[0] >= 0xe0U) && (s[0] <= 0xefU))
+    {
+        n = 3;
+
+        if (s[0] == 0xe0U)
+        {
+            low = 0xa0U;  /* overlong */
+        }
+        else if (s[0] == 0xedU)
+        {
+            high = 0x9fU;  /* surrogates */
+        }
+    }
+    else if ((s[0] >= 0xf0U) && (s[0] <= 0xf4U))
+    {
+        n = 4;
+
+        if (s[0] == 0xf0U)
+        {
+            low = 0x90U;  /* overlong */
+        }
+        else if (s[0] == 0xf4U)
+        {
+            high = 0x8fU;  /* beyond U+10FFFF */
+        }
+    }
+    else
+    {
+        return 0;  /* continuation byte, overlong 0xc0/0xc1 or 0xf5 to 0xff */
+    }
+
+    if ((len < n) || (s[1] < low) || (s[1] > high))
+    {
+        return 0;
+    }
+
+    for (i = 2; i < n; i++)
+    {
+        if ((s[i] & 0xc0U) != 0x80U)
+        {
+            return 0;
+        }
+    }
+
+    return n;
+}
+
+size_t utf8_validate(
+    const char *s,
+    size_t len
+    )
+{
+    size_t i = 0, n;
+
+    while ((i += plain_run(s + i, len - i)) < len)
+    {
+        /*
+         * consecutive sequences (e.g. a word of non-latin script) are
+         * checked without returning to the run of ASCII characters.
+         */
+        do
+        {
+            if ((n = sequence_len((const unsigned char *) s + i, len - i)) == 0)
+            {
+                return i;
+            }
+
+            i += n;
+        } while ((i < len) && ((unsigned char) s[i] >= 0x80U));
+    }
+
+    return len;
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,50 @@
+/* ================================================================ */
+/**
+ * @file utf8_validate.h
+ * UTF-8 validation of the bulletin board.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This header declares the validation of the text received from the
+ * clients. Text is accepted if it is well-formed UTF-8 (no overlong
+ * encodings, no surrogates, no code points beyond U+10FFFF) without
+ * control characters, except for the white space characters '\\t',
+ * '\\n', '\\v', '\\f' and '\\r'. The C1 control characters U+0080 to
+ * U+009F are rejected as well.
+ */
+/*
+ * $Id:$
+ */
+
+#ifndef UTF8_VALIDATE_H
+#define UTF8_VALIDATE_H
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stddef.h>
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/**
+ * \brief Validate text
+ *
+ * \param s the text [IN]
+ * \param len length of \a s [IN]
+ *
+ * \return offset of the first byte of the first rejected character or
+ *         sequence, \a len if the text is accepted
+ */
+extern size_t utf8_validate(const char *s, size_t len);
+
+#endif /* UTF8_VALIDATE_H */
+
+/*
+ * =================================================================== eof ==
+ */
@@ -0,0 +1,418 @@
+/* ================================================================ */
+/**
+ * @file utf8_validate_test.c
+ * Tests of the UTF-8 validation.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file checks the SSE2 path of utf8_validate.c and its
+ * scalar path, which is utf8_validate.c compiled once more without
+ * __SSE2__ and with the function renamed to utf8_validate_scalar(),
+ * against a reference decoding every code point. Overlong encodings,
+ * surrogates, code points beyond U+10FFFF and truncated sequences are
+ * placed at every alignment, thus they straddle and end at the 16 byte
+ * boundaries of the vector loop, followed by random texts. It is run
+ * by "make test", the exit status is EXIT_FAILURE if any check failed.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utf8_validate.h"
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define TEXTLEN 64           /* four vectors */
+#define ALIGNMENTS 16        /* alignments of the text to a vector */
+#define GUARDLEN 16          /* bytes behind the text */
+#define RANDOMTEXTS 100000
+#define SEED 20161018U
+
+/*
+ * ------------------------------------------------- function declarations --
+ */
+
+/*
+ * the scalar path, see the Makefile
+ */
+extern size_t utf8_validate_scalar(const char *s, size_t len);
+
+/*
+ * -------------------------------------------------------------- typedefs --
+ */
+
+typedef struct
+{
+    const char *name;
+    const char *bytes;
+    size_t len;
+    int valid;
+} sequence_t;
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+static unsigned int failures = 0;
+
+static const sequence_t sequences[] =
+{
+    { "U+0080 (C1 control)", "\xc2\x80", 2, 0 },
+    { "U+009F (C1 control)", "\xc2\x9f", 2, 0 },
+    { "U+00A0", "\xc2\xa0", 2, 1 },
+    { "U+07FF", "\xdf\xbf", 2, 1 },
+    { "U+0800", "\xe0\xa0\x80", 3, 1 },
+    { "U+D7FF", "\xed\x9f\xbf", 3, 1 },
+    { "U+E000", "\xee\x80\x80", 3, 1 },
+    { "U+FFFF", "\xef\xbf\xbf", 3, 1 },
+    { "U+10000", "\xf0\x90\x80\x80", 4, 1 },
+    { "U+10FFFF", "\xf4\x8f\xbf\xbf", 4, 1 },
+    { "overlong U+0000", "\xc0\x80", 2, 0 },
+    { "overlong U+007F", "\xc1\xbf", 2, 0 },
+    { "overlong U+07FF", "\xe0\x9f\xbf", 3, 0 },
+    { "overlong U+FFFF", "\xf0\x8f\xbf\xbf", 4, 0 },
+    { "surrogate U+D800", "\xed\xa0\x80", 3, 0 },
+    { "surrogate U+DBFF", "\xed\xaf\xbf", 3, 0 },
+    { "surrogate U+DC00", "\xed\xb0\x80", 3, 0 },
+    { "surrogate U+DFFF", "\xed\xbf\xbf", 3, 0 },
+    { "U+110000", "\xf4\x90\x80\x80", 4, 0 },
+    { "U+13FFFF", "\xf4\xbf\xbf\xbf", 4, 0 },
+    { "U+140000", "\xf5\x80\x80\x80", 4, 0 },
+    { "U+1FFFFF", "\xf7\xbf\xbf\xbf", 4, 0 },
+    { "lone continuation byte", "\x80", 1, 0 },
+    { "lead byte 0xf8", "\xf8\x88\x80\x80\x80", 5, 0 },
+    { "lead byte 0xff", "\xff", 1, 0 },
+    { "2 byte lead byte followed by ASCII", "\xc3" "a", 2, 0 },
+    { "3 byte sequence with ASCII as third byte", "\xe2\x82" "a", 3, 0 },
+    { "4 byte sequence with a lead byte as fourth byte", "\xf0\x9f\x98\xf0", 4, 0 },
+    { "DEL", "\x7f", 1, 0 },
+    { "NUL", "\x00", 1, 0 },
+    { "TAB", "\t", 1, 1 }
+};
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Validate text by decoding every code point
+ *
+ * \param s the text [IN]
+ * \param len length of \a s [IN]
+ *
+ * \return offset of the first byte of the first rejected character or
+ *         sequence, \a len if the text is accepted
+ */
+static size_t reference_validate(
+    const char *s,
+    size_t len
+    )
+{
+    const unsigned char *u = (const unsigned char *) s;
+    unsigned long cp, min;
+    size_t i = 0, n, j;
+
+    while (i < len)
+    {
+        if (u[i] < 0x80U)
+        {
+            n = 1;
+            cp = u[i];
+            min = 0;
+        }
+        else if ((u[i] & 0xe0U) == 0xc0U)
+        {
+            n = 2;
+            cp = u[i] & 0x1fU;
+            min = 0x80UL;
+        }
+        else if ((u[i] & 0xf0U) == 0xe0U)
+        {
+            n = 3;
+            cp = u[i] & 0x0fU;
+            min = 0x800UL;
+        }
+        else if ((u[i] & 0xf8U) == 0xf0U)
+        {
+            n = 4;
+            cp = u[i] & 0x07U;
+            min = 0x10000UL;
+        }
+        else
+        {
+            return i;
+        }
+
+        if (len - i < n)
+        {
+            return i;
+        }
+
+        for (j = 1; j < n; j++)
+        {
+            if ((u[i + j] & 0xc0U) != 0x80U)
+            {
+                return i;
+            }
+
+            cp = (cp << 6) | (u[i + j] & 0x3fU);
+        }
+
+        if (
+            (cp < min) ||
+            ((cp >= 0xd800UL) && (cp <= 0xdfffUL)) ||
+            (cp > 0x10ffffUL) ||
+            ((cp < 0x20UL) && ((cp < '\t') || (cp > '\r'))) ||
+            ((cp >= 0x7fUL) && (cp <= 0x9fUL))
+            )
+        {
+            return i;
+        }
+
+        i += n;
+    }
+
+    return len;
+}
+
+/**
+ * \brief Compare both paths and the reference on a text
+ *
+ * \param s the text to be validated [IN]
+ * \param len length of \a s [IN]
+ * \param name zero-terminated string describing the text [IN]
+ * \param expected the expected result, i.e. the offset of the first
+ *        rejected byte or \a len [IN]
+ */
+static void compare(
+    const char *s,
+    size_t len,
+    const char *name,
+    size_t expected
+    )
+{
+    static const char guards[] = { 'x', '\x80' };
+    char guarded[2 * ALIGNMENTS + TEXTLEN + GUARDLEN];
+    char *t = guarded + (ALIGNMENTS + (uintptr_t) s % ALIGNMENTS - (uintptr_t) guarded % ALIGNMENTS);
+    size_t vector, scalar, reference, i;
+
+    /*
+     * the copy keeps the alignment of the text and is followed by bytes
+     * which would extend a run of ASCII characters or a sequence if read
+     * beyond the end of the text
+     */
+    memcpy(t, s, len);
+
+    for (i = 0; i < sizeof(guards); i++)
+    {
+        memset(t + len, guards[i], GUARDLEN);
+
+        vector = utf8_validate(t, len);
+        scalar = utf8_validate_scalar(t, len);
+        reference = reference_validate(t, len);
+
+        if ((vector != expected) || (scalar != expected) || (reference != expected))
+        {
+            (void) fprintf(
+                stderr,
+                "%s: %s in %zu bytes: expected %zu, sse2 %zu, scalar %zu, reference %zu\n",
+                __FILE__,
+                name,
+                len,
+                expected,
+                vector,
+                scalar,
+                reference
+                );
+            failures++;
+        }
+    }
+}
+
+/**
+ * \brief Place every sequence of the table at every position
+ *
+ * The sequence is preceded by ASCII characters, thus it starts at every
+ * offset of a vector and straddles its boundary, and is followed by
+ * ASCII characters or ends the text.
+ */
+static void test_sequences(
+    void
+    )
+{
+    char buf[ALIGNMENTS + TEXTLEN];
+    char *s;
+    const sequence_t *seq;
+    size_t align, pos, i;
+
+    for (align = 0; align < ALIGNMENTS; align++)
+    {
+        s = buf + align;
+
+        for (i = 0; i < sizeof(sequences) / sizeof(*sequences); i++)
+        {
+            seq = &sequences[i];
+
+            for (pos = 0; pos + seq->len <= TEXTLEN; pos++)
+            {
+                memset(s, 'x', TEXTLEN);
+                memcpy(s + pos, seq->bytes, seq->len);
+
+                compare(s, TEXTLEN, seq->name, seq->valid ? TEXTLEN : pos);
+                compare(s, pos + seq->len, seq->name, seq->valid ? pos + seq->len : pos);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Cut valid sequences off at the end of a vector
+ *
+ * The text ends in the middle of the sequence at a boundary of 16
+ * bytes, i.e. where the vector loop hands over to the tail, with the
+ * rest of the sequence lying behind the text.
+ */
+static void test_truncated(
+    void
+    )
+{
+    char buf[ALIGNMENTS + TEXTLEN];
+    char *s;
+    const sequence_t *seq;
+    size_t align, end, cut, i;
+
+    for (align = 0; align < ALIGNMENTS; align++)
+    {
+        s = buf + align;
+
+        for (i = 0; i < sizeof(sequences) / sizeof(*sequences); i++)
+        {
+            seq = &sequences[i];
+
+            if (!seq->valid || (seq->len < 2))
+            {
+                continue;
+            }
+
+            for (end = 16; end < TEXTLEN; end += 16)
+            {
+                for (cut = 1; cut < seq->len; cut++)
+                {
+                    memset(s, 'x', TEXTLEN);
+                    memcpy(s + end - cut, seq->bytes, seq->len);
+
+                    compare(s, end, seq->name, end - cut);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief Append a random character to a text
+ *
+ * Mostly printable ASCII characters and well-formed sequences, every
+ * now and then a random byte.
+ *
+ * \param s the text [OUT]
+ * \param len length of the text so far [IN]
+ *
+ * \return the new length of the text, at most TEXTLEN
+ */
+static size_t append_random(
+    char *s,
+    size_t len
+    )
+{
+    const sequence_t *seq;
+    int r = rand() % 16;
+
+    if (r == 0)
+    {
+        s[len++] = (char) (rand() % 256);
+    }
+    else if (r < 4)
+    {
+        seq = &sequences[(size_t) rand() % (sizeof(sequences) / sizeof(*sequences))];
+
+        if (seq->valid && (len + seq->len <= TEXTLEN))
+        {
+            memcpy(s + len, seq->bytes, seq->len);
+            len += seq->len;
+        }
+    }
+    else
+    {
+        s[len++] = (char) (0x20 + rand() % 0x5f);
+    }
+
+    return len;
+}
+
+/**
+ * \brief Compare both paths and the reference on random texts
+ */
+static void test_random(
+    void
+    )
+{
+    char buf[ALIGNMENTS + TEXTLEN];
+    char *s;
+    size_t len, target;
+    int i;
+
+    srand(SEED);
+
+    for (i = 0; i < RANDOMTEXTS; i++)
+    {
+        s = buf + (size_t) i % ALIGNMENTS;
+        target = (size_t) rand() % (TEXTLEN + 1);
+
+        for (len = 0; len < target; )
+        {
+            len = append_random(s, len);
+        }
+
+        compare(s, len, "random text", reference_validate(s, len));
+    }
+}
+
+/**
+ * \brief Run the tests
+ *
+ * \return EXIT_SUCCESS if all checks passed, EXIT_FAILURE otherwise
+ */
+int main(
+    void
+    )
+{
+    test_sequences();
+    test_truncated();
+    test_random();
+
+    if (failures > 0)
+    {
+        (void) fprintf(stderr, "%s: %u checks failed\n", __FILE__, failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * =================================================================== eof ==
+ */
@@ -8,7 +8,7 @@
 -->
 <html>
   <head>
-    <meta http-equiv="Content-Type" content="text/html; charset=ISO-8859-15" />
+    <meta http-equiv="Content-Type" content="text/html; charset=UTF-8" />
     <meta http-equiv="refresh" content="5">
     <title>Verteilte Computersysteme - TCP/IP</title>
   </head>
@@ -22,12 +22,27 @@
     <h2><a name="tcpibulletin"/>Bulletin Board</h2>
 
     <?php
-      $fn="bulletin_board_content.dat";
-      $file=fopen($fn, "r");
-      flock($file, LOCK_SH);
-      include($fn);
-      flock($file, LOCK_UN);
-      fclose($file);
+      /*
+       * the content is rotated into segments - only the newest rotated
+       * segment and the active file are shown.
+       */
+      $files=array_slice(glob("bulletin_board_content.[0-9]*.dat"), -1);
+      $files[]="bulletin_board_content.dat";
+      foreach ($files as $fn) {
+        if (($file=@fopen($fn, "r")) === false) {
+          continue;
+        }
+        flock($file, LOCK_SH);
+        $content=stream_get_contents($file);
+        flock($file, LOCK_UN);
+        fclose($file);
+        /*
+         * lock-free writers (SMSL_APPEND_MODE=atomic) append each entry
+         * with a single write() - skip an entry which is still in flight.
+         */
+        $end=strrpos($content, "</dd>\n");
+        echo ($end === false) ? "" : substr($content, 0, $end + 6);
+      }
     ?>
   </body>
 </html>
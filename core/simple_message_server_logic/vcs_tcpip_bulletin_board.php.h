@@ -0,0 +1,129 @@
+static const unsigned char vcs_tcpip_bulletin_board_php[] = {
+0x3c, 0x21, 0x44, 0x4f, 0x43, 0x54, 0x59, 0x50, 0x45, 0x20, 0x68, 0x74, 
+0x6d, 0x6c, 0x20, 0x50, 0x55, 0x42, 0x4c, 0x49, 0x43, 0x20, 0x22, 0x2d, 
+0x2f, 0x2f, 0x57, 0x33, 0x43, 0x2f, 0x2f, 0x44, 0x54, 0x44, 0x20, 0x58, 
+0x48, 0x54, 0x4d, 0x4c, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x54, 0x72, 0x61, 
+0x6e, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x61, 0x6c, 0x2f, 0x2f, 0x45, 
+0x4e, 0x22, 0x20, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 
+0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x54, 0x52, 
+0x2f, 0x78, 0x68, 0x74, 0x6d, 0x6c, 0x31, 0x2f, 0x44, 0x54, 0x44, 0x2f, 
+0x78, 0x68, 0x74, 0x6d, 0x6c, 0x31, 0x2d, 0x74, 0x72, 0x61, 0x6e, 0x73, 
+0x69, 0x74, 0x69, 0x6f, 0x6e, 0x61, 0x6c, 0x2e, 0x64, 0x74, 0x64, 0x22, 
+0x3e, 0x0a, 0x3c, 0x21, 0x2d, 0x2d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x54, 
+0x68, 0x69, 0x73, 0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6d, 
+0x61, 0x69, 0x6e, 0x20, 0x70, 0x61, 0x67, 0x65, 0x20, 0x6f, 0x66, 0x20, 
+0x74, 0x68, 0x65, 0x20, 0x62, 0x75, 0x6c, 0x6c, 0x65, 0x74, 0x69, 0x6e, 
+0x20, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x20, 0x65, 0x78, 0x65, 0x72, 0x63, 
+0x69, 0x73, 0x65, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x74, 0x68, 0x65, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x75, 0x72, 0x73, 0x65, 0x20, 
+0x22, 0x56, 0x65, 0x72, 0x74, 0x65, 0x69, 0x6c, 0x74, 0x65, 0x20, 0x43, 
+0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x72, 0x73, 0x79, 0x73, 0x74, 0x65, 
+0x6d, 0x65, 0x20, 0x2d, 0x20, 0x54, 0x43, 0x50, 0x2f, 0x49, 0x50, 0x22, 
+0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x54, 0x65, 0x63, 0x68, 
+0x6e, 0x69, 0x6b, 0x75, 0x6d, 0x20, 0x57, 0x69, 0x65, 0x6e, 0x2e, 0x0a, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x41, 0x75, 0x74, 0x68, 0x6f, 0x72, 0x3a, 
+0x20, 0x54, 0x68, 0x6f, 0x6d, 0x61, 0x73, 0x20, 0x4d, 0x2e, 0x20, 0x47, 
+0x61, 0x6c, 0x6c, 0x61, 0x2c, 0x20, 0x46, 0x72, 0x61, 0x6e, 0x7a, 0x20, 
+0x48, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x65, 0x72, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x44, 0x61, 0x74, 0x65, 0x3a, 0x20, 0x32, 0x30, 0x31, 0x30, 0x2d, 
+0x30, 0x37, 0x2d, 0x31, 0x37, 0x0a, 0x2d, 0x2d, 0x3e, 0x0a, 0x3c, 0x68, 
+0x74, 0x6d, 0x6c, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x68, 0x65, 0x61, 0x64, 
+0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 
+0x68, 0x74, 0x74, 0x70, 0x2d, 0x65, 0x71, 0x75, 0x69, 0x76, 0x3d, 0x22, 
+0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x54, 0x79, 0x70, 0x65, 
+0x22, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x3d, 0x22, 0x74, 
+0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3b, 0x20, 0x63, 0x68, 
+0x61, 0x72, 0x73, 0x65, 0x74, 0x3d, 0x55, 0x54, 0x46, 0x2d, 0x38, 0x22, 
+0x20, 0x2f, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x6d, 0x65, 0x74, 
+0x61, 0x20, 0x68, 0x74, 0x74, 0x70, 0x2d, 0x65, 0x71, 0x75, 0x69, 0x76, 
+0x3d, 0x22, 0x72, 0x65, 0x66, 0x72, 0x65, 0x73, 0x68, 0x22, 0x20, 0x63, 
+0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x3d, 0x22, 0x35, 0x22, 0x3e, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0x56, 
+0x65, 0x72, 0x74, 0x65, 0x69, 0x6c, 0x74, 0x65, 0x20, 0x43, 0x6f, 0x6d, 
+0x70, 0x75, 0x74, 0x65, 0x72, 0x73, 0x79, 0x73, 0x74, 0x65, 0x6d, 0x65, 
+0x20, 0x2d, 0x20, 0x54, 0x43, 0x50, 0x2f, 0x49, 0x50, 0x3c, 0x2f, 0x74, 
+0x69, 0x74, 0x6c, 0x65, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x2f, 0x68, 0x65, 
+0x61, 0x64, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x62, 0x6f, 0x64, 0x79, 0x3e, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x68, 0x72, 0x2f, 0x3e, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x3c, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3e, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x68, 0x31, 0x3e, 0x56, 0x65, 
+0x72, 0x74, 0x65, 0x69, 0x6c, 0x74, 0x65, 0x20, 0x43, 0x6f, 0x6d, 0x70, 
+0x75, 0x74, 0x65, 0x72, 0x73, 0x79, 0x73, 0x74, 0x65, 0x6d, 0x65, 0x20, 
+0x2d, 0x20, 0x54, 0x43, 0x50, 0x2f, 0x49, 0x50, 0x3c, 0x2f, 0x68, 0x31, 
+0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x63, 0x65, 0x6e, 0x74, 
+0x65, 0x72, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x68, 0x72, 0x2f, 
+0x3e, 0x0a, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x68, 0x32, 0x3e, 0x3c, 
+0x61, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x74, 0x63, 0x70, 0x69, 
+0x62, 0x75, 0x6c, 0x6c, 0x65, 0x74, 0x69, 0x6e, 0x22, 0x2f, 0x3e, 0x42, 
+0x75, 0x6c, 0x6c, 0x65, 0x74, 0x69, 0x6e, 0x20, 0x42, 0x6f, 0x61, 0x72, 
+0x64, 0x3c, 0x2f, 0x68, 0x32, 0x3e, 0x0a, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x3c, 0x3f, 0x70, 0x68, 0x70, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x2f, 0x2a, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2a, 0x20, 
+0x74, 0x68, 0x65, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 
+0x69, 0x73, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x64, 0x20, 0x69, 
+0x6e, 0x74, 0x6f, 0x20, 0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x73, 
+0x20, 0x2d, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x74, 0x68, 0x65, 0x20, 
+0x6e, 0x65, 0x77, 0x65, 0x73, 0x74, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 
+0x65, 0x64, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2a, 0x20, 
+0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x61, 0x6e, 0x64, 0x20, 
+0x74, 0x68, 0x65, 0x20, 0x61, 0x63, 0x74, 0x69, 0x76, 0x65, 0x20, 0x66, 
+0x69, 0x6c, 0x65, 0x20, 0x61, 0x72, 0x65, 0x20, 0x73, 0x68, 0x6f, 0x77, 
+0x6e, 0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2a, 0x2f, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x24, 0x66, 0x69, 0x6c, 0x65, 
+0x73, 0x3d, 0x61, 0x72, 0x72, 0x61, 0x79, 0x5f, 0x73, 0x6c, 0x69, 0x63, 
+0x65, 0x28, 0x67, 0x6c, 0x6f, 0x62, 0x28, 0x22, 0x62, 0x75, 0x6c, 0x6c, 
+0x65, 0x74, 0x69, 0x6e, 0x5f, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x5f, 0x63, 
+0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2e, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 
+0x2a, 0x2e, 0x64, 0x61, 0x74, 0x22, 0x29, 0x2c, 0x20, 0x2d, 0x31, 0x29, 
+0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x24, 0x66, 0x69, 0x6c, 
+0x65, 0x73, 0x5b, 0x5d, 0x3d, 0x22, 0x62, 0x75, 0x6c, 0x6c, 0x65, 0x74, 
+0x69, 0x6e, 0x5f, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x5f, 0x63, 0x6f, 0x6e, 
+0x74, 0x65, 0x6e, 0x74, 0x2e, 0x64, 0x61, 0x74, 0x22, 0x3b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x61, 0x63, 0x68, 
+0x20, 0x28, 0x24, 0x66, 0x69, 0x6c, 0x65, 0x73, 0x20, 0x61, 0x73, 0x20, 
+0x24, 0x66, 0x6e, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x28, 0x24, 0x66, 0x69, 0x6c, 
+0x65, 0x3d, 0x40, 0x66, 0x6f, 0x70, 0x65, 0x6e, 0x28, 0x24, 0x66, 0x6e, 
+0x2c, 0x20, 0x22, 0x72, 0x22, 0x29, 0x29, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 
+0x66, 0x61, 0x6c, 0x73, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x69, 
+0x6e, 0x75, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x7d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x66, 
+0x6c, 0x6f, 0x63, 0x6b, 0x28, 0x24, 0x66, 0x69, 0x6c, 0x65, 0x2c, 0x20, 
+0x4c, 0x4f, 0x43, 0x4b, 0x5f, 0x53, 0x48, 0x29, 0x3b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x24, 0x63, 0x6f, 0x6e, 0x74, 0x65, 
+0x6e, 0x74, 0x3d, 0x73, 0x74, 0x72, 0x65, 0x61, 0x6d, 0x5f, 0x67, 0x65, 
+0x74, 0x5f, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x73, 0x28, 0x24, 
+0x66, 0x69, 0x6c, 0x65, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x66, 0x6c, 0x6f, 0x63, 0x6b, 0x28, 0x24, 0x66, 0x69, 
+0x6c, 0x65, 0x2c, 0x20, 0x4c, 0x4f, 0x43, 0x4b, 0x5f, 0x55, 0x4e, 0x29, 
+0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x66, 0x63, 
+0x6c, 0x6f, 0x73, 0x65, 0x28, 0x24, 0x66, 0x69, 0x6c, 0x65, 0x29, 0x3b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2a, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2a, 0x20, 0x6c, 
+0x6f, 0x63, 0x6b, 0x2d, 0x66, 0x72, 0x65, 0x65, 0x20, 0x77, 0x72, 0x69, 
+0x74, 0x65, 0x72, 0x73, 0x20, 0x28, 0x53, 0x4d, 0x53, 0x4c, 0x5f, 0x41, 
+0x50, 0x50, 0x45, 0x4e, 0x44, 0x5f, 0x4d, 0x4f, 0x44, 0x45, 0x3d, 0x61, 
+0x74, 0x6f, 0x6d, 0x69, 0x63, 0x29, 0x20, 0x61, 0x70, 0x70, 0x65, 0x6e, 
+0x64, 0x20, 0x65, 0x61, 0x63, 0x68, 0x20, 0x65, 0x6e, 0x74, 0x72, 0x79, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2a, 0x20, 
+0x77, 0x69, 0x74, 0x68, 0x20, 0x61, 0x20, 0x73, 0x69, 0x6e, 0x67, 0x6c, 
+0x65, 0x20, 0x77, 0x72, 0x69, 0x74, 0x65, 0x28, 0x29, 0x20, 0x2d, 0x20, 
+0x73, 0x6b, 0x69, 0x70, 0x20, 0x61, 0x6e, 0x20, 0x65, 0x6e, 0x74, 0x72, 
+0x79, 0x20, 0x77, 0x68, 0x69, 0x63, 0x68, 0x20, 0x69, 0x73, 0x20, 0x73, 
+0x74, 0x69, 0x6c, 0x6c, 0x20, 0x69, 0x6e, 0x20, 0x66, 0x6c, 0x69, 0x67, 
+0x68, 0x74, 0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x2a, 0x2f, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x24, 0x65, 0x6e, 0x64, 0x3d, 0x73, 0x74, 0x72, 0x72, 0x70, 0x6f, 0x73, 
+0x28, 0x24, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x22, 
+0x3c, 0x2f, 0x64, 0x64, 0x3e, 0x5c, 0x6e, 0x22, 0x29, 0x3b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x63, 0x68, 0x6f, 0x20, 
+0x28, 0x24, 0x65, 0x6e, 0x64, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x66, 0x61, 
+0x6c, 0x73, 0x65, 0x29, 0x20, 0x3f, 0x20, 0x22, 0x22, 0x20, 0x3a, 0x20, 
+0x73, 0x75, 0x62, 0x73, 0x74, 0x72, 0x28, 0x24, 0x63, 0x6f, 0x6e, 0x74, 
+0x65, 0x6e, 0x74, 0x2c, 0x20, 0x30, 0x2c, 0x20, 0x24, 0x65, 0x6e, 0x64, 
+0x20, 0x2b, 0x20, 0x36, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x7d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3f, 0x3e, 0x0a, 0x20, 0x20, 
+0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x0a, 0x3c, 0x2f, 0x68, 0x74, 
+0x6d, 0x6c, 0x3e, 0x0a, 0x0a, 0x00, 
+};
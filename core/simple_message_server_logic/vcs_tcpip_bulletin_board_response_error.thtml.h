@@ -0,0 +1,109 @@
+#include "template.h"
+
+static const unsigned char vcs_tcpip_bulletin_board_response_error_thtml_deflated_0[] = {
+        0x8c, 0x92, 0x51, 0x6f, 0x9b, 0x30, 0x10, 0xc7, 0xdf, 0xf9, 0x14, 0x37,
+        0x3f, 0xec, 0x0d, 0xbc, 0xa8, 0xaa, 0x94, 0x6d, 0x90, 0x4a, 0x21, 0xa9,
+        0x86, 0xd4, 0xb5, 0x51, 0x4b, 0xbb, 0xed, 0xd1, 0x85, 0x0b, 0xb6, 0x6a,
+        0x0c, 0xb3, 0x8f, 0x92, 0xf4, 0xd3, 0xcf, 0x04, 0xd2, 0xa6, 0xd2, 0x1e,
+        0xca, 0x93, 0xef, 0xce, 0xff, 0xdf, 0xff, 0xee, 0x4c, 0x7c, 0xb1, 0xab,
+        0x35, 0x3c, 0xa3, 0x75, 0xaa, 0x31, 0x09, 0x9b, 0x45, 0x5f, 0x18, 0xa0,
+        0x29, 0x9a, 0x52, 0x99, 0x2a, 0x61, 0xd9, 0xdd, 0x4d, 0x38, 0x9f, 0x9f,
+        0x7f, 0x0d, 0x67, 0xe7, 0xec, 0x62, 0x11, 0xc4, 0x9f, 0x56, 0x37, 0x69,
+        0xfe, 0x67, 0xb3, 0x06, 0x49, 0x5e, 0xb5, 0xb9, 0x5f, 0x5e, 0x65, 0x29,
+        0xb0, 0x90, 0xf3, 0x5f, 0x67, 0x29, 0xe7, 0xab, 0x7c, 0x05, 0xbf, 0x7f,
+        0xe4, 0x3f, 0xaf, 0xc0, 0x63, 0x20, 0xb7, 0xc2, 0x38, 0x45, 0x1e, 0x2b,
+        0x34, 0xe7, 0xeb, 0x6b, 0x16, 0x30, 0x49, 0xd4, 0x7e, 0xe3, 0xbc, 0xef,
+        0xfb, 0xa8, 0x3f, 0x8b, 0x1a, 0x5b, 0xf1, 0xfc, 0x96, 0xef, 0x06, 0xd6,
+        0x6c, 0x10, 0x4f, 0xc7, 0x90, 0x4e, 0x94, 0x51, 0x49, 0x25, 0xf3, 0xce,
+        0x43, 0x65, 0x11, 0x00, 0xc4, 0x12, 0x45, 0x39, 0x1c, 0xfc, 0xb1, 0x46,
+        0x12, 0x30, 0x30, 0x43, 0xfc, 0xdb, 0xa9, 0xe7, 0x84, 0xa5, 0x8d, 0x21,
+        0x34, 0x14, 0xe6, 0xfb, 0x16, 0x19, 0x14, 0x63, 0x94, 0x30, 0xc2, 0x1d,
+        0xf1, 0x01, 0xf0, 0x3d, 0x28, 0xa4, 0xb0, 0x0e, 0x29, 0xb9, 0xcf, 0x2f,
+        0xc3, 0x39, 0x03, 0x3e, 0x91, 0xb4, 0x32, 0x4f, 0x60, 0x51, 0x27, 0xcc,
+        0xd1, 0x5e, 0xa3, 0x93, 0x88, 0xc4, 0x80, 0x3c, 0x66, 0x52, 0x17, 0xce,
+        0x31, 0x90, 0x16, 0xb7, 0x3e, 0x2e, 0x5a, 0xd5, 0x46, 0x87, 0xc4, 0x51,
+        0x4e, 0x8a, 0x34, 0x2e, 0x1e, 0xd0, 0x12, 0x2a, 0x4d, 0x08, 0x69, 0x53,
+        0xb7, 0x1d, 0xf9, 0x9d, 0xee, 0x1d, 0x61, 0x8d, 0x10, 0x42, 0x9e, 0x6e,
+        0x78, 0xb6, 0x81, 0x30, 0xb8, 0x45, 0xd7, 0x36, 0xc6, 0x61, 0xcc, 0x47,
+        0xd1, 0x30, 0x12, 0x3f, 0xce, 0x14, 0x3f, 0x36, 0xe5, 0x7e, 0x62, 0x4a,
+        0x7b, 0xa4, 0x17, 0x7e, 0x08, 0xb4, 0x63, 0x70, 0xa8, 0xcc, 0x3e, 0x64,
+        0x05, 0x6f, 0x56, 0x5e, 0x31, 0xa2, 0xf8, 0x29, 0xeb, 0xc4, 0x82, 0xc4,
+        0xe3, 0xd8, 0xcb, 0xe8, 0x40, 0xd3, 0x86, 0x21, 0x56, 0x75, 0x05, 0xce,
+        0x16, 0x09, 0x43, 0x6b, 0x1b, 0x1b, 0xb5, 0xa6, 0x62, 0x20, 0xb4, 0xdf,
+        0xe9, 0x7a, 0x88, 0x21, 0xab, 0x45, 0x85, 0xec, 0x4d, 0xc8, 0x5f, 0x95,
+        0x07, 0x8a, 0xbf, 0xaa, 0x2a, 0x93, 0x68, 0xdc, 0xd2, 0x6b, 0xda, 0x17,
+        0xda, 0xff, 0xe7, 0xfd, 0xb7, 0x76, 0xa0, 0x1c, 0x01, 0x2a, 0x03, 0x97,
+        0x28, 0x35, 0x5a, 0x10, 0xdd, 0xb6, 0x42, 0xb2, 0xe8, 0x5f, 0x32, 0x82,
+        0xcc, 0xbf, 0x00, 0x5c, 0x8b, 0x42, 0x5a, 0x55, 0x48, 0x82, 0xa7, 0xc6,
+        0xf8, 0x69, 0xde, 0x01, 0xcc, 0xa1, 0x50, 0x62, 0x0d, 0x0f, 0xe9, 0xdd,
+        0x71, 0x15, 0xcb, 0x4e, 0x6b, 0x24, 0xcf, 0x5c, 0x36, 0xc2, 0x96, 0xef,
+        0xee, 0x4b, 0x65, 0x5e, 0xba, 0x0a, 0xb7, 0x9f, 0xbb, 0xce, 0xff, 0x1e,
+        0x15, 0x41, 0x8f, 0xb6, 0xf4, 0x56, 0x27, 0xdd, 0xf2, 0xf6, 0x63, 0xbd,
+        0xff, 0x03, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char vcs_tcpip_bulletin_board_response_error_thtml_deflated_2[] = {
+        0x84, 0x8d, 0xcb, 0x0a, 0xc2, 0x30, 0x10, 0x45, 0xf7, 0xf9, 0x8a, 0xd0,
+        0xbd, 0xcd, 0x5e, 0x62, 0x10, 0x04, 0x5d, 0xb9, 0xeb, 0x0f, 0x4c, 0x9a,
+        0xd4, 0x19, 0xcc, 0x43, 0x92, 0x11, 0xf1, 0xef, 0x7d, 0x35, 0x82, 0x50,
+        0x70, 0x56, 0xe7, 0xc2, 0x9d, 0x7b, 0x84, 0x6c, 0xa7, 0xd5, 0xc5, 0x88,
+        0x2f, 0xb3, 0xfb, 0x84, 0x27, 0x81, 0x0d, 0x7e, 0x0e, 0x58, 0xd4, 0x4c,
+        0xe0, 0x5c, 0xf1, 0xb5, 0xb6, 0x0f, 0x0d, 0x12, 0x8b, 0x9f, 0x36, 0x5d,
+        0x04, 0x0a, 0x9c, 0xd7, 0x27, 0x08, 0x01, 0xb6, 0xec, 0x47, 0x4c, 0x74,
+        0xbe, 0xc6, 0xd5, 0x8d, 0x7c, 0xea, 0x81, 0x3b, 0x33, 0x60, 0x8e, 0x50,
+        0xe5, 0xb1, 0x97, 0x87, 0x57, 0x45, 0x2b, 0x68, 0x9e, 0x9f, 0xc5, 0x7f,
+        0xfb, 0x13, 0x59, 0x1a, 0x71, 0x49, 0xb0, 0xc3, 0x42, 0x95, 0x09, 0x92,
+        0xdc, 0xbf, 0x3b, 0xcb, 0x06, 0xad, 0x6c, 0x76, 0x77, 0x23, 0xb4, 0x42,
+        0x8e, 0xc1, 0x88, 0x07, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const template_segment_t vcs_tcpip_bulletin_board_response_error_thtml_segments[] = {
+        { TEMPLATE_LITERAL, "<\077xml version=\"1.0\" encoding=\"ISO-8859-15\"\077>\n"
+                "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\"\n"
+                "\"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">\n"
+                "<html>\n"
+                "  <head>\n"
+                "    <meta http-equiv=\"Content-Type\" content=\"text/html;\n"
+                "charset=UTF-8\" />\n"
+                "    <link rel=\"stylesheet\" type=\"text/css\" href=\"tcpip.css\" />\n"
+                "    <title>Verteilte Computersysteme - TCP/IP -\n"
+                "Response</title>\n"
+                "  </head>\n"
+                "  <body>\n"
+                "    <hr/>\n"
+                "    <center>\n"
+                "       <h1>Verteilte Computersysteme - TCP/IP - Response</h1>\n"
+                "    </center>\n"
+                "    <hr/>\n"
+                "    <table>\n"
+                "       <td>\n"
+                "     <img src=\"error.png\" alt=\"Error Image\">\n"
+                "       </td>\n"
+                "       <td align=left>\n"
+                "         <p align=left>\n"
+                "            Es ist ein Fehler aufgetreten. Ihre Nachricht konnte\n"
+                "            nicht dem VCS TCP/IP Bulletin Board\n"
+                "            hinzugef&uuml;gt werden.\n"
+                "         </p>\n"
+                "         <p align=left>\n"
+                "            ", 842, vcs_tcpip_bulletin_board_response_error_thtml_deflated_0, 462 },
+        { TEMPLATE_STRING, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "\n"
+                "         </p>\n"
+                "       </td>\n"
+                "    </table>\n"
+                "    <hr/>\n"
+                "    <address>\n"
+                "      <a href=\"mailto:galla@technikum-wien.at\">Thomas M. Galla</a>\n"
+                "    </address>\n"
+                "    <address>\n"
+                "      <a href=\"mailto:fibich@technikum-wien.at\">Christian Fibich</a>\n"
+                "    </address>\n"
+                "  </body>\n"
+                "</html>\n"
+                "", 263, vcs_tcpip_bulletin_board_response_error_thtml_deflated_2, 141 },
+};
+
+static const template_t vcs_tcpip_bulletin_board_response_error_thtml = {
+        vcs_tcpip_bulletin_board_response_error_thtml_segments, 3, 1105, 1, 603
+};
@@ -0,0 +1,117 @@
+#include "template.h"
+
+static const unsigned char vcs_tcpip_bulletin_board_response_ok_thtml_deflated_0[] = {
+        0x8c, 0x93, 0x4d, 0x6f, 0x9b, 0x40, 0x10, 0x86, 0xef, 0xfc, 0x8a, 0xe9,
+        0x1e, 0x7a, 0x83, 0xad, 0x15, 0x45, 0x72, 0x53, 0x70, 0x24, 0xe3, 0x54,
+        0x45, 0x75, 0x63, 0xcb, 0xc6, 0x69, 0x7b, 0xdc, 0xc0, 0x00, 0xab, 0x2c,
+        0x0b, 0xdd, 0x1d, 0x62, 0xbb, 0xbf, 0xbe, 0x8b, 0xc1, 0x89, 0x2b, 0x55,
+        0x55, 0x38, 0xcd, 0xc7, 0x3e, 0xef, 0xbb, 0x33, 0x40, 0x78, 0x7b, 0xa8,
+        0x15, 0x3c, 0xa3, 0xb1, 0xb2, 0xd1, 0x11, 0x9b, 0x04, 0x1f, 0x18, 0xa0,
+        0xce, 0x9a, 0x5c, 0xea, 0x32, 0x62, 0xc9, 0x76, 0xe5, 0x4f, 0xa7, 0xd7,
+        0x1f, 0xfd, 0xc9, 0x35, 0xbb, 0x9d, 0x79, 0xe1, 0xbb, 0xc5, 0x2a, 0x4e,
+        0x7f, 0xae, 0xef, 0xa0, 0x22, 0x47, 0xad, 0x77, 0xf3, 0x65, 0x12, 0x03,
+        0xf3, 0x39, 0xff, 0x7e, 0x15, 0x73, 0xbe, 0x48, 0x17, 0xf0, 0xe3, 0x4b,
+        0xfa, 0x6d, 0x09, 0x4e, 0x06, 0x52, 0x23, 0xb4, 0x95, 0xe4, 0x64, 0x85,
+        0xe2, 0xfc, 0xee, 0x9e, 0x79, 0xac, 0x22, 0x6a, 0x6f, 0x38, 0xdf, 0xef,
+        0xf7, 0xc1, 0xfe, 0x2a, 0x68, 0x4c, 0xc9, 0xd3, 0x0d, 0x3f, 0xf4, 0x5a,
+        0x93, 0x1e, 0x1e, 0x43, 0x9f, 0x2e, 0xc8, 0x20, 0xa7, 0x9c, 0x39, 0xe7,
+        0xbe, 0x33, 0xf3, 0x00, 0xc2, 0x0a, 0x45, 0xde, 0x07, 0x2e, 0xac, 0x91,
+        0x04, 0xf4, 0x9a, 0x3e, 0xfe, 0xea, 0xe4, 0x73, 0xc4, 0xe2, 0x46, 0x13,
+        0x6a, 0xf2, 0xd3, 0x63, 0x8b, 0x0c, 0xb2, 0x21, 0x8b, 0x18, 0xe1, 0x81,
+        0x78, 0x2f, 0xf0, 0xc9, 0xcb, 0x2a, 0x61, 0x2c, 0x52, 0xb4, 0x4b, 0x3f,
+        0xfb, 0x53, 0x06, 0x7c, 0x54, 0x52, 0x52, 0x3f, 0x81, 0x41, 0x15, 0x31,
+        0x4b, 0x47, 0x85, 0xb6, 0x42, 0x24, 0x06, 0xe4, 0x64, 0x46, 0x3a, 0xb3,
+        0x96, 0x41, 0x65, 0xb0, 0x70, 0x79, 0xd6, 0xca, 0x36, 0x38, 0x15, 0xce,
+        0x38, 0x49, 0x52, 0x38, 0x7b, 0x40, 0x43, 0x28, 0x15, 0x21, 0xc4, 0x4d,
+        0xdd, 0x76, 0xe4, 0x76, 0x7a, 0xb4, 0x84, 0x35, 0x82, 0x0f, 0x69, 0xbc,
+        0xe6, 0xc9, 0x1a, 0x7c, 0x6f, 0x83, 0xb6, 0x6d, 0xb4, 0xc5, 0x90, 0x0f,
+        0x50, 0x3f, 0x12, 0x3f, 0xcf, 0x14, 0x3e, 0x36, 0xf9, 0x71, 0xd4, 0xac,
+        0xcc, 0x59, 0x3d, 0x73, 0x43, 0xa0, 0x19, 0x92, 0x53, 0x67, 0xf2, 0x26,
+        0x2b, 0x78, 0xb5, 0x72, 0xc4, 0x20, 0xc5, 0x2f, 0xb5, 0x2e, 0x2c, 0x48,
+        0x3c, 0x0e, 0x77, 0x19, 0x1c, 0x68, 0xdc, 0x30, 0x84, 0xb2, 0x2e, 0xc1,
+        0x9a, 0x2c, 0x62, 0xcd, 0x53, 0xd0, 0xea, 0x92, 0x81, 0x50, 0x6e, 0xa1,
+        0xab, 0xaf, 0x90, 0xd4, 0xa2, 0x44, 0xf6, 0x8a, 0xf0, 0x17, 0xe6, 0xc4,
+        0xbb, 0x73, 0xb2, 0xd4, 0x91, 0xc2, 0x82, 0x5e, 0xca, 0xae, 0xd1, 0xfe,
+        0xbb, 0xee, 0x9e, 0xc4, 0x2d, 0x17, 0xee, 0x45, 0x56, 0x19, 0x99, 0x55,
+        0x04, 0xfb, 0xce, 0xe4, 0x08, 0x68, 0x8a, 0x46, 0x95, 0x06, 0x5d, 0x09,
+        0x72, 0xac, 0xe1, 0x21, 0xde, 0x8e, 0xe3, 0xfd, 0xc5, 0xce, 0x3b, 0xa5,
+        0x90, 0xa4, 0x86, 0x79, 0x23, 0x4c, 0x0e, 0x95, 0xd4, 0xbf, 0xbb, 0x12,
+        0x8b, 0xf7, 0x5d, 0xe7, 0x5e, 0x79, 0x49, 0x01, 0x6c, 0x25, 0x42, 0x21,
+        0x75, 0x8e, 0x1a, 0x72, 0x61, 0xff, 0xc7, 0x76, 0xfd, 0x7a, 0xa0, 0x77,
+        0x45, 0x77, 0xdc, 0xc0, 0x6e, 0xb3, 0xbc, 0xb9, 0xb8, 0x3f, 0x6f, 0xdf,
+        0x36, 0x4d, 0xe8, 0x7e, 0x20, 0x9c, 0x85, 0x62, 0xfc, 0x64, 0xfe, 0x00,
+        0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char vcs_tcpip_bulletin_board_response_ok_thtml_deflated_2[] = {
+        0x52, 0xb2, 0x03, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char vcs_tcpip_bulletin_board_response_ok_thtml_deflated_4[] = {
+        0x84, 0x8e, 0xc1, 0x0a, 0xc2, 0x30, 0x10, 0x44, 0xef, 0xfd, 0x8a, 0xd0,
+        0xbb, 0xdd, 0xbb, 0xac, 0x41, 0x10, 0xf4, 0xe4, 0xcd, 0x1f, 0xd8, 0x26,
+        0xa9, 0xbb, 0x98, 0x34, 0x92, 0x44, 0xc4, 0xbf, 0xb7, 0x6a, 0x2a, 0x08,
+        0x05, 0xf7, 0x34, 0x03, 0x6f, 0x67, 0x06, 0x81, 0x34, 0x82, 0x89, 0xd6,
+        0xe9, 0x46, 0xcd, 0x87, 0x70, 0xfd, 0x3a, 0x84, 0x62, 0x3f, 0x66, 0x52,
+        0xd4, 0xfb, 0xca, 0x21, 0x27, 0xa8, 0x8a, 0xac, 0x4d, 0x2e, 0xe7, 0xf9,
+        0x03, 0x49, 0x71, 0x72, 0xc3, 0xa6, 0x0d, 0x24, 0xbe, 0xc4, 0xf5, 0x99,
+        0xbc, 0xa7, 0x6d, 0x71, 0x86, 0x47, 0xb9, 0xdc, 0xc2, 0xea, 0x2e, 0x6e,
+        0xec, 0xa8, 0xb4, 0xfa, 0xc4, 0x31, 0x50, 0x56, 0xc7, 0x4e, 0x1d, 0x5e,
+        0x08, 0x4e, 0x4b, 0x6a, 0xcf, 0x4f, 0xe2, 0xbf, 0xfc, 0x41, 0x7a, 0x31,
+        0xbc, 0x54, 0xb0, 0xe3, 0x24, 0xb9, 0x08, 0x8d, 0x6a, 0xff, 0x66, 0x96,
+        0x1b, 0x10, 0xfa, 0x68, 0x1f, 0xba, 0x41, 0xe0, 0x12, 0xbc, 0x6e, 0x9e,
+        0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const template_segment_t vcs_tcpip_bulletin_board_response_ok_thtml_segments[] = {
+        { TEMPLATE_LITERAL, "<\077xml version=\"1.0\" encoding=\"ISO-8859-15\"\077>\n"
+                "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\"\n"
+                "\"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">\n"
+                "<html>\n"
+                "  <head>\n"
+                "    <meta http-equiv=\"Content-Type\" content=\"text/html;\n"
+                "charset=UTF-8\" />\n"
+                "    <link rel=\"stylesheet\" type=\"text/css\" href=\"tcpip.css\" />\n"
+                "    <title>Verteilte Computersysteme - TCP/IP -\n"
+                "Response</title>\n"
+                "  </head>\n"
+                "  <body>\n"
+                "    <hr/>\n"
+                "    <center>\n"
+                "       <h1>Verteilte Computersysteme - TCP/IP - Response</h1>\n"
+                "    </center>\n"
+                "    <hr/>\n"
+                "    <table>\n"
+                "       <td>\n"
+                "     <img src=\"ok.png\" alt=\"OK Image\">\n"
+                "       </td>\n"
+                "       <td align=left>\n"
+                "         <p align=left>\n"
+                "            Ihre Nachricht wurde erfolgreich dem VCS TCP/IP\n"
+                "            Bulletin Board hinzugef&uuml;gt. Sie finden das\n"
+                "            Bulletin Board unter folgender URL:\n"
+                "         </p>\n"
+                "         <p align=left>\n"
+                "            <code><a href=\"", 869, vcs_tcpip_bulletin_board_response_ok_thtml_deflated_0, 472 },
+        { TEMPLATE_STRING, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "\">", 2, vcs_tcpip_bulletin_board_response_ok_thtml_deflated_2, 8 },
+        { TEMPLATE_STRING, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "</a></code>\n"
+                "         </p>\n"
+                "       </td>\n"
+                "    </table>\n"
+                "    <hr/>\n"
+                "    <address>\n"
+                "      <a href=\"mailto:galla@technikum-wien.at\">Thomas M. Galla</a>\n"
+                "    </address>\n"
+                "    <address>\n"
+                "      <a href=\"mailto:fibich@technikum-wien.at\">Christian Fibich</a>\n"
+                "    </address>\n"
+                "  </body>\n"
+                "</html>\n"
+                "", 274, vcs_tcpip_bulletin_board_response_ok_thtml_deflated_4, 149 },
+};
+
+static const template_t vcs_tcpip_bulletin_board_response_ok_thtml = {
+        vcs_tcpip_bulletin_board_response_ok_thtml_segments, 5, 1145, 2, 629
+};
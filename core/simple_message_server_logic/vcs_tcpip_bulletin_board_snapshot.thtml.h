@@ -0,0 +1,79 @@
+#include "template.h"
+
+static const unsigned char vcs_tcpip_bulletin_board_snapshot_thtml_deflated_0[] = {
+        0x8c, 0x92, 0x4d, 0x8f, 0xdb, 0x20, 0x10, 0x86, 0xef, 0xf9, 0x15, 0xb3,
+        0xdc, 0x31, 0xcd, 0xae, 0x2a, 0xad, 0x5a, 0xc7, 0x87, 0x38, 0x5b, 0x35,
+        0xd2, 0x7e, 0x44, 0x15, 0xdb, 0x6d, 0x4f, 0x11, 0xb1, 0x27, 0x01, 0xd5,
+        0x80, 0x0b, 0xe3, 0x4d, 0xf2, 0xef, 0x0b, 0x4e, 0x22, 0xe5, 0x52, 0xb5,
+        0x88, 0xc3, 0x00, 0xf3, 0x3e, 0xf3, 0xc1, 0x94, 0x37, 0x8b, 0x97, 0x5a,
+        0xfe, 0x5c, 0x3d, 0x80, 0x26, 0xdb, 0xc1, 0xea, 0x75, 0xfe, 0xb8, 0xac,
+        0x81, 0x71, 0x21, 0xde, 0xee, 0x6a, 0x21, 0x16, 0x72, 0x01, 0x3f, 0xbe,
+        0xca, 0xa7, 0x47, 0x98, 0x16, 0x1f, 0x40, 0x06, 0xe5, 0xa2, 0x21, 0xe3,
+        0x9d, 0xea, 0x84, 0x78, 0x78, 0x66, 0xc0, 0x34, 0x51, 0xff, 0x49, 0x88,
+        0xfd, 0x7e, 0x5f, 0xec, 0xef, 0x0a, 0x1f, 0x76, 0x42, 0x7e, 0x13, 0x87,
+        0xcc, 0x9a, 0x66, 0xf1, 0xd9, 0xe4, 0x74, 0xa5, 0x2c, 0x5a, 0x6a, 0x59,
+        0x35, 0x29, 0x6f, 0x38, 0x9f, 0x40, 0x5a, 0x52, 0x9b, 0x08, 0x69, 0x93,
+        0x46, 0x88, 0xa4, 0xc8, 0x34, 0x10, 0x9d, 0xea, 0xa3, 0xf6, 0x04, 0x7e,
+        0x3b, 0x5e, 0x6f, 0x86, 0xae, 0x43, 0x32, 0x0e, 0x36, 0x5e, 0x85, 0x16,
+        0xf0, 0x80, 0xa1, 0x31, 0x11, 0x61, 0x1b, 0xbc, 0xcd, 0x0e, 0x23, 0xa7,
+        0xf1, 0x43, 0x48, 0x77, 0xec, 0x3b, 0x06, 0x42, 0xd3, 0x11, 0x42, 0xed,
+        0x6d, 0x3f, 0x10, 0x86, 0x78, 0x8c, 0x84, 0x16, 0x81, 0x83, 0xac, 0x57,
+        0x62, 0xb9, 0x62, 0xe0, 0xdd, 0xc8, 0x95, 0xd8, 0x68, 0x67, 0x7e, 0x0d,
+        0x16, 0xde, 0x0c, 0xba, 0x62, 0x32, 0x72, 0x96, 0x94, 0xb3, 0x09, 0xb8,
+        0x43, 0x87, 0x41, 0x11, 0xb6, 0xb0, 0x39, 0x42, 0x34, 0xb6, 0xef, 0x70,
+        0x6d, 0x31, 0x46, 0xb5, 0xc3, 0x75, 0xc4, 0xf0, 0x8e, 0x61, 0xdd, 0xf9,
+        0x5d, 0xca, 0x56, 0x6d, 0x53, 0x0c, 0x40, 0xd5, 0x68, 0xe8, 0x7d, 0xa4,
+        0x62, 0xc2, 0x79, 0x2a, 0x2f, 0x17, 0x5e, 0x25, 0x60, 0xa9, 0x51, 0xb5,
+        0xd5, 0x48, 0x2e, 0x2d, 0x92, 0x82, 0xdc, 0x32, 0x8e, 0xbf, 0x07, 0xf3,
+        0x3e, 0x63, 0xb5, 0x77, 0x84, 0x8e, 0xb8, 0x3c, 0xf6, 0xc8, 0x52, 0x05,
+        0xe3, 0x69, 0xc6, 0x08, 0x0f, 0x24, 0x32, 0xe0, 0x33, 0x34, 0x5a, 0xa5,
+        0xaa, 0x68, 0xf6, 0x2a, 0xbf, 0xf0, 0x7b, 0x06, 0xe2, 0x6f, 0xa4, 0x80,
+        0xdb, 0x80, 0x51, 0x5f, 0x41, 0x3e, 0xb2, 0xb3, 0x2f, 0x19, 0xea, 0xb0,
+        0xfa, 0x77, 0x5b, 0x4a, 0x71, 0xf2, 0xcc, 0x49, 0x8b, 0x4b, 0xd6, 0xe5,
+        0xc6, 0xb7, 0xc7, 0x33, 0x48, 0x87, 0x4b, 0xf8, 0x26, 0x45, 0xc0, 0x70,
+        0x3a, 0xe4, 0x87, 0xe9, 0x7f, 0xe1, 0x93, 0xdb, 0x49, 0x2e, 0xae, 0xf5,
+        0x27, 0xec, 0xd9, 0xbc, 0xad, 0x4a, 0x05, 0x4e, 0x59, 0x4c, 0x4d, 0x68,
+        0x7a, 0x73, 0xf9, 0x78, 0x26, 0xaa, 0xf9, 0x65, 0x06, 0xe6, 0x79, 0x06,
+        0x12, 0xec, 0x36, 0x89, 0xfe, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const unsigned char vcs_tcpip_bulletin_board_snapshot_thtml_deflated_2[] = {
+        0xe2, 0x52, 0x50, 0xb0, 0xd1, 0x4f, 0xca, 0x4f, 0xa9, 0xb4, 0xe3, 0xb2,
+        0xd1, 0xcf, 0x28, 0xc9, 0xcd, 0xb1, 0xe3, 0x02, 0x00, 0x00, 0x00, 0xff,
+        0xff,
+};
+
+static const template_segment_t vcs_tcpip_bulletin_board_snapshot_thtml_segments[] = {
+        { TEMPLATE_LITERAL, "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\" \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">\n"
+                "<!--\n"
+                "    This is the static snapshot of the bulletin board exercise from the\n"
+                "    course \"Verteilte Computersysteme - TCP/IP\" on the Technikum Wien.\n"
+                "\n"
+                "    It is regenerated by simple_message_server_logic after each post.\n"
+                "-->\n"
+                "<html>\n"
+                "  <head>\n"
+                "    <meta http-equiv=\"Content-Type\" content=\"text/html; charset=UTF-8\" />\n"
+                "    <meta http-equiv=\"refresh\" content=\"5\">\n"
+                "    <title>Verteilte Computersysteme - TCP/IP</title>\n"
+                "  </head>\n"
+                "  <body>\n"
+                "    <hr/>\n"
+                "    <center>\n"
+                "      <h1>Verteilte Computersysteme - TCP/IP</h1>\n"
+                "    </center>\n"
+                "    <hr/>\n"
+                "\n"
+                "    <h2><a name=\"tcpibulletin\"/>Bulletin Board</h2>\n"
+                "\n"
+                "", 703, vcs_tcpip_bulletin_board_snapshot_thtml_deflated_0, 406 },
+        { TEMPLATE_STRING, NULL, 0, NULL, 0 },
+        { TEMPLATE_LITERAL, "\n"
+                "  </body>\n"
+                "</html>\n"
+                "", 19, vcs_tcpip_bulletin_board_snapshot_thtml_deflated_2, 25 },
+};
+
+static const template_t vcs_tcpip_bulletin_board_snapshot_thtml = {
+        vcs_tcpip_bulletin_board_snapshot_thtml_segments, 3, 722, 1, 431
+};
@@ -24,9 +24,12 @@
 #include <netdb.h>
 #include <string.h>
 #include <simple_message_client_commandline_handling.h>
+#include <protocol_v2.h>
 #include <unistd.h>
 #include <err.h>
 #include <errno.h>
+#include <limits.h>
+#include <zlib.h>
 //#include <arpa/inet.h>    //Can be used for printf(IP);
 
 /*
@@ -34,6 +37,12 @@
  */
 
 #define BUFFER_SIZE 255
+#define MAX_FIELD_SIZE 4096   /* maximum size of a field other than the file data */
+#define FALLBACK_V1 1         /* server does not support protocol version 2 */
+#define PIPELINE_DEPTH 8      /* maximum number of requests sent ahead of their responses */
+#define MAX_STATUS_SIZE (MAX_FIELD_SIZE + 4 * SMP2_MAXBATCHRECORDS)   /* status frame incl. record statuses */
+#define BATCH_END "."         /* line terminating a record of a batch file */
+#define RESUME_ATTEMPTS 3     /* maximum number of attempts to resume an interrupted response */
 #define print_v(fmt, ...)                                   \
   if (verbose)                                              \
     fprintf(stderr, "%s(): " fmt, __func__, __VA_ARGS__);
@@ -42,11 +51,37 @@
 * -------------------------------------------------------------- typedefs --
 */
 
+/**
+ * A record of a batch file, the strings are allocated with malloc().
+ */
+typedef struct {
+    char *user;
+    char *img_url;  /* may be NULL */
+    char *message;
+} record_t;
+
+/**
+ * A request for posts which are printed to stdout, e.g. a search.
+ */
+typedef struct {
+    const char *keyword;    // first line "<keyword>=<value>" of protocol version 1
+    uint16_t tag;           // field of protocol version 2
+    const char *value;
+} query_t;
+
 /*
  * --------------------------------------------------------------- globals --
  */
 
 static int verbose;
+static long rejected_records;   /* records of batch requests rejected by the server */
+static long record_offset;      /* number of the first record of the current batch request */
+static int to_stdout;           /* write received files to stdout instead of disk */
+static long response_status;    /* status of the last response */
+static uint64_t resume_id;      /* id of the last response, 0 if it cannot be resumed */
+static char *resume_file;       /* file of the last response being received when it was interrupted, NULL if none */
+static long resume_offset;      /* bytes of resume_file written to disk */
+static const char *board;       /* board the requests are addressed to, NULL for the default board */
 
 /*
  * ------------------------------------------------- function declarations --
@@ -54,8 +89,31 @@ static int verbose;
 
 static void usage(FILE *stream, const char *cmd, int exitcode);
 static int connect_to_server(const char *server, const char *port);
-static int send_req(FILE *write_fd, const char *user, const char *message, const char *img_url);
+static int send_req(FILE *write_fd, const char *user, const char *message, const char *img_url, int compressed);
 static int read_resp(FILE *read_fd);
+static int transact(const smc_options_t *options, const char *message, const query_t *query, const record_t *records, size_t record_count, int protocol);
+static int transact_pipelined(const smc_options_t *options);
+static int transact_batch(const smc_options_t *options);
+static int transact_follow(const smc_options_t *options);
+static int transact_query(const smc_options_t *options, const query_t *query);
+static int transact_resume(const smc_options_t *options, int rc);
+static int send_board(FILE *write_fd);
+static size_t encode_board(unsigned char *frame);
+static int send_req_v2(FILE *write_fd, const char *user, const char *message, const char *img_url, int compressed);
+static int send_resume_v2(FILE *write_fd, int compressed);
+static int send_batch_v2(FILE *write_fd, const record_t *records, size_t record_count, int compressed);
+static int send_subscribe_v2(FILE *write_fd, int compressed);
+static int send_query(FILE *write_fd, const query_t *query, int compressed);
+static int send_query_v2(FILE *write_fd, const query_t *query, int compressed);
+static size_t record_len(const record_t *record);
+static int read_batch(const char *batch, record_t **records, size_t *record_count);
+static void free_batch(record_t *records, size_t record_count);
+static int read_resp_v2(FILE *read_fd);
+static int read_file_frame(FILE *read_fd, uint32_t frame_len);
+static int copy_data(FILE *read_fd, FILE *fp, long file_len);
+static int inflate_data(FILE *read_fd, FILE *fp, long file_len);
+static int inflate_chunk(z_stream *z, FILE *read_fd, FILE *fp, long chunk_len);
+static int read_chunked(FILE *read_fd, FILE *fp, int deflated);
 
 /*
  * ------------------------------------------------------------- functions --
@@ -74,69 +132,541 @@ static int read_resp(FILE *read_fd);
  * \retval EXIT_SUCCESS successful execution
  */
 int main(const int argc, const char *const argv[]) {
-    const char *server;
-    const char *port;
-    const char *user;
-    const char *message;
-    const char *img_url;
+    smc_options_t options;
+    int rc = 0;
+    int i;
+
+    smc_parsecommandline_ext(argc, argv, usage, &options);
+    verbose = options.verbose;
+    board = options.board;
+    if (board != NULL && strlen(board) > SMP2_MAXBOARDLEN) {
+        warnx("Name of the board exceeds %u characters", SMP2_MAXBOARDLEN);
+        return EXIT_FAILURE;
+    }
+    print_v("Using the following options: server=%s port=%s, user=%s, img_url=%s, message=%s\n", options.server, options.port, options.user, options.img_url, options.message);
+
+    if (options.keep_alive && options.message_count > 0) {
+        // all messages over one connection, requires protocol version 2
+        rc = transact_pipelined(&options);
+    } else {
+        for (i = 0; i < options.message_count && rc == 0; i++) {
+            // try protocol version 2 first, an old server rejects it with a version 1 response
+            rc = transact_resume(&options, transact(&options, options.messages[i], NULL, NULL, 0, 2));
+            if (rc == FALLBACK_V1) {
+                print_v("%s", "Server does not support protocol version 2 - falling back to version 1\n");
+                rc = transact(&options, options.messages[i], NULL, NULL, 0, 1);
+            }
+        }
+    }
+
+    if (rc == 0 && options.batch != NULL) {
+        rc = transact_batch(&options);
+    }
 
+    if (rc == 0 && options.search != NULL) {
+        query_t search = { "search", SMP2_FIELD_SEARCH, options.search };
+
+        rc = transact_query(&options, &search);
+    }
+
+    if (rc == 0 && options.posts_by != NULL) {
+        query_t posts_by = { "posts_by", SMP2_FIELD_POSTS_BY, options.posts_by };
+
+        rc = transact_query(&options, &posts_by);
+    }
+
+    if (rc == 0 && options.follow) {
+        rc = transact_follow(&options);
+    }
+
+    free(options.messages);
+
+    return rc == 0 && rejected_records == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * \brief Send the request to the server and read the response using the given protocol version.
+ *
+ * \param options - the parsed command line
+ * \param message - message to be posted, NULL for the query or to resume the last response (protocol version 2)
+ * \param query - request for posts to be printed instead of the message, may be NULL
+ * \param records - records to be posted with a batch request instead of the message, may be NULL
+ * \param record_count - number of records, the batch requires protocol version 2
+ * \param protocol - protocol version 1 or 2
+ *
+ * @returns 0 if everything went well, FALLBACK_V1 if the server answered a
+ * version 2 request with version 1 or -1 in case of error
+ */
+static int transact(const smc_options_t *options, const char *message, const query_t *query, const record_t *records, size_t record_count, int protocol) {
     int sfd;
+    int rc;
+    char magic[SMP2_MAGIC_LEN];
     FILE *write_fd = NULL;
     FILE *read_fd = NULL;
 
-    smc_parsecommandline(argc, argv, usage, &server, &port, &user, &message, &img_url, &verbose);
-    print_v("Using the following options: server=%s port=%s, user=%s, img_url=%s, message=%s\n", server, port, user, img_url, message);
-
-    if ((sfd = connect_to_server(server, port)) == -1){
+    if ((sfd = connect_to_server(options->server, options->port)) == -1){
         fprintf(stderr, "Could not connect to server\n");
         close(sfd);
-        return EXIT_FAILURE;
+        return -1;
     }
 
     write_fd = fdopen(sfd, "w");
     if (write_fd == NULL) {
         fprintf(stderr, "Could not open write fd\n");
-        fclose(write_fd);
         close(sfd);
-        return EXIT_FAILURE;
+        return -1;
     }
 
-    if (send_req(write_fd, user, message, img_url)){
+    if (records != NULL) {
+        rc = send_batch_v2(write_fd, records, record_count, options->compressed);
+    } else if (query != NULL) {
+        rc = protocol == 2 ? send_query_v2(write_fd, query, options->compressed) : send_query(write_fd, query, options->compressed);
+    } else if (message == NULL) {
+        rc = send_resume_v2(write_fd, options->compressed);
+    } else if (protocol == 2) {
+        rc = send_req_v2(write_fd, options->user, message, options->img_url, options->compressed);
+    } else {
+        rc = send_req(write_fd, options->user, message, options->img_url, options->compressed);
+    }
+    if (rc){
         fprintf(stderr, "Error at sending request\n");
         fclose(write_fd);
-        close(sfd);
-        return EXIT_FAILURE;
+        return -1;
     }
     if (shutdown(sfd, SHUT_WR) == -1){
         fprintf(stderr, "Error could not shutdown write part of socket\n");
         fclose(write_fd);
-        close(sfd);
-        return EXIT_FAILURE;
+        return -1;
     }
     print_v("%s", "Closed write part of socket\n")
 
-    read_fd = fdopen(sfd, "r");
+    read_fd = fdopen(dup(sfd), "r");
     if (read_fd == NULL) {
         fprintf(stderr, "Could not open read fd\n");
         fclose(write_fd);
-        fclose(read_fd);
-        close(sfd);
-        return EXIT_FAILURE;
+        return -1;
     }
 
-    if (read_resp(read_fd) != 0){
+    if (protocol == 2) {
+        // the magic tells the protocol version of the response
+        if (fread(magic, 1, sizeof(magic), read_fd) != sizeof(magic)) {
+            fprintf(stderr, "Error at reading response\n");
+            rc = -1;
+        } else if (!smp2_is_frame(magic, sizeof(magic))) {
+            rc = FALLBACK_V1;
+        } else {
+            rc = read_resp_v2(read_fd);
+        }
+    } else {
+        rc = read_resp(read_fd);
+    }
+
+    if (rc == -1){
         fprintf(stderr, "Error at reading response\n");
-        fclose(write_fd);
-        fclose(read_fd);
-        close(sfd);
-        return EXIT_FAILURE;
     }
 
     fclose(write_fd);
     fclose(read_fd);
-    close(sfd);
 
-    return 0;
+    return rc;
+}
+
+/**
+ * \brief Post all messages over a single connection using protocol version 2.
+ * Up to PIPELINE_DEPTH requests are sent before their responses are read,
+ * the server answers them in order. The window keeps the pending responses
+ * small enough for the socket buffers, thus neither side blocks forever.
+ *
+ * \param options - the parsed command line
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int transact_pipelined(const smc_options_t *options) {
+    int sfd;
+    int rc = 0;
+    int sent = 0;
+    int received = 0;
+    char magic[SMP2_MAGIC_LEN];
+    FILE *write_fd = NULL;
+    FILE *read_fd = NULL;
+
+    if ((sfd = connect_to_server(options->server, options->port)) == -1){
+        fprintf(stderr, "Could not connect to server\n");
+        return -1;
+    }
+
+    write_fd = fdopen(sfd, "w");
+    read_fd = fdopen(dup(sfd), "r");
+    if (write_fd == NULL || read_fd == NULL) {
+        fprintf(stderr, "Could not open fds\n");
+        if (write_fd != NULL) {
+            fclose(write_fd);
+        } else {
+            close(sfd);
+        }
+        if (read_fd != NULL) {
+            fclose(read_fd);
+        }
+        return -1;
+    }
+
+    while (received < options->message_count && rc == 0) {
+        while (sent < options->message_count && sent - received < PIPELINE_DEPTH) {
+            if (send_req_v2(write_fd, options->user, options->messages[sent], options->img_url, options->compressed)){
+                fprintf(stderr, "Error at sending request %d\n", sent + 1);
+                rc = -1;
+                break;
+            }
+            sent++;
+
+            // signal the end of the requests, the server terminates after the last response
+            if (sent == options->message_count && shutdown(sfd, SHUT_WR) == -1){
+                fprintf(stderr, "Error could not shutdown write part of socket\n");
+                rc = -1;
+                break;
+            }
+        }
+        if (rc != 0) {
+            break;
+        }
+
+        if (fread(magic, 1, sizeof(magic), read_fd) != sizeof(magic) || !smp2_is_frame(magic, sizeof(magic))) {
+            fprintf(stderr, "Server does not support persistent connections (protocol version 2)\n");
+            rc = -1;
+            break;
+        }
+        if (read_resp_v2(read_fd) != 0) {
+            fprintf(stderr, "Error at reading response %d\n", received + 1);
+            rc = -1;
+            break;
+        }
+        received++;
+        print_v("Received response %d of %d\n", received, options->message_count);
+    }
+
+    fclose(write_fd);
+    fclose(read_fd);
+
+    return rc;
+}
+
+/**
+ * \brief Post all records of the batch file with batch requests of protocol version 2.
+ * The records are split into as few requests as the limits of a batch request
+ * allow, the server stores the records of a request with a single write. A server
+ * which does not support version 2 gets one request of version 1 per record.
+ *
+ * \param options - the parsed command line
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int transact_batch(const smc_options_t *options) {
+    smc_options_t record_options = *options;
+    record_t *records = NULL;
+    size_t record_count = 0;
+    size_t first = 0;
+    size_t count;
+    size_t len;
+    size_t i;
+    int rc = 0;
+
+    if (read_batch(options->batch, &records, &record_count) != 0) {
+        return -1;
+    }
+    print_v("Read %zu records from batch file %s\n", record_count, options->batch);
+
+    while (first < record_count && rc == 0) {
+        // a record exceeding a whole batch request is rejected right away
+        if (record_len(&records[first]) > SMP2_MAXBATCHLEN - MAX_FIELD_SIZE) {
+            warnx("Record %zu exceeds the maximum size of a batch request", first + 1);
+            rejected_records++;
+            first++;
+            continue;
+        }
+
+        len = 0;
+        for (count = 0; first + count < record_count && count < SMP2_MAXBATCHRECORDS; count++) {
+            if (len + record_len(&records[first + count]) > SMP2_MAXBATCHLEN - MAX_FIELD_SIZE) {
+                break;
+            }
+            len += record_len(&records[first + count]);
+        }
+
+        record_offset = (long) first;
+        rc = transact(options, NULL, NULL, &records[first], count, 2);
+        if (rc == FALLBACK_V1) {
+            print_v("%s", "Server does not support protocol version 2 - posting the records one by one\n");
+            rc = 0;
+            for (i = first; i < record_count && rc == 0; i++) {
+                record_options.user = records[i].user;
+                record_options.img_url = records[i].img_url;
+                rc = transact(&record_options, records[i].message, NULL, NULL, 0, 1);
+            }
+            count = record_count - first;
+        }
+        first += count;
+    }
+
+    free_batch(records, record_count);
+
+    return rc;
+}
+
+/**
+ * \brief Subscribe to the bulletin board and write the pushed posts to stdout.
+ * The server answers the subscription with its current sequence number and
+ * pushes a response for every commit of new posts, thus this function only
+ * returns if the server closes the connection.
+ *
+ * \param options - the parsed command line
+ *
+ * @returns -1, the subscription ended
+ */
+static int transact_follow(const smc_options_t *options) {
+    int sfd;
+    int rc = 0;
+    char magic[SMP2_MAGIC_LEN];
+    FILE *write_fd = NULL;
+    FILE *read_fd = NULL;
+
+    if ((sfd = connect_to_server(options->server, options->port)) == -1){
+        fprintf(stderr, "Could not connect to server\n");
+        return -1;
+    }
+
+    write_fd = fdopen(sfd, "w");
+    read_fd = fdopen(dup(sfd), "r");
+    if (write_fd == NULL || read_fd == NULL) {
+        fprintf(stderr, "Could not open fds\n");
+        if (write_fd != NULL) {
+            fclose(write_fd);
+        } else {
+            close(sfd);
+        }
+        if (read_fd != NULL) {
+            fclose(read_fd);
+        }
+        return -1;
+    }
+
+    // the write part stays open, closing it ends the subscription
+    if (send_subscribe_v2(write_fd, options->compressed)){
+        fprintf(stderr, "Error at sending subscription\n");
+        rc = -1;
+    }
+
+    to_stdout = 1;
+    while (rc == 0) {
+        if (fread(magic, 1, sizeof(magic), read_fd) != sizeof(magic)) {
+            fprintf(stderr, "Server closed the subscription\n");
+            rc = -1;
+        } else if (!smp2_is_frame(magic, sizeof(magic))) {
+            fprintf(stderr, "Server does not support subscriptions (protocol version 2)\n");
+            rc = -1;
+        } else if (read_resp_v2(read_fd) != 0) {
+            fprintf(stderr, "Error at reading pushed response\n");
+            rc = -1;
+        } else if (fflush(stdout) != 0) {
+            warnx("Could not flush stdout");
+            rc = -1;
+        }
+    }
+
+    fclose(write_fd);
+    fclose(read_fd);
+
+    return rc;
+}
+
+/**
+ * \brief Send a query and print the posts found to stdout.
+ * Protocol version 2 is tried first, the files of a rejected query are written to disk.
+ *
+ * \param options - the parsed command line
+ * \param query - the query, e.g. a search
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int transact_query(const smc_options_t *options, const query_t *query) {
+    int rc;
+
+    to_stdout = 1;
+    rc = transact(options, NULL, query, NULL, 0, 2);
+    if (rc == FALLBACK_V1) {
+        print_v("%s", "Server does not support protocol version 2 - falling back to version 1\n");
+        rc = transact(options, NULL, query, NULL, 0, 1);
+    }
+    to_stdout = 0;
+
+    if (rc == 0 && response_status != 0) {
+        warnx("Request %s= was rejected by the server - status: %ld", query->keyword, response_status);
+        rc = -1;
+    }
+
+    return rc;
+}
+
+/**
+ * \brief Resume an interrupted response of protocol version 2.
+ * The rest of the response is requested from the byte following the last one written to
+ * the partially received file, which is continued. A deflate encoded file starts over.
+ * A server of protocol version 1 never sends the id of a response, thus it is never resumed.
+ *
+ * \param options - the parsed command line
+ * \param rc - result of the transaction which may have been interrupted
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int transact_resume(const smc_options_t *options, int rc) {
+    int attempts = 0;
+
+    while (rc == -1 && resume_id != 0 && resume_file != NULL && attempts++ < RESUME_ATTEMPTS) {
+        print_v("Resuming response %llu at file %s, offset %ld\n", (unsigned long long) resume_id, resume_file, resume_offset);
+        rc = transact(options, NULL, NULL, NULL, 0, 2);
+    }
+
+    free(resume_file);
+    resume_id = 0;
+    resume_file = NULL;
+
+    return rc;
+}
+
+/**
+ * \brief Read the records of a batch file.
+ * Every record starts with the line "user=<name>", optionally followed by the line
+ * "img=<URL>", followed by the lines of the message. A line containing only "."
+ * terminates the record, the newline preceding it is not part of the message.
+ *
+ * \param batch - name of the batch file, "-" for stdin
+ * \param records - set to the allocated records
+ * \param record_count - set to the number of records
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int read_batch(const char *batch, record_t **records, size_t *record_count) {
+    FILE *fp = stdin;
+    char *line = NULL;
+    size_t len = 0;
+    ssize_t line_len;
+    size_t message_len = 0;
+    size_t size = 0;
+    long line_no = 0;
+    record_t *record = NULL;
+    record_t *tmp;
+    char *message;
+    int rc = 0;
+
+    *records = NULL;
+    *record_count = 0;
+
+    if (strcmp(batch, "-") != 0 && (fp = fopen(batch, "r")) == NULL) {
+        warn("Could not open batch file %s", batch);
+        return -1;
+    }
+
+    while (rc == 0 && (line_len = getline(&line, &len, fp)) != -1) {
+        line_no++;
+
+        if (record == NULL) {
+            // the line starts a new record
+            if (strncmp(line, "user=", 5) != 0) {
+                warnx("%s:%ld: expected user=", batch, line_no);
+                rc = -1;
+                break;
+            }
+            if (*record_count == size) {
+                size = size == 0 ? 64 : 2 * size;
+                if ((tmp = realloc(*records, size * sizeof(**records))) == NULL) {
+                    warnx("Could not allocate records");
+                    rc = -1;
+                    break;
+                }
+                *records = tmp;
+            }
+            record = &(*records)[(*record_count)++];
+            record->img_url = NULL;
+            record->message = NULL;
+            message_len = 0;
+            line[strcspn(line, "\n")] = '\0';
+            if ((record->user = strdup(line + 5)) == NULL) {
+                warnx("Could not allocate user");
+                rc = -1;
+            }
+        } else if (record->img_url == NULL && record->message == NULL && strncmp(line, "img=", 4) == 0) {
+            line[strcspn(line, "\n")] = '\0';
+            if ((record->img_url = strdup(line + 4)) == NULL) {
+                warnx("Could not allocate image URL");
+                rc = -1;
+            }
+        } else if (strcmp(line, BATCH_END "\n") == 0 || strcmp(line, BATCH_END) == 0) {
+            if (record->message == NULL) {
+                warnx("%s:%ld: record without message", batch, line_no);
+                rc = -1;
+                break;
+            }
+            // the newline preceding the terminating line is not part of the message
+            if (message_len > 0 && record->message[message_len - 1] == '\n') {
+                record->message[--message_len] = '\0';
+            }
+            record = NULL;
+        } else {
+            if ((message = realloc(record->message, message_len + line_len + 1)) == NULL) {
+                warnx("Could not allocate message");
+                rc = -1;
+                break;
+            }
+            record->message = message;
+            memcpy(record->message + message_len, line, line_len + 1);
+            message_len += line_len;
+        }
+    }
+
+    if (rc == 0 && ferror(fp)) {
+        warn("Could not read batch file %s", batch);
+        rc = -1;
+    }
+    // the last record may end with the file
+    if (rc == 0 && record != NULL && record->message == NULL) {
+        warnx("%s:%ld: record without message", batch, line_no);
+        rc = -1;
+    } else if (rc == 0 && record != NULL && record->message[message_len - 1] == '\n') {
+        record->message[message_len - 1] = '\0';
+    }
+    if (rc == 0 && *record_count == 0) {
+        warnx("%s: no records", batch);
+        rc = -1;
+    }
+
+    free(line);
+    if (fp != stdin) {
+        fclose(fp);
+    }
+
+    if (rc != 0) {
+        free_batch(*records, *record_count);
+        *records = NULL;
+        *record_count = 0;
+    }
+
+    return rc;
+}
+
+/**
+ * \brief Free the records read by read_batch().
+ *
+ * \param records - the records, may be NULL
+ * \param record_count - number of records
+ */
+static void free_batch(record_t *records, size_t record_count) {
+    size_t i;
+
+    for (i = 0; i < record_count; i++) {
+        free(records[i].user);
+        free(records[i].img_url);
+        free(records[i].message);
+    }
+    free(records);
 }
 
 /**
@@ -205,6 +735,13 @@ static void usage(FILE *stream, const char *cmd, int exitcode) {
     fprintf(stream, "        -i, --image <URL>       URL pointing to an image of the posting user\n");
     fprintf(stream, "        -m, --message <message> message to be added to the bulletin board\n");
     fprintf(stream, "        -v, --verbose           verbose output\n");
+    fprintf(stream, "        -c, --compressed        request compressed responses\n");
+    fprintf(stream, "        -k, --keep-alive        post all messages (-m may be repeated) over one connection\n");
+    fprintf(stream, "        -b, --batch <file>      post the records of file (\"-\" for stdin) with batch requests\n");
+    fprintf(stream, "        -f, --follow            print new posts as they are pushed by the server\n");
+    fprintf(stream, "        -q, --search <words>    print the posts containing all words\n");
+    fprintf(stream, "        -a, --posts-by <user>   print the posts of the user\n");
+    fprintf(stream, "        -B, --board <name>      address the board instead of the default board\n");
     fprintf(stream, "        -h, --help\n");
     exit(exitcode);
 }
@@ -217,11 +754,13 @@ static void usage(FILE *stream, const char *cmd, int exitcode) {
  * \param user - username which get added to request
  * \param message - message which get added to request
  * \param img_url - img_url which get added to request
+ * \param compressed - request compressed responses if non-zero
  *
  * @returns 0 if everything went well or -1 in case of error
  */
-static int send_req(FILE *write_fd, const char *user, const char *message, const char *img_url) {
-    const char *pre_user = "user=";
+static int send_req(FILE *write_fd, const char *user, const char *message, const char *img_url, int compressed) {
+    // a server without protocol version 2 knows no option lines but the encoding requested with -c
+    const char *pre_user = compressed ? "accept-encoding=deflate\nuser=" : "user=";
     const char *pre_message = "\n";
     const char *pre_img_url = "";
 
@@ -233,6 +772,9 @@ static int send_req(FILE *write_fd, const char *user, const char *message, const
 
     print_v("Going to send the following message:%s%s%s%s%s%s\n", pre_user, user, pre_img_url, img_url, pre_message, message)
 
+    if (send_board(write_fd) != 0) {
+        return -1;
+    }
     if (fprintf(write_fd, "%s%s%s%s%s%s", pre_user, user, pre_img_url, img_url, pre_message, message) < 0){
         warnx("Could not write to file descriptor");
         return -1;
@@ -247,68 +789,413 @@ static int send_req(FILE *write_fd, const char *user, const char *message, const
 }
 
 /**
- * \brief Fetch and well-form server response.
- * Writes obtained Files to disk.
+ * \brief Send the line addressing the board in a request of protocol version 1
  *
- * \param read_fd - FILE pointer where to read the responst
+ * \param write_fd - FILE pointer to write the request
  *
  * @returns 0 if everything went well or -1 in case of error
  */
-static int read_resp(FILE *read_fd) {
-    char *line = NULL;
-    char buffer[BUFFER_SIZE];
-    char *file_name = NULL;
-    char *cmp = NULL;
-    long status;
-    long file_len = 0;
-    long counter = 0;
-    long to_process = 0;
-    size_t read;
-    size_t len = 0;
-    FILE *fp = NULL;
-
-    if ((getline(&line, &len, read_fd)) != -1) {
-        cmp = strtok(line, "=");
-        if (strncmp(cmp,"status",7) != 0){
-            warnx("Expected: status= from server\n Received: %s=",cmp);
-            return -1;
-        }
-        errno = 0;
-        status = strtol(strtok(NULL, "\n"), NULL, 10);
-
-        if(errno != 0){
-            warnx("Something went wrong parsing status: %i", errno);
-            return -1;
-        }
-        print_v("Obtained and parsed Status from server\nStatus: %ld\n", status);
-    } else {
-        warnx("Could not well-form status - Received no line from Server\n");
+static int send_board(FILE *write_fd) {
+    if (board != NULL && fprintf(write_fd, "board=%s\n", board) < 0) {
+        warnx("Could not write to file descriptor");
         return -1;
     }
 
-    while ((getline(&line, &len, read_fd)) != -1) {
-        //get file_name
-        cmp = strtok(line, "=");
-        if (strncmp(cmp,"file",5) != 0){
-            warnx("Expected: file= from server\n Received: %s=",cmp);
-            return -1;
-        }
+    return 0;
+}
 
-        if ((file_name = strtok(NULL, "\n")) == NULL){
-            warnx("Failed read file_name");
-            return -1;
-        }
-        print_v("Obtained and parsed Filename from server\nFilename: %s\n",file_name);
+/**
+ * \brief Encode the field addressing the board in a request frame of protocol version 2
+ *
+ * \param frame - buffer the field is encoded into, NULL to get the length of the field only
+ *
+ * @returns the number of bytes of the field, 0 for the default board
+ */
+static size_t encode_board(unsigned char *frame) {
+    if (board == NULL) {
+        return 0;
+    }
+    if (frame == NULL) {
+        return SMP2_FIELD_HEADER_LEN + strlen(board);
+    }
+
+    return smp2_encode_field(frame, SMP2_FIELD_BOARD, board, (uint32_t) strlen(board));
+}
+
+/**
+ * \brief Encode the request as frame of protocol version 2 and send it to the Server
+ *
+ * \param write_fd - FILE pointer to write the request
+ * \param user - username which get added to request
+ * \param message - message which get added to request
+ * \param img_url - img_url which get added to request, may be NULL
+ * \param compressed - request compressed responses if non-zero
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int send_req_v2(FILE *write_fd, const char *user, const char *message, const char *img_url, int compressed) {
+    const char *encoding = "deflate";
+    size_t user_len = strlen(user);
+    size_t message_len = strlen(message);
+    size_t img_url_len = img_url != NULL ? strlen(img_url) : 0;
+    size_t len = SMP2_HEADER_LEN;
+    unsigned char *frame;
+
+    frame = malloc(SMP2_HEADER_LEN + 5 * SMP2_FIELD_HEADER_LEN + user_len + message_len + img_url_len + strlen(encoding) + encode_board(NULL));
+    if (frame == NULL) {
+        warnx("Could not allocate request frame");
+        return -1;
+    }
+
+    if (compressed) {
+        len += smp2_encode_field(frame + len, SMP2_FIELD_ACCEPT_ENCODING, encoding, (uint32_t) strlen(encoding));
+    }
+    // the response carries an id, thus it can be resumed if it is interrupted
+    len += smp2_encode_field(frame + len, SMP2_FIELD_ACCEPT_RANGES, NULL, 0);
+    len += encode_board(frame + len);
+    len += smp2_encode_field(frame + len, SMP2_FIELD_USER, user, (uint32_t) user_len);
+    if (img_url != NULL) {
+        len += smp2_encode_field(frame + len, SMP2_FIELD_IMG, img_url, (uint32_t) img_url_len);
+    }
+    len += smp2_encode_field(frame + len, SMP2_FIELD_MSG, message, (uint32_t) message_len);
+    smp2_encode_header(frame, SMP2_FRAME_REQUEST, (uint32_t) (len - SMP2_HEADER_LEN));
+
+    print_v("Going to send a request frame of %zu bytes\n", len);
+
+    if (fwrite(frame, 1, len, write_fd) != len){
+        warnx("Could not write to file descriptor");
+        free(frame);
+        return -1;
+    }
+    free(frame);
+
+    if (fflush(write_fd) != 0){
+        warnx("Could not flush output buffer");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Request the rest of the interrupted response from the Server using protocol version 2
+ *
+ * \param write_fd - FILE pointer to write the request
+ * \param compressed - request compressed responses if non-zero
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int send_resume_v2(FILE *write_fd, int compressed) {
+    const char *encoding = "deflate";
+    size_t file_len = strlen(resume_file);
+    size_t len = SMP2_HEADER_LEN;
+    unsigned char *frame;
+
+    frame = malloc(SMP2_HEADER_LEN + 2 * SMP2_FIELD_HEADER_LEN + 2 * sizeof(uint64_t) + file_len + strlen(encoding) + encode_board(NULL));
+    if (frame == NULL) {
+        warnx("Could not allocate request frame");
+        return -1;
+    }
+
+    if (compressed) {
+        len += smp2_encode_field(frame + len, SMP2_FIELD_ACCEPT_ENCODING, encoding, (uint32_t) strlen(encoding));
+    }
+    len += encode_board(frame + len);
+    // id, offset and name of the file follow the header of the resume field
+    len += smp2_encode_field_header(frame + len, SMP2_FIELD_RESUME, (uint32_t) (2 * sizeof(uint64_t) + file_len));
+    smp2_put_u64(frame + len, resume_id);
+    smp2_put_u64(frame + len + sizeof(uint64_t), (uint64_t) resume_offset);
+    memcpy(frame + len + 2 * sizeof(uint64_t), resume_file, file_len);
+    len += 2 * sizeof(uint64_t) + file_len;
+    smp2_encode_header(frame, SMP2_FRAME_REQUEST, (uint32_t) (len - SMP2_HEADER_LEN));
+
+    print_v("Going to send a resume frame of %zu bytes\n", len);
+
+    if (fwrite(frame, 1, len, write_fd) != len){
+        warnx("Could not write to file descriptor");
+        free(frame);
+        return -1;
+    }
+    free(frame);
+
+    if (fflush(write_fd) != 0){
+        warnx("Could not flush output buffer");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Get the length of a record encoded as field of a batch request.
+ *
+ * \param record - the record
+ *
+ * @returns the number of bytes of the encoded record
+ */
+static size_t record_len(const record_t *record) {
+    return 3 * SMP2_FIELD_HEADER_LEN + strlen(record->user) + strlen(record->message) +
+        (record->img_url != NULL ? SMP2_FIELD_HEADER_LEN + strlen(record->img_url) : 0);
+}
+
+/**
+ * \brief Encode the records as batch request of protocol version 2 and send it to the Server
+ *
+ * \param write_fd - FILE pointer to write the request
+ * \param records - records to be posted
+ * \param record_count - number of records
+ * \param compressed - request compressed responses if non-zero
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int send_batch_v2(FILE *write_fd, const record_t *records, size_t record_count, int compressed) {
+    const char *encoding = "deflate";
+    size_t len = SMP2_HEADER_LEN;
+    size_t field_len;
+    size_t i;
+    unsigned char *frame;
+
+    for (i = 0; i < record_count; i++) {
+        len += record_len(&records[i]);
+    }
+
+    frame = malloc(len + SMP2_FIELD_HEADER_LEN + strlen(encoding) + encode_board(NULL));
+    if (frame == NULL) {
+        warnx("Could not allocate batch request frame");
+        return -1;
+    }
+
+    len = SMP2_HEADER_LEN;
+    if (compressed) {
+        len += smp2_encode_field(frame + len, SMP2_FIELD_ACCEPT_ENCODING, encoding, (uint32_t) strlen(encoding));
+    }
+    len += encode_board(frame + len);
+    for (i = 0; i < record_count; i++) {
+        // the fields of the record follow the header of the record field
+        field_len = record_len(&records[i]) - SMP2_FIELD_HEADER_LEN;
+        len += smp2_encode_field_header(frame + len, SMP2_FIELD_RECORD, (uint32_t) field_len);
+        len += smp2_encode_field(frame + len, SMP2_FIELD_USER, records[i].user, (uint32_t) strlen(records[i].user));
+        if (records[i].img_url != NULL) {
+            len += smp2_encode_field(frame + len, SMP2_FIELD_IMG, records[i].img_url, (uint32_t) strlen(records[i].img_url));
+        }
+        len += smp2_encode_field(frame + len, SMP2_FIELD_MSG, records[i].message, (uint32_t) strlen(records[i].message));
+    }
+    smp2_encode_header(frame, SMP2_FRAME_REQUEST, (uint32_t) (len - SMP2_HEADER_LEN));
+
+    print_v("Going to send a batch request frame of %zu records and %zu bytes\n", record_count, len);
+
+    if (fwrite(frame, 1, len, write_fd) != len){
+        warnx("Could not write to file descriptor");
+        free(frame);
+        return -1;
+    }
+    free(frame);
+
+    if (fflush(write_fd) != 0){
+        warnx("Could not flush output buffer");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Send a subscription request of protocol version 2 to the Server
+ * The subscription starts with the posts committed from now on.
+ *
+ * \param write_fd - FILE pointer to write the request
+ * \param compressed - request compressed responses if non-zero
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int send_subscribe_v2(FILE *write_fd, int compressed) {
+    const char *encoding = "deflate";
+    unsigned char frame[SMP2_HEADER_LEN + 3 * SMP2_FIELD_HEADER_LEN + sizeof("deflate") + SMP2_MAXBOARDLEN];
+    size_t len = SMP2_HEADER_LEN;
+
+    if (compressed) {
+        len += smp2_encode_field(frame + len, SMP2_FIELD_ACCEPT_ENCODING, encoding, (uint32_t) strlen(encoding));
+    }
+    len += encode_board(frame + len);
+    len += smp2_encode_field(frame + len, SMP2_FIELD_SUBSCRIBE, NULL, 0);
+    smp2_encode_header(frame, SMP2_FRAME_REQUEST, (uint32_t) (len - SMP2_HEADER_LEN));
+
+    print_v("Going to send a subscription frame of %zu bytes\n", len);
+
+    if (fwrite(frame, 1, len, write_fd) != len){
+        warnx("Could not write to file descriptor");
+        return -1;
+    }
+    if (fflush(write_fd) != 0){
+        warnx("Could not flush output buffer");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Send a query of protocol version 1 to the Server
+ *
+ * \param write_fd - FILE pointer to write the request
+ * \param query - the query, sent as line "<keyword>=<value>"
+ * \param compressed - request compressed responses if non-zero
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int send_query(FILE *write_fd, const query_t *query, int compressed) {
+    const char *pre_query = compressed ? "accept-encoding=deflate\n" : "";
+
+    print_v("Going to send the following query:%s%s=%s\n", pre_query, query->keyword, query->value)
+
+    if (send_board(write_fd) != 0) {
+        return -1;
+    }
+    if (fprintf(write_fd, "%s%s=%s\n", pre_query, query->keyword, query->value) < 0){
+        warnx("Could not write to file descriptor");
+        return -1;
+    }
+    if (fflush(write_fd) != 0){
+        warnx("Could not flush output buffer");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Encode a query as frame of protocol version 2 and send it to the Server
+ *
+ * \param write_fd - FILE pointer to write the request
+ * \param query - the query, its value is sent in the field given by its tag
+ * \param compressed - request compressed responses if non-zero
+ *
+ * The found posts may be sent as chunked file, thus the server streams them
+ * while it reads them.
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int send_query_v2(FILE *write_fd, const query_t *query, int compressed) {
+    const char *encoding = "deflate";
+    const char *framing = "chunked";
+    size_t value_len = strlen(query->value);
+    size_t len = SMP2_HEADER_LEN;
+    unsigned char *frame;
+
+    frame = malloc(SMP2_HEADER_LEN + 3 * SMP2_FIELD_HEADER_LEN + value_len + strlen(encoding) + strlen(framing) + encode_board(NULL));
+    if (frame == NULL) {
+        warnx("Could not allocate request frame");
+        return -1;
+    }
+
+    if (compressed) {
+        len += smp2_encode_field(frame + len, SMP2_FIELD_ACCEPT_ENCODING, encoding, (uint32_t) strlen(encoding));
+    }
+    len += smp2_encode_field(frame + len, SMP2_FIELD_ACCEPT_FRAMING, framing, (uint32_t) strlen(framing));
+    len += encode_board(frame + len);
+    len += smp2_encode_field(frame + len, query->tag, query->value, (uint32_t) value_len);
+    smp2_encode_header(frame, SMP2_FRAME_REQUEST, (uint32_t) (len - SMP2_HEADER_LEN));
+
+    print_v("Going to send a %s frame of %zu bytes\n", query->keyword, len);
+
+    if (fwrite(frame, 1, len, write_fd) != len){
+        warnx("Could not write to file descriptor");
+        free(frame);
+        return -1;
+    }
+    free(frame);
+
+    if (fflush(write_fd) != 0){
+        warnx("Could not flush output buffer");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Fetch and well-form server response.
+ * Writes obtained Files to disk.
+ *
+ * \param read_fd - FILE pointer where to read the responst
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int read_resp(FILE *read_fd) {
+    char *line = NULL;
+    char *file_name = NULL;
+    char *cmp = NULL;
+    long status;
+    long file_len = 0;
+    int deflated;
+    size_t len = 0;
+    FILE *fp = NULL;
+
+    if ((getline(&line, &len, read_fd)) != -1) {
+        cmp = strtok(line, "=");
+        if (strncmp(cmp,"status",7) != 0){
+            warnx("Expected: status= from server\n Received: %s=",cmp);
+            return -1;
+        }
+        errno = 0;
+        status = strtol(strtok(NULL, "\n"), NULL, 10);
+
+        if(errno != 0){
+            warnx("Something went wrong parsing status: %i", errno);
+            return -1;
+        }
+        print_v("Obtained and parsed Status from server\nStatus: %ld\n", status);
+        response_status = status;
+    } else {
+        warnx("Could not well-form status - Received no line from Server\n");
+        return -1;
+    }
+
+    while ((getline(&line, &len, read_fd)) != -1) {
+        //get file_name
+        cmp = strtok(line, "=");
+        if (strncmp(cmp,"seq",4) == 0){
+            // sequence number of delta, search and posts by user responses
+            print_v("Sequence number: %s", line + 4);
+            continue;
+        }
+        if (strncmp(cmp,"file",5) != 0){
+            warnx("Expected: file= from server\n Received: %s=",cmp);
+            return -1;
+        }
+
+        if ((file_name = strtok(NULL, "\n")) == NULL){
+            warnx("Failed read file_name");
+            return -1;
+        }
+        print_v("Obtained and parsed Filename from server\nFilename: %s\n",file_name);
 
-        //open file
-        if ((fp = fopen(file_name, "w+")) == NULL) {
+        //open file, the files of a failed request always go to disk
+        if (to_stdout && response_status == 0) {
+            fp = stdout;
+        } else if ((fp = fopen(file_name, "w+")) == NULL) {
             warnx("Could not open File: %s\n",file_name);
             return -1;
         }
 
-        //get file_len
+        //get file_len, optionally preceded by the encoding
+        deflated = 0;
         if ((getline(&line, &len, read_fd)) != -1) {
             cmp = strtok(line, "=");
+            if (strncmp(cmp,"encoding",9) == 0){
+                if ((cmp = strtok(NULL, "\n")) == NULL || strcmp(cmp, "deflate") != 0){
+                    warnx("Unsupported encoding from server: %s", cmp == NULL ? "" : cmp);
+                    return -1;
+                }
+                deflated = 1;
+                print_v("%s\n", "File is deflate encoded");
+
+                if ((getline(&line, &len, read_fd)) == -1) {
+                    warnx("Could not read File length line\n");
+                    return -1;
+                }
+                cmp = strtok(line, "=");
+            }
             if (strncmp(cmp,"len",4) != 0){
                 warnx("Expected: len= from server\n Received: %s=",cmp);
                 return -1;
@@ -324,38 +1211,436 @@ static int read_resp(FILE *read_fd) {
             return -1;
         }
 
-        counter = file_len;
-
         //read/write data
-        while (counter != 0) {
-            to_process = counter;
-            if (to_process > BUFFER_SIZE) {
-                to_process = BUFFER_SIZE;
+        if ((deflated ? inflate_data(read_fd, fp, file_len) : copy_data(read_fd, fp, file_len)) != 0) {
+            return -1;
+        }
+
+        if (fp == stdout) {
+            continue;
+        }
+        if (fclose(fp) == EOF) {
+            warnx("Error closing filestream\n");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief Fetch the frames of a protocol version 2 response.
+ * Writes obtained Files to disk. The magic of the first frame has already been read.
+ *
+ * \param read_fd - FILE pointer where to read the response
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int read_resp_v2(FILE *read_fd) {
+    unsigned char buffer[MAX_STATUS_SIZE];
+    const unsigned char *pos;
+    smp2_header_t header;
+    smp2_field_t field;
+    size_t have = SMP2_MAGIC_LEN;
+    size_t i;
+    long status;
+    int rc;
+
+    memcpy(buffer, SMP2_MAGIC, SMP2_MAGIC_LEN);
+
+    for (;;) {
+        if (fread(buffer + have, 1, SMP2_HEADER_LEN - have, read_fd) != SMP2_HEADER_LEN - have) {
+            warnx("Response ended without end frame\n");
+            return -1;
+        }
+        have = 0;
+
+        if (smp2_decode_header(buffer, &header) == -1) {
+            warnx("Received malformed frame header\n");
+            return -1;
+        }
+
+        switch (header.type) {
+            case SMP2_FRAME_STATUS:
+                if (header.len > sizeof(buffer) || fread(buffer, 1, header.len, read_fd) != header.len) {
+                    warnx("Could not read status frame\n");
+                    return -1;
+                }
+                pos = buffer;
+                while ((rc = smp2_next_field(&pos, buffer + header.len, &field)) == 1) {
+                    if (field.tag == SMP2_FIELD_STATUS && field.len == sizeof(uint32_t)) {
+                        response_status = (long) (int32_t) smp2_get_u32(field.value);
+                        print_v("Obtained and parsed Status from server\nStatus: %ld\n", response_status);
+                    } else if (field.tag == SMP2_FIELD_SEQ && field.len == sizeof(uint64_t)) {
+                        print_v("Sequence number: %llu\n", (unsigned long long) smp2_get_u64(field.value));
+                    } else if (field.tag == SMP2_FIELD_ID && field.len == sizeof(uint64_t)) {
+                        // the response may be resumed if it is interrupted
+                        resume_id = smp2_get_u64(field.value);
+                        print_v("Response id: %llu\n", (unsigned long long) resume_id);
+                    } else if (field.tag == SMP2_FIELD_RECORD_STATUS) {
+                        // the status of every record of a batch request
+                        for (i = 0; i + sizeof(uint32_t) <= field.len; i += sizeof(uint32_t)) {
+                            status = (long) (int32_t) smp2_get_u32(field.value + i);
+                            if (status != 0) {
+                                warnx("Record %ld was rejected by the server - status: %ld", record_offset + (long) (i / sizeof(uint32_t)) + 1, status);
+                                rejected_records++;
+                            }
+                        }
+                        print_v("Obtained the status of %zu records\n", (size_t) field.len / sizeof(uint32_t));
+                    } else if (field.tag == SMP2_FIELD_DROPPED && field.len == sizeof(uint64_t)) {
+                        warnx("Missed %llu posts - the client lagged behind the server", (unsigned long long) smp2_get_u64(field.value));
+                    }
+                }
+                if (rc == -1) {
+                    warnx("Received malformed status frame\n");
+                    return -1;
+                }
+                break;
+
+            case SMP2_FRAME_FILE:
+                if (read_file_frame(read_fd, header.len) != 0) {
+                    return -1;
+                }
+                break;
+
+            case SMP2_FRAME_END:
+                print_v("%s", "Obtained end frame\n");
+                return 0;
+
+            default:
+                // skip unknown frames
+                if (copy_data(read_fd, NULL, (long) header.len) != 0) {
+                    return -1;
+                }
+                break;
+        }
+    }
+}
+
+/**
+ * \brief Fetch a file frame of a protocol version 2 response and write the file to disk.
+ * The data field is the last field of the frame and is streamed to the file. The file of a
+ * resumed response is continued at the offset given by the frame. If the data ends prematurely,
+ * the name of the file and the number of bytes written are kept to resume the response.
+ *
+ * \param read_fd - FILE pointer where to read the response
+ * \param frame_len - length of the frame payload
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int read_file_frame(FILE *read_fd, uint32_t frame_len) {
+    unsigned char field_header[SMP2_FIELD_HEADER_LEN];
+    char file_name[MAX_FIELD_SIZE];
+    char encoding[MAX_FIELD_SIZE];
+    unsigned char offset_value[sizeof(uint64_t)];
+    smp2_field_t field;
+    FILE *fp = NULL;
+    long offset = 0;
+    int chunked = 0;
+    int rc;
+
+    file_name[0] = '\0';
+    encoding[0] = '\0';
+
+    for (;;) {
+        if (frame_len < SMP2_FIELD_HEADER_LEN || fread(field_header, 1, sizeof(field_header), read_fd) != sizeof(field_header)) {
+            warnx("File frame without data field\n");
+            return -1;
+        }
+        smp2_decode_field_header(field_header, &field);
+        frame_len -= SMP2_FIELD_HEADER_LEN;
+
+        if (field.len > frame_len) {
+            warnx("Field exceeds file frame\n");
+            return -1;
+        }
+        frame_len -= field.len;
+
+        if (field.tag == SMP2_FIELD_DATA) {
+            break;
+        }
+
+        if (field.tag == SMP2_FIELD_NAME || field.tag == SMP2_FIELD_ENCODING) {
+            char *value = field.tag == SMP2_FIELD_NAME ? file_name : encoding;
+
+            if (field.len >= MAX_FIELD_SIZE || fread(value, 1, field.len, read_fd) != field.len) {
+                warnx("Could not read field of file frame\n");
+                return -1;
             }
+            value[field.len] = '\0';
+        } else if (field.tag == SMP2_FIELD_OFFSET && field.len == sizeof(offset_value)) {
+            // the file of a resumed response continues at the offset
+            if (fread(offset_value, 1, sizeof(offset_value), read_fd) != sizeof(offset_value) || smp2_get_u64(offset_value) > LONG_MAX) {
+                warnx("Could not read offset of file frame\n");
+                return -1;
+            }
+            offset = (long) smp2_get_u64(offset_value);
+            print_v("File continues at offset %ld\n", offset);
+        } else if (field.tag == SMP2_FIELD_CHUNKED) {
+            // the data follows in chunk frames
+            chunked = 1;
+            if (copy_data(read_fd, NULL, (long) field.len) != 0) {
+                return -1;
+            }
+        } else if (copy_data(read_fd, NULL, (long) field.len) != 0) {
+            return -1;
+        }
+    }
+
+    if (frame_len != 0 || file_name[0] == '\0') {
+        warnx("Malformed file frame\n");
+        return -1;
+    }
+    if (encoding[0] != '\0' && strcmp(encoding, "deflate") != 0) {
+        warnx("Unsupported encoding from server: %s", encoding);
+        return -1;
+    }
+    print_v("Obtained file frame\nFilename: %s\nFile length: %lu\n", file_name, (unsigned long) field.len);
 
-            // read [buffersize] from file descriptor
-            read = fread(buffer, 1, (size_t) to_process, read_fd);
-            if ((long)read < to_process){
-                warnx("File Data read Error\n");
+    // pushed posts and the posts found by a query are written to stdout, the files of a failed request to disk
+    if (to_stdout && response_status == 0) {
+        fp = stdout;
+    } else if (offset > 0) {
+        // continue the partially written file of an interrupted response
+        if ((fp = fopen(file_name, "r+")) == NULL || fseek(fp, offset, SEEK_SET) == -1) {
+            warnx("Could not continue File: %s at offset %ld\n", file_name, offset);
+            if (fp != NULL) {
+                fclose(fp);
+            }
+            return -1;
+        }
+    } else if ((fp = fopen(file_name, "w+")) == NULL) {
+        warnx("Could not open File: %s\n",file_name);
+        return -1;
+    }
+
+    free(resume_file);
+    if ((resume_file = strdup(file_name)) == NULL) {
+        warnx("Failed to copy file_name");
+    }
+    resume_offset = offset;
+
+    if (chunked) {
+        rc = field.len == 0 ? read_chunked(read_fd, fp, encoding[0] != '\0') : -1;
+    } else if (encoding[0] != '\0') {
+        rc = inflate_data(read_fd, fp, (long) field.len);
+    } else {
+        rc = copy_data(read_fd, fp, (long) field.len);
+    }
+
+    if (rc == 0) {
+        free(resume_file);
+        resume_file = NULL;
+    } else if (fp != stdout && encoding[0] == '\0' && fflush(fp) == 0) {
+        // keep what has been received, a deflate encoded file cannot be continued
+        resume_offset = ftell(fp);
+    }
+
+    if (fp == stdout) {
+        return rc;
+    }
+
+    if (fclose(fp) == EOF) {
+        warnx("Error closing filestream\n");
+        return -1;
+    }
+
+    return rc;
+}
+
+/**
+ * \brief Copy file data from the server response to disk.
+ *
+ * \param read_fd - FILE pointer where to read the response
+ * \param fp - FILE pointer of the file to write to, NULL to skip the data
+ * \param file_len - number of bytes to copy
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int copy_data(FILE *read_fd, FILE *fp, long file_len) {
+    char buffer[BUFFER_SIZE];
+    long counter = file_len;
+    long to_process = 0;
+    size_t read;
+
+    while (counter != 0) {
+        to_process = counter;
+        if (to_process > BUFFER_SIZE) {
+            to_process = BUFFER_SIZE;
+        }
+
+        // read [buffersize] from file descriptor
+        read = fread(buffer, 1, (size_t) to_process, read_fd);
+        if ((long)read < to_process){
+            warnx("File Data read Error\n");
+            return -1;
+        }
+
+        // write [buffersize] bytes to file
+        if (fp != NULL && (long)(fwrite(buffer, sizeof(char), (size_t) to_process, fp)) < to_process){
+            warnx("File Data write Error\n");
+            return -1;
+        }
+
+        counter -= to_process;
+        print_v("Copied %ld Bytes to File - %ld Bytes left\n",to_process,counter);
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Inflate deflate encoded file data from the server response to disk.
+ * The data is inflated while it is read, thus the complete file is never
+ * held in memory.
+ *
+ * \param read_fd - FILE pointer where to read the response
+ * \param fp - FILE pointer of the file to write to
+ * \param file_len - number of encoded bytes
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int inflate_data(FILE *read_fd, FILE *fp, long file_len) {
+    int rc;
+    z_stream z;
+
+    memset(&z, 0, sizeof(z));
+    // raw deflate stream without zlib header
+    if (inflateInit2(&z, -15) != Z_OK){
+        warnx("Could not initialize inflate\n");
+        return -1;
+    }
+
+    rc = inflate_chunk(&z, read_fd, fp, file_len);
+    inflateEnd(&z);
+
+    if (rc == 0){
+        warnx("File Data truncated deflate stream\n");
+        return -1;
+    }
+
+    return rc == 1 ? 0 : -1;
+}
+
+/**
+ * \brief Inflate a part of a deflate stream from the server response to disk.
+ * The stream state is kept in z, thus a stream may be split into several parts.
+ *
+ * \param z - the initialized inflate stream
+ * \param read_fd - FILE pointer where to read the response
+ * \param fp - FILE pointer of the file to write to
+ * \param chunk_len - number of encoded bytes of this part
+ *
+ * @returns 1 if the stream has ended, 0 if it continues or -1 in case of error
+ */
+static int inflate_chunk(z_stream *z, FILE *read_fd, FILE *fp, long chunk_len) {
+    unsigned char in[BUFFER_SIZE];
+    unsigned char out[4 * BUFFER_SIZE];
+    long counter = chunk_len;
+    long to_process = 0;
+    size_t read, have;
+    int rc = Z_OK;
+
+    while (counter != 0) {
+        to_process = counter;
+        if (to_process > BUFFER_SIZE) {
+            to_process = BUFFER_SIZE;
+        }
+
+        read = fread(in, 1, (size_t) to_process, read_fd);
+        if ((long)read < to_process){
+            warnx("File Data read Error\n");
+            return -1;
+        }
+        counter -= to_process;
+
+        z->next_in = in;
+        z->avail_in = (uInt) to_process;
+
+        // inflate until the input is consumed and the output flushed
+        do {
+            z->next_out = out;
+            z->avail_out = sizeof(out);
+
+            rc = inflate(z, Z_NO_FLUSH);
+            if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR){
+                warnx("File Data inflate Error: %s\n", z->msg != NULL ? z->msg : "unknown");
                 return -1;
             }
 
-            // write [buffersize] bytes to file
-            if ((long)(fwrite(buffer, sizeof(char), (size_t) to_process, fp)) < to_process){
+            have = sizeof(out) - z->avail_out;
+            if (fwrite(out, sizeof(char), have, fp) < have){
                 warnx("File Data write Error\n");
                 return -1;
             }
+        } while (z->avail_out == 0);
 
-            counter -= to_process;
-            print_v("Copied %ld Bytes to File - %ld Bytes left\n",to_process,counter);
+        print_v("Inflated %ld Bytes to File - %ld Bytes left\n",to_process,counter);
+    }
+
+    return rc == Z_STREAM_END ? 1 : 0;
+}
+
+/**
+ * \brief Copy a chunked file of a protocol version 2 response to disk.
+ * The data of the file follows its file frame in chunk frames, the empty chunk frame ends it.
+ * A deflate encoded file is one deflate stream split into the chunks.
+ *
+ * \param read_fd - FILE pointer where to read the response
+ * \param fp - FILE pointer of the file to write to
+ * \param deflated - the file is deflate encoded if non-zero
+ *
+ * @returns 0 if everything went well or -1 in case of error
+ */
+static int read_chunked(FILE *read_fd, FILE *fp, int deflated) {
+    unsigned char buffer[SMP2_HEADER_LEN];
+    smp2_header_t header;
+    int rc = 0;
+    int ended = 0;
+    z_stream z;
+
+    memset(&z, 0, sizeof(z));
+    // raw deflate stream without zlib header
+    if (deflated && inflateInit2(&z, -15) != Z_OK){
+        warnx("Could not initialize inflate\n");
+        return -1;
+    }
+
+    for (;;) {
+        if (fread(buffer, 1, sizeof(buffer), read_fd) != sizeof(buffer)) {
+            warnx("Could not read chunk frame - file truncated\n");
+            rc = -1;
+            break;
+        }
+        if (smp2_decode_header(buffer, &header) == -1 || header.type != SMP2_FRAME_CHUNK) {
+            warnx("Expected chunk frame from server\n");
+            rc = -1;
+            break;
+        }
+        print_v("Obtained chunk of %lu Bytes\n", (unsigned long) header.len);
+        if (header.len == 0) {
+            break;
         }
 
-        if (fclose(fp) == EOF) {
-            warnx("Error closing filestream\n");
-            return -1;
+        if (deflated) {
+            if ((rc = inflate_chunk(&z, read_fd, fp, (long) header.len)) == -1) {
+                break;
+            }
+            ended = rc;
+            rc = 0;
+        } else if ((rc = copy_data(read_fd, fp, (long) header.len)) != 0) {
+            break;
         }
     }
-    return 0;
+
+    if (deflated) {
+        inflateEnd(&z);
+        if (rc == 0 && !ended) {
+            warnx("File Data truncated deflate stream\n");
+            rc = -1;
+        }
+    }
+
+    return rc;
 }
 
 /*
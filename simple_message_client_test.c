@@ -0,0 +1,311 @@
+/* ================================================================ */
+/**
+ * @file simple_message_client_test.c
+ * Test of the client against a server without protocol version 2.
+ *
+ * In the course "Verteilte Computer Systeme" the students shall
+ * implement a bulletin board. It shall consist of a spawning TCP/IP
+ * server which executes the business logic provided by the lector,
+ * and a suitable TCP/IP client.
+ *
+ * This source file runs the client given as argument against a server
+ * answering like the original business logic: a request not starting
+ * with "user=" is rejected with an error response of version 1, any
+ * other one is answered with an OK response. The client has to retry
+ * the post of version 2 with version 1 and the retry has to be
+ * accepted, i.e. it must not start with option lines the original
+ * business logic does not know. It is run by ctest, the exit status is
+ * EXIT_FAILURE if any check failed.
+ */
+/*
+ * $Id:$
+ */
+
+/*
+ * -------------------------------------------------------------- includes --
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*
+ * --------------------------------------------------------------- defines --
+ */
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+#define MAXREQUESTLEN 4096
+#define TIMEOUT 10             /* seconds until a hanging client fails the test */
+
+#define HTML_FILE "vcs_tcpip_bulletin_board_response.html"
+#define OK_HTML "<html><body>ok</body></html>\n"
+#define ERROR_HTML "<html><body>error</body></html>\n"
+#define PNG "\x89PNG\r\n\x1a\n"
+
+/*
+ * --------------------------------------------------------------- globals --
+ */
+
+static unsigned int failures = 0;
+
+/*
+ * ------------------------------------------------------------- functions --
+ */
+
+/**
+ * \brief Record the outcome of a check
+ *
+ * \param ok non-zero if the check passed [IN]
+ * \param expr zero-terminated string containing the checked expression [IN]
+ * \param line line of the check [IN]
+ */
+static void check(
+    int ok,
+    const char *expr,
+    int line
+    )
+{
+    if (!ok)
+    {
+        (void) fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, line, expr);
+        failures++;
+    }
+}
+
+/**
+ * \brief Read a request until the client shuts down its side
+ *
+ * \param fd the connected socket [IN]
+ * \param buf buffer for the zero-terminated request of MAXREQUESTLEN bytes [OUT]
+ *
+ * \return the length of the request
+ */
+static size_t read_request(
+    int fd,
+    char *buf
+    )
+{
+    size_t len = 0;
+    ssize_t cnt;
+
+    while (
+        (len < MAXREQUESTLEN - 1) &&
+        ((cnt = read(fd, buf + len, MAXREQUESTLEN - 1 - len)) > 0)
+        )
+    {
+        len += (size_t) cnt;
+    }
+
+    buf[len] = '\0';
+
+    return len;
+}
+
+/**
+ * \brief Answer a request like the original business logic
+ *
+ * \param fd the connected socket [IN]
+ * \param request the zero-terminated request [IN]
+ */
+static void respond(
+    int fd,
+    const char *request
+    )
+{
+    const int ok = (strncmp(request, "user=", strlen("user=")) == 0);
+    const char *html = ok ? OK_HTML : ERROR_HTML;
+    char response[MAXREQUESTLEN];
+    int cnt;
+
+    cnt = snprintf(
+        response,
+        sizeof(response),
+        "status=%d\nfile=" HTML_FILE "\nlen=%zu\n%sfile=%s\nlen=%zu\n" PNG,
+        ok ? 0 : 1,
+        strlen(html),
+        html,
+        ok ? "ok.png" : "error.png",
+        strlen(PNG)
+        );
+
+    CHECK((cnt > 0) && ((size_t) cnt < sizeof(response)));
+    CHECK(write(fd, response, (size_t) cnt) == cnt);
+}
+
+/**
+ * \brief Check the contents of a received file
+ *
+ * \param filename zero-terminated string containing the name of the file [IN]
+ * \param expected zero-terminated string containing the expected contents [IN]
+ *
+ * \retval 1 the file has the expected contents
+ * \retval 0 otherwise
+ */
+static int has_contents(
+    const char *filename,
+    const char *expected
+    )
+{
+    char buf[MAXREQUESTLEN];
+    FILE *fp;
+    size_t len;
+
+    if ((fp = fopen(filename, "r")) == NULL)
+    {
+        return 0;
+    }
+
+    len = fread(buf, 1, sizeof(buf), fp);
+    (void) fclose(fp);
+
+    return (len == strlen(expected)) && (memcmp(buf, expected, len) == 0);
+}
+
+/**
+ * \brief Post a message through the fallback to protocol version 1
+ *
+ * \param client zero-terminated string containing the path of the client [IN]
+ */
+static void test_fallback(
+    const char *client
+    )
+{
+    char requests[2][MAXREQUESTLEN];
+    char port[8];
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    int lfd, fd, i, status;
+    pid_t pid;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    if (
+        ((lfd = socket(AF_INET, SOCK_STREAM, 0)) == -1) ||
+        (bind(lfd, (struct sockaddr *) &addr, sizeof(addr)) == -1) ||
+        (listen(lfd, 2) == -1) ||
+        (getsockname(lfd, (struct sockaddr *) &addr, &addr_len) == -1)
+        )
+    {
+        perror("listening socket");
+        failures++;
+        return;
+    }
+
+    (void) snprintf(port, sizeof(port), "%u", (unsigned int) ntohs(addr.sin_port));
+
+    if ((pid = fork()) == -1)
+    {
+        perror("fork");
+        failures++;
+        (void) close(lfd);
+        return;
+    }
+
+    if (pid == 0)
+    {
+        (void) close(lfd);
+        (void) execl(
+            client, client,
+            "-s", "127.0.0.1", "-p", port, "-u", "tester", "-m", "hello",
+            (char *) NULL
+            );
+        perror(client);
+        _exit(EXIT_FAILURE);
+    }
+
+    /*
+     * the request of version 2 and its retry with version 1
+     */
+    for (i = 0; i < 2; i++)
+    {
+        if ((fd = accept(lfd, NULL, NULL)) == -1)
+        {
+            perror("accept");
+            failures++;
+            break;
+        }
+
+        (void) read_request(fd, requests[i]);
+        respond(fd, requests[i]);
+        (void) close(fd);
+    }
+
+    (void) close(lfd);
+
+    CHECK(waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS));
+
+    if (i == 2)
+    {
+        CHECK(strncmp(requests[0], "SMP2", strlen("SMP2")) == 0);
+        CHECK(strcmp(requests[1], "user=tester\nhello") == 0);
+    }
+
+    CHECK(has_contents(HTML_FILE, OK_HTML));
+    CHECK(has_contents("ok.png", PNG));
+}
+
+/**
+ * \brief Run the test in a temporary directory receiving the files
+ *
+ * \param argc the number of arguments [IN]
+ * \param argv the arguments [IN]
+ *
+ * \return EXIT_SUCCESS if all checks passed, EXIT_FAILURE otherwise
+ */
+int main(
+    int argc,
+    char **argv
+    )
+{
+    char dir[] = "/tmp/simple_message_client_test.XXXXXX";
+    char client[4096];
+
+    if (argc != 2)
+    {
+        (void) fprintf(stderr, "usage: %s client\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (
+        (realpath(argv[1], client) == NULL) ||
+        (mkdtemp(dir) == NULL) ||
+        (chdir(dir) == -1)
+        )
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    (void) alarm(TIMEOUT);
+
+    test_fallback(client);
+
+    (void) unlink(HTML_FILE);
+    (void) unlink("ok.png");
+    (void) unlink("error.png");
+    (void) chdir("/");
+    (void) rmdir(dir);
+
+    if (failures > 0)
+    {
+        (void) fprintf(stderr, "%s: %u checks failed\n", __FILE__, failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * =================================================================== eof ==
+ */